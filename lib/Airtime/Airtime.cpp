@@ -0,0 +1,43 @@
+#include "Airtime.h"
+
+namespace Airtime {
+
+// 2^SF / (125 kHz << bw), exact in microseconds for SF >= 7
+uint32_t loraSymbolUs(uint8_t sf, uint8_t bandwidth)
+{
+    if (sf < 7) sf = 7;
+    if (sf > 12) sf = 12;
+    if (bandwidth > 2) bandwidth = 2;
+    return 8UL << (sf - bandwidth);
+}
+
+uint32_t loraPacketUs(uint8_t sf, uint8_t bandwidth, uint8_t codingRate,
+                      uint16_t preambleLength, size_t payloadLen, bool crc)
+{
+    if (sf < 7) sf = 7;
+    if (sf > 12) sf = 12;
+    if (bandwidth > 2) bandwidth = 2;
+    if (codingRate < 1) codingRate = 1;
+    if (codingRate > 4) codingRate = 4;
+
+    uint32_t symbolUs = loraSymbolUs(sf, bandwidth);
+    bool lowDataRate = symbolUs >= 16384;
+
+    int32_t bits = 8 * (int32_t)payloadLen - 4 * sf + 28 + (crc ? 16 : 0);
+    int32_t bitsPerBlock = 4 * (sf - (lowDataRate ? 2 : 0));
+    int32_t blocks = bits > 0 ? (bits + bitsPerBlock - 1) / bitsPerBlock : 0;
+    uint32_t payloadSymbols = 8 + (uint32_t)blocks * (codingRate + 4);
+
+    // (Npreamble + 4.25) symbols, counted in quarter symbols
+    uint32_t preambleQuarters = 4UL * preambleLength + 17;
+    return preambleQuarters * symbolUs / 4 + payloadSymbols * symbolUs;
+}
+
+uint32_t fskPacketUs(uint32_t bitrate, size_t payloadLen, bool crc)
+{
+    if (bitrate == 0) return 0;
+    uint64_t bits = 8ULL * (FSK_PREAMBLE_BYTES + FSK_SYNC_BYTES + 1 + payloadLen + (crc ? 2 : 0));
+    return (uint32_t)((bits * 1000000ULL + bitrate - 1) / bitrate);
+}
+
+} // namespace Airtime
@@ -0,0 +1,51 @@
+#ifndef AIRTIME_H
+#define AIRTIME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Time on Air
+// ============================================================================
+// Host-compilable (no Arduino dependency) SX1262 packet time on air, in
+// microseconds. Used by the firmware's duty-cycle budget and by the native
+// simulation's radio model.
+//
+// LoRa (SX1262 datasheet 6.1.4, SF7-SF12):
+//   Tsym      = 2^SF / BW
+//   preamble  = (Npreamble + 4.25) * Tsym
+//   payload   = 8 + max(ceil((8*PL - 4*SF + 28 + 16*CRC - 20*IH) / (4*(SF - 2*DE))), 0) * (CR + 4)
+// DE (low data rate optimize) is on when Tsym >= 16.38 ms, as SX126x-Arduino
+// sets it: SF11/SF12 at 125 kHz and SF12 at 250 kHz. Resonant frames are
+// variable length, so the header is always explicit (IH = 0).
+// Reference points: 13 bytes at SF7/BW125/CR4-5 = 46.3 ms, 51 bytes at SF12 =
+// 2465.8 ms.
+//
+// FSK: preamble, sync word, length byte, payload and CRC at the bit rate.
+// The preamble and sync word lengths are the library defaults.
+namespace Airtime {
+    constexpr uint8_t FSK_PREAMBLE_BYTES = 5;
+    constexpr uint8_t FSK_SYNC_BYTES     = 3;
+
+    // bandwidth: 0 = 125 kHz, 1 = 250 kHz, 2 = 500 kHz. codingRate: 1-4 = 4/5-4/8.
+    uint32_t loraSymbolUs(uint8_t sf, uint8_t bandwidth);
+    uint32_t loraPacketUs(uint8_t sf, uint8_t bandwidth, uint8_t codingRate,
+                          uint16_t preambleLength, size_t payloadLen, bool crc = true);
+    uint32_t fskPacketUs(uint32_t bitrate, size_t payloadLen, bool crc = true);
+
+    // `totalBytes` split over `packetCount` packets as evenly as possible
+    // (ResonantLRRadio fragments frames above one packet)
+    template <typename PacketUs>
+    uint32_t splitUs(size_t totalBytes, uint8_t packetCount, PacketUs packetUs) {
+        if (packetCount == 0) return 0;
+        size_t base = totalBytes / packetCount;
+        size_t longer = totalBytes % packetCount;
+        uint32_t us = (packetCount - longer) * packetUs(base);
+        if (longer > 0) {
+            us += longer * packetUs(base + 1);
+        }
+        return us;
+    }
+}
+
+#endif // AIRTIME_H
@@ -0,0 +1,117 @@
+#include "CpuGovernor.h"
+
+const char* CpuGovernor::phaseName(CpuPhase phase) {
+    switch (phase) {
+        case CpuPhase::BOOT:       return "BOOT";
+        case CpuPhase::CRYPTO:     return "CRYPTO";
+        case CpuPhase::SENSOR_IO:  return "SENSOR_IO";
+        case CpuPhase::RADIO_WAIT: return "RADIO_WAIT";
+        case CpuPhase::FLUSH:      return "FLUSH";
+        default:                   return "?";
+    }
+}
+
+void CpuGovernor::begin(CpuClockBackend* backend) {
+    _backend = backend;
+    for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+        _held[p] = 0;
+        for (uint8_t l = 0; l < LEVEL_COUNT; l++) {
+            _phaseUs[p][l] = 0;
+        }
+    }
+    for (uint8_t l = 0; l < LEVEL_COUNT; l++) {
+        _levelUs[l] = 0;
+    }
+    _level = CpuLevel::IDLE;
+    _transitions = 0;
+    _segmentStartUs = _backend != nullptr ? _backend->nowUs() : 0;
+}
+
+void CpuGovernor::setLevel(CpuPhase phase, CpuLevel level) {
+    if (phase >= CpuPhase::COUNT || level >= CpuLevel::COUNT) return;
+    if (_held[(uint8_t)phase] > 0) return;
+    _phaseLevel[(uint8_t)phase] = level;
+}
+
+// The clock goes up before the phase's work starts
+void CpuGovernor::enter(CpuPhase phase) {
+    if (_backend == nullptr || phase >= CpuPhase::COUNT) return;
+    uint8_t p = (uint8_t)phase;
+    _backend->acquire(_phaseLevel[p]);
+
+    _backend->lock();
+    closeSegment(_backend->nowUs());
+    if (_held[p] < 0xFF) {
+        _held[p]++;
+    }
+    updateLevel();
+    _backend->unlock();
+}
+
+// ...and comes down only once it is done
+void CpuGovernor::leave(CpuPhase phase) {
+    if (_backend == nullptr || phase >= CpuPhase::COUNT) return;
+    uint8_t p = (uint8_t)phase;
+
+    _backend->lock();
+    if (_held[p] == 0) {
+        _backend->unlock();
+        return;
+    }
+    closeSegment(_backend->nowUs());
+    _held[p]--;
+    updateLevel();
+    _backend->unlock();
+
+    _backend->release(_phaseLevel[p]);
+}
+
+void CpuGovernor::settle() {
+    if (_backend == nullptr) return;
+    _backend->lock();
+    closeSegment(_backend->nowUs());
+    _backend->unlock();
+}
+
+double CpuGovernor::modeled_uWh(float supplyV) const {
+    double uWh = 0.0;
+    for (uint8_t l = 0; l < LEVEL_COUNT; l++) {
+        uWh += LEVEL_MA[l] * (_levelUs[l] / 1000.0) * supplyV / 3600.0;
+    }
+    return uWh;
+}
+
+double CpuGovernor::saved_uWh(float supplyV) const {
+    const float fullMa = LEVEL_MA[(uint8_t)CpuLevel::FULL];
+    double uWh = 0.0;
+    for (uint8_t l = 0; l < LEVEL_COUNT; l++) {
+        uWh += (fullMa - LEVEL_MA[l]) * (_levelUs[l] / 1000.0) * supplyV / 3600.0;
+    }
+    return uWh;
+}
+
+void CpuGovernor::closeSegment(uint64_t nowUs) {
+    uint64_t us = nowUs > _segmentStartUs ? nowUs - _segmentStartUs : 0;
+    _segmentStartUs = nowUs;
+    if (us == 0) return;
+    uint8_t l = (uint8_t)_level;
+    _levelUs[l] += us;
+    for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+        if (_held[p] > 0) {
+            _phaseUs[p][l] += us;
+        }
+    }
+}
+
+void CpuGovernor::updateLevel() {
+    CpuLevel next = CpuLevel::IDLE;
+    for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+        if (_held[p] > 0 && _phaseLevel[p] > next) {
+            next = _phaseLevel[p];
+        }
+    }
+    if (next != _level) {
+        _level = next;
+        _transitions++;
+    }
+}
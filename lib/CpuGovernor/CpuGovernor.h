@@ -0,0 +1,119 @@
+#ifndef CPU_GOVERNOR_H
+#define CPU_GOVERNOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// What the code in a stretch of the wake is doing, for its clock needs
+enum class CpuPhase : uint8_t {
+    BOOT,               // setup() up to the first loop() pass
+    CRYPTO,             // ECDH/ECDSA, credential parsing, AES-GCM
+    SENSOR_IO,          // I2C conversions and reads
+    RADIO_WAIT,         // waiting on the SX1262 (ACK and command windows)
+    FLUSH,              // SPI FRAM write-back
+    COUNT
+};
+
+// CPU clock, lowest first. IO keeps APB at 80 MHz so SPI and I2C run at
+// their configured rates; IDLE drops to the 40 MHz crystal.
+enum class CpuLevel : uint8_t {
+    IDLE,
+    IO,
+    FULL,
+    COUNT
+};
+
+// ============================================================================
+// Clock Control Backend
+// ============================================================================
+// Levels are held like ESP-IDF PM locks: refcounted, and the clock runs at
+// the highest one held (IDLE when none is). The firmware backend maps them
+// to esp_pm locks; the native simulation uses a mock that checks the
+// transitions.
+class CpuClockBackend {
+public:
+    virtual ~CpuClockBackend() = default;
+
+    virtual uint64_t nowUs() = 0;
+    virtual void acquire(CpuLevel level) = 0;
+    virtual void release(CpuLevel level) = 0;
+
+    // Serializes the governor's accounting across cores; no-op on the host
+    virtual void lock() {}
+    virtual void unlock() {}
+};
+
+// ============================================================================
+// CPU Governor
+// ============================================================================
+// Host-compilable (no Arduino dependency). Each phase declares the level it
+// needs; enter() raises the clock to it before the work starts and leave()
+// lets it drop again. Phases nest and may overlap across cores, and the
+// clock follows the highest level among the phases held.
+//
+// Time is accounted per level and, for each phase, per level it actually
+// ran at (a SENSOR_IO read inside BOOT runs at FULL). The modeled MCU
+// current per level gives the energy, and the saving against running the
+// whole wake at FULL, for the power manager's estimate.
+class CpuGovernor {
+public:
+    static constexpr uint8_t PHASE_COUNT = (uint8_t)CpuPhase::COUNT;
+    static constexpr uint8_t LEVEL_COUNT = (uint8_t)CpuLevel::COUNT;
+
+    // ESP32-S3, both cores running, WiFi/BT off; FULL matches the power
+    // manager's fixed MCU term
+    static constexpr uint16_t LEVEL_MHZ[LEVEL_COUNT] = {40, 80, 240};
+    static constexpr float    LEVEL_MA[LEVEL_COUNT]  = {14.0f, 22.0f, 40.0f};
+
+    static const char* phaseName(CpuPhase phase);
+
+    // Starts the accounting; nothing held
+    void begin(CpuClockBackend* backend);
+
+    // Override the default level of a phase (before it is first entered)
+    void setLevel(CpuPhase phase, CpuLevel level);
+    CpuLevel level(CpuPhase phase) const { return _phaseLevel[(uint8_t)phase]; }
+
+    void enter(CpuPhase phase);
+    void leave(CpuPhase phase);
+    bool active(CpuPhase phase) const { return _held[(uint8_t)phase] > 0; }
+
+    CpuLevel current() const { return _level; }
+    uint16_t currentMhz() const { return LEVEL_MHZ[(uint8_t)_level]; }
+    uint32_t transitions() const { return _transitions; }
+
+    // Closes the running segment at now, so the totals below include it
+    void settle();
+
+    // Since begin(), as of the last settle(), enter() or leave()
+    uint64_t levelUs(CpuLevel level) const { return _levelUs[(uint8_t)level]; }
+    uint64_t phaseUs(CpuPhase phase, CpuLevel level) const {
+        return _phaseUs[(uint8_t)phase][(uint8_t)level];
+    }
+
+    // Modeled MCU energy, and what running it all at FULL would have cost more
+    double modeled_uWh(float supplyV) const;
+    double saved_uWh(float supplyV) const;
+
+private:
+    CpuClockBackend* _backend = nullptr;
+    CpuLevel _phaseLevel[PHASE_COUNT] = {
+        CpuLevel::FULL,     // BOOT
+        CpuLevel::FULL,     // CRYPTO
+        CpuLevel::IO,       // SENSOR_IO
+        CpuLevel::IDLE,     // RADIO_WAIT
+        CpuLevel::IO,       // FLUSH
+    };
+    uint8_t _held[PHASE_COUNT] = {};
+    CpuLevel _level = CpuLevel::IDLE;
+    uint64_t _segmentStartUs = 0;
+    uint64_t _levelUs[LEVEL_COUNT] = {};
+    uint64_t _phaseUs[PHASE_COUNT][LEVEL_COUNT] = {};
+    uint32_t _transitions = 0;
+
+    // Caller holds the backend lock
+    void closeSegment(uint64_t nowUs);
+    void updateLevel();
+};
+
+#endif // CPU_GOVERNOR_H
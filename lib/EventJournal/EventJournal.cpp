@@ -0,0 +1,163 @@
+#include "EventJournal.h"
+#include <string.h>
+
+namespace {
+
+void putBe16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+uint16_t getBe16(const uint8_t* p) {
+    return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+} // namespace
+
+// CRC-8, polynomial 0x07, initial 0xFF: an all-zero slot does not pass
+uint8_t EventJournal::crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)(crc << 1) ^ 0x07 : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool EventJournal::begin(JournalStorage* storage, uint16_t base, uint16_t capacity) {
+    _storage = storage;
+    _base = base;
+    _capacity = capacity;
+
+    uint8_t header[HEADER_SIZE];
+    _storage->read(_base, header, sizeof(header));
+    _head = getBe16(header + 2);
+    _count = getBe16(header + 4);
+    bool valid = getBe16(header) == MAGIC
+              && header[6] == crc8(header, HEADER_SIZE - 1)
+              && _head < _capacity
+              && _count <= _capacity;
+    if (!valid) {
+        clear();
+    }
+    return valid;
+}
+
+void EventJournal::clear() {
+    _head = 0;
+    _count = 0;
+    writeHeader();
+}
+
+void EventJournal::writeHeader() {
+    uint8_t header[HEADER_SIZE];
+    putBe16(header, MAGIC);
+    putBe16(header + 2, _head);
+    putBe16(header + 4, _count);
+    header[6] = crc8(header, HEADER_SIZE - 1);
+    _storage->write(_base, header, sizeof(header));
+}
+
+void EventJournal::append(const JournalRecord& record) {
+    if (_storage == nullptr || _capacity == 0) return;
+    // A full ring first gives up its oldest record, which the write below
+    // overwrites, so a power cut in between never leaves a half-written slot
+    // inside the journal
+    if (_count == _capacity) {
+        _count--;
+        writeHeader();
+    }
+    uint8_t slot[RECORD_SIZE];
+    encode(record, slot);
+    _storage->write(slotAddress(_head), slot, sizeof(slot));
+
+    _head = (uint16_t)((_head + 1) % _capacity);
+    if (_count < _capacity) _count++;
+    writeHeader();
+}
+
+size_t EventJournal::buildPage(uint8_t page, uint8_t* out, size_t outLen) const {
+    if (_storage == nullptr) return 0;
+    size_t skip = (size_t)page * PAGE_RECORDS;
+    if (page > 0 && skip >= _count) return 0;
+    uint8_t n = (uint8_t)(_count - skip < PAGE_RECORDS ? _count - skip : PAGE_RECORDS);
+    size_t len = PAGE_HEADER_SIZE + n * RECORD_SIZE;
+    if (outLen < len) return 0;
+
+    out[0] = page;
+    out[1] = pageCount();
+    putBe16(out + 2, _count);
+    out[4] = n;
+    if (n == 0) return len;
+
+    // The page's slots in storage order (oldest first), one read or two if
+    // they wrap, then reversed to newest first
+    uint8_t* records = out + PAGE_HEADER_SIZE;
+    uint16_t newest = (uint16_t)((_head + _capacity - 1 - skip % _capacity) % _capacity);
+    uint16_t oldest = (uint16_t)((newest + _capacity + 1 - n) % _capacity);
+    uint16_t first = oldest + n <= _capacity ? n : (uint16_t)(_capacity - oldest);
+    _storage->read(slotAddress(oldest), records, first * RECORD_SIZE);
+    if (first < n) {
+        _storage->read(slotAddress(0), records + first * RECORD_SIZE, (n - first) * RECORD_SIZE);
+    }
+    uint8_t tmp[RECORD_SIZE];
+    for (uint8_t i = 0; i < n / 2; i++) {
+        uint8_t* a = records + i * RECORD_SIZE;
+        uint8_t* b = records + (n - 1 - i) * RECORD_SIZE;
+        memcpy(tmp, a, RECORD_SIZE);
+        memcpy(a, b, RECORD_SIZE);
+        memcpy(b, tmp, RECORD_SIZE);
+    }
+    return len;
+}
+
+void EventJournal::encode(const JournalRecord& r, uint8_t out[RECORD_SIZE]) {
+    putBe16(out, r.cycle);
+    out[2] = (uint8_t)r.wake;
+    out[3] = (uint8_t)r.tx;
+    out[4] = r.flags;
+    out[5] = (uint8_t)r.ackRssi;
+    out[6] = (uint8_t)r.ackSnr;
+    putBe16(out + 7, r.batteryCentivolts);
+    putBe16(out + 9, r.awakeMs);
+    out[11] = crc8(out, RECORD_SIZE - 1);
+}
+
+bool EventJournal::decode(const uint8_t in[RECORD_SIZE], JournalRecord* r) {
+    if (in[11] != crc8(in, RECORD_SIZE - 1)) return false;
+    r->cycle = getBe16(in);
+    r->wake = (JournalWake)in[2];
+    r->tx = (JournalTx)in[3];
+    r->flags = in[4];
+    r->ackRssi = (int8_t)in[5];
+    r->ackSnr = (int8_t)in[6];
+    r->batteryCentivolts = getBe16(in + 7);
+    r->awakeMs = getBe16(in + 9);
+    return true;
+}
+
+int EventJournal::parsePage(const uint8_t* in, size_t len, PageInfo* info,
+                            JournalRecord* out, size_t maxOut) {
+    if (in == nullptr || len < PAGE_HEADER_SIZE) return -1;
+    info->page = in[0];
+    info->pageCount = in[1];
+    info->count = getBe16(in + 2);
+    info->records = in[4];
+    info->damaged = 0;
+    if (info->records > PAGE_RECORDS || len != PAGE_HEADER_SIZE + info->records * RECORD_SIZE) {
+        return -1;
+    }
+
+    int decoded = 0;
+    for (uint8_t i = 0; i < info->records; i++) {
+        JournalRecord r;
+        if (!decode(in + PAGE_HEADER_SIZE + i * RECORD_SIZE, &r)) {
+            info->damaged++;
+        } else if ((size_t)decoded < maxOut) {
+            out[decoded++] = r;
+        }
+    }
+    return decoded;
+}
@@ -0,0 +1,157 @@
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// What started the wake
+enum class JournalWake : uint8_t {
+    POWER_ON,
+    TIMER,
+    BUTTON,
+    CONTACT,
+    RADIO,              // wake-on-radio command
+    RESET               // any other reset: brownout detector, watchdog, panic
+};
+
+// How this wake's telemetry frame fared
+enum class JournalTx : uint8_t {
+    NONE,               // nothing sent (radio off, not adopted, boot error)
+    SENT,               // sent, no ACK requested
+    ACKED,
+    NO_ACK,             // ACK requested, none received
+    FAILED,             // radio reported a TX failure
+    DEFERRED            // held back by the airtime budget
+};
+
+namespace JournalFlag {
+    constexpr uint8_t BROWNOUT       = 0x01;    // previous wake's TX never completed
+    constexpr uint8_t BROWNOUT_RESET = 0x02;    // chip reset by the brownout detector
+    constexpr uint8_t METRICS_SENT   = 0x04;
+    constexpr uint8_t COMMAND        = 0x08;    // a command was received
+    constexpr uint8_t BOOT_ERROR     = 0x10;
+    constexpr uint8_t RADIO_OFF      = 0x20;    // sample-only wake
+}
+
+struct JournalRecord {
+    uint16_t cycle = 0;                 // low 16 bits of the metrics cycleCount
+    JournalWake wake = JournalWake::TIMER;
+    JournalTx tx = JournalTx::NONE;
+    uint8_t flags = 0;
+    int8_t ackRssi = 0;                 // dBm, 0 = no ACK this wake
+    int8_t ackSnr = 0;                  // dB
+    uint16_t batteryCentivolts = 0;     // raw reading this wake
+    uint16_t awakeMs = 0;               // saturates at 65535
+};
+
+// ============================================================================
+// Journal Storage Backend
+// ============================================================================
+// Byte access to the journal's address range. The firmware backend is the
+// SPI FRAM; the native simulation uses a RAM image.
+class JournalStorage {
+public:
+    virtual ~JournalStorage() = default;
+
+    virtual void read(uint16_t addr, uint8_t* buf, size_t len) = 0;
+    virtual void write(uint16_t addr, const uint8_t* data, size_t len) = 0;
+};
+
+// ============================================================================
+// Event Journal
+// ============================================================================
+// Host-compilable (no Arduino dependency) ring of one fixed-size record per
+// wake. The cumulative counters in the metrics report say how often a link
+// or power problem happened; the journal says when, and what else happened
+// in the same wakes. The gateway reads it back a page at a time
+// (CMD_READ_JOURNAL).
+//
+// Header (7 bytes at base, big-endian like the rest of FRAM):
+//   0-1    magic       uint16_t MAGIC
+//   2-3    head        uint16_t next slot to write
+//   4-5    count       uint16_t records held, up to capacity
+//   6      crc         CRC-8 of bytes 0-5
+//
+// Record (RECORD_SIZE bytes, one slot):
+//   0-1    cycle       uint16_t
+//   2      wake        JournalWake
+//   3      tx          JournalTx
+//   4      flags       JournalFlag bits
+//   5      ackRssi     int8_t, dBm
+//   6      ackSnr      int8_t, dB
+//   7-8    battery     uint16_t, centivolts
+//   9-10   awakeMs     uint16_t
+//   11     crc         CRC-8 of bytes 0-10
+//
+// append() writes the record, then the header, so a brownout between the
+// two only loses that record (once the ring is full, the oldest one goes a
+// wake early: the header drops it before its slot is reused). A damaged
+// header (bad magic or CRC) restarts the journal empty.
+//
+// Page (buildPage(), newest records first, page 0 = the newest):
+//   0      page        uint8_t
+//   1      pageCount   uint8_t, pages holding records
+//   2-3    count       uint16_t, records held
+//   4      records     uint8_t, in this page (0-PAGE_RECORDS)
+//   5..    records     RECORD_SIZE bytes each, as stored, CRC included
+class EventJournal {
+public:
+    static constexpr uint8_t  CMD_READ_JOURNAL = 0x0A;
+    static constexpr uint8_t  MAX_PAGES_PER_COMMAND = 4;
+
+    static constexpr uint16_t MAGIC = 0x4A31;           // "J1"
+    static constexpr size_t   HEADER_SIZE = 7;
+    static constexpr size_t   RECORD_SIZE = 12;
+    static constexpr uint8_t  PAGE_RECORDS = 16;
+    static constexpr size_t   PAGE_HEADER_SIZE = 5;
+    static constexpr size_t   PAGE_SIZE = PAGE_HEADER_SIZE + PAGE_RECORDS * RECORD_SIZE;
+
+    static constexpr size_t regionSize(uint16_t capacity) {
+        return HEADER_SIZE + (size_t)capacity * RECORD_SIZE;
+    }
+
+    // False if the header was missing or damaged; the journal then starts
+    // empty (one header write)
+    bool begin(JournalStorage* storage, uint16_t base, uint16_t capacity);
+    bool isInitialized() const { return _storage != nullptr; }
+
+    void append(const JournalRecord& record);
+    void clear();
+
+    uint16_t count() const { return _count; }
+    uint16_t capacity() const { return _capacity; }
+    uint8_t pageCount() const { return (uint8_t)((_count + PAGE_RECORDS - 1) / PAGE_RECORDS); }
+
+    // Returns the page length, 0 if the page is past the last one (page 0 of
+    // an empty journal is a header with no records) or out is too small
+    size_t buildPage(uint8_t page, uint8_t* out, size_t outLen) const;
+
+    static void encode(const JournalRecord& record, uint8_t out[RECORD_SIZE]);
+    // False on a CRC mismatch
+    static bool decode(const uint8_t in[RECORD_SIZE], JournalRecord* record);
+    static uint8_t crc8(const uint8_t* data, size_t len);
+
+    // Gateway side
+    struct PageInfo {
+        uint8_t page;
+        uint8_t pageCount;
+        uint16_t count;
+        uint8_t records;        // in this page
+        uint8_t damaged;        // of those, failed their CRC (not in out)
+    };
+    // Returns the records decoded into out, newest first; -1 on a malformed page
+    static int parsePage(const uint8_t* in, size_t len, PageInfo* info,
+                         JournalRecord* out, size_t maxOut);
+
+private:
+    JournalStorage* _storage = nullptr;
+    uint16_t _base = 0;
+    uint16_t _capacity = 0;
+    uint16_t _head = 0;
+    uint16_t _count = 0;
+
+    uint16_t slotAddress(uint16_t slot) const { return _base + HEADER_SIZE + slot * RECORD_SIZE; }
+    void writeHeader();
+};
+
+#endif // EVENT_JOURNAL_H
@@ -0,0 +1,187 @@
+#include "FrameBatch.h"
+#include <openssl/evp.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace ResonantWire;
+
+// ============================================================================
+// SessionKeyCache
+// ============================================================================
+
+SessionKeyCache::SessionKeyCache(size_t capacity, Loader loader)
+    : _capacity(capacity > 0 ? capacity : 1), _loader(std::move(loader)) {}
+
+SessionKeyCache::~SessionKeyCache() {
+    for (auto& e : _entries) {
+        EVP_CIPHER_CTX_free(e.second.ctx);
+    }
+}
+
+bool SessionKeyCache::put(uint32_t sourceId, const uint8_t key[KEY_SIZE]) {
+    erase(sourceId);
+    return insert(sourceId, key) != nullptr;
+}
+
+void SessionKeyCache::erase(uint32_t sourceId) {
+    auto it = _entries.find(sourceId);
+    if (it == _entries.end()) return;
+    EVP_CIPHER_CTX_free(it->second.ctx);
+    _lru.erase(it->second.lru);
+    _entries.erase(it);
+}
+
+evp_cipher_ctx_st* SessionKeyCache::context(uint32_t sourceId) {
+    auto it = _entries.find(sourceId);
+    if (it != _entries.end()) {
+        _hits++;
+        _lru.splice(_lru.begin(), _lru, it->second.lru);
+        return it->second.ctx;
+    }
+    _misses++;
+    uint8_t key[KEY_SIZE];
+    if (!_loader || !_loader(sourceId, key)) return nullptr;
+    evp_cipher_ctx_st* ctx = insert(sourceId, key);
+    memset(key, 0, sizeof(key));
+    return ctx;
+}
+
+// Key schedule expanded here, once; frames then pass only their IV
+evp_cipher_ctx_st* SessionKeyCache::insert(uint32_t sourceId, const uint8_t* key) {
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    if (ctx == nullptr) return nullptr;
+    if (EVP_DecryptInit_ex(ctx, EVP_aes_128_gcm(), nullptr, nullptr, nullptr) != 1
+        || EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, GCM_IV_SIZE, nullptr) != 1
+        || EVP_DecryptInit_ex(ctx, nullptr, nullptr, key, nullptr) != 1) {
+        EVP_CIPHER_CTX_free(ctx);
+        return nullptr;
+    }
+    while (_entries.size() >= _capacity) {
+        erase(_lru.back());
+    }
+    _lru.push_front(sourceId);
+    _entries[sourceId] = Entry{ctx, _lru.begin()};
+    return ctx;
+}
+
+// ============================================================================
+// FrameBatchDecoder
+// ============================================================================
+
+size_t FrameBatchDecoder::decode(const FrameRef* frames, size_t count, DecodedFrame* out) {
+    // Pass 1: header and checksum, in arrival order. Plaintext-only frame
+    // types are done here; the rest wait for their key.
+    _order.clear();
+    for (size_t i = 0; i < count; i++) {
+        DecodedFrame& d = out[i];
+        const uint8_t* payload;
+        size_t len;
+        d.status = FrameDecoder::parse(frames[i].data, frames[i].len, &d.header, &payload, &len);
+        d.kind = PayloadKind::UNKNOWN;
+        d.encrypted = false;
+        d.payloadLen = 0;
+        if (d.status != FrameStatus::OK) continue;
+        if (encryptedType(d.header.frameType)) {
+            _order.push_back((uint64_t)d.header.sourceId << 32 | (uint32_t)i);
+            continue;
+        }
+        memcpy(d.payload, payload, len);
+        d.payloadLen = (uint8_t)len;
+    }
+
+    // Pass 2: grouped by device, one key lookup per group
+    std::sort(_order.begin(), _order.end());
+    evp_cipher_ctx_st* ctx = nullptr;
+    uint32_t current = 0;
+    for (size_t n = 0; n < _order.size(); n++) {
+        uint32_t sourceId = (uint32_t)(_order[n] >> 32);
+        DecodedFrame& d = out[(uint32_t)_order[n]];
+        if (n == 0 || sourceId != current) {
+            ctx = _keys.context(sourceId);
+            current = sourceId;
+        }
+        const uint8_t* payload = frames[(uint32_t)_order[n]].data + HEADER_SIZE;
+        size_t len = frames[(uint32_t)_order[n]].len - FRAME_OVERHEAD;
+        if (ctx != nullptr) {
+            if (!decrypt(ctx, d.header, payload, len, &d)) {
+                d.status = FrameStatus::AUTH_FAILED;
+                continue;
+            }
+            d.encrypted = true;
+        } else if (_requireEncryption) {
+            d.status = FrameStatus::NO_KEY;
+            continue;
+        } else {
+            memcpy(d.payload, payload, len);
+            d.payloadLen = (uint8_t)len;
+        }
+    }
+
+    size_t ok = 0;
+    for (size_t i = 0; i < count; i++) {
+        DecodedFrame& d = out[i];
+        if (d.status != FrameStatus::OK) continue;
+        d.kind = FrameDecoder::kind(d.header, d.payload, d.payloadLen);
+        if (!validPayload(d)) {
+            d.status = FrameStatus::BAD_PAYLOAD;
+            continue;
+        }
+        ok++;
+    }
+    return ok;
+}
+
+bool FrameBatchDecoder::decode(const uint8_t* frame, size_t len, DecodedFrame* out) {
+    FrameRef ref{frame, len};
+    return decode(&ref, 1, out) == 1;
+}
+
+// The frames ResonantEncryption covers: everything the device sends after
+// adoption except the ACK
+bool FrameBatchDecoder::encryptedType(uint8_t frameType) {
+    return frameType == TYPE_TELEMETRY || frameType == TYPE_METRICS
+        || frameType == TYPE_COMMAND_RESPONSE || frameType == TYPE_SETTINGS;
+}
+
+bool FrameBatchDecoder::decrypt(evp_cipher_ctx_st* ctx, const FrameHeader& header,
+                                const uint8_t* payload, size_t len, DecodedFrame* out) {
+    if (len <= GCM_OVERHEAD) return false;
+    size_t ctLen = len - GCM_OVERHEAD;
+    uint8_t aad[AAD_SIZE];
+    uint8_t tag[GCM_TAG_SIZE];
+    FrameDecoder::aad(header, aad);
+    memcpy(tag, payload + GCM_IV_SIZE + ctLen, GCM_TAG_SIZE);
+
+    int n = 0;
+    int tail = 0;
+    if (EVP_DecryptInit_ex(ctx, nullptr, nullptr, nullptr, payload) != 1
+        || EVP_DecryptUpdate(ctx, nullptr, &n, aad, AAD_SIZE) != 1
+        || EVP_DecryptUpdate(ctx, out->payload, &n, payload + GCM_IV_SIZE, (int)ctLen) != 1
+        || EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, GCM_TAG_SIZE, tag) != 1
+        || EVP_DecryptFinal_ex(ctx, out->payload + n, &tail) != 1) {
+        memset(out->payload, 0, ctLen);
+        return false;
+    }
+    out->payloadLen = (uint8_t)(n + tail);
+    return true;
+}
+
+bool FrameBatchDecoder::validPayload(const DecodedFrame& d) {
+    switch (d.kind) {
+    case PayloadKind::TELEMETRY: {
+        TelemetryReading readings[FrameDecoder::MAX_READINGS];
+        return FrameDecoder::telemetry(d.header, d.payload, d.payloadLen,
+                                       readings, FrameDecoder::MAX_READINGS) > 0;
+    }
+    case PayloadKind::METRICS:
+    case PayloadKind::SETTINGS:
+        return d.payloadLen == REGION_SIZE;
+    case PayloadKind::METRICS_DELTA:
+        return d.payloadLen >= 6;               // MetricsDelta::HEADER_SIZE
+    case PayloadKind::COMMAND_RESPONSE:
+        return d.payloadLen >= 2;
+    case PayloadKind::UNKNOWN:
+        return !encryptedType(d.header.frameType);
+    }
+    return false;
+}
@@ -0,0 +1,115 @@
+#ifndef FRAME_BATCH_H
+#define FRAME_BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "FrameDecoder.h"
+
+struct evp_cipher_ctx_st;       // OpenSSL EVP_CIPHER_CTX
+
+// ============================================================================
+// Session Key Cache
+// ============================================================================
+// Per-device AES-128-GCM decrypt contexts for the gateway, keyed by source
+// ID. Each holds the expanded key schedule, so a frame only sets its IV.
+// Devices not in the cache are asked of the loader (adoption database etc.),
+// least recently used ones are dropped past `capacity`.
+//
+// Not thread-safe: one cache per decoding thread. The loader may be shared
+// if it is.
+class SessionKeyCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 65536;
+
+    // False if the device has no session key (not adopted)
+    using Loader = std::function<bool(uint32_t sourceId, uint8_t key[ResonantWire::KEY_SIZE])>;
+
+    explicit SessionKeyCache(size_t capacity = DEFAULT_CAPACITY, Loader loader = nullptr);
+    ~SessionKeyCache();
+    SessionKeyCache(const SessionKeyCache&) = delete;
+    SessionKeyCache& operator=(const SessionKeyCache&) = delete;
+
+    // New adoption or re-key. False if OpenSSL could not set the key up.
+    bool put(uint32_t sourceId, const uint8_t key[ResonantWire::KEY_SIZE]);
+    void erase(uint32_t sourceId);
+
+    // Keyed decrypt context, nullptr if the device has no key
+    evp_cipher_ctx_st* context(uint32_t sourceId);
+
+    size_t size() const { return _entries.size(); }
+    uint64_t hits() const { return _hits; }
+    uint64_t misses() const { return _misses; }
+
+private:
+    struct Entry {
+        evp_cipher_ctx_st* ctx;
+        std::list<uint32_t>::iterator lru;
+    };
+
+    size_t _capacity;
+    Loader _loader;
+    std::unordered_map<uint32_t, Entry> _entries;
+    std::list<uint32_t> _lru;           // most recent first
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+
+    evp_cipher_ctx_st* insert(uint32_t sourceId, const uint8_t* key);
+};
+
+// ============================================================================
+// Frame Batch Decoder
+// ============================================================================
+// Validates, decrypts and classifies many frames in one call. Frames are
+// checked in arrival order, then decrypted grouped by source ID, so each
+// device's context is looked up once per batch and stays hot in cache while
+// its frames go through. AES and GHASH run on OpenSSL's AES-NI/PCLMUL (or
+// ARMv8 crypto) code paths.
+//
+// Telemetry, metrics, command response and settings frames are decrypted
+// when the cache has a key for their source. Without one they are taken as
+// the plaintext fallback (`encrypted` false) unless requireEncryption is on.
+// Other frame types (adoption, ACK) pass through as plaintext. Every
+// payload is checked against its frame type; a plaintext frame that is
+// really ciphertext fails as BAD_PAYLOAD.
+//
+// Not thread-safe: one decoder, with its own cache, per thread.
+struct FrameRef {
+    const uint8_t* data;
+    size_t len;
+};
+
+struct DecodedFrame {
+    FrameStatus status;
+    FrameHeader header;
+    PayloadKind kind;
+    bool encrypted;
+    uint8_t payloadLen;
+    uint8_t payload[ResonantWire::MAX_PAYLOAD];     // plaintext
+};
+
+class FrameBatchDecoder {
+public:
+    explicit FrameBatchDecoder(SessionKeyCache& keys) : _keys(keys) {}
+
+    void setRequireEncryption(bool require) { _requireEncryption = require; }
+
+    // out[i] is frames[i]. Returns frames decoded OK.
+    size_t decode(const FrameRef* frames, size_t count, DecodedFrame* out);
+    bool decode(const uint8_t* frame, size_t len, DecodedFrame* out);
+
+private:
+    SessionKeyCache& _keys;
+    bool _requireEncryption = false;
+    std::vector<uint64_t> _order;       // sourceId << 32 | index
+
+    static bool encryptedType(uint8_t frameType);
+    static bool decrypt(evp_cipher_ctx_st* ctx, const FrameHeader& header,
+                        const uint8_t* payload, size_t len, DecodedFrame* out);
+    static bool validPayload(const DecodedFrame& frame);
+};
+
+#endif // FRAME_BATCH_H
@@ -0,0 +1,238 @@
+#include "FrameDecoder.h"
+#include <TelemetryCodec.h>
+#include <math.h>
+#include <string.h>
+
+using namespace ResonantWire;
+
+namespace {
+
+constexpr uint64_t EVEN_BYTES = 0x00FF00FF00FF00FFULL;
+constexpr size_t SWAR_WORDS = 128;          // 2 * 255 * 128 still fits a 16-bit lane
+
+uint16_t be16(const uint8_t* p) {
+    return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+uint32_t be32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+void putBe32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+TelemetryReading reading(uint32_t ageS, float celsius, int8_t contact) {
+    return TelemetryReading{ageS, celsius, NAN, contact};
+}
+
+size_t legacyTelemetry(const uint8_t* p, size_t len, TelemetryReading* out) {
+    if (len != 3 || p[2] > 1) return 0;
+    out[0] = reading(0, (int16_t)be16(p) / 100.0f, (int8_t)p[2]);
+    return 1;
+}
+
+size_t batchTelemetry(const uint8_t* p, size_t len, TelemetryReading* out, size_t maxOut) {
+    if (len < 2) return 0;
+    uint8_t count = p[1];
+    if (count == 0 || count > maxOut || len != 2 + (size_t)count * 5) return 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t* r = p + 2 + i * 5;
+        out[i] = reading(be16(r), (int16_t)be16(r + 2) / 100.0f, r[4] ? 1 : 0);
+    }
+    return count;
+}
+
+size_t compactTelemetry(const uint8_t* p, size_t len, TelemetryReading* out, size_t maxOut) {
+    TelemetrySample samples[FrameDecoder::MAX_READINGS];
+    uint8_t max = maxOut < FrameDecoder::MAX_READINGS ? (uint8_t)maxOut : FrameDecoder::MAX_READINGS;
+    uint8_t n = TelemetryCodec::decode(p, len, samples, max);
+    for (uint8_t i = 0; i < n; i++) {
+        out[i] = reading(samples[i].ageS, TelemetryCodec::celsiusFromRaw(samples[i].raw),
+                         samples[i].contact ? 1 : 0);
+    }
+    return n;
+}
+
+// One reading per frame: the channels fill in its fields
+size_t typedTelemetry(const uint8_t* p, size_t len, TelemetryReading* out) {
+    if (len < 2) return 0;
+    TelemetryReading r = reading(0, NAN, -1);
+    size_t i = 2;
+    for (uint8_t ch = 0; ch < p[1]; ch++) {
+        if (i >= len) return 0;
+        uint8_t type = p[i++];
+        if (type & 0x80) continue;          // read failed, no sample
+        switch (type) {
+        case 0x01:
+            if (i + 2 > len) return 0;
+            r.celsius = TelemetryCodec::celsiusFromRaw((int16_t)be16(p + i));
+            i += 2;
+            break;
+        case 0x02:
+            if (i + 1 > len) return 0;
+            r.contact = p[i++] ? 1 : 0;
+            break;
+        case 0x03:
+            if (i + 4 > len) return 0;
+            // A TMP112 on the same board wins the temperature
+            if (isnan(r.celsius)) r.celsius = -45.0f + 175.0f * be16(p + i) / 65536.0f;
+            r.humidity = 100.0f * be16(p + i + 2) / 65536.0f;
+            i += 4;
+            break;
+        default:
+            return 0;                       // unknown size, cannot skip it
+        }
+    }
+    if (i != len) return 0;
+    out[0] = r;
+    return 1;
+}
+
+} // namespace
+
+const char* frameStatusName(FrameStatus status) {
+    switch (status) {
+    case FrameStatus::OK:           return "ok";
+    case FrameStatus::TOO_SHORT:    return "too short";
+    case FrameStatus::BAD_HEADER:   return "bad header";
+    case FrameStatus::BAD_LENGTH:   return "bad length";
+    case FrameStatus::BAD_CHECKSUM: return "bad checksum";
+    case FrameStatus::NO_KEY:       return "no key";
+    case FrameStatus::AUTH_FAILED:  return "auth failed";
+    case FrameStatus::BAD_PAYLOAD:  return "bad payload";
+    }
+    return "?";
+}
+
+// Even and odd bytes of each 64-bit word go into four 16-bit lanes. Byte
+// order does not matter for a plain sum, so loads are native-endian.
+uint8_t FrameDecoder::checksum(const uint8_t* frame, size_t len) {
+    if (len < 4) return 0;
+    const uint8_t* p = frame + 3;
+    size_t n = len - 4;
+    uint32_t sum = 0;
+    while (n >= 8) {
+        size_t words = n / 8 < SWAR_WORDS ? n / 8 : SWAR_WORDS;
+        uint64_t lanes = 0;
+        for (size_t w = 0; w < words; w++) {
+            uint64_t v;
+            memcpy(&v, p, 8);
+            lanes += (v & EVEN_BYTES) + ((v >> 8) & EVEN_BYTES);
+            p += 8;
+        }
+        n -= words * 8;
+        sum += (uint32_t)(lanes & 0xFFFF) + (uint32_t)(lanes >> 16 & 0xFFFF)
+             + (uint32_t)(lanes >> 32 & 0xFFFF) + (uint32_t)(lanes >> 48);
+    }
+    while (n--) {
+        sum += *p++;
+    }
+    return (uint8_t)sum;
+}
+
+FrameStatus FrameDecoder::parse(const uint8_t* frame, size_t len, FrameHeader* header,
+                                const uint8_t** payload, size_t* payloadLen) {
+    if (frame == nullptr || len < FRAME_OVERHEAD) return FrameStatus::TOO_SHORT;
+    if (frame[0] != HEADER_BYTE) return FrameStatus::BAD_HEADER;
+    if (len > MAX_FRAME || be16(frame + 1) != len - 3) return FrameStatus::BAD_LENGTH;
+    if (checksum(frame, len) != frame[len - 1]) return FrameStatus::BAD_CHECKSUM;
+
+    header->sourceId = be32(frame + 3);
+    header->destinationId = be32(frame + 7);
+    header->frameType = frame[11];
+    header->options = frame[12];
+    header->sequence = be32(frame + 13);
+    header->totalPackets = frame[17];
+    header->packetIndex = frame[18];
+    *payload = frame + HEADER_SIZE;
+    *payloadLen = len - FRAME_OVERHEAD;
+    return FrameStatus::OK;
+}
+
+void FrameDecoder::aad(const FrameHeader& header, uint8_t out[AAD_SIZE]) {
+    out[0] = header.frameType;
+    putBe32(out + 1, header.sourceId);
+    putBe32(out + 5, header.sequence);
+}
+
+PayloadKind FrameDecoder::kind(const FrameHeader& header, const uint8_t* payload, size_t len) {
+    bool extended = (header.options & OPTION_EXTENDED) && len > 0;
+    switch (header.frameType) {
+    case TYPE_TELEMETRY:
+        return PayloadKind::TELEMETRY;
+    case TYPE_METRICS:
+        if (!extended) return PayloadKind::METRICS;
+        return payload[0] == METRICS_DELTA ? PayloadKind::METRICS_DELTA : PayloadKind::UNKNOWN;
+    case TYPE_SETTINGS:
+        return PayloadKind::SETTINGS;
+    case TYPE_COMMAND_RESPONSE:
+        return PayloadKind::COMMAND_RESPONSE;
+    default:
+        return PayloadKind::UNKNOWN;
+    }
+}
+
+size_t FrameDecoder::telemetry(const FrameHeader& header, const uint8_t* payload, size_t len,
+                               TelemetryReading* out, size_t maxOut) {
+    if (header.frameType != TYPE_TELEMETRY || payload == nullptr || maxOut == 0) return 0;
+    if (!(header.options & OPTION_EXTENDED)) return legacyTelemetry(payload, len, out);
+    if (len == 0) return 0;
+    switch (payload[0]) {
+    case TELEMETRY_BATCH:   return batchTelemetry(payload, len, out, maxOut);
+    case TELEMETRY_COMPACT: return compactTelemetry(payload, len, out, maxOut);
+    case TELEMETRY_TYPED:   return typedTelemetry(payload, len, out);
+    default:                return 0;
+    }
+}
+
+bool FrameDecoder::metrics(const FrameHeader& header, const uint8_t* payload, size_t len,
+                           MetricsSummary* out) {
+    if (header.frameType != TYPE_METRICS || (header.options & OPTION_EXTENDED)) return false;
+    return metrics(payload, len, out);
+}
+
+bool FrameDecoder::metrics(const uint8_t* p, size_t len, MetricsSummary* out) {
+    if (p == nullptr || len != REGION_SIZE) return false;
+    out->metricsVersion = p[0];
+    out->firmwareVersion = p[1];
+    out->hardwareVersion = p[2];
+    out->sensorType = p[3];
+    out->batteryCentivolts = be16(p + 4);
+    out->totalTxMs = be32(p + 6);
+    out->totalRxMs = be32(p + 10);
+    out->totalActiveMs = be32(p + 14);
+    out->totalSleepS = be32(p + 18);
+    out->cycleCount = be32(p + 22);
+    out->txCount = be32(p + 26);
+    out->ackFailCount = p[30];
+    out->ackFailTotal = be16(p + 31);
+    out->telemetrySinceMetrics = be16(p + 33);
+    out->bootCount = be16(p + 35);
+    out->totalEnergy_uWh = be32(p + 37);
+    return true;
+}
+
+bool FrameDecoder::settings(const uint8_t* p, size_t len, SettingsSummary* out) {
+    if (p == nullptr || len != REGION_SIZE) return false;
+    out->settingsVersion = p[0];
+    out->telemetryInterval = be16(p + 1);
+    out->telemetryMaxWake = be16(p + 3);
+    out->txPower = (int8_t)p[5];
+    out->spreadingFactor = p[6];
+    out->bandwidth = p[7];
+    out->frequency = be32(p + 8);
+    out->codingRate = p[12];
+    out->waitAfterTx = be16(p + 13);
+    out->ackFailThreshold = p[15];
+    out->telemetryAckRequired = p[16];
+    out->metricsReportInterval = be16(p + 17);
+    out->parentId = be32(p + 19);
+    out->sensorType = p[33];
+    out->firmwareVersion = p[34];
+    out->hardwareVersion = p[35];
+    return true;
+}
@@ -0,0 +1,160 @@
+#ifndef FRAME_DECODER_H
+#define FRAME_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Frame Decoder
+// ============================================================================
+// Host-side (no Arduino dependency) parser for the frames in
+// V1_SENSOR_WIRE_FORMAT.md, for gateway ingestion. The constants mirror
+// RESONANT_FRAME and ResonantEncryption; keep them in step with the wire doc.
+//
+// This file covers everything after decryption: header and checksum checks
+// and typed views of the telemetry, metrics and settings payloads. Batched
+// GCM decryption with per-device keys is in FrameBatch.h.
+//
+// The checksum runs 8 bytes at a time (SWAR: four 16-bit lane sums in one
+// 64-bit word), so validating a 255-byte frame is ~32 adds, not 251.
+namespace ResonantWire {
+    constexpr uint8_t HEADER_BYTE      = 0x85;
+    constexpr size_t  HEADER_SIZE      = 19;
+    constexpr size_t  FRAME_OVERHEAD   = 20;        // header + checksum
+    constexpr size_t  MAX_FRAME        = 255;
+    constexpr size_t  MAX_PAYLOAD      = MAX_FRAME - FRAME_OVERHEAD;
+
+    constexpr size_t  GCM_IV_SIZE      = 12;
+    constexpr size_t  GCM_TAG_SIZE     = 16;
+    constexpr size_t  GCM_OVERHEAD     = GCM_IV_SIZE + GCM_TAG_SIZE;
+    constexpr size_t  AAD_SIZE         = 9;
+    constexpr size_t  KEY_SIZE         = 16;        // AES-128 session key
+
+    constexpr uint8_t TYPE_TELEMETRY        = 0x01;
+    constexpr uint8_t TYPE_METRICS          = 0x02;
+    constexpr uint8_t TYPE_COMMAND_RESPONSE = 0x03;
+    constexpr uint8_t TYPE_SETTINGS         = 0x04;
+    constexpr uint8_t TYPE_COMMAND          = 0x08;
+
+    constexpr uint8_t OPTION_ACK       = 0x01;
+    constexpr uint8_t OPTION_EXTENDED  = 0x02;
+
+    constexpr uint8_t TELEMETRY_BATCH  = 0x01;
+    constexpr uint8_t TELEMETRY_COMPACT = 0x02;
+    constexpr uint8_t TELEMETRY_TYPED  = 0x03;
+    constexpr uint8_t METRICS_DELTA    = 0x01;
+
+    constexpr size_t  REGION_SIZE      = 207;       // metrics and settings payloads
+}
+
+enum class FrameStatus : uint8_t {
+    OK,
+    TOO_SHORT,          // under 20 bytes
+    BAD_HEADER,         // first byte not 0x85
+    BAD_LENGTH,         // length field does not match the frame
+    BAD_CHECKSUM,
+    NO_KEY,             // encrypted payload, no session key for the source
+    AUTH_FAILED,        // GCM tag mismatch
+    BAD_PAYLOAD         // decrypted, but not a payload of its frame type
+};
+
+const char* frameStatusName(FrameStatus status);
+
+enum class PayloadKind : uint8_t {
+    UNKNOWN,
+    TELEMETRY,
+    METRICS,            // full 207-byte report
+    METRICS_DELTA,      // apply to a baseline with MetricsDelta::decode()
+    SETTINGS,
+    COMMAND_RESPONSE
+};
+
+struct FrameHeader {
+    uint32_t sourceId;          // bytes 3-6 as a big-endian number
+    uint32_t destinationId;
+    uint32_t sequence;
+    uint8_t frameType;
+    uint8_t options;
+    uint8_t totalPackets;
+    uint8_t packetIndex;
+};
+
+// One reading from any telemetry format. NaN where the format or the
+// board has no such value.
+struct TelemetryReading {
+    uint32_t ageS;              // seconds before TX (0 for single readings)
+    float celsius;
+    float humidity;             // %RH, SHTC3 only
+    int8_t contact;             // 1 closed, 0 open, -1 not reported
+};
+
+// Universal part of the metrics report (bytes 0-40)
+struct MetricsSummary {
+    uint8_t metricsVersion;
+    uint8_t firmwareVersion;
+    uint8_t hardwareVersion;
+    uint8_t sensorType;
+    uint16_t batteryCentivolts;
+    uint32_t totalTxMs;
+    uint32_t totalRxMs;
+    uint32_t totalActiveMs;
+    uint32_t totalSleepS;
+    uint32_t cycleCount;
+    uint32_t txCount;
+    uint8_t ackFailCount;
+    uint16_t ackFailTotal;
+    uint16_t telemetrySinceMetrics;
+    uint16_t bootCount;
+    uint32_t totalEnergy_uWh;
+};
+
+// Universal part of the settings report (bytes 0-35)
+struct SettingsSummary {
+    uint8_t settingsVersion;
+    uint16_t telemetryInterval;
+    uint16_t telemetryMaxWake;
+    int8_t txPower;
+    uint8_t spreadingFactor;
+    uint8_t bandwidth;
+    uint32_t frequency;
+    uint8_t codingRate;
+    uint16_t waitAfterTx;
+    uint8_t ackFailThreshold;
+    uint8_t telemetryAckRequired;
+    uint16_t metricsReportInterval;
+    uint32_t parentId;
+    uint8_t sensorType;
+    uint8_t firmwareVersion;
+    uint8_t hardwareVersion;
+};
+
+class FrameDecoder {
+public:
+    static constexpr size_t MAX_READINGS = 40;     // TelemetryBatch::MAX_RECORDS
+
+    // Sum of bytes [3..len-2], as the last byte of a valid frame
+    static uint8_t checksum(const uint8_t* frame, size_t len);
+
+    // Header, length field and checksum. On OK, `payload` points into
+    // `frame` (still encrypted if the source is adopted).
+    static FrameStatus parse(const uint8_t* frame, size_t len, FrameHeader* header,
+                             const uint8_t** payload, size_t* payloadLen);
+
+    // frameType + sourceID + sequence, as the sender built it
+    static void aad(const FrameHeader& header, uint8_t out[ResonantWire::AAD_SIZE]);
+
+    static PayloadKind kind(const FrameHeader& header, const uint8_t* payload, size_t len);
+
+    // Any telemetry format. Returns readings written, 0 if the payload is
+    // malformed or `out` is too small.
+    static size_t telemetry(const FrameHeader& header, const uint8_t* payload, size_t len,
+                            TelemetryReading* out, size_t maxOut);
+
+    // Full reports only; false for deltas and short payloads
+    static bool metrics(const FrameHeader& header, const uint8_t* payload, size_t len,
+                        MetricsSummary* out);
+    static bool metrics(const uint8_t* region, size_t len, MetricsSummary* out);
+    static bool settings(const uint8_t* payload, size_t len, SettingsSummary* out);
+};
+
+#endif // FRAME_DECODER_H
@@ -0,0 +1,115 @@
+#include "MetricsDelta.h"
+#include <TelemetryCodec.h>
+
+namespace {
+
+uint32_t getField(const uint8_t* region, const MetricsDelta::Field& f) {
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < f.size; i++) {
+        v = (v << 8) | region[f.offset + i];
+    }
+    return v;
+}
+
+void putField(uint8_t* region, const MetricsDelta::Field& f, uint32_t v) {
+    for (uint8_t i = f.size; i > 0; i--) {
+        region[f.offset + i - 1] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+// (current - base) modulo the field width, sign-extended
+int32_t fieldDelta(uint32_t current, uint32_t base, uint8_t size) {
+    uint32_t d = current - base;
+    if (size >= 4) return (int32_t)d;
+    uint8_t shift = 32 - 8 * size;
+    return (int32_t)(d << shift) >> shift;
+}
+
+bool validTable(const MetricsDelta::Field* fields, uint8_t fieldCount, size_t regionLen) {
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        uint8_t s = fields[i].size;
+        if ((s != 1 && s != 2 && s != 4) || fields[i].offset + s > regionLen) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+size_t MetricsDelta::encode(const Field* fields, uint8_t fieldCount,
+                            const uint8_t* base, const uint8_t* current, size_t regionLen,
+                            uint32_t baseSequence, uint8_t* out, size_t outLen) {
+    size_t bitmapLen = bitmapSize(fieldCount);
+    if (fieldCount == 0 || outLen < HEADER_SIZE + bitmapLen
+        || !validTable(fields, fieldCount, regionLen)) {
+        return 0;
+    }
+
+    // Anything the table does not cover must be unchanged
+    for (size_t b = 0; b < regionLen; b++) {
+        if (base[b] == current[b]) continue;
+        bool inTable = false;
+        for (uint8_t i = 0; i < fieldCount && !inTable; i++) {
+            inTable = b >= fields[i].offset && b < (size_t)fields[i].offset + fields[i].size;
+        }
+        if (!inTable) return 0;
+    }
+
+    out[0] = FORMAT_DELTA;
+    out[1] = (uint8_t)(baseSequence >> 24);
+    out[2] = (uint8_t)(baseSequence >> 16);
+    out[3] = (uint8_t)(baseSequence >> 8);
+    out[4] = (uint8_t)baseSequence;
+    out[5] = fieldCount;
+    uint8_t* bitmap = out + HEADER_SIZE;
+    for (size_t i = 0; i < bitmapLen; i++) {
+        bitmap[i] = 0;
+    }
+
+    size_t pos = HEADER_SIZE + bitmapLen;
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        uint32_t now = getField(current, fields[i]);
+        uint32_t was = getField(base, fields[i]);
+        if (now == was) continue;
+        bitmap[i / 8] |= (uint8_t)(1 << (i % 8));
+        uint32_t v = TelemetryCodec::zigzag(fieldDelta(now, was, fields[i].size));
+        size_t n = TelemetryCodec::putVarint(v, out + pos, outLen - pos);
+        if (n == 0) return 0;
+        pos += n;
+    }
+    return pos;
+}
+
+bool MetricsDelta::decode(const Field* fields, uint8_t fieldCount,
+                          const uint8_t* in, size_t inLen,
+                          uint8_t* region, size_t regionLen, uint32_t* baseSequence) {
+    size_t bitmapLen = bitmapSize(fieldCount);
+    if (inLen < HEADER_SIZE + bitmapLen || in[0] != FORMAT_DELTA || in[5] != fieldCount
+        || !validTable(fields, fieldCount, regionLen)) {
+        return false;
+    }
+    if (baseSequence != nullptr) {
+        *baseSequence = MetricsDelta::baseSequence(in, inLen);
+    }
+
+    const uint8_t* bitmap = in + HEADER_SIZE;
+    size_t pos = HEADER_SIZE + bitmapLen;
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        if (!(bitmap[i / 8] & (1 << (i % 8)))) continue;
+        uint32_t v;
+        size_t n = TelemetryCodec::getVarint(in + pos, inLen - pos, &v);
+        if (n == 0) return false;
+        pos += n;
+        putField(region, fields[i], getField(region, fields[i]) + (uint32_t)TelemetryCodec::unzigzag(v));
+    }
+    // Bits past the table and trailing bytes mean a different table
+    for (size_t i = fieldCount; i < bitmapLen * 8; i++) {
+        if (bitmap[i / 8] & (1 << (i % 8))) return false;
+    }
+    return pos == inLen;
+}
+
+uint32_t MetricsDelta::baseSequence(const uint8_t* in, size_t inLen) {
+    if (inLen < HEADER_SIZE || in[0] != FORMAT_DELTA) return 0;
+    return (uint32_t)in[1] << 24 | (uint32_t)in[2] << 16 | (uint32_t)in[3] << 8 | in[4];
+}
@@ -0,0 +1,57 @@
+#ifndef METRICS_DELTA_H
+#define METRICS_DELTA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Metrics Delta Codec
+// ============================================================================
+// Host-compilable (no Arduino dependency) encoder/decoder for the delta
+// metrics payload, metrics format 0x01. Used by the firmware, the native
+// benchmark and gateway-side decoders.
+//
+// The 207-byte metrics region is described by a table of big-endian unsigned
+// fields. A delta carries only the fields that differ from a baseline report
+// the gateway already holds, each as a zig-zag varint of (current - baseline)
+// modulo the field width, so counters that wrap still cost a byte or two.
+// Bytes outside the table are not carried; a change there needs a full report.
+//
+// Wire payload (format DELTA):
+//   0      format         0x01
+//   1-4    baseSequence   uint32_t, frame sequence number of the baseline
+//   5      fieldCount     uint8_t, table size the bitmap was built against
+//   6..    bitmap         ceil(fieldCount / 8) bytes, bit i = field i changed,
+//                         field 0 in bit 0 of the first byte
+//          deltas         varint zigzag(delta) per changed field, table order
+class MetricsDelta {
+public:
+    struct Field {
+        uint8_t offset;     // byte offset in the region
+        uint8_t size;       // 1, 2 or 4
+    };
+
+    static constexpr uint8_t FORMAT_DELTA = 0x01;
+    static constexpr size_t HEADER_SIZE = 6;
+    static constexpr size_t MAX_VARINT_SIZE = 5;
+
+    static constexpr size_t bitmapSize(uint8_t fieldCount) { return (fieldCount + 7) / 8; }
+
+    // Returns bytes written. 0 if a byte outside the table changed, or if out
+    // is too small; send a full report then.
+    static size_t encode(const Field* fields, uint8_t fieldCount,
+                         const uint8_t* base, const uint8_t* current, size_t regionLen,
+                         uint32_t baseSequence, uint8_t* out, size_t outLen);
+
+    // Applies a delta payload to a copy of the baseline in `region`. Returns
+    // false on a malformed payload or a table size mismatch (region is then
+    // left partly updated).
+    static bool decode(const Field* fields, uint8_t fieldCount,
+                       const uint8_t* in, size_t inLen,
+                       uint8_t* region, size_t regionLen, uint32_t* baseSequence);
+
+    // Baseline sequence named by a delta payload, 0 if it is not one
+    static uint32_t baseSequence(const uint8_t* in, size_t inLen);
+};
+
+#endif // METRICS_DELTA_H
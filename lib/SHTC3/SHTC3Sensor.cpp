@@ -0,0 +1,68 @@
+#include "SHTC3Sensor.h"
+
+bool SHTC3Sensor::begin(TwoWire& wire) {
+    _wire = &wire;
+
+    // A sleeping SHTC3 only ACKs the wake-up command, so that doubles as the probe
+    sensorOperational = command(CMD_WAKEUP);
+    if (!sensorOperational) {
+        return false;
+    }
+    delayMicroseconds(WAKEUP_US);
+    return command(CMD_SLEEP);
+}
+
+bool SHTC3Sensor::startConversion() {
+    if (!sensorOperational || !command(CMD_WAKEUP)) {
+        return false;
+    }
+    delayMicroseconds(WAKEUP_US);
+    return command(CMD_MEASURE);
+}
+
+bool SHTC3Sensor::readSample(uint8_t* out) {
+    uint8_t buf[6];
+    _wire->requestFrom(ADDRESS, (uint8_t)sizeof(buf));
+    bool ok = _wire->available() >= (int)sizeof(buf);
+    if (ok) {
+        for (uint8_t i = 0; i < sizeof(buf); i++) {
+            buf[i] = _wire->read();
+        }
+        ok = crc8(buf, 2) == buf[2] && crc8(buf + 3, 2) == buf[5];
+    }
+    command(CMD_SLEEP);
+    if (!ok) {
+        return false;
+    }
+
+    out[0] = buf[0];
+    out[1] = buf[1];
+    out[2] = buf[3];
+    out[3] = buf[4];
+    return true;
+}
+
+void SHTC3Sensor::shutdown() {
+    if (sensorOperational) {
+        command(CMD_SLEEP);
+    }
+}
+
+bool SHTC3Sensor::command(uint16_t cmd) {
+    _wire->beginTransmission(ADDRESS);
+    _wire->write((uint8_t)(cmd >> 8));
+    _wire->write((uint8_t)(cmd & 0xFF));
+    return _wire->endTransmission() == 0;
+}
+
+// CRC-8, polynomial 0x31, init 0xFF (datasheet section 5.9)
+uint8_t SHTC3Sensor::crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
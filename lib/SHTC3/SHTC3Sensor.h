@@ -0,0 +1,44 @@
+#ifndef SHTC3_SENSOR_H
+#define SHTC3_SENSOR_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <SensorChannel.h>
+
+// ============================================================================
+// SHTC3 temperature + humidity channel (multi-sensor SKUs)
+// ============================================================================
+// Register-level instead of the SparkFun library so the measurement can be
+// started and read back later without blocking. The part is put back to sleep
+// (~0.3 uA) after every readout.
+//
+// Sample: raw T uint16_t, raw RH uint16_t.
+//   T = -45 + 175 * rawT / 65536 C, RH = 100 * rawRH / 65536 %
+class SHTC3Sensor : public SensorChannel {
+public:
+    static constexpr uint8_t  ADDRESS = 0x70;
+    static constexpr uint32_t MEASUREMENT_TIME_MS = 13;     // datasheet max 12.1 ms, normal mode
+
+    uint8_t type() const override { return SensorType::SHTC3_TEMP_RH; }
+    uint8_t sampleSize() const override { return 4; }
+    uint32_t conversionTimeMs() const override { return MEASUREMENT_TIME_MS; }
+    bool begin(TwoWire& wire) override;
+    bool startConversion() override;
+    bool readSample(uint8_t* out) override;
+    void shutdown() override;
+
+    bool sensorOperational = false;
+
+private:
+    TwoWire* _wire = nullptr;
+
+    static constexpr uint16_t CMD_WAKEUP  = 0x3517;
+    static constexpr uint16_t CMD_SLEEP   = 0xB098;
+    static constexpr uint16_t CMD_MEASURE = 0x7866;     // T first, normal mode, no clock stretching
+    static constexpr uint32_t WAKEUP_US   = 240;
+
+    bool command(uint16_t cmd);
+    static uint8_t crc8(const uint8_t* data, size_t len);
+};
+
+#endif // SHTC3_SENSOR_H
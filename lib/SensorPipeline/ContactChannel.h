@@ -0,0 +1,35 @@
+#ifndef CONTACT_CHANNEL_H
+#define CONTACT_CHANNEL_H
+
+#include "SensorChannel.h"
+
+// ============================================================================
+// Contact input (reed switch to GND, internal pull-up)
+// ============================================================================
+class ContactChannel : public SensorChannel {
+public:
+    explicit ContactChannel(uint8_t pin) : _pin(pin) {}
+
+    uint8_t type() const override { return SensorType::CONTACT; }
+    uint8_t sampleSize() const override { return 1; }
+    uint32_t conversionTimeMs() const override { return 0; }
+
+    bool begin(TwoWire&) override {
+        pinMode(_pin, INPUT_PULLUP);
+        return true;
+    }
+    bool startConversion() override { return true; }
+    bool readSample(uint8_t* out) override {
+        _closed = digitalRead(_pin) == LOW;
+        out[0] = _closed ? 0x01 : 0x00;
+        return true;
+    }
+
+    bool closed() const { return _closed; }
+
+private:
+    uint8_t _pin;
+    bool _closed = false;
+};
+
+#endif // CONTACT_CHANNEL_H
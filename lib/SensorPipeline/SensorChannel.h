@@ -0,0 +1,45 @@
+#ifndef SENSOR_CHANNEL_H
+#define SENSOR_CHANNEL_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// ============================================================================
+// Sample Types (typed telemetry record, format 0x03)
+// ============================================================================
+// Each type has a fixed sample size on the wire, see V1_SENSOR_WIRE_FORMAT.md.
+namespace SensorType {
+    constexpr uint8_t TMP112_TEMPERATURE = 0x01;    // int16_t raw count, 0.0625 C/LSB
+    constexpr uint8_t CONTACT            = 0x02;    // uint8_t 0x01 = closed
+    constexpr uint8_t SHTC3_TEMP_RH      = 0x03;    // uint16_t raw T + uint16_t raw RH
+
+    constexpr uint8_t READ_FAILED = 0x80;           // OR'd into the type, no sample bytes follow
+}
+
+// ============================================================================
+// Sensor Channel
+// ============================================================================
+// One source of samples in a SensorPipeline. A channel only has to start a
+// conversion and read it back; the pipeline starts every channel at once and
+// does the readback in one pass once the slowest conversion is done.
+class SensorChannel {
+public:
+    virtual ~SensorChannel() = default;
+
+    virtual uint8_t type() const = 0;
+    virtual uint8_t sampleSize() const = 0;
+    // Time from startConversion() until the result can be read, 0 = immediate
+    virtual uint32_t conversionTimeMs() const = 0;
+
+    // Probe the part; false = not fitted
+    virtual bool begin(TwoWire& wire) = 0;
+    virtual bool startConversion() = 0;
+    // Polled once conversionTimeMs() has passed, for parts with a done flag
+    virtual bool isReady() { return true; }
+    // Write sampleSize() bytes, big-endian. false = read failed.
+    virtual bool readSample(uint8_t* out) = 0;
+    // Lowest-power state before deep sleep
+    virtual void shutdown() {}
+};
+
+#endif // SENSOR_CHANNEL_H
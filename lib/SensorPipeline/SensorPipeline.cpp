@@ -0,0 +1,127 @@
+#include "SensorPipeline.h"
+
+bool SensorPipeline::add(SensorChannel* channel, bool required) {
+    if (channel == nullptr || _count >= MAX_CHANNELS || channel->sampleSize() > MAX_SAMPLE_SIZE) {
+        return false;
+    }
+    Slot& s = _slots[_count];
+    s.channel = channel;
+    s.required = required;
+    s.fitted = false;
+    s.valid = false;
+    s.offset = _count * MAX_SAMPLE_SIZE;
+    _count++;
+    return true;
+}
+
+bool SensorPipeline::begin(TwoWire& wire) {
+    wire.begin(SDA, SCL);
+    wire.setClock(I2C_CLOCK_HZ);
+
+    bool ok = true;
+    for (uint8_t i = 0; i < _count; i++) {
+        Slot& s = _slots[i];
+        s.fitted = s.channel->begin(wire);
+        if (!s.fitted && s.required) {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void SensorPipeline::start() {
+    _waitMs = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        Slot& s = _slots[i];
+        s.valid = false;
+        if (!s.fitted) continue;
+        if (!s.channel->startConversion()) continue;
+        uint32_t t = s.channel->conversionTimeMs();
+        if (t > _waitMs) _waitMs = t;
+    }
+    _startMs = millis();
+    _started = true;
+    _complete = false;
+}
+
+void SensorPipeline::loop() {
+    if (!isBusy()) {
+        return;
+    }
+
+    uint32_t elapsed = millis() - _startMs;
+    if (elapsed < _waitMs) {
+        return;
+    }
+    if (elapsed < _waitMs + TIMEOUT_MARGIN_MS) {
+        for (uint8_t i = 0; i < _count; i++) {
+            if (_slots[i].fitted && !_slots[i].channel->isReady()) {
+                return;
+            }
+        }
+    }
+
+    readAll();
+    _complete = true;
+    if (_callback != nullptr) {
+        _callback();
+    }
+}
+
+uint32_t SensorPipeline::msUntilDue() const {
+    if (!isBusy()) {
+        return UINT32_MAX;
+    }
+    uint32_t elapsed = millis() - _startMs;
+    return elapsed < _waitMs ? _waitMs - elapsed : READY_POLL_MS;
+}
+
+void SensorPipeline::readAll() {
+    for (uint8_t i = 0; i < _count; i++) {
+        Slot& s = _slots[i];
+        s.valid = s.fitted && s.channel->readSample(_samples + s.offset);
+    }
+}
+
+const uint8_t* SensorPipeline::sample(uint8_t type) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        const Slot& s = _slots[i];
+        if (s.fitted && s.channel->type() == type) {
+            return s.valid ? _samples + s.offset : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+size_t SensorPipeline::encode(uint8_t* out, size_t outLen) const {
+    if (!_complete || outLen < HEADER_SIZE) {
+        return 0;
+    }
+
+    size_t len = HEADER_SIZE;
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        const Slot& s = _slots[i];
+        if (!s.fitted) continue;
+        uint8_t size = s.valid ? s.channel->sampleSize() : 0;
+        if (len + 1 + size > outLen) {
+            return 0;
+        }
+        out[len++] = s.valid ? s.channel->type() : (s.channel->type() | SensorType::READ_FAILED);
+        memcpy(out + len, _samples + s.offset, size);
+        len += size;
+        n++;
+    }
+    out[0] = FORMAT_TYPED;
+    out[1] = n;
+    return len;
+}
+
+void SensorPipeline::shutdown() {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_slots[i].fitted) {
+            _slots[i].channel->shutdown();
+        }
+    }
+    _started = false;
+}
@@ -0,0 +1,82 @@
+#ifndef SENSOR_PIPELINE_H
+#define SENSOR_PIPELINE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "SensorChannel.h"
+
+// ============================================================================
+// Sensor Pipeline
+// ============================================================================
+// Registry of the sensor channels fitted to this board. start() kicks off
+// every conversion back-to-back, so the wait is that of the slowest
+// channel and not the sum of all of them. loop() never blocks. Once every
+// channel is ready (or the timeout hits), it reads them all in one pass on
+// the 400 kHz bus and fires onComplete.
+//
+// encode() serializes the samples as one typed record (format 0x03):
+//   0      format         0x03
+//   1      count          uint8_t
+//   2..    channels       count x { type uint8_t, sample (size fixed per type) }
+// A channel whose read failed is sent as type | 0x80 with no sample bytes.
+class SensorPipeline {
+public:
+    using CompleteCallback = void (*)();
+
+    static constexpr uint8_t  FORMAT_TYPED   = 0x03;
+    static constexpr uint8_t  MAX_CHANNELS   = 6;
+    static constexpr uint8_t  MAX_SAMPLE_SIZE = 8;
+    static constexpr size_t   HEADER_SIZE    = 2;
+    static constexpr size_t   MAX_RECORD_SIZE = HEADER_SIZE + MAX_CHANNELS * (1 + MAX_SAMPLE_SIZE);
+    static constexpr uint32_t I2C_CLOCK_HZ   = 400000;
+    static constexpr uint32_t TIMEOUT_MARGIN_MS = 20;   // past the slowest conversion time
+    static constexpr uint32_t READY_POLL_MS  = 1;       // done-flag polling inside the margin
+
+    // Register a channel. Required channels missing at begin() fail it;
+    // optional ones are just left out of the record.
+    bool add(SensorChannel* channel, bool required = false);
+    void onComplete(CompleteCallback cb) { _callback = cb; }
+
+    // Bring up the bus and probe every channel. false = a required one is missing.
+    bool begin(TwoWire& wire = Wire);
+
+    // Start a conversion on every fitted channel
+    void start();
+    void loop();
+    bool isBusy() const { return _started && !_complete; }
+    // How long a caller may block before loop() has work; UINT32_MAX if idle
+    uint32_t msUntilDue() const;
+    bool isComplete() const { return _complete; }
+
+    // Sample of the first fitted channel of this type from the last pass;
+    // nullptr if there is none or its read failed
+    const uint8_t* sample(uint8_t type) const;
+
+    // Returns bytes written, 0 if nothing has been read yet or out is too small
+    size_t encode(uint8_t* out, size_t outLen) const;
+
+    void shutdown();
+
+private:
+    struct Slot {
+        SensorChannel* channel;
+        bool required;
+        bool fitted;
+        bool valid;
+        uint8_t offset;             // into _samples
+    };
+
+    Slot _slots[MAX_CHANNELS] = {};
+    uint8_t _count = 0;
+    uint8_t _samples[MAX_CHANNELS * MAX_SAMPLE_SIZE] = {};
+    CompleteCallback _callback = nullptr;
+
+    bool _started = false;
+    bool _complete = false;
+    uint32_t _startMs = 0;
+    uint32_t _waitMs = 0;
+
+    void readAll();
+};
+
+#endif // SENSOR_PIPELINE_H
@@ -0,0 +1,52 @@
+#include "SettingsPatch.h"
+#include <string.h>
+
+namespace {
+
+const SettingsPatch::Field* find(const SettingsPatch::Field* fields, uint8_t fieldCount,
+                                 uint8_t offset) {
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        if (fields[i].offset == offset) return &fields[i];
+    }
+    return nullptr;
+}
+
+// Whole fields only, back to back, none protected
+bool validEntry(const SettingsPatch::Field* fields, uint8_t fieldCount,
+                uint8_t offset, uint8_t length, uint8_t* touch) {
+    if (length == 0 || (size_t)offset + length > SettingsPatch::REGION_SIZE) return false;
+    size_t end = (size_t)offset + length;
+    size_t pos = offset;
+    while (pos < end) {
+        const SettingsPatch::Field* f = find(fields, fieldCount, (uint8_t)pos);
+        if (f == nullptr || f->touch == 0 || pos + f->size > end) return false;
+        *touch |= f->touch;
+        pos += f->size;
+    }
+    return true;
+}
+
+} // namespace
+
+uint8_t SettingsPatch::apply(const Field* fields, uint8_t fieldCount,
+                             uint8_t* region, const uint8_t* patch, size_t patchLen) {
+    // Validate everything before the first write
+    uint8_t touch = 0;
+    size_t pos = 0;
+    while (pos < patchLen) {
+        if (patchLen - pos < 2) return 0;
+        uint8_t offset = patch[pos];
+        uint8_t length = patch[pos + 1];
+        if (patchLen - pos - 2 < length || !validEntry(fields, fieldCount, offset, length, &touch)) {
+            return 0;
+        }
+        pos += 2 + length;
+    }
+
+    pos = 0;
+    while (pos < patchLen) {
+        memcpy(region + patch[pos], patch + pos + 2, patch[pos + 1]);
+        pos += 2 + patch[pos + 1];
+    }
+    return touch;
+}
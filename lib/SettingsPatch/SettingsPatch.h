@@ -0,0 +1,47 @@
+#ifndef SETTINGS_PATCH_H
+#define SETTINGS_PATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Settings Patch
+// ============================================================================
+// Host-compilable (no Arduino dependency). Partial settings write for
+// one-packet downlinks. CMD_CONFIGURE_SETTINGS needs the whole 207-byte
+// region (a two-packet frame); a patch carries only the fields that change:
+//
+//   repeated:  offset  uint8_t   settings byte offset (wire layout)
+//              length  uint8_t   1-207
+//              bytes   length bytes, big-endian like the region
+//
+// Each entry must start and end on field boundaries of the settings layout
+// (the firmware's table is SettingsFields) and may span several adjacent
+// fields. Bytes outside the table (reserved) and protected fields (parentID,
+// sensorType, firmwareVersion, hardwareVersion) are rejected. The patched
+// region then goes through applySettingsFromWire() like a full configure,
+// so the library's validation still applies.
+class SettingsPatch {
+public:
+    static constexpr uint8_t CMD_PATCH_SETTINGS = 0x09;
+    static constexpr size_t REGION_SIZE = 207;
+
+    // Subsystems a patch touched, for re-applying only what changed
+    static constexpr uint8_t TOUCH_TIMING = 0x01;     // telemetryInterval, telemetryMaxWake
+    static constexpr uint8_t TOUCH_RADIO  = 0x02;     // txPower, SF, BW, frequency, CR
+    static constexpr uint8_t TOUCH_SENSOR = 0x04;     // sensor-specific tail
+    static constexpr uint8_t TOUCH_OTHER  = 0x08;     // read live from settings()
+
+    struct Field {
+        uint8_t offset;
+        uint8_t size;
+        uint8_t touch;      // 0 = protected
+    };
+
+    // Applies the entries to `region` (REGION_SIZE bytes). Returns the TOUCH_
+    // mask, 0 if the patch is empty or invalid (region then unchanged).
+    static uint8_t apply(const Field* fields, uint8_t fieldCount,
+                         uint8_t* region, const uint8_t* patch, size_t patchLen);
+};
+
+#endif // SETTINGS_PATCH_H
@@ -1,69 +1,160 @@
 #include "Sensor.h"
 
-bool TMP112Sensor::begin(TwoWire& wire, uint8_t addr) {
-    _wire = &wire;
-    _addr = addr;
+void TMP112Sensor::setOneShotMode(bool enabled) {
+    _oneShot = enabled;
+    applyConfig();
+}
+
+void TMP112Sensor::setExtendedMode(bool enabled) {
+    _extended = enabled;
+    applyConfig();
+}
+
+void TMP112Sensor::setConversionRate(ConversionRate rate) {
+    _rate = rate;
+    applyConfig();
+}
+
+void TMP112Sensor::configure(bool oneShot, bool extended, ConversionRate rate) {
+    // The rate only matters in continuous mode; in one-shot mode a change is
+    // kept for later without restarting the conversion in flight
+    bool rateChanged = rate != _rate && !oneShot;
+    _rate = rate;
+    if (oneShot == _oneShot && extended == _extended && !rateChanged) {
+        return;
+    }
+    _oneShot = oneShot;
+    _extended = extended;
+    applyConfig();
+}
+
+void TMP112Sensor::applyConfig() {
+    if (!sensorOperational) {
+        return;
+    }
+    if (!_oneShot) {
+        _conversionPending = false;
+        writeConfig(false, false);
+    } else if (_conversionPending) {
+        // Restart the in-flight conversion with the new format
+        writeConfig(true, true);
+        _conversionStartMs = millis();
+    } else {
+        writeConfig(true, false);
+    }
+}
 
-    _wire->begin(SDA, SCL);
+bool TMP112Sensor::begin(TwoWire& wire) {
+    _wire = &wire;
 
     _wire->beginTransmission(_addr);
     uint8_t error = _wire->endTransmission();
 
     sensorOperational = (error == 0);
-    return sensorOperational;
+    if (!sensorOperational) {
+        return false;
+    }
+
+    // One-shot: park in shutdown until the pipeline starts a conversion
+    return writeConfig(_oneShot, false);
 }
 
-void TMP112Sensor::setContactPin(uint8_t pin) {
-    _contactPin = (int8_t)pin;
-    pinMode(pin, INPUT_PULLUP);
+bool TMP112Sensor::startConversion() {
+    if (!sensorOperational) {
+        return false;
+    }
+    if (!_oneShot) {
+        return true;
+    }
+    if (!writeConfig(true, true)) {
+        return false;
+    }
+    _conversionPending = true;
+    _conversionStartMs = millis();
+    return true;
 }
 
-void TMP112Sensor::onDataReady(DataReadyCallback cb) {
-    _callback = cb;
+bool TMP112Sensor::isReady() {
+    if (!_conversionPending) {
+        return true;
+    }
+    uint32_t elapsed = millis() - _conversionStartMs;
+    if (elapsed < CONVERSION_TIME_MS) {
+        return false;
+    }
+    uint8_t cfg1 = 0;
+    bool done = readConfig(&cfg1) && (cfg1 & CFG1_OS);
+    return done || elapsed >= CONVERSION_TIMEOUT_MS;
 }
 
-void TMP112Sensor::requestReading() {
-    _readingRequested = true;
+bool TMP112Sensor::readSample(uint8_t* out) {
+    _conversionPending = false;
+    bool ok = readTemperature();
+    out[0] = ((uint16_t)lastRawCount >> 8) & 0xFF;
+    out[1] = (uint16_t)lastRawCount & 0xFF;
+    return ok;
 }
 
-void TMP112Sensor::loop() {
-    if (!_readingRequested || !sensorOperational) {
+void TMP112Sensor::shutdown() {
+    if (!sensorOperational) {
         return;
     }
-    _readingRequested = false;
+    _conversionPending = false;
+    writeConfig(true, false);
+}
 
-    float tempC = readTemperature();
-    contactClosed = readContact();
+bool TMP112Sensor::writeConfig(bool shutdown, bool oneShot) {
+    uint8_t cfg1 = CFG1_DEFAULT | (shutdown ? CFG1_SD : 0) | (oneShot ? CFG1_OS : 0);
+    uint8_t cfg2 = ((uint8_t)_rate << 6) | CFG2_AL | (_extended ? CFG2_EM : 0);
 
-    if (_callback != nullptr) {
-        _callback(tempC, contactClosed);
+    _wire->beginTransmission(_addr);
+    _wire->write(REG_CONFIG);
+    _wire->write(cfg1);
+    _wire->write(cfg2);
+    return _wire->endTransmission() == 0;
+}
+
+bool TMP112Sensor::readConfig(uint8_t* cfg1) {
+    _wire->beginTransmission(_addr);
+    _wire->write(REG_CONFIG);
+    _wire->endTransmission(false);
+
+    _wire->requestFrom(_addr, (uint8_t)2);
+    if (_wire->available() < 2) {
+        return false;
     }
+    *cfg1 = _wire->read();
+    _wire->read();
+    return true;
 }
 
-float TMP112Sensor::readTemperature() {
+bool TMP112Sensor::readTemperature() {
     _wire->beginTransmission(_addr);
     _wire->write(REG_TEMPERATURE);
     _wire->endTransmission(false);
 
     _wire->requestFrom(_addr, (uint8_t)2);
     if (_wire->available() < 2) {
-        return -999.0f;
+        lastRawCount = RAW_INVALID;
+        return false;
     }
 
     uint8_t msb = _wire->read();
     uint8_t lsb = _wire->read();
 
-    int16_t raw = (msb << 4) | (lsb >> 4);
-    if (raw & 0x800) {
-        raw |= 0xF000;
-    }
-
-    return raw * 0.0625f;
-}
-
-bool TMP112Sensor::readContact() {
-    if (_contactPin < 0) {
-        return false;
+    // Bit 0 of the LSB flags the 13-bit extended format
+    int16_t raw;
+    if (lsb & 0x01) {
+        raw = (msb << 5) | (lsb >> 3);
+        if (raw & 0x1000) {
+            raw |= 0xE000;
+        }
+    } else {
+        raw = (msb << 4) | (lsb >> 4);
+        if (raw & 0x800) {
+            raw |= 0xF000;
+        }
     }
-    return digitalRead(_contactPin) == LOW;
+    lastRawCount = raw;
+    return true;
 }
@@ -3,33 +3,83 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <SensorChannel.h>
 
-class TMP112Sensor {
+// ============================================================================
+// TMP112 temperature channel
+// ============================================================================
+// Default is one-shot mode. The part sits in shutdown (~0.5 uA) and each
+// reading is a single conversion. The pipeline starts it early in boot, so
+// the ~26 ms conversion overlaps the rest of boot. isReady() polls the OS bit.
+//
+// Continuous mode (setOneShotMode(false)) converts at the configured rate
+// until shutdown() is called before deep sleep.
+class TMP112Sensor : public SensorChannel {
 public:
-    using DataReadyCallback = void (*)(float temperatureC, bool contactClosed);
+    enum class ConversionRate : uint8_t {
+        HZ_0_25 = 0,
+        HZ_1    = 1,
+        HZ_4    = 2,    // power-on default
+        HZ_8    = 3
+    };
 
-    bool begin(TwoWire& wire = Wire, uint8_t addr = 0x48);
-    void setContactPin(uint8_t pin);
-    void loop();
-    void requestReading();
-    void onDataReady(DataReadyCallback cb);
+    static constexpr int16_t RAW_INVALID = -2048;           // 0x800, below the sensor's range
+    static constexpr uint32_t CONVERSION_TIME_MS = 26;      // datasheet typical
+    static constexpr uint32_t CONVERSION_TIMEOUT_MS = 40;   // datasheet max 35 ms
+
+    explicit TMP112Sensor(uint8_t addr = 0x48) : _addr(addr) {}
+
+    // Mode setters take effect at begin(), or immediately once running (an
+    // in-flight one-shot conversion is restarted)
+    void setOneShotMode(bool enabled);
+    void setExtendedMode(bool enabled);                     // 13-bit, up to +150 C
+    void setConversionRate(ConversionRate rate);            // continuous mode only
+    // All three at once; touches the part only if something that matters in
+    // the resulting mode changed (the rate does not in one-shot mode)
+    void configure(bool oneShot, bool extended, ConversionRate rate);
+
+    // SensorChannel
+    uint8_t type() const override { return SensorType::TMP112_TEMPERATURE; }
+    uint8_t sampleSize() const override { return 2; }
+    uint32_t conversionTimeMs() const override { return _oneShot ? CONVERSION_TIME_MS : 0; }
+    bool begin(TwoWire& wire) override;
+    bool startConversion() override;
+    bool isReady() override;
+    bool readSample(uint8_t* out) override;
+    // Put the part into shutdown before deep sleep
+    void shutdown() override;
+
+    bool isConversionPending() const { return _conversionPending; }
+    float temperatureC() const { return lastRawCount * 0.0625f; }
 
     bool sensorOperational = false;
-    bool contactClosed = false;
+    int16_t lastRawCount = RAW_INVALID;     // count of the last reading, 0.0625 C/LSB (12 or 13 bit)
 
 private:
     TwoWire* _wire = nullptr;
-    uint8_t _addr = 0x48;
-    DataReadyCallback _callback = nullptr;
-    bool _readingRequested = false;
+    uint8_t _addr;
 
-    int8_t _contactPin = -1;
+    bool _oneShot = true;
+    bool _extended = false;
+    ConversionRate _rate = ConversionRate::HZ_4;
+    bool _conversionPending = false;
+    uint32_t _conversionStartMs = 0;
 
     static constexpr uint8_t REG_TEMPERATURE = 0x00;
     static constexpr uint8_t REG_CONFIG      = 0x01;
 
-    float readTemperature();
-    bool readContact();
+    // Configuration register, byte 1
+    static constexpr uint8_t CFG1_OS = 0x80;    // write: start one-shot; read: 1 = conversion done
+    static constexpr uint8_t CFG1_SD = 0x01;    // shutdown
+    static constexpr uint8_t CFG1_DEFAULT = 0x60;
+    // Configuration register, byte 2
+    static constexpr uint8_t CFG2_AL = 0x20;
+    static constexpr uint8_t CFG2_EM = 0x10;
+
+    void applyConfig();
+    bool writeConfig(bool shutdown, bool oneShot);
+    bool readConfig(uint8_t* cfg1);
+    bool readTemperature();
 };
 
 #endif // TMP112_SENSOR_H
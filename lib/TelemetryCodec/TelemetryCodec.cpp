@@ -0,0 +1,135 @@
+#include "TelemetryCodec.h"
+
+size_t TelemetryCodec::putVarint(uint32_t v, uint8_t* out, size_t outLen) {
+    size_t n = 0;
+    do {
+        if (n >= outLen) return 0;
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        out[n++] = v ? (b | 0x80) : b;
+    } while (v);
+    return n;
+}
+
+size_t TelemetryCodec::getVarint(const uint8_t* in, size_t inLen, uint32_t* v) {
+    uint32_t result = 0;
+    for (size_t n = 0; n < inLen && n < MAX_VARINT_SIZE; n++) {
+        result |= (uint32_t)(in[n] & 0x7F) << (7 * n);
+        if ((in[n] & 0x80) == 0) {
+            *v = result;
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+int16_t TelemetryCodec::rawFromCelsius(float c) {
+    float counts = c / 0.0625f;
+    int32_t raw = (int32_t)(counts < 0 ? counts - 0.5f : counts + 0.5f);
+    if (raw < RAW_MIN) return RAW_MIN;
+    if (raw > RAW_MAX) return RAW_MAX;
+    return (int16_t)raw;
+}
+
+size_t TelemetryCodec::encode(const TelemetrySample* samples, uint8_t count,
+                              uint8_t* out, size_t outLen) {
+    if (count == 0 || outLen < HEADER_SIZE) return 0;
+
+    uint32_t interval = count > 1 ? samples[count - 2].ageS - samples[count - 1].ageS : 0;
+    bool irregular = false;
+    for (uint8_t i = 1; i < count; i++) {
+        if (samples[i - 1].ageS - samples[i].ageS != interval) {
+            irregular = true;
+            break;
+        }
+    }
+
+    out[0] = FORMAT_COMPACT;
+    out[1] = count;
+    out[2] = irregular ? FLAG_IRREGULAR : 0;
+    size_t pos = HEADER_SIZE;
+
+    size_t n = putVarint(samples[count - 1].ageS, out + pos, outLen - pos);
+    if (n == 0) return 0;
+    pos += n;
+    if (!irregular) {
+        n = putVarint(interval, out + pos, outLen - pos);
+        if (n == 0) return 0;
+        pos += n;
+    }
+
+    if (pos + FIRST_SAMPLE_SIZE > outLen) return 0;
+    uint16_t first = ((uint16_t)samples[0].raw & 0x1FFF) | (samples[0].contact ? 0x8000 : 0);
+    out[pos++] = first >> 8;
+    out[pos++] = first & 0xFF;
+
+    for (uint8_t i = 1; i < count; i++) {
+        int32_t delta = (int32_t)samples[i].raw - samples[i - 1].raw;
+        n = putVarint((zigzag(delta) << 1) | (samples[i].contact ? 1 : 0), out + pos, outLen - pos);
+        if (n == 0) return 0;
+        pos += n;
+        if (irregular) {
+            n = putVarint(samples[i - 1].ageS - samples[i].ageS, out + pos, outLen - pos);
+            if (n == 0) return 0;
+            pos += n;
+        }
+    }
+    return pos;
+}
+
+uint8_t TelemetryCodec::decode(const uint8_t* in, size_t inLen,
+                               TelemetrySample* out, uint8_t maxSamples) {
+    if (inLen < HEADER_SIZE || in[0] != FORMAT_COMPACT) return 0;
+    uint8_t count = in[1];
+    bool irregular = (in[2] & FLAG_IRREGULAR) != 0;
+    if (count == 0 || count > maxSamples) return 0;
+    size_t pos = HEADER_SIZE;
+
+    uint32_t newestAge = 0;
+    uint32_t interval = 0;
+    size_t n = getVarint(in + pos, inLen - pos, &newestAge);
+    if (n == 0) return 0;
+    pos += n;
+    if (!irregular) {
+        n = getVarint(in + pos, inLen - pos, &interval);
+        if (n == 0) return 0;
+        pos += n;
+    }
+
+    if (pos + FIRST_SAMPLE_SIZE > inLen) return 0;
+    uint16_t first = ((uint16_t)in[pos] << 8) | in[pos + 1];
+    pos += FIRST_SAMPLE_SIZE;
+    int16_t raw = (int16_t)(first & 0x1FFF);
+    if (raw & 0x1000) raw |= (int16_t)0xE000;
+    out[0].raw = raw;
+    out[0].contact = (first & 0x8000) != 0;
+
+    // Gaps are relative, so collect them first and resolve ages from the newest
+    uint32_t gapSum = 0;
+    for (uint8_t i = 1; i < count; i++) {
+        uint32_t v = 0;
+        n = getVarint(in + pos, inLen - pos, &v);
+        if (n == 0) return 0;
+        pos += n;
+        out[i].raw = (int16_t)(out[i - 1].raw + unzigzag(v >> 1));
+        out[i].contact = (v & 1) != 0;
+
+        uint32_t gap = interval;
+        if (irregular) {
+            n = getVarint(in + pos, inLen - pos, &gap);
+            if (n == 0) return 0;
+            pos += n;
+        }
+        out[i].ageS = gap;      // temporarily the gap to sample i-1
+        gapSum += gap;
+    }
+    if (pos != inLen) return 0;
+
+    uint32_t age = newestAge + gapSum;
+    out[0].ageS = age;
+    for (uint8_t i = 1; i < count; i++) {
+        age -= out[i].ageS;
+        out[i].ageS = age;
+    }
+    return count;
+}
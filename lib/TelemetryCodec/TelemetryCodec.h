@@ -0,0 +1,77 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Telemetry Codec
+// ============================================================================
+// Host-compilable (no Arduino dependency) encoder/decoder for the compact
+// telemetry payload, format 0x02. Used by the firmware, the native benchmark
+// and gateway-side decoders.
+//
+// Readings are carried as the TMP112's native count (0.0625 C/LSB, 12-bit or
+// 13-bit extended mode)
+// instead of centi-degrees, so nothing is lost to rounding and the first
+// sample plus the contact bit fit in 2 bytes. Every following sample is a
+// zig-zag varint of its delta to the previous one with the contact bit in
+// bit 0, which is 1 byte for anything under +/-2 C between readings.
+//
+// Wire payload (format COMPACT):
+//   0      format         0x02
+//   1      count          uint8_t
+//   2      flags          bit 0 = IRREGULAR (per-sample gaps follow each delta)
+//   3..    newestAge      varint, seconds before TX of the last sample
+//          interval       varint, seconds between samples (regular batches only)
+//          sample 0       uint16_t: bit 15 contact, bits 12-0 raw count
+//          sample 1..N-1  varint (zigzag(raw[i] - raw[i-1]) << 1 | contact)
+//                         [+ varint gap to the previous sample if IRREGULAR]
+struct TelemetrySample {
+    uint32_t ageS;          // seconds before TX
+    int16_t raw;            // TMP112 count, sign-extended
+    bool contact;
+};
+
+class TelemetryCodec {
+public:
+    static constexpr uint8_t FORMAT_COMPACT = 0x02;
+    static constexpr uint8_t FLAG_IRREGULAR = 0x01;
+
+    static constexpr int16_t RAW_MIN     = -4095;   // 13-bit extended mode range
+    static constexpr int16_t RAW_MAX     = 4095;
+    static constexpr int16_t RAW_INVALID = -2048;   // -128 C, reported for a failed I2C read
+
+    static constexpr size_t HEADER_SIZE      = 3;
+    static constexpr size_t MAX_VARINT_SIZE  = 5;
+    static constexpr size_t FIRST_SAMPLE_SIZE = 2;
+
+    // Worst case for n samples (irregular spacing, maximal deltas)
+    static constexpr size_t maxEncodedSize(uint8_t n) {
+        return HEADER_SIZE + 2 * MAX_VARINT_SIZE + FIRST_SAMPLE_SIZE
+             + (n > 0 ? (size_t)(n - 1) * (3 + MAX_VARINT_SIZE) : 0);
+    }
+
+    // Samples oldest first (ageS non-increasing). Returns bytes written, 0 on
+    // empty input or if out is too small.
+    static size_t encode(const TelemetrySample* samples, uint8_t count,
+                         uint8_t* out, size_t outLen);
+
+    // Returns samples decoded, 0 on a malformed payload or if out is too small.
+    static uint8_t decode(const uint8_t* in, size_t inLen,
+                          TelemetrySample* out, uint8_t maxSamples);
+
+    // Conversions
+    static int16_t rawFromCelsius(float c);
+    static float celsiusFromRaw(int16_t raw) { return raw * 0.0625f; }
+    // Same truncation as the legacy (int16_t)(tempC * 100)
+    static int16_t centiFromRaw(int16_t raw) { return (int16_t)((int32_t)raw * 25 / 4); }
+
+    // Building blocks
+    static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+    static int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+    static size_t putVarint(uint32_t v, uint8_t* out, size_t outLen);
+    static size_t getVarint(const uint8_t* in, size_t inLen, uint32_t* v);
+};
+
+#endif // TELEMETRY_CODEC_H
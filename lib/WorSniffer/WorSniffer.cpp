@@ -0,0 +1,89 @@
+#include "WorSniffer.h"
+#include <Airtime.h>
+#include <string.h>
+
+uint32_t WorSniffer::rxWindowUs(uint8_t sf, uint8_t bandwidth) {
+    return RX_WINDOW_SYMBOLS * Airtime::loraSymbolUs(sf, bandwidth);
+}
+
+uint32_t WorSniffer::periodUs(uint32_t sniffMs, uint8_t sf, uint8_t bandwidth) {
+    uint32_t rxUs = rxWindowUs(sf, bandwidth);
+    uint32_t us = sniffMs * 1000;
+    return us < 2 * rxUs ? 2 * rxUs : us;
+}
+
+// The preamble has to span a whole sleep plus a listen window, with enough
+// symbols left for the receiver to lock on
+uint16_t WorSniffer::preambleSymbols(uint32_t periodMs, uint8_t sf, uint8_t bandwidth) {
+    uint32_t symbolUs = Airtime::loraSymbolUs(sf, bandwidth);
+    uint64_t coverUs = (uint64_t)periodMs * 1000 + rxWindowUs(sf, bandwidth);
+    uint64_t symbols = (coverUs + symbolUs - 1) / symbolUs + RX_WINDOW_SYMBOLS;
+    return symbols > 0xFFFF ? 0xFFFF : (uint16_t)symbols;
+}
+
+bool WorSniffer::addressedTo(const uint8_t* frame, size_t len, const uint8_t deviceId[4]) {
+    if (frame == nullptr || len < FRAME_HEADER_SIZE + 1 || len > MAX_FRAME) return false;
+    if (frame[0] != FRAME_HEADER || ((size_t)frame[1] << 8 | frame[2]) != len - 3) return false;
+    if (memcmp(frame + 7, deviceId, 4) != 0) return false;
+    if (frame[11] != COMMAND_FRAME_TYPE || frame[17] != 1) return false;
+    uint8_t sum = 0;
+    for (size_t i = 3; i < len - 1; i++) {
+        sum += frame[i];
+    }
+    return sum == frame[len - 1];
+}
+
+void WorSniffer::begin(SniffBackend* backend, uint32_t sniffMs, uint8_t sf, uint8_t bandwidth,
+                       uint16_t preambleLength) {
+    _backend = backend;
+    _rxUs = rxWindowUs(sf, bandwidth);
+    _periodUs = periodUs(sniffMs, sf, bandwidth);
+    _preamble = preambleLength != 0 ? preambleLength
+                                    : preambleSymbols(_periodUs / 1000, sf, bandwidth);
+}
+
+// Listen window, then the rest of the period asleep
+bool WorSniffer::arm() {
+    return _backend != nullptr && _backend->sniff(_rxUs, _periodUs - _rxUs, _preamble);
+}
+
+WorWake WorSniffer::sleep(uint64_t us, const uint8_t deviceId[4],
+                          uint8_t* frame, size_t* frameLen, int16_t* rssi, int8_t* snr) {
+    _falseWakes = 0;
+    _rearmFailed = false;
+    *frameLen = 0;
+
+    uint64_t start = _backend->nowUs();
+    uint64_t end = start + us;
+    uint64_t now = start;
+    WorWake wake = WorWake::TIMER;
+    while (now < end) {
+        SniffEvent event = _backend->lightSleep(end - now);
+        now = _backend->nowUs();
+        if (event == SniffEvent::BUTTON) {
+            wake = WorWake::BUTTON;
+            break;
+        }
+        if (event == SniffEvent::CONTACT) {
+            wake = WorWake::CONTACT;
+            break;
+        }
+        if (event != SniffEvent::DIO1) continue;
+
+        size_t len = MAX_FRAME;
+        if (_backend->read(frame, &len, rssi, snr) && addressedTo(frame, len, deviceId)) {
+            *frameLen = len;
+            wake = WorWake::FRAME;
+            break;
+        }
+        if (_falseWakes < 0xFFFF) _falseWakes++;
+        if (!arm()) {
+            // Boot early as a timer wake rather than light-sleep deaf
+            _rearmFailed = true;
+            break;
+        }
+    }
+    _sleptUs = now - start;
+    _remainingUs = now < end ? end - now : 0;
+    return wake;
+}
@@ -0,0 +1,99 @@
+#ifndef WOR_SNIFFER_H
+#define WOR_SNIFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// How the last wake-on-radio sleep ended
+enum class WorWake : uint8_t {
+    NONE,           // not a wake-on-radio sleep
+    TIMER,          // telemetry interval over
+    FRAME,          // command frame for this device, kept for dispatch
+    BUTTON,         // GPIO2
+    CONTACT         // GPIO14 changed
+};
+
+// What ended one light sleep
+enum class SniffEvent : uint8_t {
+    NONE,           // timer slice, or a GPIO wake with no pin still active
+    DIO1,           // the SX1262 raised an interrupt
+    BUTTON,
+    CONTACT
+};
+
+// ============================================================================
+// Sniff Backend
+// ============================================================================
+// The firmware backend light-sleeps the ESP32-S3 with GPIO wakes and drives
+// the SX1262 through the sniff hooks (wake_on_radio.h); host tests use a
+// fake radio.
+class SniffBackend {
+public:
+    virtual ~SniffBackend() = default;
+
+    virtual uint64_t nowUs() = 0;
+    // Sleeps at most `us`
+    virtual SniffEvent lightSleep(uint64_t us) = 0;
+
+    // RX duty cycle: listen `rxUs`, sleep `sleepUs`, for `preambleLength`
+    virtual bool sniff(uint32_t rxUs, uint32_t sleepUs, uint16_t preambleLength) = 0;
+    // The packet that ended a sniff. False for a CRC or header error.
+    virtual bool read(uint8_t* buf, size_t* len, int16_t* rssi, int8_t* snr) = 0;
+};
+
+// ============================================================================
+// Wake-on-Radio Sniffer
+// ============================================================================
+// Host-compilable (no Arduino dependency). The sniff timing and the loop
+// WakeOnRadio::sleep() runs: sleep until a wake, check a received packet
+// in software, and re-arm the radio on a packet that is not a command for
+// this device.
+//
+// A sniff period listens for RX_WINDOW_SYMBOLS and is at least two listen
+// windows long (SF12 windows are ~130 ms). The gateway's preamble has to
+// cover the whole period, so one listen window always lands in it.
+class WorSniffer {
+public:
+    static constexpr uint8_t  RX_WINDOW_SYMBOLS = 4;
+    static constexpr size_t   MAX_FRAME = 255;
+    static constexpr uint8_t  FRAME_HEADER = 0x85;
+    static constexpr uint8_t  COMMAND_FRAME_TYPE = 0x08;
+    static constexpr size_t   FRAME_HEADER_SIZE = 19;
+
+    static uint32_t rxWindowUs(uint8_t sf, uint8_t bandwidth);
+    static uint32_t periodUs(uint32_t sniffMs, uint8_t sf, uint8_t bandwidth);
+    // Shortest preamble a sniff period of `periodMs` cannot miss
+    static uint16_t preambleSymbols(uint32_t periodMs, uint8_t sf, uint8_t bandwidth);
+    // Well-formed single-packet command frame for `deviceId`
+    static bool addressedTo(const uint8_t* frame, size_t len, const uint8_t deviceId[4]);
+
+    // `preambleLength` 0 = preambleSymbols() of the period
+    void begin(SniffBackend* backend, uint32_t sniffMs, uint8_t sf, uint8_t bandwidth,
+               uint16_t preambleLength = 0);
+    uint16_t preambleLength() const { return _preamble; }
+
+    bool arm();
+
+    // Sleeps up to `us`. A FRAME wake leaves the packet in `frame` (MAX_FRAME
+    // bytes). A failed re-arm ends the sleep early as a TIMER wake.
+    WorWake sleep(uint64_t us, const uint8_t deviceId[4],
+                  uint8_t* frame, size_t* frameLen, int16_t* rssi, int8_t* snr);
+
+    // Last sleep()
+    uint64_t sleptUs() const { return _sleptUs; }
+    uint64_t remainingUs() const { return _remainingUs; }
+    uint16_t falseWakes() const { return _falseWakes; }
+    bool rearmFailed() const { return _rearmFailed; }
+
+private:
+    SniffBackend* _backend = nullptr;
+    uint32_t _rxUs = 0;
+    uint32_t _periodUs = 0;
+    uint16_t _preamble = 0;
+    uint64_t _sleptUs = 0;
+    uint64_t _remainingUs = 0;
+    uint16_t _falseWakes = 0;
+    bool _rearmFailed = false;
+};
+
+#endif // WOR_SNIFFER_H
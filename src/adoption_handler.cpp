@@ -3,12 +3,13 @@
 
 void DeviceAdoptionHandler::init(ResonantEncryption* enc, ResonantFRAMStorage* store,
                                   ResonantFrame* frame, ResonantLRRadio* radio,
-                                  ResonantPowerManager* power) {
+                                  ResonantPowerManager* power, TxFrameArena* arena) {
     _enc = enc;
     _store = store;
     _frame = frame;
     _radio = radio;
     _power = power;
+    _arena = arena;
 }
 
 bool DeviceAdoptionHandler::handleAdoptionRequest(const uint8_t* data, size_t dataLength,
@@ -172,12 +173,12 @@ void DeviceAdoptionHandler::sendAdoptionAccept(uint8_t destinationID[4],
         destinationID[0], destinationID[1], destinationID[2], destinationID[3]);
     uint8_t acceptData[1] = {0xAA};
     uint8_t options = ResonantFrame::buildOptionsV1(false);
-    FrameData frame = _frame->buildAdoptionAcceptFrame(acceptData, 1, destinationID, options, txSequenceNumber);
+    _arena->setHeader(_frame->adoptionAcceptFrameType, destinationID, options);
+    _arena->buildPlain(acceptData, sizeof(acceptData), txSequenceNumber);
     txSequenceNumber++;
     _store->setTxSequenceNumber(txSequenceNumber);
     txContext = TxContext::ADOPTION_ACCEPT;
-    _radio->send(frame.frame, frame.size);
-    delete[] frame.frame;
+    _radio->send(_arena->frame(), _arena->size(), destinationID, false);
 }
 
 void DeviceAdoptionHandler::sendAdoptionAcceptCrypto(uint8_t destinationID[4],
@@ -216,22 +217,16 @@ void DeviceAdoptionHandler::sendAdoptionAcceptCrypto(uint8_t destinationID[4],
         return;
     }
 
-    uint8_t deviceCert[ResonantEncryption::MAX_CERT_SIZE];
+    // Assemble in the member buffer; the cert is read straight into place
+    uint8_t* payload = _acceptPayload;
     size_t deviceCertLen = ResonantEncryption::MAX_CERT_SIZE;
-    bool hasCert = _enc->getDeviceCert(deviceCert, &deviceCertLen);
+    bool hasCert = _enc->getDeviceCert(payload + ACCEPT_FIXED_SIZE, &deviceCertLen);
     if (!hasCert) {
         deviceCertLen = 0;
         LOG_D("No device cert available, sending without cert");
     }
 
-    size_t payloadSize = 64 + 64 + 12 + 16 + 16 + 2 + deviceCertLen;
-    uint8_t* payload = new uint8_t[payloadSize];
-    if (payload == nullptr) {
-        LOG_E("Payload allocation failed");
-        sendAdoptionAccept(destinationID, txSequenceNumber, txContext);
-        return;
-    }
-
+    size_t payloadSize = ACCEPT_FIXED_SIZE + deviceCertLen;
     size_t offset = 0;
     memcpy(payload + offset, devicePubKey, 64);       offset += 64;
     memcpy(payload + offset, signature, 64);          offset += 64;
@@ -239,10 +234,7 @@ void DeviceAdoptionHandler::sendAdoptionAcceptCrypto(uint8_t destinationID[4],
     memcpy(payload + offset, encryptedNonce, 16);     offset += 16;
     memcpy(payload + offset, tag, 16);                offset += 16;
     payload[offset] = (deviceCertLen >> 8) & 0xFF;    offset += 1;
-    payload[offset] = deviceCertLen & 0xFF;           offset += 1;
-    if (deviceCertLen > 0) {
-        memcpy(payload + offset, deviceCert, deviceCertLen);
-    }
+    payload[offset] = deviceCertLen & 0xFF;
 
     uint8_t options = ResonantFrame::buildOptionsV1(false);
 
@@ -253,8 +245,6 @@ void DeviceAdoptionHandler::sendAdoptionAcceptCrypto(uint8_t destinationID[4],
     txContext = TxContext::ADOPTION_ACCEPT;
     _radio->send(frame.frame, frame.size, destinationID, false);
     delete[] frame.frame;
-
-    delete[] payload;
     LOG_I("Crypto adoption accept sent (%zu bytes: pubkey + sig + nonce proof + cert)", payloadSize);
 }
 
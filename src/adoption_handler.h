@@ -8,6 +8,7 @@
 #include "resonant_lr_radio.h"
 #include "resonant_power_manager.h"
 #include "resonant_log.h"
+#include "tx_frame_arena.h"
 
 enum class TxContext {
     NONE,
@@ -15,6 +16,7 @@ enum class TxContext {
     METRICS,
     SETTINGS_REPORT,
     COMMAND_RESPONSE,
+    JOURNAL_PAGE,
     ACK,
     ADOPTION_ADVERTISE,
     ADOPTION_ACCEPT
@@ -24,7 +26,7 @@ class DeviceAdoptionHandler {
 public:
     void init(ResonantEncryption* enc, ResonantFRAMStorage* store,
               ResonantFrame* frame, ResonantLRRadio* radio,
-              ResonantPowerManager* power);
+              ResonantPowerManager* power, TxFrameArena* arena);
 
     bool handleAdoptionRequest(const uint8_t* data, size_t dataLength,
                                const uint8_t* sourceID,
@@ -50,6 +52,11 @@ private:
     ResonantFrame* _frame = nullptr;
     ResonantLRRadio* _radio = nullptr;
     ResonantPowerManager* _power = nullptr;
+    TxFrameArena* _arena = nullptr;
+
+    // pubkey(64) + sig(64) + iv(12) + nonce proof(16) + tag(16) + certLen(2) + cert
+    static constexpr size_t ACCEPT_FIXED_SIZE = 64 + 64 + 12 + 16 + 16 + 2;
+    uint8_t _acceptPayload[ACCEPT_FIXED_SIZE + ResonantEncryption::MAX_CERT_SIZE];
 
     void getDeviceSensorId(uint8_t* sensorId);
 };
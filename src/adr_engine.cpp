@@ -0,0 +1,132 @@
+#include "adr_engine.h"
+
+void AdrEngine::init(SensorRegionStore* store) {
+    _store = store;
+    if (!enabled()) return;
+    int8_t s = step();
+    uint8_t count = _store->get8(SensorRegion::SCRATCHPAD, BASE + 2);
+    if (count > WINDOW || s < minStep() || s > maxStep()) {
+        LOG_W("ADR: state invalid (step %d), back to preset", s);
+        setStep(0);
+        _store->put8(SensorRegion::SCRATCHPAD, BASE + 1, 0);
+        resetWindow();
+    }
+}
+
+uint8_t AdrEngine::flags() const {
+    if (_store == nullptr || !_store->isInitialized()) return 0;
+    uint8_t f = _store->get8(SensorRegion::SETTINGS, SensorSettings::ADR_FLAGS);
+    return f == 0xFF ? 0 : f;
+}
+
+bool AdrEngine::enabled() const {
+    return flags() & FLAG_ENABLED;
+}
+
+int8_t AdrEngine::step() const {
+    if (!enabled()) return 0;
+    return (int8_t)_store->get8(SensorRegion::SCRATCHPAD, BASE);
+}
+
+int8_t AdrEngine::minStep() const {
+    return (flags() & FLAG_DATA_RATE) ? -5 : 0;                 // SF12
+}
+
+int8_t AdrEngine::maxStep() const {
+    int8_t bwSteps = (flags() & FLAG_DATA_RATE) ? 2 : 0;        // BW500
+    return bwSteps + (BASE_TX_POWER - MIN_TX_POWER) / 2;
+}
+
+void AdrEngine::apply(RadioConfig& config) const {
+    int8_t s = step();
+    if (s == 0 || config.modem != MODEM_LORA_MODE) return;
+
+    if (s < 0) {
+        config.loraSpreadingFactor = 7 - s;
+        return;
+    }
+    if (flags() & FLAG_DATA_RATE) {
+        uint8_t bw = s < 2 ? s : 2;
+        config.loraBandwidth = bw;
+        s -= bw;
+    }
+    int8_t power = BASE_TX_POWER - 2 * s;
+    config.txPower = power < MIN_TX_POWER ? MIN_TX_POWER : power;
+}
+
+// SX1262 demodulation floor (dB SNR), rounded up to stay conservative
+int8_t AdrEngine::demodFloor(uint8_t sf) {
+    static const int8_t FLOOR[] = {-7, -10, -12, -15, -17, -20};
+    if (sf < 7) sf = 7;
+    if (sf > 12) sf = 12;
+    return FLOOR[sf - 7];
+}
+
+void AdrEngine::onAck(const RadioConfig& current, int8_t snr) {
+    if (!enabled()) return;
+
+    int16_t margin = (int16_t)snr - demodFloor(current.loraSpreadingFactor)
+                   - (BASE_TX_POWER - current.txPower);
+    if (margin > 127) margin = 127;
+    if (margin < -128) margin = -128;
+
+    uint8_t target = _store->get8(SensorRegion::SETTINGS, SensorSettings::ADR_MARGIN_TARGET);
+    if (target == 0 || target == 0xFF) target = DEFAULT_MARGIN_DB;
+
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 1, 0);
+    _store->put8(SensorRegion::METRICS, SensorMetrics::ADR_LAST_MARGIN, (uint8_t)(int8_t)margin);
+
+    int8_t s = step();
+    if (margin < target) {
+        if (s > minStep()) {
+            LOG_I("ADR: margin %d dB < %u, step %d -> %d", margin, target, s, s - 1);
+            setStep(s - 1);
+        }
+        resetWindow();
+        return;
+    }
+
+    uint8_t count = _store->get8(SensorRegion::SCRATCHPAD, BASE + 2);
+    uint8_t head = _store->get8(SensorRegion::SCRATCHPAD, BASE + 3) % WINDOW;
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 4 + head, (uint8_t)(int8_t)margin);
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 3, (head + 1) % WINDOW);
+    if (count < WINDOW) {
+        _store->put8(SensorRegion::SCRATCHPAD, BASE + 2, ++count);
+    }
+    if (count < WINDOW || s >= maxStep()) return;
+
+    int8_t lowest = 127;
+    for (uint8_t i = 0; i < WINDOW; i++) {
+        int8_t m = (int8_t)_store->get8(SensorRegion::SCRATCHPAD, BASE + 4 + i);
+        if (m < lowest) lowest = m;
+    }
+    if (lowest >= target + STEP_DB) {
+        LOG_I("ADR: window margin >= %d dB, step %d -> %d", lowest, s, s + 1);
+        setStep(s + 1);
+        resetWindow();
+    }
+}
+
+void AdrEngine::onAckTimeout() {
+    if (!enabled()) return;
+    uint8_t missed = _store->get8(SensorRegion::SCRATCHPAD, BASE + 1) + 1;
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 1, missed);
+
+    int8_t s = step();
+    if (missed >= ACK_LOSS_STEP_UP && s > minStep()) {
+        LOG_W("ADR: %u ACKs missed, step %d -> %d", missed, s, s - 1);
+        setStep(s - 1);
+        _store->put8(SensorRegion::SCRATCHPAD, BASE + 1, 0);
+        resetWindow();
+    }
+}
+
+void AdrEngine::setStep(int8_t step) {
+    _store->put8(SensorRegion::SCRATCHPAD, BASE, (uint8_t)step);
+    _store->put8(SensorRegion::METRICS, SensorMetrics::ADR_STEP, (uint8_t)step);
+}
+
+void AdrEngine::resetWindow() {
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 2, 0);
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 3, 0);
+}
@@ -0,0 +1,72 @@
+#ifndef ADR_ENGINE_H
+#define ADR_ENGINE_H
+
+#include <Arduino.h>
+#include "resonant_lr_radio.h"
+#include "sensor_region_store.h"
+
+// ============================================================================
+// ADR Engine (adaptive data rate + TX power)
+// ============================================================================
+// Walks a ladder of radio settings, one step per decision, using the link
+// margin measured on telemetry ACKs:
+//   step < 0   SF7+|step| at BW125, 22 dBm        (data-rate steps only)
+//   step 0     LoRa Long Range preset: SF7/BW125, 22 dBm
+//   step 1-2   BW250, then BW500 at SF7             (data-rate steps only)
+//   then       TX power down 2 dB per step, floor MIN_TX_POWER
+//
+// Margin is the ACK SNR above the demodulation floor of the current SF,
+// minus the TX power we are below the preset. The gateway's ACK comes back
+// over the same path at the preset power, so that approximates the margin
+// left on our uplink. One step down needs a full window of margins
+// >= target + STEP_DB; a margin below target or ACK_LOSS_STEP_UP missed
+// ACKs in a row steps back up. The window restarts after every step, which
+// gives the hysteresis.
+//
+// Settings (sensor tail):
+//   ADR_FLAGS          uint8_t  bit 0 = enabled, bit 1 = data-rate steps allowed
+//                                (only if the gateway listens on all of them)
+//   ADR_MARGIN_TARGET  uint8_t  dB, 0 / 0xFF = DEFAULT_MARGIN_DB
+//
+// FRAM state (scratchpad sensor tail, ADR_STATE):
+//   0      step           int8_t
+//   1      missedAcks     uint8_t
+//   2      count          uint8_t   margins in the window
+//   3      head           uint8_t
+//   4-11   margins        8 x int8_t, dB
+class AdrEngine {
+public:
+    static constexpr uint8_t WINDOW            = 8;
+    static constexpr uint8_t DEFAULT_MARGIN_DB = 10;
+    static constexpr int8_t  STEP_DB           = 3;
+    static constexpr uint8_t ACK_LOSS_STEP_UP  = 2;
+    static constexpr int8_t  BASE_TX_POWER     = 22;
+    static constexpr int8_t  MIN_TX_POWER      = 2;
+    static constexpr uint8_t FLAG_ENABLED      = 0x01;
+    static constexpr uint8_t FLAG_DATA_RATE    = 0x02;
+
+    void init(SensorRegionStore* store);
+
+    bool enabled() const;
+    int8_t step() const;
+
+    // Overlay the current step on the preset (bootRadio)
+    void apply(RadioConfig& config) const;
+
+    void onAck(const RadioConfig& current, int8_t snr);
+    void onAckTimeout();
+
+private:
+    SensorRegionStore* _store = nullptr;
+
+    static constexpr uint16_t BASE = SensorScratchpad::ADR_STATE;
+
+    uint8_t flags() const;
+    int8_t minStep() const;
+    int8_t maxStep() const;
+    void setStep(int8_t step);
+    void resetWindow();
+    static int8_t demodFloor(uint8_t sf);
+};
+
+#endif // ADR_ENGINE_H
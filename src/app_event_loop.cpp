@@ -0,0 +1,106 @@
+#include "app_event_loop.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+
+namespace {
+
+constexpr uint32_t RADIO_LOCK_WAIT_MS = 5;      // one resonantRadio.loop() pass
+
+} // namespace
+
+const char* appStateName(AppState state) {
+    switch (state) {
+        case AppState::SAMPLING:    return "SAMPLING";
+        case AppState::RADIO:       return "RADIO";
+        case AppState::REPLY_DELAY: return "REPLY_DELAY";
+        case AppState::SLEEP:       return "SLEEP";
+    }
+    return "?";
+}
+
+void AppEventLoop::begin(ResonantLRRadio* radio) {
+    _radio = radio;
+    _queue = xQueueCreateStatic(QUEUE_LENGTH, sizeof(AppEvent), _queueStorage, &_queueBuffer);
+    _radioMutex = xSemaphoreCreateMutexStatic(&_radioMutexBuffer);
+}
+
+void AppEventLoop::post(AppEvent event) {
+    if (_queue == nullptr) return;
+    xQueueSend(_queue, &event, 0);
+}
+
+AppEvent AppEventLoop::wait(uint32_t timeoutMs, bool lightSleep) {
+    AppEvent event = AppEvent::NONE;
+    if (xQueueReceive(_queue, &event, 0) == pdTRUE || timeoutMs == 0) {
+        return event;
+    }
+    // A high DIO1 is an IRQ Core 0 has not serviced yet; it would end the
+    // sleep at once
+    if (lightSleep && timeoutMs >= MIN_LIGHT_SLEEP_MS && lightSleepAvailable()
+        && digitalRead(DIO1_PIN) == LOW
+        && this->lightSleep(timeoutMs < LIGHT_SLEEP_SLICE_MS ? timeoutMs : LIGHT_SLEEP_SLICE_MS)) {
+        xQueueReceive(_queue, &event, 0);
+        return event;
+    }
+    xQueueReceive(_queue, &event, pdMS_TO_TICKS(timeoutMs));
+    return event;
+}
+
+void AppEventLoop::radioLock() {
+    if (_radioMutex != nullptr) xSemaphoreTake(_radioMutex, portMAX_DELAY);
+}
+
+void AppEventLoop::radioUnlock() {
+    if (_radioMutex != nullptr) xSemaphoreGive(_radioMutex);
+}
+
+bool AppEventLoop::lightSleepAvailable() const {
+    return _radio != nullptr && _radio->radioInitialized;
+}
+
+// False if it did not sleep: Core 0 busy in the radio loop, or a timer due
+// too soon
+bool AppEventLoop::lightSleep(uint32_t ms) {
+    if (xSemaphoreTake(_radioMutex, pdMS_TO_TICKS(RADIO_LOCK_WAIT_MS)) != pdTRUE) {
+        return false;
+    }
+    int64_t now = esp_timer_get_time();
+    int64_t sleepUs = (int64_t)ms * 1000;
+    int64_t alarm = esp_timer_get_next_alarm_for_wake_up();
+    if (alarm - now < sleepUs) {
+        sleepUs = alarm - now;
+    }
+    if (sleepUs < (int64_t)MIN_LIGHT_SLEEP_MS * 1000) {
+        xSemaphoreGive(_radioMutex);
+        return false;
+    }
+
+    gpio_intr_disable((gpio_num_t)DIO1_PIN);
+    gpio_wakeup_enable((gpio_num_t)DIO1_PIN, GPIO_INTR_HIGH_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup((uint64_t)sleepUs);
+    Serial1.flush();
+
+    esp_light_sleep_start();
+    _lightSleepUs += esp_timer_get_time() - now;
+    _lightSleepCount++;
+
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+    gpio_wakeup_disable((gpio_num_t)DIO1_PIN);
+    gpio_set_intr_type((gpio_num_t)DIO1_PIN, GPIO_INTR_POSEDGE);
+    gpio_intr_enable((gpio_num_t)DIO1_PIN);
+    // A rise just before gpio_intr_disable() was already seen by the ISR;
+    // handing it over again only makes the driver read a cleared IRQ status
+    bool missed = digitalRead(DIO1_PIN) == HIGH;
+    if (missed && _dio1Missed == nullptr) {
+        resonantRadioDio1Missed(*_radio);   // runs the radio callbacks; the lock keeps Core 0 out
+    }
+    xSemaphoreGive(_radioMutex);
+
+    if (missed && _dio1Missed != nullptr) {
+        _dio1Missed();
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef APP_EVENT_LOOP_H
+#define APP_EVENT_LOOP_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include "resonant_lr_radio.h"
+#include "sx126x_hooks.h"
+
+// What woke loop() up
+enum class AppEvent : uint8_t {
+    NONE,               // wait timed out
+    SENSOR_READY,       // onSensorDataReady()
+    TX_DONE,            // onTxComplete()
+    RX_DONE,            // onDataReceived()
+    RADIO_ERROR         // onRadioError(), including RX timeouts
+};
+
+// Core 1 application state, one per thing loop() waits on
+enum class AppState : uint8_t {
+    SAMPLING,           // sensor conversion running; telemetry goes out when it is read
+    RADIO,              // frames and listen windows, sequenced by the radio callbacks
+    REPLY_DELAY,        // gap before a queued settings or metrics report
+    SLEEP               // flush and deep sleep, does not return
+};
+
+const char* appStateName(AppState state);
+
+// ============================================================================
+// App Event Loop
+// ============================================================================
+// loop() blocks in wait() instead of polling. The radio callbacks (Core 0)
+// and the sensor callback post an event, and wait() returns at the first
+// one or when the timeout given by the current state passes.
+//
+// While it waits, Core 1 light-sleeps the whole chip (~240 uA instead of
+// ~40 mA), in slices of at most LIGHT_SLEEP_SLICE_MS. Wakes:
+//   - DIO1 (GPIO47) high: the SX1262 raised TxDone, RxDone or a timeout
+//   - the timeout, or the next esp_timer alarm (the radio driver's timers)
+// The SX1262 keeps transmitting or receiving on its own meanwhile, so the
+// ACK window and the command window cost radio RX current only.
+//
+// Light sleep needs:
+//   - the Core 0 radio task outside resonantRadio.loop(). It holds
+//     radioLock() around each pass, and wait() takes the lock to sleep.
+//   - resonantRadioDio1Missed() (sx126x_hooks.h). gpio_wakeup_enable()
+//     replaces the driver's rising-edge interrupt on DIO1 with a level
+//     wake. A rise while asleep is therefore never seen as an edge, and
+//     the hook hands it to the driver, with the lock still held.
+//
+// Stats: time light-slept and the number of slices, since begin()
+class AppEventLoop {
+public:
+    static constexpr size_t   QUEUE_LENGTH = 8;
+    static constexpr uint8_t  DIO1_PIN = 47;            // LORA_SX126X_DIO1
+    static constexpr uint32_t LIGHT_SLEEP_SLICE_MS = 100;
+    static constexpr uint32_t MIN_LIGHT_SLEEP_MS = 3;   // shorter waits block without sleeping
+
+    void begin(ResonantLRRadio* radio);
+
+    // Any task. Drops the event if the queue is full; the loop re-checks
+    // state on every wake anyway.
+    void post(AppEvent event);
+
+    // Next event, or NONE after `timeoutMs`
+    AppEvent wait(uint32_t timeoutMs, bool lightSleep);
+
+    // Core 0 radio task, around resonantRadio.loop()
+    void radioLock();
+    void radioUnlock();
+
+    // A missed DIO1 rise goes to `handler` instead of straight to the
+    // driver, for a radio task that blocks until it is told (RadioTask)
+    void onDio1Missed(void (*handler)()) { _dio1Missed = handler; }
+
+    bool lightSleepAvailable() const;
+    uint32_t lightSleepMs() const { return (uint32_t)(_lightSleepUs / 1000); }
+    uint32_t lightSleepCount() const { return _lightSleepCount; }
+
+private:
+    ResonantLRRadio* _radio = nullptr;
+    void (*_dio1Missed)() = nullptr;
+    QueueHandle_t _queue = nullptr;
+    StaticQueue_t _queueBuffer;
+    uint8_t _queueStorage[QUEUE_LENGTH * sizeof(AppEvent)];
+    SemaphoreHandle_t _radioMutex = nullptr;
+    StaticSemaphore_t _radioMutexBuffer;
+    uint64_t _lightSleepUs = 0;
+    uint32_t _lightSleepCount = 0;
+
+    bool lightSleep(uint32_t ms);
+};
+
+#endif // APP_EVENT_LOOP_H
@@ -0,0 +1,100 @@
+#include "boot_scheduler.h"
+#include "resonant_log.h"
+
+void BootScheduler::begin() {
+    _beginUs = micros();
+    _done = xEventGroupCreateStatic(&_doneBuffer);
+}
+
+void BootScheduler::add(uint8_t id, const char* name, uint8_t core, uint32_t deps, StepFn fn) {
+    if (id >= MAX_STEPS) return;
+    Step& s = _steps[id];
+    s.name = name;
+    s.fn = fn;
+    s.deps = deps;
+    s.core = core;
+    if (id >= _count) _count = id + 1;
+}
+
+void BootScheduler::skip(uint8_t id) {
+    _steps[id].skipped = true;
+}
+
+void BootScheduler::complete(uint8_t id, bool ok) {
+    _steps[id].ok = ok;
+    _steps[id].endUs = micros() - _beginUs;
+    xEventGroupSetBits(_done, bit(id));
+}
+
+void BootScheduler::runCore(uint8_t core) {
+    for (uint8_t id = 0; id < _count; id++) {
+        Step& s = _steps[id];
+        if (s.fn == nullptr || s.core != core) continue;
+
+        if (s.deps != 0 && !waitFor(s.deps, DEPENDENCY_TIMEOUT_MS)) {
+            LOG_E("Boot step %s: dependencies timed out", s.name);
+            s.startUs = micros() - _beginUs;
+            complete(id, false);
+            continue;
+        }
+
+        s.startUs = micros() - _beginUs;
+        if (s.skipped) {
+            complete(id, false);
+            continue;
+        }
+        complete(id, s.fn());
+    }
+}
+
+bool BootScheduler::waitFor(uint32_t mask, uint32_t timeoutMs) {
+    EventBits_t bits = xEventGroupWaitBits(_done, mask, pdFALSE, pdTRUE, pdMS_TO_TICKS(timeoutMs));
+    return (bits & mask) == mask;
+}
+
+uint32_t BootScheduler::criticalPath(uint32_t targets, uint32_t* readyUs) const {
+    int8_t cur = -1;
+    for (uint8_t id = 0; id < _count; id++) {
+        if ((targets & bit(id)) && (cur < 0 || _steps[id].endUs > _steps[cur].endUs)) {
+            cur = id;
+        }
+    }
+    if (readyUs != nullptr) {
+        *readyUs = cur < 0 ? 0 : _steps[cur].endUs;
+    }
+
+    uint32_t path = 0;
+    while (cur >= 0) {
+        path |= bit(cur);
+        const Step& s = _steps[cur];
+        int8_t next = -1;
+        for (int8_t id = 0; id < (int8_t)_count; id++) {
+            if (id == cur || _steps[id].fn == nullptr) continue;
+            bool dep = (s.deps & bit(id)) != 0;
+            bool coreBefore = id < cur && _steps[id].core == s.core;
+            if ((dep || coreBefore) && _steps[id].endUs <= s.startUs
+                && (next < 0 || _steps[id].endUs > _steps[next].endUs)) {
+                next = id;
+            }
+        }
+        cur = next;
+    }
+    return path;
+}
+
+void BootScheduler::logCriticalPath(uint32_t targets) const {
+    uint32_t readyUs = 0;
+    uint32_t path = criticalPath(targets, &readyUs);
+
+    char line[160];
+    size_t pos = 0;
+    for (uint8_t id = 0; id < _count && pos < sizeof(line); id++) {
+        if (!(path & bit(id))) continue;
+        const Step& s = _steps[id];
+        pos += snprintf(line + pos, sizeof(line) - pos, " %s[C%u %lu-%lu]",
+                        s.name, s.core, (unsigned long)(s.startUs / 1000), (unsigned long)(s.endUs / 1000));
+    }
+    line[pos < sizeof(line) ? pos : sizeof(line) - 1] = '\0';
+    LOG_I("Boot ready at %lu.%lu ms, critical path (ms):%s",
+          (unsigned long)(readyUs / 1000), (unsigned long)(readyUs % 1000 / 100), line);
+}
@@ -0,0 +1,72 @@
+#ifndef BOOT_SCHEDULER_H
+#define BOOT_SCHEDULER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+// ============================================================================
+// Boot Scheduler
+// ============================================================================
+// Runs setup() steps as soon as their dependencies complete, on the core
+// each step is pinned to. Each core runs its own steps in id order via
+// runCore(). Completion is signalled through an event group, so a waiting
+// core blocks instead of polling.
+//
+// A failed or skipped step still completes. Dependents check succeeded()
+// themselves, which keeps the existing bootError handling in charge.
+//
+// criticalPath() walks back from a set of target steps through whichever
+// predecessor finished last: a dependency or the previous step on the same
+// core. The result is the chain that gated the targets.
+class BootScheduler {
+public:
+    static constexpr uint8_t  MAX_STEPS = 8;
+    static constexpr uint32_t DEPENDENCY_TIMEOUT_MS = 3000;
+
+    using StepFn = bool (*)();
+
+    static constexpr uint32_t bit(uint8_t id) { return 1UL << id; }
+
+    void begin();
+    void add(uint8_t id, const char* name, uint8_t core, uint32_t deps, StepFn fn);
+
+    // Complete a step without running it
+    void skip(uint8_t id);
+
+    // Run every step pinned to this core; returns when the last one is done
+    void runCore(uint8_t core);
+
+    // Block until all steps in mask are done; false on timeout
+    bool waitFor(uint32_t mask, uint32_t timeoutMs);
+
+    bool succeeded(uint8_t id) const { return _steps[id].ok; }
+    bool skipped(uint8_t id) const { return _steps[id].skipped; }
+
+    // Returns the mask of steps on the critical path; readyUs = when the
+    // last target finished, relative to begin()
+    uint32_t criticalPath(uint32_t targets, uint32_t* readyUs) const;
+    void logCriticalPath(uint32_t targets) const;
+
+private:
+    struct Step {
+        const char* name = nullptr;
+        StepFn fn = nullptr;
+        uint32_t deps = 0;
+        uint8_t core = 0;
+        volatile bool skipped = false;
+        volatile bool ok = false;
+        uint32_t startUs = 0;
+        uint32_t endUs = 0;
+    };
+
+    Step _steps[MAX_STEPS];
+    uint8_t _count = 0;
+    uint32_t _beginUs = 0;
+    EventGroupHandle_t _done = nullptr;
+    StaticEventGroup_t _doneBuffer;
+
+    void complete(uint8_t id, bool ok);
+};
+
+#endif // BOOT_SCHEDULER_H
@@ -0,0 +1,89 @@
+#include "cpu_clock.h"
+#include <esp_timer.h>
+#include "resonant_log.h"
+
+bool EspCpuClock::begin() {
+#if CONFIG_PM_ENABLE
+    esp_pm_config_esp32s3_t config = {};
+    config.max_freq_mhz = MAX_MHZ;
+    config.min_freq_mhz = MIN_MHZ;
+    config.light_sleep_enable = false;
+    if (esp_pm_configure(&config) != ESP_OK
+        || esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "gov_full", &_cpuMax) != ESP_OK
+        || esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "gov_io", &_apbMax) != ESP_OK) {
+        LOG_W("CPU governor: esp_pm unavailable, clock left at %u MHz", getCpuFrequencyMhz());
+        return false;
+    }
+#else
+    _switchMutex = xSemaphoreCreateMutexStatic(&_switchMutexBuffer);
+    applyHighest();
+#endif
+    _ready = true;
+    return true;
+}
+
+uint64_t EspCpuClock::nowUs() {
+    return (uint64_t)esp_timer_get_time();
+}
+
+#if CONFIG_PM_ENABLE
+
+void EspCpuClock::acquire(CpuLevel level) {
+    if (!_ready) return;
+    if (level == CpuLevel::FULL) {
+        esp_pm_lock_acquire(_cpuMax);
+    } else if (level == CpuLevel::IO) {
+        esp_pm_lock_acquire(_apbMax);
+    }
+}
+
+void EspCpuClock::release(CpuLevel level) {
+    if (!_ready) return;
+    if (level == CpuLevel::FULL) {
+        esp_pm_lock_release(_cpuMax);
+    } else if (level == CpuLevel::IO) {
+        esp_pm_lock_release(_apbMax);
+    }
+}
+
+#else
+
+void EspCpuClock::acquire(CpuLevel level) {
+    if (!_ready) return;
+    xSemaphoreTake(_switchMutex, portMAX_DELAY);
+    _held[(uint8_t)level]++;
+    applyHighest();
+    xSemaphoreGive(_switchMutex);
+}
+
+void EspCpuClock::release(CpuLevel level) {
+    if (!_ready) return;
+    xSemaphoreTake(_switchMutex, portMAX_DELAY);
+    if (_held[(uint8_t)level] > 0) {
+        _held[(uint8_t)level]--;
+    }
+    applyHighest();
+    xSemaphoreGive(_switchMutex);
+}
+
+// Caller holds _switchMutex (or is begin())
+void EspCpuClock::applyHighest() {
+    uint8_t level = 0;
+    for (uint8_t l = 1; l < CpuGovernor::LEVEL_COUNT; l++) {
+        if (_held[l] > 0) level = l;
+    }
+    uint16_t mhz = CpuGovernor::LEVEL_MHZ[level];
+    if (getCpuFrequencyMhz() != mhz) {
+        setCpuFrequencyMhz(mhz);
+    }
+}
+
+#endif
+
+void EspCpuClock::lock() {
+    portENTER_CRITICAL(&_mux);
+}
+
+void EspCpuClock::unlock() {
+    portEXIT_CRITICAL(&_mux);
+}
@@ -0,0 +1,59 @@
+#ifndef CPU_CLOCK_H
+#define CPU_CLOCK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "CpuGovernor.h"
+
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+
+// ============================================================================
+// ESP32-S3 Clock Backend
+// ============================================================================
+// CpuGovernor levels as ESP-IDF PM locks:
+//   FULL  ESP_PM_CPU_FREQ_MAX   240 MHz
+//   IO    ESP_PM_APB_FREQ_MAX   80 MHz, APB at 80 MHz
+//   IDLE  no lock               40 MHz (XTAL), APB at 40 MHz
+// esp_pm arbitrates between cores, so a CRYPTO phase on Core 0 keeps the
+// clock up for Core 1 too. Automatic light sleep stays off; AppEventLoop
+// light-sleeps explicitly.
+//
+// Arduino's UART, SPI and I2C drivers re-derive their dividers on an APB
+// change, so Serial1 and the SX1262/FRAM buses keep working at IDLE.
+//
+// Builds without CONFIG_PM_ENABLE fall back to setCpuFrequencyMhz() with
+// the same refcounting, under a mutex.
+class EspCpuClock : public CpuClockBackend {
+public:
+    static constexpr uint16_t MAX_MHZ = 240;
+    static constexpr uint16_t MIN_MHZ = 40;
+    static constexpr float    SUPPLY_V = 3.3f;      // regulator output, as the power manager's estimate
+
+    // Before the governor's begin(). False if esp_pm rejected the config;
+    // the clock then stays where it is and only the accounting runs.
+    bool begin();
+
+    uint64_t nowUs() override;
+    void acquire(CpuLevel level) override;
+    void release(CpuLevel level) override;
+    void lock() override;
+    void unlock() override;
+
+private:
+    bool _ready = false;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_handle_t _cpuMax = nullptr;
+    esp_pm_lock_handle_t _apbMax = nullptr;
+#else
+    SemaphoreHandle_t _switchMutex = nullptr;
+    StaticSemaphore_t _switchMutexBuffer;
+    uint8_t _held[CpuGovernor::LEVEL_COUNT] = {};
+    void applyHighest();
+#endif
+};
+
+#endif // CPU_CLOCK_H
@@ -0,0 +1,105 @@
+#ifndef DIRTY_RANGES_H
+#define DIRTY_RANGES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Dirty Ranges
+// ============================================================================
+// Sorted set of modified byte ranges within one FRAM region, coalesced into
+// as few SPI WRITE bursts as possible. Ranges closer than MERGE_GAP are
+// joined: re-sending a few clean bytes is cheaper than another WREN + WRITE +
+// address header. When full, the two closest ranges are merged.
+//
+// Header-only and Arduino-free so the native simulation can use it.
+class DirtyRanges {
+public:
+    static constexpr uint8_t  MAX_RANGES = 8;
+    static constexpr uint16_t MERGE_GAP  = 4;      // WREN + WRITE + 16-bit address
+
+    struct Range {
+        uint16_t start;
+        uint16_t end;       // exclusive
+    };
+
+    void clear() { _count = 0; }
+    bool empty() const { return _count == 0; }
+    uint8_t count() const { return _count; }
+    const Range& operator[](uint8_t i) const { return _ranges[i]; }
+
+    size_t bytes() const {
+        size_t total = 0;
+        for (uint8_t i = 0; i < _count; i++) {
+            total += _ranges[i].end - _ranges[i].start;
+        }
+        return total;
+    }
+
+    void add(uint16_t start, size_t len) {
+        if (len == 0) return;
+        uint16_t end = (uint16_t)(start + len);
+
+        // Absorb every range within MERGE_GAP of [start, end)
+        uint8_t i = 0;
+        while (i < _count && _ranges[i].end + MERGE_GAP < start) {
+            i++;
+        }
+        uint8_t j = i;
+        while (j < _count && _ranges[j].start <= end + MERGE_GAP) {
+            if (_ranges[j].start < start) start = _ranges[j].start;
+            if (_ranges[j].end > end) end = _ranges[j].end;
+            j++;
+        }
+
+        if (j > i) {
+            _ranges[i] = {start, end};
+            remove(i + 1, j - i - 1);
+            return;
+        }
+
+        if (_count == MAX_RANGES) {
+            mergeClosest();
+            add(start, end - start);
+            return;
+        }
+        for (uint8_t k = _count; k > i; k--) {
+            _ranges[k] = _ranges[k - 1];
+        }
+        _ranges[i] = {start, end};
+        _count++;
+    }
+
+    void add(const DirtyRanges& other) {
+        for (uint8_t i = 0; i < other._count; i++) {
+            add(other._ranges[i].start, other._ranges[i].end - other._ranges[i].start);
+        }
+    }
+
+private:
+    Range _ranges[MAX_RANGES];
+    uint8_t _count = 0;
+
+    void remove(uint8_t at, uint8_t n) {
+        for (uint8_t k = at; k + n < _count; k++) {
+            _ranges[k] = _ranges[k + n];
+        }
+        _count -= n;
+    }
+
+    void mergeClosest() {
+        uint8_t best = 0;
+        uint16_t bestGap = UINT16_MAX;
+        for (uint8_t k = 0; k + 1 < _count; k++) {
+            uint16_t gap = _ranges[k + 1].start - _ranges[k].end;
+            if (gap < bestGap) {
+                bestGap = gap;
+                best = k;
+            }
+        }
+        _ranges[best].end = _ranges[best + 1].end;
+        remove(best + 1, 1);
+    }
+};
+
+#endif // DIRTY_RANGES_H
@@ -0,0 +1,36 @@
+#include "downlink_gate.h"
+
+void DownlinkGate::init(SensorRegionStore* store) {
+    _store = store;
+}
+
+bool DownlinkGate::enabled() const {
+    if (_store == nullptr || !_store->isInitialized()) return false;
+    uint8_t flags = _store->get8(SensorRegion::SETTINGS, SensorSettings::DOWNLINK_GATE);
+    return flags != 0xFF && (flags & FLAG_ENABLED);
+}
+
+bool DownlinkGate::parse(const uint8_t* payload, size_t len, DownlinkHint& hint) {
+    if (payload == nullptr || len < HINT_SIZE) return false;
+    hint.pending = payload[0] & HINT_PENDING;
+    hint.delayMs = payload[1] * DELAY_UNIT_MS;
+    return true;
+}
+
+uint32_t DownlinkGate::windowMs(const DownlinkHint& hint, uint32_t remainingMs) {
+    if (!hint.pending) return 0;
+    uint32_t window = hint.delayMs + WINDOW_MARGIN_MS;
+    return window < remainingMs ? window : remainingMs;
+}
+
+void DownlinkGate::onGated(uint32_t remainingMs, uint32_t windowMs) {
+    if (_store == nullptr || !_store->isInitialized() || windowMs >= remainingMs) return;
+    uint32_t saved = _store->get32(SensorRegion::METRICS, SensorMetrics::RX_SAVED_TIME);
+    _store->put32(SensorRegion::METRICS, SensorMetrics::RX_SAVED_TIME, saved + (remainingMs - windowMs));
+    if (windowMs == 0) {
+        uint16_t n = _store->get16(SensorRegion::METRICS, SensorMetrics::WINDOWS_SKIPPED);
+        if (n < 0xFFFF) {
+            _store->put16(SensorRegion::METRICS, SensorMetrics::WINDOWS_SKIPPED, n + 1);
+        }
+    }
+}
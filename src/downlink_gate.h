@@ -0,0 +1,61 @@
+#ifndef DOWNLINK_GATE_H
+#define DOWNLINK_GATE_H
+
+#include <Arduino.h>
+#include "sensor_region_store.h"
+
+// Downlink hint carried in an ACK payload
+struct DownlinkHint {
+    bool pending = false;       // the gateway has a command queued for this device
+    uint32_t delayMs = 0;       // until the gateway expects to send it
+};
+
+// ============================================================================
+// Downlink Gate
+// ============================================================================
+// The command window after a metrics frame (waitAfterTx, 8 s by default) is
+// the longest radio-on time of a metrics wake, and usually nothing arrives.
+// With the gate on, metrics frames request an ACK and the gateway says in it
+// whether a command is queued:
+//   - nothing queued: the window closes at the ACK
+//   - command queued: the window is cut to the expected delay + WINDOW_MARGIN_MS
+//   - ACK without a hint, or no ACK: the full window, as before
+// A telemetry ACK with the pending bit opens a command window on wakes that
+// send no metrics.
+//
+// ACK payload (decrypted, optional):
+//   0      flags    uint8_t  bit 0 = downlink pending
+//   1      delay    uint8_t  expected delay, 100 ms units (0 = at once)
+//
+// Settings (sensor tail):
+//   DOWNLINK_GATE   uint8_t  bit 0 = on, 0xFF = off
+//
+// Metrics (sensor tail):
+//   RX_SAVED_TIME   uint32_t ms of command window not listened
+//   WINDOWS_SKIPPED uint16_t windows closed at the ACK (saturating)
+class DownlinkGate {
+public:
+    static constexpr uint8_t FLAG_ENABLED = 0x01;
+    static constexpr uint8_t HINT_PENDING = 0x01;
+    static constexpr size_t HINT_SIZE = 2;
+    static constexpr uint32_t DELAY_UNIT_MS = 100;
+    static constexpr uint32_t WINDOW_MARGIN_MS = 1000;
+
+    void init(SensorRegionStore* store);
+
+    bool enabled() const;
+
+    // False if the payload carries no hint
+    static bool parse(const uint8_t* payload, size_t len, DownlinkHint& hint);
+
+    // Window to listen for, out of the `remainingMs` left of the full one
+    static uint32_t windowMs(const DownlinkHint& hint, uint32_t remainingMs);
+
+    // The ACK cut a window of `remainingMs` to `windowMs` (metrics)
+    void onGated(uint32_t remainingMs, uint32_t windowMs);
+
+private:
+    SensorRegionStore* _store = nullptr;
+};
+
+#endif // DOWNLINK_GATE_H
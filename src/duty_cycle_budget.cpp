@@ -0,0 +1,82 @@
+#include "duty_cycle_budget.h"
+#include <Airtime.h>
+
+uint32_t DutyCycleBudget::frameUs(const RadioConfig& config, size_t frameBytes, uint8_t packetCount) {
+    return Airtime::splitUs(frameBytes, packetCount, [&config](size_t len) {
+        if (config.modem == MODEM_FSK_MODE) {
+            return Airtime::fskPacketUs(config.fskDatarate, len, config.crcOn);
+        }
+        return Airtime::loraPacketUs(config.loraSpreadingFactor, config.loraBandwidth,
+                                     config.loraCodingRate, config.loraPreambleLength,
+                                     len, config.crcOn);
+    });
+}
+
+void DutyCycleBudget::init(SensorRegionStore* store) {
+    _store = store;
+}
+
+uint8_t DutyCycleBudget::permille() const {
+    if (_store == nullptr || !_store->isInitialized()) return 0;
+    uint8_t p = _store->get8(SensorRegion::SETTINGS, SensorSettings::DUTY_CYCLE);
+    return p == 0xFF ? 0 : p;
+}
+
+// permille of BUCKETS * BUCKET_S seconds, in ms
+uint32_t DutyCycleBudget::limitMs() const {
+    return (uint32_t)permille() * BUCKETS * BUCKET_S;
+}
+
+uint32_t DutyCycleBudget::usedMs() const {
+    uint32_t used = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+        used += _store->get32(SensorRegion::SCRATCHPAD, bucket(i));
+    }
+    return used;
+}
+
+bool DutyCycleBudget::allows(uint32_t airtimeUs) const {
+    if (!enabled()) return true;
+    uint32_t airtimeMs = (airtimeUs + 999) / 1000;
+    return usedMs() + airtimeMs <= limitMs();
+}
+
+void DutyCycleBudget::onWake(uint32_t sleptSeconds) {
+    if (!enabled()) return;
+    uint32_t elapsed = _store->get16(SensorRegion::SCRATCHPAD, BASE) + sleptSeconds;
+    uint8_t head = _store->get8(SensorRegion::SCRATCHPAD, BASE + 2) % BUCKETS;
+
+    uint32_t rotations = elapsed / BUCKET_S;
+    if (rotations > BUCKETS) rotations = BUCKETS;
+    for (uint32_t i = 0; i < rotations; i++) {
+        head = (head + 1) % BUCKETS;
+        _store->put32(SensorRegion::SCRATCHPAD, bucket(head), 0);
+    }
+    _store->put16(SensorRegion::SCRATCHPAD, BASE, elapsed % BUCKET_S);
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 2, head);
+}
+
+void DutyCycleBudget::onTransmitted(uint32_t airtimeUs) {
+    if (_store == nullptr || !_store->isInitialized()) return;
+    uint32_t airtimeMs = (airtimeUs + 999) / 1000;
+    uint16_t frameMs = airtimeMs > 0xFFFF ? 0xFFFF : airtimeMs;
+
+    _store->put16(SensorRegion::METRICS, SensorMetrics::AIRTIME_LAST_FRAME, frameMs);
+    if (frameMs > _store->get16(SensorRegion::METRICS, SensorMetrics::AIRTIME_MAX_FRAME)) {
+        _store->put16(SensorRegion::METRICS, SensorMetrics::AIRTIME_MAX_FRAME, frameMs);
+    }
+    uint32_t total = _store->get32(SensorRegion::METRICS, SensorMetrics::AIRTIME_TOTAL);
+    _store->put32(SensorRegion::METRICS, SensorMetrics::AIRTIME_TOTAL, total + airtimeMs);
+
+    if (!enabled()) return;
+    uint8_t head = _store->get8(SensorRegion::SCRATCHPAD, BASE + 2) % BUCKETS;
+    uint32_t used = _store->get32(SensorRegion::SCRATCHPAD, bucket(head));
+    _store->put32(SensorRegion::SCRATCHPAD, bucket(head), used + airtimeMs);
+}
+
+void DutyCycleBudget::onDeferred() {
+    uint16_t n = _store->get16(SensorRegion::METRICS, SensorMetrics::DUTY_DEFERRED);
+    if (n < 0xFFFF) {
+        _store->put16(SensorRegion::METRICS, SensorMetrics::DUTY_DEFERRED, n + 1);
+    }
+}
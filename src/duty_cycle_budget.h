@@ -0,0 +1,67 @@
+#ifndef DUTY_CYCLE_BUDGET_H
+#define DUTY_CYCLE_BUDGET_H
+
+#include <Arduino.h>
+#include "resonant_lr_radio.h"
+#include "sensor_region_store.h"
+
+// ============================================================================
+// Duty-Cycle Budget
+// ============================================================================
+// Rolling one-hour record of transmit airtime, kept as BUCKETS buckets of
+// BUCKET_S seconds. The clock advances by the sleep that just ended
+// (telemetryInterval approximation, like the other wake counters); awake
+// time is not counted.
+//
+// With a limit set, frames that can wait are held back while the window
+// has no room for them:
+//   - timer telemetry wakes run sample-only (queued in the batch, or resent
+//     on a later wake when the report filter still sees the change)
+//   - the metrics frame stays due until a later wake
+// Button, contact and power-on wakes, adoption traffic, command responses
+// and settings reports always go out.
+//
+// Every transmitted frame is charged and its airtime exported in metrics,
+// limit or not.
+//
+// Settings (sensor tail):
+//   DUTY_CYCLE  uint8_t  permille of the hour (10 = 1 %), 0 / 0xFF = no limit
+//
+// FRAM state (scratchpad sensor tail, DUTY_STATE):
+//   0-1    bucketElapsed  uint16_t  seconds into the current bucket
+//   2      head           uint8_t   current bucket
+//   3-26   bucketMs       6 x uint32_t  airtime per bucket, ms
+class DutyCycleBudget {
+public:
+    static constexpr uint8_t  BUCKETS  = 6;
+    static constexpr uint16_t BUCKET_S = 600;
+
+    // Time on air of a frame sent with `config` (Airtime model)
+    static uint32_t frameUs(const RadioConfig& config, size_t frameBytes, uint8_t packetCount = 1);
+
+    void init(SensorRegionStore* store);
+
+    bool enabled() const { return permille() != 0; }
+    uint32_t limitMs() const;
+    uint32_t usedMs() const;
+
+    // Would a frame of this airtime still fit in the window?
+    bool allows(uint32_t airtimeUs) const;
+
+    // Advance the window by the sleep that just ended
+    void onWake(uint32_t sleptSeconds);
+    // A frame left the antenna (onTxComplete)
+    void onTransmitted(uint32_t airtimeUs);
+    // A frame was held back (metrics)
+    void onDeferred();
+
+private:
+    SensorRegionStore* _store = nullptr;
+
+    static constexpr uint16_t BASE = SensorScratchpad::DUTY_STATE;
+
+    uint8_t permille() const;
+    uint16_t bucket(uint8_t i) const { return BASE + 3 + 4 * i; }
+};
+
+#endif // DUTY_CYCLE_BUDGET_H
@@ -0,0 +1,18 @@
+#include "fram_journal.h"
+
+void FramJournalStorage::init(MB85RS64V* fram, SensorRegionStore* store) {
+    _fram = fram;
+    _store = store;
+}
+
+void FramJournalStorage::read(uint16_t addr, uint8_t* buf, size_t len) {
+    _fram->read(addr, buf, len);
+    _store->stats().bytesRead += len;
+}
+
+void FramJournalStorage::write(uint16_t addr, const uint8_t* data, size_t len) {
+    _fram->write(addr, data, len);
+    FramStats& s = _store->stats();
+    s.writeBursts++;
+    s.bytesWritten += len;
+}
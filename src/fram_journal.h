@@ -0,0 +1,33 @@
+#ifndef FRAM_JOURNAL_H
+#define FRAM_JOURNAL_H
+
+#include <Arduino.h>
+#include <EventJournal.h>
+#include "MB85RS64V.h"
+#include "sensor_region_store.h"
+
+static_assert(EventJournal::regionSize(FreeRegion::EVENT_JOURNAL_CAPACITY) == FreeRegion::EVENT_JOURNAL_SIZE,
+              "event journal layout");
+static_assert(FreeRegion::EVENT_JOURNAL >= FreeRegion::METRICS_BASELINE + FreeRegion::METRICS_BASELINE_SIZE
+              && FreeRegion::EVENT_JOURNAL + FreeRegion::EVENT_JOURNAL_SIZE - 1 <= FreeRegion::END,
+              "event journal outside the free region");
+
+// ============================================================================
+// FRAM Journal Storage
+// ============================================================================
+// The event journal's backend: direct SPI reads and writes of the free
+// region (the journal is not mirrored in RAM), counted in the wake's
+// FramStats with the sensor tails' traffic.
+class FramJournalStorage : public JournalStorage {
+public:
+    void init(MB85RS64V* fram, SensorRegionStore* store);
+
+    void read(uint16_t addr, uint8_t* buf, size_t len) override;
+    void write(uint16_t addr, const uint8_t* data, size_t len) override;
+
+private:
+    MB85RS64V* _fram = nullptr;
+    SensorRegionStore* _store = nullptr;
+};
+
+#endif // FRAM_JOURNAL_H
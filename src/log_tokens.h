@@ -0,0 +1,190 @@
+// Generated by tools/log_tokens.py from the LOG_* calls in src/. Do not edit;
+// it is regenerated before every firmware build.
+#ifndef LOG_TOKENS_H
+#define LOG_TOKENS_H
+
+#include <stdint.h>
+
+namespace ResonantLog {
+
+struct TokenEntry {
+    uint32_t hash;          // FNV-1a of the format string
+    char level;             // E, W, I or D
+    const char* fmt;
+};
+
+constexpr uint16_t TABLE_HASH = 0x0288;
+constexpr uint16_t TOKEN_COUNT = 166;
+
+inline constexpr TokenEntry TOKENS[] = {
+    {0x5CF4616Eu, 'E', "Adoption rejected: mutual attestation failed"},    // 0
+    {0x04F44694u, 'E', "Boot error: 0x%04X"},    // 1
+    {0xEB020177u, 'E', "Boot step %s: dependencies timed out"},    // 2
+    {0x90D235BAu, 'E', "Command frame has no data"},    // 3
+    {0x2CDF2EC7u, 'E', "Decrypted command has no data"},    // 4
+    {0x82A23A27u, 'E', "FRAM MB85RS64V not detected"},    // 5
+    {0x232D40A3u, 'E', "FRAM storage initialization failed"},    // 6
+    {0xBFDA795Eu, 'E', "Frame too large for arena: %zu bytes"},    // 7
+    {0x6764A881u, 'E', "Radio Error: [%d] %s"},    // 8
+    {0x05700990u, 'E', "Radio initialization failed on Core 0!"},    // 9
+    {0x20B5DDC9u, 'E', "Radio initialization failed on Core 0, going to sleep"},    // 10
+    {0xDDDB8B1Cu, 'E', "Sensor region read out of range: %u+%zu"},    // 11
+    {0xA005828Fu, 'E', "Sensor region write out of range: %u+%zu"},    // 12
+    {0x1517796Eu, 'W', "ACK payload failed to decrypt, downlink hint ignored"},    // 13
+    {0x81A2974Cu, 'W', "ADR: %u ACKs missed, step %d -> %d"},    // 14
+    {0xF99B1A8Bu, 'W', "ADR: state invalid (step %d), back to preset"},    // 15
+    {0x8F5F0881u, 'W', "Arena GCM encrypt failed"},    // 16
+    {0xC778A0CFu, 'W', "Brownout detected! Previous TX never completed. Recovery cycle %u"},    // 17
+    {0x81D5E038u, 'W', "CPU governor: esp_pm unavailable, clock left at %u MHz"},    // 18
+    {0x9E4F337Au, 'W', "Configure settings: expected 207 bytes, got %zu"},    // 19
+    {0x3485D063u, 'W', "Connection lost — clearing parent, will re-adopt next wake"},    // 20
+    {0x978A1C88u, 'W', "Decryption failed, treating as plaintext"},    // 21
+    {0x5A6C3B8Fu, 'W', "Duty cycle: %lu of %lu ms used this hour, metrics deferred"},    // 22
+    {0xDD047AC9u, 'W', "Duty cycle: %lu of %lu ms used this hour, telemetry deferred"},    // 23
+    {0x6F49155Bu, 'W', "ECDH key agreement failed"},    // 24
+    {0x825F8FA3u, 'W', "Encryption unavailable, sending plaintext"},    // 25
+    {0x45D65F29u, 'W', "Event journal: no valid header, starting empty"},    // 26
+    {0x56013AABu, 'W', "Extended sleep: %lu seconds for battery recovery"},    // 27
+    {0x235A35D3u, 'W', "FRAM self-test FAILED"},    // 28
+    {0x2808D8D6u, 'W', "Failed to extract public key from gateway cert"},    // 29
+    {0xEE5D055Bu, 'W', "Gateway ECDSA signature verification failed"},    // 30
+    {0x3F78086Fu, 'W', "Gateway certificate chain verification failed"},    // 31
+    {0x0C76B297u, 'W', "Journal page %u not sent (%s)"},    // 32
+    {0x56B369F5u, 'W', "Multi-packet reception failed"},    // 33
+    {0xF5429DD9u, 'W', "Patch settings: invalid patch (%zu bytes)"},    // 34
+    {0xE01A231Du, 'W', "Read journal: invalid request (page %u of %u, %u pages)"},    // 35
+    {0x90A2491Eu, 'W', "Reading buffer corrupt (count=%u), clearing"},    // 36
+    {0xE24E1969u, 'W', "Reading buffer full, oldest reading dropped"},    // 37
+    {0x82D54F6Eu, 'W', "Session key derivation failed"},    // 38
+    {0xDD96090Fu, 'W', "Skipping signature verification (cert not verified)"},    // 39
+    {0x0DB04835u, 'W', "Unknown command: 0x%02X"},    // 40
+    {0x311C2BF4u, 'W', "Wake-on-radio: no frame kept, back to sleep"},    // 41
+    {0xBD197214u, 'W', "Wake-on-radio: re-arm failed"},    // 42
+    {0x3047A1AAu, 'W', "Wake-on-radio: sniff not armed, radio to sleep"},    // 43
+    {0x33AD6DAAu, 'W', "encryptGCM nonce proof failed, falling back to plain accept"},    // 44
+    {0x539364DFu, 'W', "getPublicKey failed, falling back to plain accept"},    // 45
+    {0x0B5724A4u, 'W', "signData failed, falling back to plain accept"},    // 46
+    {0xFBF33F8Du, 'I', "*** Woken by a command (wake-on-radio) ***"},    // 47
+    {0xCFA52DDEu, 'I', "*** Woken by contact sensor (ext1/GPIO14) ***"},    // 48
+    {0xE297006Fu, 'I', "*** Woken by user button (ext0/GPIO2) ***"},    // 49
+    {0x7FB471FDu, 'I', "========================================"},    // 50
+    {0x7AE73B9Au, 'I', "=====================\n"},    // 51
+    {0x703BBEAFu, 'I', "==================\n"},    // 52
+    {0x41CFC99Cu, 'I', "ACK received!"},    // 53
+    {0x2834B6DEu, 'I', "ADR: margin %d dB < %u, step %d -> %d"},    // 54
+    {0x4E7FBEE9u, 'I', "ADR: window margin >= %d dB, step %d -> %d"},    // 55
+    {0xCFD16CA4u, 'I', "Adoption accept sent, sending initial metrics..."},    // 56
+    {0xE99A8049u, 'I', "Adoption advertise sent, listening for adoption request..."},    // 57
+    {0x11017822u, 'I', "Adoption request received!"},    // 58
+    {0xE7E07719u, 'I', "Airtime: %lu.%03lu ms"},    // 59
+    {0xD3C8CB78u, 'I', "Battery swap detected: %u → %u cV"},    // 60
+    {0x842FAE6Au, 'I', "Boot ready at %lu.%lu ms, critical path (ms):%s"},    // 61
+    {0x08446B76u, 'I', "Bytes sent: %zu"},    // 62
+    {0xAE724A0Eu, 'I', "CPU %u MHz: %lu ms"},    // 63
+    {0x6547FE82u, 'I', "CPU governor: %lu switches, %.1f uWh saved against full clock"},    // 64
+    {0x9FCB61B2u, 'I', "Command frame received"},    // 65
+    {0xEDBFD65Au, 'I', "Command response sent: cmd=0x%02X, result=0x%02X"},    // 66
+    {0xA5739C2Bu, 'I', "Command: Energy/timing counters reset"},    // 67
+    {0xCEB7DCA2u, 'I', "Command: Factory reset executed"},    // 68
+    {0xD3E3BAD7u, 'I', "Command: Read journal, pages %u-%u of %u"},    // 69
+    {0x12B12624u, 'I', "Command: Request metrics (full report)"},    // 70
+    {0x7E1623E6u, 'I', "Command: Request settings"},    // 71
+    {0xA17E51B6u, 'I', "Command: Settings patched (touched 0x%02X%s)"},    // 72
+    {0xD7E5E300u, 'I', "Command: Sleep now — skipping response to save power"},    // 73
+    {0x691572E7u, 'I', "Crypto adoption accept sent (%zu bytes: pubkey + sig + nonce proof + cert)"},    // 74
+    {0xE5B62D4Eu, 'I', "Data Length: %zu bytes"},    // 75
+    {0x5B299570u, 'I', "Deferred radio config applied"},    // 76
+    {0xC206E716u, 'I', "Deferred wake: %.2f C, contact %s not sent (radio off)"},    // 77
+    {0xBA31AEADu, 'I', "Downlink %s: command window %lu of %lu ms"},    // 78
+    {0xB82DDB14u, 'I', "Downlink pending, listening %lu ms for commands"},    // 79
+    {0x3FCC4959u, 'I', "Encrypted %s metrics frame sent (%zu bytes)"},    // 80
+    {0x144ADB10u, 'I', "Encrypted settings report sent (%zu bytes)"},    // 81
+    {0x5B6DA450u, 'I', "FRAM MB85RS64V detected"},    // 82
+    {0x275B1C27u, 'I', "FRAM Storage v1"},    // 83
+    {0xF777F59Cu, 'I', "FRAM last cycle: %u bursts, %u bytes, %u library flushes"},    // 84
+    {0x2DE04A72u, 'I', "FRAM self-test PASSED"},    // 85
+    {0x5C8DDFADu, 'I', "Flushing %u queued readings (format 0x%02X, %zu bytes)"},    // 86
+    {0x5BC69302u, 'I', "Frame Type: 0x%02X, Options: 0x%02X"},    // 87
+    {0x5482FC0Au, 'I', "Frequency: %.1f MHz"},    // 88
+    {0x6B0D52F5u, 'I', "Gateway ECDSA signature verified"},    // 89
+    {0x305B41B2u, 'I', "Gateway ID: %02X:%02X:%02X:%02X"},    // 90
+    {0x78637269u, 'I', "Gateway certificate chain verified"},    // 91
+    {0x811E449Du, 'I', "Including device cert (%zu bytes) in discovery"},    // 92
+    {0xA1581487u, 'I', "Journal page %u sent (%u records, %zu bytes)"},    // 93
+    {0x56DFBB2Fu, 'I', "Journal: cycle %u, wake %u, tx %u, flags 0x%02X (%u records)"},    // 94
+    {0xB333AF88u, 'I', "Light sleep: %lu ms in %lu slices"},    // 95
+    {0xDF220C4Au, 'I', "Metrics ACK received"},    // 96
+    {0xFAC9C5B1u, 'I', "Metrics TX complete, listening for commands..."},    // 97
+    {0xAB2F8E06u, 'I', "Metrics baseline now seq %lu"},    // 98
+    {0x99E9B593u, 'I', "Metrics delta against seq %lu: %zu bytes"},    // 99
+    {0x74156A53u, 'I', "Metrics delta not possible, sending full report"},    // 100
+    {0x1EFB328Au, 'I', "Mock session key cleared (adoption reset)"},    // 101
+    {0xF85EE81Eu, 'I', "Mode: FSK %d bps"},    // 102
+    {0x6B90BED6u, 'I', "Mode: LoRa SF%d BW%d"},    // 103
+    {0xAE3E8F44u, 'I', "Multi-packet data received (fully reassembled)"},    // 104
+    {0x518DF82Du, 'I', "Packets: %d"},    // 105
+    {0x66F29802u, 'I', "Parent ID stored (non-crypto adoption), sequence number reset"},    // 106
+    {0xE742273Au, 'I', "Parent ID stored, sequence number reset"},    // 107
+    {0x3EF3554Eu, 'I', "Processing command: 0x%02X"},    // 108
+    {0x8D814AFCu, 'I', "Provisioned device credentials loaded"},    // 109
+    {0x43E66010u, 'I', "Queued reading %u/%u: %.2f C, contact %s (radio off)"},    // 110
+    {0x8A557814u, 'I', "Quiet wake: %.2f C, contact %s within deadband (radio off)"},    // 111
+    {0x487427CFu, 'I', "RAK3112 ResonantLRRadio"},    // 112
+    {0x3800A6B0u, 'I', "RSSI: %d dBm, SNR: %d dB"},    // 113
+    {0xBBEDFEA5u, 'I', "Radio init complete, starting main radio loop"},    // 114
+    {0x325894A0u, 'I', "Radio task on core %d, DIO1 interrupt driven"},    // 115
+    {0x763CB441u, 'I', "Radio task started on Core %d"},    // 116
+    {0x0AB267D7u, 'I', "Radio task: %lu passes, %lu DIO1 interrupts"},    // 117
+    {0xBA287EE3u, 'I', "Report: contact changed"},    // 118
+    {0x313D3DD2u, 'I', "Report: heartbeat (%lus silent)"},    // 119
+    {0x383533A3u, 'I', "Report: temperature moved %ld.%02ld C"},    // 120
+    {0x29D943F5u, 'I', "Root CA certificate loaded"},    // 121
+    {0x4773685Cu, 'I', "Sending %zu encrypted bytes (%zu plaintext)"},    // 122
+    {0x77D4C0BCu, 'I', "Sending adoption accept to %02X:%02X:%02X:%02X"},    // 123
+    {0x0627A4E5u, 'I', "Sending crypto adoption accept to %02X:%02X:%02X:%02X"},    // 124
+    {0x0B5C4096u, 'I', "Sending discovery/adoption advertise frame..."},    // 125
+    {0x19828BB3u, 'I', "Sending full metrics report"},    // 126
+    {0xC7B3B1E5u, 'I', "Sending metrics frame..."},    // 127
+    {0x32D41378u, 'I', "Sending settings report"},    // 128
+    {0x224FD528u, 'I', "Session key derived from adoption handshake"},    // 129
+    {0xFC77A92Cu, 'I', "Session key persisted to FRAM scratchpad (mock)"},    // 130
+    {0x1DF2D0C1u, 'I', "Session key restored from FRAM (mock)"},    // 131
+    {0xDE4222E6u, 'I', "Session key restored from RTC (mock)"},    // 132
+    {0x2295484Fu, 'I', "Settings applied from wire (radio config deferred until after TX)"},    // 133
+    {0x3F49DA25u, 'I', "Settings report TX complete"},    // 134
+    {0xF4E9BD1Bu, 'I', "Source ID: %02X:%02X:%02X:%02X"},    // 135
+    {0x5130C81Au, 'I', "Success: %s"},    // 136
+    {0x385C6ADBu, 'I', "Telemetry transmission complete"},    // 137
+    {0x5E13AFBDu, 'I', "Temperature: %.2f C, Contact: %s -> sending telemetry"},    // 138
+    {0x72E87E06u, 'I', "Test session key loaded for unadopted testing"},    // 139
+    {0x7885E4AFu, 'I', "Timestamp: %lu"},    // 140
+    {0xC754C716u, 'I', "Total TX time: %lu ms"},    // 141
+    {0x32E007EEu, 'I', "Using LoRa Long Range preset (SF7/BW125)"},    // 142
+    {0x242A3728u, 'I', "Using LoRa Long Range preset, ADR step %d (SF%u/BW%u/%d dBm)"},    // 143
+    {0x876350D0u, 'I', "Waiting for ACK..."},    // 144
+    {0x52EBCBB0u, 'I', "Wake phases (ms):%s"},    // 145
+    {0x7F9AD1C9u, 'I', "Wake timeout reached (telemetry-only cycle)"},    // 146
+    {0xAE937DE2u, 'I', "Wake-on-radio: sniffing every %u ms for %lu s"},    // 147
+    {0x1AB4A1A8u, 'I', "Warm crypto context valid, credential parsing deferred"},    // 148
+    {0x9DFFA981u, 'I', "\n--- Device NOT adopted - sending adoption advertise ---"},    // 149
+    {0x577071A3u, 'I', "\n--- Device adopted by %02X:%02X:%02X:%02X ---"},    // 150
+    {0x8E18D34Cu, 'I', "\n=== Data Received ==="},    // 151
+    {0xAA3B5F60u, 'I', "\n=== TX Complete ==="},    // 152
+    {0x60C2DC15u, 'I', "\n========================================"},    // 153
+    {0x171B0BF7u, 'D', "  %s: %lu ms"},    // 154
+    {0xC1968C7Bu, 'D', "Decrypted command payload: %zu bytes"},    // 155
+    {0xDB47572Au, 'D', "Event %u in %s"},    // 156
+    {0x71657D13u, 'D', "Network config received: %zu bytes"},    // 157
+    {0x406B328Cu, 'D', "No cert available, proceeding without attestation (dev mode)"},    // 158
+    {0xA4605789u, 'D', "No device cert available, sending without cert"},    // 159
+    {0x7D2BE9D0u, 'D', "No gateway cert in payload, skipping chain verification"},    // 160
+    {0xC175074Fu, 'D', "Other frame type received"},    // 161
+    {0x3FADE9CFu, 'D', "State %s -> %s"},    // 162
+    {0x97288C42u, 'D', "TX Channel: %u, TX Interval: %u sec"},    // 163
+    {0x4D58A516u, 'D', "Throughput: %.2f bytes/sec (%.2f KB/s)"},    // 164
+    {0xEBF6ED9Bu, 'D', "Total packets: %d"},    // 165
+};
+
+} // namespace ResonantLog
+
+#endif // LOG_TOKENS_H
@@ -1,116 +1,307 @@
 #include "main.h"
 
+// FRAM traffic of the last completed wake, reported in the next wake's metrics
+RTC_DATA_ATTR FramStats lastCycleFramStats;
+
 // ============================================================================
 // Setup (runs on Core 1)
 // ============================================================================
 void setup()
 {
+    phaseTracer.begin();
+    appEvents.begin(&resonantRadio);
     Serial1.begin(115200, SERIAL_8N1, PIN_SERIAL1_RX, PIN_SERIAL1_TX);
-    uint16_t bootError = 0;
+    ResonantLog::begin();
+    cpuClock.begin();
+    cpuGovernor.begin(&cpuClock);
+    cpuGovernor.enter(CpuPhase::BOOT);
 
     // Safe defaults before FRAM is read
-    powerManager.setSleepDuration(5);
+    setSleepDuration(5);
     powerManager.setWakeTimeout(5000);
     powerManager.setWakeInterruptPin(2, HIGH);
     powerManager.setContactWakePin(14);
     powerManager.enablePeripheralCircuit();
 
-    // --- FRAM Init ---
-    if (fram.begin(framSPI, 12, 10, 11, 13)) {
-        LOG_I("FRAM MB85RS64V detected");
-        if (fram.selfTest()) {
-            LOG_I("FRAM self-test PASSED");
-        } else {
-            LOG_W("FRAM self-test FAILED");
-            bootError |= BootError::FRAM;
-        }
+    resetReason = esp_reset_reason();
+    firstBoot = (resetReason == ESP_RST_POWERON);
+    interruptWake = powerManager.wasWokenByInterrupt();
+    contactWake = powerManager.wasWokenByContact();
+
+    // Each step starts as soon as its dependencies are done. Radio init runs
+    // on Core 0 in parallel with storage and crypto on Core 1.
+    bootScheduler.begin();
+    bootScheduler.add(BootStep::SENSOR,  "sensor",  1, 0, bootSensor);
+    bootScheduler.add(BootStep::FRAM,    "fram",    1, 0, bootFram);
+    bootScheduler.add(BootStep::STORAGE, "storage", 1, BootScheduler::bit(BootStep::FRAM), bootStorage);
+    bootScheduler.add(BootStep::PLAN,    "plan",    1, BootScheduler::bit(BootStep::STORAGE)
+                                                      | BootScheduler::bit(BootStep::SENSOR), bootPlan);
+    bootScheduler.add(BootStep::RADIO,   "radio",   0, BootScheduler::bit(BootStep::PLAN), bootRadio);
+    bootScheduler.add(BootStep::CRYPTO,  "crypto",  1, BootScheduler::bit(BootStep::PLAN), bootCrypto);
+
+    xTaskCreatePinnedToCore(backgroundTasks, "RadioTask", 20000, NULL, 1, &backgroundTask, RADIO_TASK_CORE);
+    bootScheduler.runCore(1);
+
+    // --- Batched / report-by-exception telemetry: quiet timer wakes never start the radio ---
+    if (sampleOnlyWake) {
+        runSampleOnlyWake();
+    }
+
+    LOG_I("\n========================================");
+    LOG_I("RAK3112 ResonantLRRadio");
+    LOG_I("FRAM Storage v1");
+    LOG_I("========================================");
+
+    // Wait for radio init on Core 0 (fixed 3s ceiling, independent of wake timeout)
+    phaseTracer.start(WakePhase::RADIO_WAIT);
+    bootScheduler.waitFor(BootScheduler::bit(BootStep::RADIO), 3000);
+    phaseTracer.stop(WakePhase::RADIO_WAIT);
+    if (!bootScheduler.succeeded(BootStep::RADIO) || !resonantRadio.radioInitialized) {
+        LOG_E("Radio initialization failed on Core 0, going to sleep");
+        bootError |= BootError::RADIO;
+    }
+    recordBootCriticalPath();
+
+    resonantRadio.onRxComplete(onDataReceived);
+    resonantRadio.onTxComplete(onTxComplete);
+    resonantRadio.onError(onRadioError);
+    resonantRadio.setPowerManager(&powerManager);
+    adoptionHandler.init(&encryption, &framStorage, &resonantFrame, &resonantRadio, &powerManager, &txArena);
+
+    RadioConfig currentConfig = resonantRadio.getConfig();
+    LOG_I("Frequency: %.1f MHz", (double)(currentConfig.frequency / 1000000.0));
+    if (currentConfig.modem == MODEM_LORA_MODE) {
+        LOG_I("Mode: LoRa SF%d BW%d",
+            currentConfig.loraSpreadingFactor,
+            currentConfig.loraBandwidth == 0 ? 125 : (currentConfig.loraBandwidth == 1 ? 250 : 500));
     } else {
+        LOG_I("Mode: FSK %d bps", currentConfig.fskDatarate);
+    }
+
+    if (!framStorage.isAdopted()) {
+        LOG_I("\n--- Device NOT adopted - sending adoption advertise ---");
+        uint32_t seq = framStorage.scratchpad().txSequenceNumber;
+        adoptionHandler.sendAdoptionAdvertise(SENSOR_TYPE, HARDWARE_VERSION, FIRMWARE_VERSION,
+                                              seq, currentTxContext);
+        radioTask.kick();
+    } else {
+        uint8_t parentId[4];
+        memcpy(parentId, framStorage.settings().parentID, 4);
+        LOG_I("\n--- Device adopted by %02X:%02X:%02X:%02X ---",
+              parentId[0], parentId[1], parentId[2], parentId[3]);
+        if (sensorPipeline.isBusy()) {
+            phaseTracer.start(WakePhase::SENSOR_READ);
+        }
+    }
+
+    if (bootError != 0) {
+        LOG_E("Boot error: 0x%04X", bootError);
+        if (framStorage.isInitialized()) {
+            accumulateMetricsBeforeSleep();
+            flushBeforeSleep();
+        }
+        sensorPipeline.shutdown();
+        sleepRadio();
+        enterSleep();
+    }
+
+    appState = AppState::SAMPLING;
+    if (radioWake && framStorage.isAdopted()) {
+        appState = AppState::RADIO;
+        dispatchSniffedFrame();
+    }
+    cpuGovernor.leave(CpuPhase::BOOT);
+}
+
+// ============================================================================
+// Boot Steps (run by bootScheduler)
+// ============================================================================
+bool bootSensor()
+{
+    sensorPipeline.add(&tempSensor, true);
+    sensorPipeline.add(&contactInput, true);
+    sensorPipeline.add(&humiditySensor);
+    sensorPipeline.onComplete(onSensorDataReady);
+
+    bool ok = sensorPipeline.begin(Wire);
+    if (!ok) {
+        bootError |= BootError::SENSOR;
+    }
+    // Conversions run through the rest of boot; loop() picks up the results
+    sensorPipeline.start();
+    return ok;
+}
+
+bool bootFram()
+{
+    if (!fram.begin(framSPI, 12, 10, 11, 13)) {
         LOG_E("FRAM MB85RS64V not detected");
         bootError |= BootError::FRAM;
+        return false;
+    }
+    LOG_I("FRAM MB85RS64V detected");
+    phaseTracer.start(WakePhase::FRAM_SELF_TEST);
+    bool selfTestPassed = fram.selfTest();
+    phaseTracer.stop(WakePhase::FRAM_SELF_TEST);
+    if (!selfTestPassed) {
+        LOG_W("FRAM self-test FAILED");
+        bootError |= BootError::FRAM;
+        return false;
     }
+    LOG_I("FRAM self-test PASSED");
+    return true;
+}
 
-    // --- FRAM Storage Init ---
-    if (!(bootError & BootError::FRAM)) {
-        if (!framStorage.begin(fram, SENSOR_TYPE, FIRMWARE_VERSION, HARDWARE_VERSION)) {
-            LOG_E("FRAM storage initialization failed");
-            bootError |= BootError::STORAGE;
-        }
+bool bootStorage()
+{
+    if (bootError & BootError::FRAM) {
+        return false;
+    }
+    if (!framStorage.begin(fram, SENSOR_TYPE, FIRMWARE_VERSION, HARDWARE_VERSION)) {
+        LOG_E("FRAM storage initialization failed");
+        bootError |= BootError::STORAGE;
+        return false;
+    }
+    sensorStore.begin(fram);
+    telemetryBatch.init(&sensorStore);
+    reportFilter.init(&sensorStore);
+    adrEngine.init(&sensorStore);
+    dutyCycle.init(&sensorStore);
+    metricsReport.init(&sensorStore, &fram);
+    downlinkGate.init(&sensorStore);
+    phaseTracer.attach(&sensorStore);
+    framJournal.init(&fram, &sensorStore);
+    if (!eventJournal.begin(&framJournal, FreeRegion::EVENT_JOURNAL, FreeRegion::EVENT_JOURNAL_CAPACITY)) {
+        LOG_W("Event journal: no valid header, starting empty");
     }
 
     // Configure power manager from FRAM settings (with sane minimums)
-    if (framStorage.isInitialized()) {
-        uint16_t sleepSec = framStorage.settings().telemetryInterval;
-        uint16_t wakeMs   = framStorage.settings().telemetryMaxWake;
-        powerManager.setSleepDuration(sleepSec > 0 ? sleepSec : 5);
-        powerManager.setWakeTimeout(wakeMs >= 1000 ? wakeMs : 5000);
+    uint16_t sleepSec = framStorage.settings().telemetryInterval;
+    uint16_t wakeMs   = framStorage.settings().telemetryMaxWake;
+    setSleepDuration(sleepSec > 0 ? sleepSec : 5);
+    powerManager.setWakeTimeout(wakeMs >= 1000 ? wakeMs : 5000);
+
+    // A wake-on-radio sleep ends in a short deep sleep; the real source is in RTC memory
+    wakeOnRadio.init(&sensorStore, resetReason == ESP_RST_DEEPSLEEP);
+    switch (wakeOnRadio.lastWake()) {
+        case WorWake::BUTTON:  interruptWake = true; break;
+        case WorWake::CONTACT: contactWake = true; break;
+        case WorWake::FRAME:
+            // Only the command this wake; the rest of the interval afterwards
+            radioWake = true;
+            setSleepDuration(wakeOnRadio.remainingSeconds() > 0 ? wakeOnRadio.remainingSeconds() : 1);
+            break;
+        default: break;
     }
 
-    // --- Determine wake reason ---
-    esp_reset_reason_t resetReason = esp_reset_reason();
-    firstBoot = (resetReason == ESP_RST_POWERON);
-    interruptWake = powerManager.wasWokenByInterrupt();
-    contactWake = powerManager.wasWokenByContact();
-
-    if (framStorage.isInitialized()) {
-        if (firstBoot) {
-            framStorage.setLastWakeReason(WakeReason::POWER_ON);
-            framStorage.incrementBootCount();
-        } else if (interruptWake) {
-            framStorage.setLastWakeReason(WakeReason::BUTTON);
-        } else if (contactWake) {
-            framStorage.setLastWakeReason(WakeReason::CONTACT);
-        } else {
-            framStorage.setLastWakeReason(WakeReason::TIMER);
-        }
+    // --- Wake reason ---
+    if (firstBoot) {
+        framStorage.setLastWakeReason(WakeReason::POWER_ON);
+        framStorage.incrementBootCount();
+    } else if (interruptWake) {
+        framStorage.setLastWakeReason(WakeReason::BUTTON);
+    } else if (contactWake) {
+        framStorage.setLastWakeReason(WakeReason::CONTACT);
+    } else {
+        framStorage.setLastWakeReason(WakeReason::TIMER);     // wake-on-radio command wakes too
+    }
 
-        framStorage.clearCycleFlags();
-        framStorage.incrementCycleCount();
+    framStorage.clearCycleFlags();
+    framStorage.incrementCycleCount();
 
-        // --- Brownout Detection ---
-        if (framStorage.scratchpad().lastTxStatus == TxStatus::TX_ATTEMPT) {
-            uint8_t recoveryCount = framStorage.scratchpad().brownoutRecoveryCount;
-            recoveryCount++;
-            framStorage.setBrownoutRecoveryCount(recoveryCount);
-            LOG_W("Brownout detected! Previous TX never completed. Recovery cycle %u", recoveryCount);
+    cycleRecord.cycle = (uint16_t)framStorage.metrics().cycleCount;
+    if (firstBoot) {
+        cycleRecord.wake = JournalWake::POWER_ON;
+    } else if (resetReason != ESP_RST_DEEPSLEEP) {
+        cycleRecord.wake = JournalWake::RESET;
+    } else if (interruptWake) {
+        cycleRecord.wake = JournalWake::BUTTON;
+    } else if (contactWake) {
+        cycleRecord.wake = JournalWake::CONTACT;
+    } else if (radioWake) {
+        cycleRecord.wake = JournalWake::RADIO;
+    }
+    if (resetReason == ESP_RST_BROWNOUT) {
+        cycleRecord.flags |= JournalFlag::BROWNOUT_RESET;
+    }
 
-            uint32_t extendedSleep = framStorage.settings().telemetryInterval * (1 << recoveryCount);
-            if (extendedSleep > 3600) extendedSleep = 3600;
-            powerManager.setSleepDuration(extendedSleep);
-            LOG_W("Extended sleep: %lu seconds for battery recovery", extendedSleep);
-        } else {
-            if (framStorage.scratchpad().brownoutRecoveryCount > 0) {
-                framStorage.setBrownoutRecoveryCount(0);
-            }
+    // --- Brownout Detection ---
+    if (framStorage.scratchpad().lastTxStatus == TxStatus::TX_ATTEMPT) {
+        uint8_t recoveryCount = framStorage.scratchpad().brownoutRecoveryCount;
+        recoveryCount++;
+        framStorage.setBrownoutRecoveryCount(recoveryCount);
+        cycleRecord.flags |= JournalFlag::BROWNOUT;
+        LOG_W("Brownout detected! Previous TX never completed. Recovery cycle %u", recoveryCount);
+
+        uint32_t extendedSleep = framStorage.settings().telemetryInterval * (1 << recoveryCount);
+        if (extendedSleep > 3600) extendedSleep = 3600;
+        setSleepDuration(extendedSleep);
+        LOG_W("Extended sleep: %lu seconds for battery recovery", extendedSleep);
+    } else {
+        if (framStorage.scratchpad().brownoutRecoveryCount > 0) {
+            framStorage.setBrownoutRecoveryCount(0);
         }
+    }
 
-        framStorage.setLastTxStatus(TxStatus::IDLE);
+    framStorage.setLastTxStatus(TxStatus::IDLE);
 
-        // --- Battery Voltage Filtering ---
-        updateBatteryVoltage();
+    // --- Battery Voltage Filtering ---
+    updateBatteryVoltage();
 
-        // Add sleep time from this sleep cycle (telemetryInterval approximation)
-        if (resetReason == ESP_RST_DEEPSLEEP) {
-            framStorage.addSleepTime(framStorage.settings().telemetryInterval);
-        }
+    // Add sleep time from this sleep cycle (telemetryInterval approximation,
+    // measured after a wake-on-radio sleep)
+    if (resetReason == ESP_RST_DEEPSLEEP) {
+        uint32_t slept = wakeOnRadio.lastWake() != WorWake::NONE ? wakeOnRadio.sleptSeconds()
+                                                                  : framStorage.settings().telemetryInterval;
+        framStorage.addSleepTime(slept);
+        telemetryBatch.onWake(slept);
+        reportFilter.onWake(slept);
+        dutyCycle.onWake(slept);
     }
+    return true;
+}
 
+// Decides what this wake does before the radio is allowed to start
+bool bootPlan()
+{
     if (interruptWake) {
         LOG_I("*** Woken by user button (ext0/GPIO2) ***");
     } else if (contactWake) {
         LOG_I("*** Woken by contact sensor (ext1/GPIO14) ***");
+    } else if (radioWake) {
+        LOG_I("*** Woken by a command (wake-on-radio) ***");
     }
 
-    // --- Sensor Init ---
-    if (!tempSensor.begin(Wire, 0x48)) {
-        bootError |= BootError::SENSOR;
-    }
-    tempSensor.setContactPin(14);
-    tempSensor.onDataReady(onSensorDataReady);
+    applySensorConfig();
 
-    LOG_I("\n========================================");
-    LOG_I("RAK3112 ResonantLRRadio");
-    LOG_I("FRAM Storage v1");
-    LOG_I("========================================");
+    bool timerWake = bootError == 0 && framStorage.isAdopted() && resetReason == ESP_RST_DEEPSLEEP
+                  && !interruptWake && !contactWake && !radioWake;
+    if (timerWake && telemetryBatch.enabled()) {
+        sampleOnlyWake = !telemetryBatch.isFlushDueAfterNext();
+    } else if (timerWake && reportFilter.enabled()) {
+        // Report-by-exception needs this wake's reading before the radio may start
+        waitForSensorPipeline();
+        sampleOnlyWake = !reportFilter.shouldReport(tempSensor.lastRawCount, contactInput.closed());
+    }
+    if (timerWake && !sampleOnlyWake) {
+        // Sized for the largest telemetry frame this format can produce
+        size_t plaintext = telemetryBatch.enabled() ? TelemetryBatch::MAX_WIRE_SIZE
+                                                    : SensorPipeline::MAX_RECORD_SIZE;
+        size_t frameBytes = TxFrameArena::HEADER_SIZE + TxFrameArena::CHECKSUM_SIZE
+                          + ENCRYPTION_OVERHEAD + plaintext;
+        if (!dutyCycle.allows(DutyCycleBudget::frameUs(plannedRadioConfig(), frameBytes))) {
+            LOG_W("Duty cycle: %lu of %lu ms used this hour, telemetry deferred",
+                  (unsigned long)dutyCycle.usedMs(), (unsigned long)dutyCycle.limitMs());
+            dutyCycle.onDeferred();
+            airtimeDeferred = true;
+            sampleOnlyWake = true;
+        }
+    }
+    if (sampleOnlyWake) {
+        bootScheduler.skip(BootStep::RADIO);
+        bootScheduler.skip(BootStep::CRYPTO);
+        return true;
+    }
 
     // Clear adoption on reset for test purposes
     if (resetReason != ESP_RST_DEEPSLEEP && framStorage.isAdopted()) {
@@ -121,24 +312,77 @@ void setup()
         LOG_I("Mock session key cleared (adoption reset)");
 #endif
     }
+    return true;
+}
 
-    // Start radio init on Core 0
-    xTaskCreatePinnedToCore(backgroundTasks, "RadioTask", 20000, NULL, 1, &backgroundTask, 0);
+// SensorSettings::TMP112_CONFIG -> driver. Runs after bootSensor() has started
+// the first conversion, which is only restarted if the format changes.
+void applySensorConfig()
+{
+    if (!tempSensor.sensorOperational || !sensorStore.isInitialized()) {
+        return;
+    }
+    uint8_t cfg = sensorStore.get8(SensorRegion::SETTINGS, SensorSettings::TMP112_CONFIG);
+    if (cfg == 0xFF) {
+        cfg = 0;
+    }
+    tempSensor.configure(!(cfg & TMP112Config::CONTINUOUS), cfg & TMP112Config::EXTENDED,
+                         (TMP112Sensor::ConversionRate)TMP112Config::rate(cfg));
+}
+
+// The preset with this wake's ADR step applied
+RadioConfig plannedRadioConfig()
+{
+    RadioConfig config = ResonantLRRadio::getLoRaLongRangePreset();
+    adrEngine.apply(config);
+    return config;
+}
 
-    // --- Encryption Init ---
+// Runs on Core 0 from backgroundTasks()
+bool bootRadio()
+{
+    RadioConfig config = plannedRadioConfig();
+
+    if (adrEngine.step() != 0) {
+        LOG_I("Using LoRa Long Range preset, ADR step %d (SF%u/BW%u/%d dBm)", adrEngine.step(),
+              config.loraSpreadingFactor, 125u << config.loraBandwidth, config.txPower);
+    } else {
+        LOG_I("Using LoRa Long Range preset (SF7/BW125)");
+    }
+    if (!resonantRadio.init(&resonantFrame, config)) {
+        LOG_E("Radio initialization failed on Core 0!");
+        return false;
+    }
+    wakeOnRadio.onRadioStarted();
+    return true;
+}
+
+bool bootCrypto()
+{
+    // Adopted deep-sleep wakes with a valid warm context only need the session
+    // key; credentials and CA are parsed on demand for adoption traffic.
+    phaseTracer.start(WakePhase::CRYPTO_INIT);
+    cpuGovernor.enter(CpuPhase::CRYPTO);
+    uint32_t bootGeneration = framStorage.isInitialized() ? framStorage.metrics().bootCount : 0;
+    uint32_t credentialsCrc = credentialsFingerprint();
+    bool warmCrypto = resetReason == ESP_RST_DEEPSLEEP && framStorage.isAdopted()
+                   && warmContext.restore(bootGeneration, credentialsCrc);
+    if (!warmCrypto) {
+        warmContext.invalidate();
+    }
+
+    bool ok = true;
     if (encryption.begin()) {
-        if (device_key_der_len > 0 && device_cert_der_len > 0) {
-            if (encryption.loadDeviceCredentials(device_key_der, device_key_der_len, device_cert_der, device_cert_der_len)) {
-                LOG_I("Provisioned device credentials loaded");
-            } else { bootError |= BootError::ENCRYPTION; }
-        } else { bootError |= BootError::ENCRYPTION; }
-    } else { bootError |= BootError::ENCRYPTION; }
-
-    if (resonant_ca_cert_der_len > 0) {
-        if (encryption.loadCACertBundle(resonant_ca_cert_der, resonant_ca_cert_der_len)) {
-            LOG_I("Root CA certificate loaded");
-        } else { bootError |= BootError::ENCRYPTION; }
-    } else { bootError |= BootError::ENCRYPTION; }
+        if (warmCrypto) {
+            LOG_I("Warm crypto context valid, credential parsing deferred");
+        } else if (!ensureCryptoCredentials()) {
+            ok = false;
+        }
+    } else { ok = false; }
+
+    uint8_t arenaSourceId[4];
+    getDeviceSensorId(arenaSourceId);
+    txArena.init(&encryption, arenaSourceId);
 
     if (!framStorage.isAdopted()) {
         uint8_t testKey[ResonantEncryption::AES128_KEY_SIZE] = {
@@ -151,101 +395,77 @@ void setup()
         LOG_I("Test session key loaded for unadopted testing");
     }
 #ifdef ATECC_MOCK
+    else if (warmContext.hasSessionKey()) {
+        encryption.storeKey(warmContext.sessionKey(), WarmContext::SESSION_KEY_SIZE,
+                            ResonantEncryption::SLOT_SESSION_KEY);
+        LOG_I("Session key restored from RTC (mock)");
+    }
     else if (framStorage.hasMockSessionKey()) {
         uint8_t savedKey[ResonantEncryption::AES128_KEY_SIZE];
         framStorage.getMockSessionKey(savedKey, sizeof(savedKey));
         encryption.storeKey(savedKey, sizeof(savedKey),
                             ResonantEncryption::SLOT_SESSION_KEY);
+        warmContext.setSessionKey(savedKey);
         memset(savedKey, 0, sizeof(savedKey));
         LOG_I("Session key restored from FRAM (mock)");
     }
 #endif
 
-    // Wait for radio init on Core 0 (fixed 3s ceiling, independent of wake timeout)
-    unsigned long radioWaitStart = millis();
-    while (!resonantRadio.radioInitialized && (millis() - radioWaitStart < 3000)) {
-        delay(1);
+    // Full load succeeded on an adopted device: later wakes can skip it
+    if (!warmCrypto && cryptoCredentialsLoaded && framStorage.isAdopted()) {
+        warmContext.save(bootGeneration, credentialsCrc);
     }
-    if (!resonantRadio.radioInitialized) {
-        LOG_E("Radio initialization failed on Core 0, going to sleep");
-        bootError |= BootError::RADIO;
-    }
-
-    resonantRadio.onRxComplete(onDataReceived);
-    resonantRadio.onTxComplete(onTxComplete);
-    resonantRadio.onError(onRadioError);
-    resonantRadio.setPowerManager(&powerManager);
-    adoptionHandler.init(&encryption, &framStorage, &resonantFrame, &resonantRadio, &powerManager);
+    cpuGovernor.leave(CpuPhase::CRYPTO);
+    phaseTracer.stop(WakePhase::CRYPTO_INIT);
 
-    RadioConfig currentConfig = resonantRadio.getConfig();
-    LOG_I("Frequency: %.1f MHz", (double)(currentConfig.frequency / 1000000.0));
-    if (currentConfig.modem == MODEM_LORA_MODE) {
-        LOG_I("Mode: LoRa SF%d BW%d",
-            currentConfig.loraSpreadingFactor,
-            currentConfig.loraBandwidth == 0 ? 125 : (currentConfig.loraBandwidth == 1 ? 250 : 500));
-    } else {
-        LOG_I("Mode: FSK %d bps", currentConfig.fskDatarate);
-    }
-
-    if (!framStorage.isAdopted()) {
-        LOG_I("\n--- Device NOT adopted - sending adoption advertise ---");
-        uint32_t seq = framStorage.scratchpad().txSequenceNumber;
-        adoptionHandler.sendAdoptionAdvertise(SENSOR_TYPE, HARDWARE_VERSION, FIRMWARE_VERSION,
-                                              seq, currentTxContext);
-    } else {
-        uint8_t parentId[4];
-        memcpy(parentId, framStorage.settings().parentID, 4);
-        LOG_I("\n--- Device adopted by %02X:%02X:%02X:%02X ---",
-              parentId[0], parentId[1], parentId[2], parentId[3]);
-        tempSensor.requestReading();
+    if (!ok) {
+        bootError |= BootError::ENCRYPTION;
     }
+    return ok;
+}
 
-    if (bootError != 0) {
-        LOG_E("Boot error: 0x%04X", bootError);
-        if (framStorage.isInitialized()) {
-            accumulateMetricsBeforeSleep();
-            framStorage.flush();
-        }
-        resonantRadio.deepSleep();
-        powerManager.goToSleep();
-    }
+// Steps that gate the first TX; the chain that finished last is stored in metrics
+void recordBootCriticalPath()
+{
+    const uint32_t firstTxDeps = BootScheduler::bit(BootStep::RADIO)
+                               | BootScheduler::bit(BootStep::CRYPTO)
+                               | BootScheduler::bit(BootStep::SENSOR);
+    bootScheduler.logCriticalPath(firstTxDeps);
+
+    if (!sensorStore.isInitialized()) return;
+    uint32_t readyUs = 0;
+    uint32_t path = bootScheduler.criticalPath(firstTxDeps, &readyUs);
+    uint32_t units = readyUs / PhaseTracer::UNIT_US;
+    sensorStore.put16(SensorRegion::METRICS, SensorMetrics::BOOT_READY_TIME,
+                      units > 0xFFFF ? 0xFFFF : (uint16_t)units);
+    sensorStore.put8(SensorRegion::METRICS, SensorMetrics::BOOT_CRITICAL_PATH, (uint8_t)path);
 }
 
 // ============================================================================
 // Loop (runs on Core 1)
 // ============================================================================
+// One pass per event or timeout (AppEventLoop); between them Core 1 is
+// blocked, light-sleeping when the radio hooks allow it. The radio callbacks
+// on Core 0 still sequence frames and listen windows; each posts an event
+// when it is done, so this loop never polls.
+//
+//   SAMPLING     -> RADIO        telemetry sent (or nothing to send)
+//   RADIO        -> REPLY_DELAY  a command queued a settings/metrics report
+//   REPLY_DELAY  -> RADIO        report sent after REPLY_GAP_MS
+//   any          -> SLEEP        powerManager.shouldSleep(), radio idle
 void loop()
 {
-    tempSensor.loop();
-
-    if (sensorDataReady && framStorage.isAdopted()) {
-        sensorDataReady = false;
-        uint8_t parentId[4];
-        memcpy(parentId, framStorage.settings().parentID, 4);
-
-        int16_t tempCenti = (int16_t)(lastTemperatureC * 100);
-        uint8_t payload[3] = {
-            (uint8_t)(tempCenti >> 8),
-            (uint8_t)(tempCenti & 0xFF),
-            lastContactClosed ? (uint8_t)0x01 : (uint8_t)0x00
-        };
-        LOG_I("Temperature: %.2f C, Contact: %s -> sending telemetry",
-              lastTemperatureC, lastContactClosed ? "CLOSED" : "OPEN");
-
-        // Mark TX attempt in scratchpad for brownout detection
-        uint16_t vBat = (uint16_t)(powerManager.getBatteryVoltage() * 100);
-        framStorage.setPreTxBatteryVoltage(vBat);
-        framStorage.setLastTxStatus(TxStatus::TX_ATTEMPT);
-        framStorage.flush();
-
-        sendEncryptedTelemetry(payload, 3, parentId);
+    bool radioWait = appState == AppState::RADIO;
+    if (radioWait) cpuGovernor.enter(CpuPhase::RADIO_WAIT);
+    AppEvent event = appEvents.wait(appWaitMs(), true);
+    if (radioWait) cpuGovernor.leave(CpuPhase::RADIO_WAIT);
+    if (event != AppEvent::NONE) {
+        LOG_D("Event %u in %s", (unsigned)event, appStateName(appState));
     }
-
-    if (pendingSettingsReport && !resonantRadio.isBusy()) {
-        pendingSettingsReport = false;
-        LOG_I("Sending settings report");
-        delay(50);
-        sendSettingsFrame();
+    if (sensorPipeline.isBusy()) {
+        cpuGovernor.enter(CpuPhase::SENSOR_IO);
+        sensorPipeline.loop();
+        cpuGovernor.leave(CpuPhase::SENSOR_IO);
     }
 
     bool telemetryOnlyCycle = framStorage.isAdopted()
@@ -255,7 +475,9 @@ void loop()
                            && currentTxContext != TxContext::ADOPTION_ACCEPT
                            && currentTxContext != TxContext::METRICS
                            && currentTxContext != TxContext::SETTINGS_REPORT
-                           && currentTxContext != TxContext::COMMAND_RESPONSE;
+                           && currentTxContext != TxContext::COMMAND_RESPONSE
+                           && currentTxContext != TxContext::JOURNAL_PAGE
+                           && !commandWindowOpen;
 
     if (telemetryOnlyCycle && powerManager.checkWakeTimeout()) {
         LOG_I("Wake timeout reached (telemetry-only cycle)");
@@ -263,10 +485,139 @@ void loop()
 
     if (powerManager.shouldSleep() && !resonantRadio.isBusy()
         && resonantRadio.isTransmissionComplete()) {
-        accumulateMetricsBeforeSleep();
-        framStorage.flush();
-        resonantRadio.deepSleep();
-        powerManager.goToSleep();
+        setAppState(AppState::SLEEP);
+    }
+
+    switch (appState) {
+        case AppState::SAMPLING:
+            if (telemetryDue()) {
+                sendTelemetryReading();
+                setAppState(AppState::RADIO);
+            } else if (!sensorPipeline.isBusy()) {
+                setAppState(AppState::RADIO);
+            }
+            break;
+
+        case AppState::RADIO:
+            if (telemetryDue() && !pendingSettingsReport && !pendingMetricsReport
+                && journalPagesLeft == 0 && !commandWindowOpen
+                && currentTxContext != TxContext::METRICS
+                && !resonantRadio.isBusy() && resonantRadio.isTransmissionComplete()) {
+                // Adopted during this wake: the reading taken at boot goes out
+                // once nothing else holds the radio
+                sendTelemetryReading();
+            } else if ((pendingSettingsReport || pendingMetricsReport || journalPagesLeft > 0)
+                       && !resonantRadio.isBusy()) {
+                replyAtMs = millis() + REPLY_GAP_MS;
+                setAppState(AppState::REPLY_DELAY);
+            }
+            break;
+
+        case AppState::REPLY_DELAY:
+            if ((int32_t)(millis() - replyAtMs) >= 0 && !resonantRadio.isBusy()) {
+                sendQueuedReport();
+                setAppState(AppState::RADIO);
+            }
+            break;
+
+        case AppState::SLEEP:
+            accumulateMetricsBeforeSleep();
+            flushBeforeSleep();
+            sensorPipeline.shutdown();
+            sleepRadio();
+            enterSleep();
+            break;
+    }
+}
+
+void setAppState(AppState next)
+{
+    if (next == appState) return;
+    LOG_D("State %s -> %s", appStateName(appState), appStateName(next));
+    appState = next;
+}
+
+// How long loop() may block before the current state needs another look
+uint32_t appWaitMs()
+{
+    switch (appState) {
+        case AppState::SAMPLING: {
+            uint32_t due = sensorPipeline.msUntilDue();
+            return due < APP_RECHECK_MS ? due : APP_RECHECK_MS;
+        }
+        case AppState::REPLY_DELAY: {
+            int32_t left = (int32_t)(replyAtMs - millis());
+            return left <= 0 ? APP_RECHECK_MS : (uint32_t)left;
+        }
+        case AppState::SLEEP:
+            return 0;
+        default:
+            return APP_RECHECK_MS;
+    }
+}
+
+bool telemetryDue()
+{
+    return sensorDataReady && framStorage.isAdopted() && !radioWake;
+}
+
+void sendTelemetryReading()
+{
+    sensorDataReady = false;
+    uint8_t parentId[4];
+    memcpy(parentId, framStorage.settings().parentID, 4);
+
+    int16_t tempCenti = (int16_t)(lastTemperatureC * 100);
+    LOG_I("Temperature: %.2f C, Contact: %s -> sending telemetry",
+          lastTemperatureC, lastContactClosed ? "CLOSED" : "OPEN");
+
+    // Mark TX attempt in scratchpad for brownout detection
+    uint16_t vBat = (uint16_t)(powerManager.getBatteryVoltage() * 100);
+    framStorage.setPreTxBatteryVoltage(vBat);
+    framStorage.setLastTxStatus(TxStatus::TX_ATTEMPT);
+
+    uint8_t payload[TelemetryBatch::MAX_WIRE_SIZE > SensorPipeline::MAX_RECORD_SIZE
+                    ? TelemetryBatch::MAX_WIRE_SIZE : SensorPipeline::MAX_RECORD_SIZE];
+    size_t payloadLen = 0;
+    uint8_t options = TelemetryFormat::OPTION_EXTENDED_PAYLOAD;
+    if (telemetryBatch.enabled()) {
+        telemetryBatch.append(tempSensor.lastRawCount, lastContactClosed);
+        payloadLen = telemetryBatch.encode(payload, sizeof(payload));
+        LOG_I("Flushing %u queued readings (format 0x%02X, %zu bytes)",
+              telemetryBatch.count(), payload[0], payloadLen);
+        batchInFlight = true;
+    } else if (telemetryBatch.typedRecords()) {
+        payloadLen = sensorPipeline.encode(payload, sizeof(payload));
+        reportFilter.onSending(tempSensor.lastRawCount, lastContactClosed);
+    } else {
+        payload[0] = (uint8_t)(tempCenti >> 8);
+        payload[1] = (uint8_t)(tempCenti & 0xFF);
+        payload[2] = lastContactClosed ? (uint8_t)0x01 : (uint8_t)0x00;
+        payloadLen = 3;
+        options = 0;
+        reportFilter.onSending(tempSensor.lastRawCount, lastContactClosed);
+    }
+
+    // The wake's one mid-cycle checkpoint: the TX_ATTEMPT marker (and a
+    // batched reading) must be in FRAM before the radio draws TX current
+    flushStorage();
+    sendEncryptedTelemetry(payload, payloadLen, parentId, options);
+}
+
+// Settings first; a queued metrics report goes out on the next pass through
+// REPLY_DELAY, once the settings frame has left, then journal pages one per pass
+void sendQueuedReport()
+{
+    if (pendingSettingsReport) {
+        pendingSettingsReport = false;
+        LOG_I("Sending settings report");
+        sendSettingsFrame();
+    } else if (pendingMetricsReport) {
+        pendingMetricsReport = false;
+        LOG_I("Sending full metrics report");
+        sendMetricsFrame();
+    } else if (journalPagesLeft > 0) {
+        sendJournalPage();
     }
 }
 
@@ -293,17 +644,22 @@ void handleCommand(uint8_t commandId, uint8_t* params, size_t paramsLength, uint
         }
 
         case ResonantFrame::CMD_FACTORY_RESET:
+            warmContext.invalidate();
             framStorage.factoryReset();
+            framStorage.flush();
+            sensorStore.begin(fram);
+            if (eventJournal.isInitialized()) {
+                eventJournal.clear();       // cycle numbers restart with the metrics
+            }
             LOG_I("Command: Factory reset executed");
             break;
 
         case ResonantFrame::CMD_SLEEP_NOW:
+            // Core 1 flushes and sleeps in SLEEP once the radio is idle;
+            // onDataReceived() posts the event that wakes it
             LOG_I("Command: Sleep now — skipping response to save power");
             powerManager.markRxComplete();
-            accumulateMetricsBeforeSleep();
-            framStorage.flush();
-            resonantRadio.deepSleep();
-            powerManager.goToSleep();
+            powerManager.requestSleep();
             return;
 
         case ResonantFrame::CMD_CONFIGURE_SETTINGS: {
@@ -316,29 +672,83 @@ void handleCommand(uint8_t commandId, uint8_t* params, size_t paramsLength, uint
                 responseCode = ResonantFrame::CMD_RESPONSE_FAILED;
                 break;
             }
-            framStorage.flush();
+            flushStorage();
+            sensorStore.reloadSettings();
 
-            pendingRadioConfig = resonantRadio.getConfig();
-            pendingRadioConfig.txPower = framStorage.settings().txPower;
-            pendingRadioConfig.loraSpreadingFactor = framStorage.settings().spreadingFactor;
-            pendingRadioConfig.loraBandwidth = framStorage.settings().bandwidth;
-            pendingRadioConfig.frequency = framStorage.settings().frequency;
-            pendingRadioConfig.loraCodingRate = framStorage.settings().codingRate;
-
-            powerManager.setSleepDuration(framStorage.settings().telemetryInterval);
+            stageRadioConfig();
+            setSleepDuration(framStorage.settings().telemetryInterval);
             powerManager.extendWakeTimeout(framStorage.settings().telemetryMaxWake);
 
             LOG_I("Settings applied from wire (radio config deferred until after TX)");
-            pendingRadioConfigApply = true;
             pendingSettingsReport = true;
             return;
         }
 
+        case SettingsPatch::CMD_PATCH_SETTINGS: {
+            // Patch the live region, then apply it like a full configure
+            uint8_t settings[ResonantFRAMStorage::PAYLOAD_SIZE];
+            buildSettingsPayload(settings);
+            uint8_t touched = SettingsPatch::apply(SettingsFields::TABLE, SettingsFields::COUNT,
+                                                   settings, params, paramsLength);
+            if (touched == 0) {
+                responseCode = ResonantFrame::CMD_RESPONSE_INVALID_PARAMS;
+                LOG_W("Patch settings: invalid patch (%zu bytes)", paramsLength);
+                break;
+            }
+            if (!framStorage.applySettingsFromWire(settings, sizeof(settings))) {
+                responseCode = ResonantFrame::CMD_RESPONSE_FAILED;
+                break;
+            }
+            flushStorage();
+
+            // Re-apply only what the patch touched
+            if (touched & SettingsPatch::TOUCH_SENSOR) {
+                sensorStore.reloadSettings();
+            }
+            if (touched & SettingsPatch::TOUCH_TIMING) {
+                setSleepDuration(framStorage.settings().telemetryInterval);
+                powerManager.extendWakeTimeout(framStorage.settings().telemetryMaxWake);
+            }
+            if (touched & SettingsPatch::TOUCH_RADIO) {
+                stageRadioConfig();
+            }
+            LOG_I("Command: Settings patched (touched 0x%02X%s)", touched,
+                  (touched & SettingsPatch::TOUCH_RADIO) ? ", radio config deferred until after TX" : "");
+            break;
+        }
+
         case ResonantFrame::CMD_REQUEST_SETTINGS:
             LOG_I("Command: Request settings");
             pendingSettingsReport = true;
             return;
 
+        case ResonantFrame::CMD_REQUEST_METRICS:
+            LOG_I("Command: Request metrics (full report)");
+            metricsReport.requestFull();
+            pendingMetricsReport = true;
+            return;
+
+        case EventJournal::CMD_READ_JOURNAL: {
+            // [first page] [page count]: both optional, one page from the newest by default
+            uint8_t page = paramsLength >= 1 ? params[0] : 0;
+            uint8_t pages = paramsLength >= 2 ? params[1] : 1;
+            uint8_t available = eventJournal.pageCount() > 0 ? eventJournal.pageCount() : 1;
+            if (!eventJournal.isInitialized() || paramsLength > 2 || page >= available
+                || pages == 0 || pages > EventJournal::MAX_PAGES_PER_COMMAND) {
+                responseCode = ResonantFrame::CMD_RESPONSE_INVALID_PARAMS;
+                LOG_W("Read journal: invalid request (page %u of %u, %u pages)", page, available, pages);
+                break;
+            }
+            if (pages > available - page) {
+                pages = available - page;
+            }
+            LOG_I("Command: Read journal, pages %u-%u of %u", page, page + pages - 1, available);
+            journalNextPage = page;
+            journalPagesLeft = pages;
+            memcpy(journalDestination, sourceID, 4);
+            return;
+        }
+
         default:
             responseCode = ResonantFrame::CMD_RESPONSE_UNKNOWN_CMD;
             LOG_W("Unknown command: 0x%02X", commandId);
@@ -348,33 +758,32 @@ void handleCommand(uint8_t commandId, uint8_t* params, size_t paramsLength, uint
     delay(150);
 
     uint8_t responseData[2] = {commandId, responseCode};
-    uint8_t* encPayload = nullptr;
-    size_t encLen = 0;
+    sendArenaFrame(resonantFrame.commandResponseFrameType, responseData, sizeof(responseData),
+                   sourceID, false, TxContext::COMMAND_RESPONSE);
 
-    uint8_t cmdOpts = ResonantFrame::buildOptionsV1(false);
-    uint8_t cmdSensorId[4];
-    getDeviceSensorId(cmdSensorId);
-    uint32_t seq = framStorage.getNextTxSequenceNumber();
+    LOG_I("Command response sent: cmd=0x%02X, result=0x%02X", commandId, responseCode);
+}
 
-    if (encryption.isInitialized() &&
-        encryption.encryptForWire(responseData, 2,
-                       resonantFrame.commandResponseFrameType, cmdSensorId, seq,
-                       &encPayload, &encLen)) {
-        FrameData response = resonantFrame.buildCommandResponseFrame(
-            encPayload, encLen, sourceID, cmdOpts, seq);
-        currentTxContext = TxContext::COMMAND_RESPONSE;
-        resonantRadio.send(response.frame, response.size);
-        delete[] response.frame;
-        delete[] encPayload;
-    } else {
-        FrameData response = resonantFrame.buildCommandResponseFrame(
-            responseData, 2, sourceID, cmdOpts, seq);
-        currentTxContext = TxContext::COMMAND_RESPONSE;
-        resonantRadio.send(response.frame, response.size);
-        delete[] response.frame;
-    }
+// Radio fields of the new settings, applied by applyStagedRadioConfig() once
+// the reply to the command is on air
+void stageRadioConfig()
+{
+    pendingRadioConfig = resonantRadio.getConfig();
+    pendingRadioConfig.txPower = framStorage.settings().txPower;
+    pendingRadioConfig.loraSpreadingFactor = framStorage.settings().spreadingFactor;
+    pendingRadioConfig.loraBandwidth = framStorage.settings().bandwidth;
+    pendingRadioConfig.frequency = framStorage.settings().frequency;
+    pendingRadioConfig.loraCodingRate = framStorage.settings().codingRate;
+    pendingRadioConfigApply = true;
+}
 
-    LOG_I("Command response sent: cmd=0x%02X, result=0x%02X", commandId, responseCode);
+void applyStagedRadioConfig()
+{
+    if (!pendingRadioConfigApply) return;
+    pendingRadioConfigApply = false;
+    resonantRadio.setConfig(pendingRadioConfig);
+    resonantRadio.applyConfig();
+    LOG_I("Deferred radio config applied");
 }
 
 // ============================================================================
@@ -388,8 +797,50 @@ void onDataReceived(ValidateFrameResult& result, uint8_t* data, size_t dataLengt
     LOG_I("Data Length: %zu bytes", dataLength);
     LOG_I("Timestamp: %lu", millis());
 
+    DownlinkHint hint;
+    bool hinted = result.frameType == resonantFrame.acknowledgementFrameType
+               && readDownlinkHint(result, data, dataLength, hint);
     if (result.frameType == resonantFrame.acknowledgementFrameType) {
+        cycleRecord.ackRssi = (int8_t)(rssi < INT8_MIN ? INT8_MIN : (rssi > -1 ? -1 : rssi));
+        cycleRecord.ackSnr = snr;
+    }
+
+    if (result.frameType == resonantFrame.acknowledgementFrameType
+        && currentTxContext == TxContext::METRICS) {
+        // Delta metrics: the report is now the gateway's baseline. The
+        // command window the metrics frame opened runs on, unless the
+        // gateway said it has nothing or not much more to send.
+        LOG_I("Metrics ACK received");
+        metricsReport.onAcknowledged();
+        uint32_t elapsed = millis() - commandWindowStartMs;
+        uint32_t waitAfterTx = framStorage.getWaitAfterTx();
+        uint32_t window = waitAfterTx > elapsed ? waitAfterTx - elapsed : 0;
+        if (hinted) {
+            uint32_t remaining = window;
+            window = DownlinkGate::windowMs(hint, remaining);
+            downlinkGate.onGated(remaining, window);
+            LOG_I("Downlink %s: command window %lu of %lu ms", hint.pending ? "pending" : "none",
+                  (unsigned long)window, (unsigned long)remaining);
+        }
+        if (window > 0) {
+            resonantRadio.startRx(window);
+        } else {
+            powerManager.markRxComplete();
+            powerManager.requestSleep();
+        }
+
+    } else if (result.frameType == resonantFrame.acknowledgementFrameType) {
         LOG_I("ACK received!");
+        phaseTracer.stop(WakePhase::ACK_RX);
+        if (cycleRecord.tx == JournalTx::NO_ACK) {
+            cycleRecord.tx = JournalTx::ACKED;
+        }
+        adrEngine.onAck(resonantRadio.getConfig(), snr);
+        if (batchInFlight) {
+            batchInFlight = false;
+            telemetryBatch.clear();
+        }
+        reportFilter.onReported();
         framStorage.resetAckFailCount();
         framStorage.addCycleFlag(CycleFlag::ACK_RECEIVED);
         powerManager.markRxComplete();
@@ -399,6 +850,13 @@ void onDataReceived(ValidateFrameResult& result, uint8_t* data, size_t dataLengt
             LOG_I("Sending metrics frame...");
             powerManager.clearSleepRequest();
             sendMetricsFrame();
+        } else if (hinted && hint.pending) {
+            // No metrics this wake: the command window opens for the gateway
+            uint32_t window = DownlinkGate::windowMs(hint, framStorage.getWaitAfterTx());
+            LOG_I("Downlink pending, listening %lu ms for commands", (unsigned long)window);
+            commandWindowOpen = true;
+            powerManager.markRxStart();
+            resonantRadio.startRx(window);
         } else {
             powerManager.requestSleep();
         }
@@ -406,13 +864,17 @@ void onDataReceived(ValidateFrameResult& result, uint8_t* data, size_t dataLengt
     } else if (result.frameType == resonantFrame.commandFrameType) {
         LOG_I("Command frame received");
         framStorage.addCycleFlag(CycleFlag::CMD_RECEIVED);
+        cycleRecord.flags |= JournalFlag::COMMAND;
         powerManager.extendWakeTimeout(framStorage.settings().telemetryMaxWake);
 
         if (encryption.isInitialized() && dataLength > ENCRYPTION_OVERHEAD) {
             uint8_t plaintext[dataLength];
             size_t ptLen = 0;
-            if (encryption.decryptFromWire(data, dataLength, result.frameType,
-                               result.sourceID, result.sequenceNumber, plaintext, &ptLen)) {
+            cpuGovernor.enter(CpuPhase::CRYPTO);
+            bool decrypted = encryption.decryptFromWire(data, dataLength, result.frameType,
+                               result.sourceID, result.sequenceNumber, plaintext, &ptLen);
+            cpuGovernor.leave(CpuPhase::CRYPTO);
+            if (decrypted) {
                 LOG_D("Decrypted command payload: %zu bytes", ptLen);
                 if (ptLen >= 1) {
                     handleCommand(plaintext[0], plaintext + 1, ptLen - 1, result.sourceID);
@@ -434,9 +896,13 @@ void onDataReceived(ValidateFrameResult& result, uint8_t* data, size_t dataLengt
     } else if (result.frameType == resonantFrame.adoptionRequestFrameType) {
         powerManager.clearSleepRequest();
         powerManager.setWakeTimeout(10000);
+        warmContext.invalidate();
+        cpuGovernor.enter(CpuPhase::CRYPTO);
+        ensureCryptoCredentials();
         uint32_t seq = framStorage.scratchpad().txSequenceNumber;
         adoptionHandler.handleAdoptionRequest(data, dataLength, result.sourceID,
                                                seq, currentTxContext);
+        cpuGovernor.leave(CpuPhase::CRYPTO);
         framStorage.setTxSequenceNumber(seq);
 
     } else if (result.frameType == resonantFrame.multiPacketFrameType) {
@@ -447,6 +913,30 @@ void onDataReceived(ValidateFrameResult& result, uint8_t* data, size_t dataLengt
     }
 
     LOG_I("=====================\n");
+    appEvents.post(AppEvent::RX_DONE);
+}
+
+// ACK payload (DownlinkGate): decrypted like a command payload when it is
+// long enough to be encrypted, plaintext otherwise
+bool readDownlinkHint(ValidateFrameResult& result, uint8_t* data, size_t dataLength, DownlinkHint& hint)
+{
+    if (!downlinkGate.enabled() || dataLength == 0) {
+        return false;
+    }
+    if (encryption.isInitialized() && dataLength > ENCRYPTION_OVERHEAD) {
+        uint8_t plaintext[dataLength];
+        size_t ptLen = 0;
+        cpuGovernor.enter(CpuPhase::CRYPTO);
+        bool decrypted = encryption.decryptFromWire(data, dataLength, result.frameType,
+                                                    result.sourceID, result.sequenceNumber, plaintext, &ptLen);
+        cpuGovernor.leave(CpuPhase::CRYPTO);
+        if (!decrypted) {
+            LOG_W("ACK payload failed to decrypt, downlink hint ignored");
+            return false;
+        }
+        return DownlinkGate::parse(plaintext, ptLen, hint);
+    }
+    return DownlinkGate::parse(data, dataLength, hint);
 }
 
 // ============================================================================
@@ -454,13 +944,17 @@ void onDataReceived(ValidateFrameResult& result, uint8_t* data, size_t dataLengt
 // ============================================================================
 void onTxComplete(bool success, size_t bytesSent, uint8_t packetCount)
 {
+    phaseTracer.stop(WakePhase::TX);
     unsigned long totalTxTime = powerManager.getTxTime();
+    uint32_t airtimeUs = DutyCycleBudget::frameUs(resonantRadio.getConfig(), bytesSent, packetCount);
+    dutyCycle.onTransmitted(airtimeUs);
 
     LOG_I("\n=== TX Complete ===");
     LOG_I("Success: %s", success ? "YES" : "NO");
     LOG_I("Bytes sent: %zu", bytesSent);
     LOG_I("Packets: %d", packetCount);
     LOG_I("Total TX time: %lu ms", totalTxTime);
+    LOG_I("Airtime: %lu.%03lu ms", (unsigned long)(airtimeUs / 1000), (unsigned long)(airtimeUs % 1000));
     LOG_I("Timestamp: %lu", millis());
 
     if (packetCount > 1) {
@@ -483,10 +977,22 @@ void onTxComplete(bool success, size_t bytesSent, uint8_t packetCount)
     switch (currentTxContext) {
         case TxContext::TELEMETRY:
             LOG_I("Telemetry transmission complete");
+            cycleRecord.tx = !success ? JournalTx::FAILED
+                           : telemetryAckRequired ? JournalTx::NO_ACK : JournalTx::SENT;
             framStorage.incrementTelemetrySinceMetrics();
+            if (batchInFlight && !telemetryAckRequired) {
+                batchInFlight = false;
+                if (success) {
+                    telemetryBatch.clear();
+                }
+            }
+            if (success && !telemetryAckRequired) {
+                reportFilter.onReported();
+            }
 
             if (telemetryAckRequired) {
                 LOG_I("Waiting for ACK...");
+                phaseTracer.start(WakePhase::ACK_RX);
                 powerManager.markRxStart();
                 resonantRadio.startRx(3000);
             } else {
@@ -502,23 +1008,27 @@ void onTxComplete(bool success, size_t bytesSent, uint8_t packetCount)
         case TxContext::METRICS:
             LOG_I("Metrics TX complete, listening for commands...");
             framStorage.addCycleFlag(CycleFlag::METRICS_SENT);
+            cycleRecord.flags |= JournalFlag::METRICS_SENT;
             framStorage.resetTelemetrySinceMetrics();
             powerManager.markRxStart();
+            commandWindowStartMs = millis();
             resonantRadio.startRx(framStorage.getWaitAfterTx());
             break;
         case TxContext::SETTINGS_REPORT:
             LOG_I("Settings report TX complete");
-            if (pendingRadioConfigApply) {
-                pendingRadioConfigApply = false;
-                resonantRadio.setConfig(pendingRadioConfig);
-                resonantRadio.applyConfig();
-                LOG_I("Deferred radio config applied after settings report");
-            }
+            applyStagedRadioConfig();
             powerManager.requestSleep();
             break;
         case TxContext::COMMAND_RESPONSE:
+            applyStagedRadioConfig();
             powerManager.requestSleep();
             break;
+        case TxContext::JOURNAL_PAGE:
+            if (journalPagesLeft == 0) {
+                applyStagedRadioConfig();
+                powerManager.requestSleep();
+            }
+            break;
         case TxContext::ACK:
             powerManager.requestSleep();
             break;
@@ -529,6 +1039,7 @@ void onTxComplete(bool success, size_t bytesSent, uint8_t packetCount)
             break;
         case TxContext::ADOPTION_ACCEPT:
             LOG_I("Adoption accept sent, sending initial metrics...");
+            metricsReport.requestFull();        // a new parent has no baseline
             powerManager.clearSleepRequest();
             powerManager.setWakeTimeout(10000);
             sendMetricsFrame();
@@ -537,6 +1048,7 @@ void onTxComplete(bool success, size_t bytesSent, uint8_t packetCount)
             powerManager.requestSleep();
             break;
     }
+    appEvents.post(AppEvent::TX_DONE);
 }
 
 // ============================================================================
@@ -548,18 +1060,23 @@ void onRadioError(uint8_t errorCode, const char* message)
 
     switch (errorCode) {
         case RADIO_ERROR_TX_TIMEOUT:
+            phaseTracer.stop(WakePhase::TX);
             framStorage.setLastTxStatus(TxStatus::TX_FAILED);
             powerManager.markRxComplete();
             powerManager.requestSleep();
             break;
         case RADIO_ERROR_RX_TIMEOUT:
+            phaseTracer.stop(WakePhase::ACK_RX);
             powerManager.markRxComplete();
-            if (currentTxContext == TxContext::TELEMETRY && framStorage.isAdopted()) {
+            batchInFlight = false;
+            if (currentTxContext == TxContext::TELEMETRY && !commandWindowOpen && framStorage.isAdopted()) {
                 framStorage.incrementAckFailCount();
                 framStorage.incrementAckFailTotal();
+                adrEngine.onAckTimeout();
                 if (framStorage.isConnectionLost()) {
                     LOG_W("Connection lost — clearing parent, will re-adopt next wake");
                     framStorage.clearParentID();
+                    warmContext.invalidate();
                 }
             }
             powerManager.requestSleep();
@@ -570,160 +1087,382 @@ void onRadioError(uint8_t errorCode, const char* message)
         default:
             break;
     }
+    appEvents.post(AppEvent::RADIO_ERROR);
 }
 
 // ============================================================================
-// Background Tasks (runs on Core 0)
+// Background Tasks (runs on RADIO_TASK_CORE, Core 0 by default)
 // ============================================================================
 void backgroundTasks(void *arg)
 {
-    LOG_I("Radio task started on Core 0");
-
-    RadioConfig config = ResonantLRRadio::getLoRaLongRangePreset();
-    LOG_I("Using LoRa Long Range preset (SF7/BW125)");
+    LOG_I("Radio task started on Core %d", xPortGetCoreID());
 
-    if (!resonantRadio.init(&resonantFrame, config)) {
-        LOG_E("Radio initialization failed on Core 0!");
+    bootScheduler.runCore(0);
+    if (!bootScheduler.succeeded(BootStep::RADIO)) {
         vTaskDelete(NULL);
         return;
     }
 
     LOG_I("Radio init complete, starting main radio loop");
-
-    while (true) {
-        resonantRadio.loop();
-        vTaskDelay(1);
-    }
+    radioTask.begin(&resonantRadio, &appEvents);
+    radioTask.run();
 }
 
 // ============================================================================
 // Callback: Sensor Data Ready
 // ============================================================================
-void onSensorDataReady(float temperatureC, bool contactClosed)
+void onSensorDataReady()
 {
-    lastTemperatureC = temperatureC;
-    lastContactClosed = contactClosed;
+    phaseTracer.stop(WakePhase::SENSOR_READ);
+    lastTemperatureC = tempSensor.temperatureC();
+    lastContactClosed = contactInput.closed();
     sensorDataReady = true;
+    appEvents.post(AppEvent::SENSOR_READY);
 }
 
 // ============================================================================
 // Telemetry Helper
 // ============================================================================
-void sendEncryptedTelemetry(const uint8_t* payload, size_t payloadLen, uint8_t parentId[4])
+void sendEncryptedTelemetry(const uint8_t* payload, size_t payloadLen, uint8_t parentId[4],
+                            uint8_t extraOptions)
+{
+    bool telemetryAckRequired = framStorage.settings().telemetryAckRequired != 0;
+    if (sendArenaFrame(resonantFrame.telemetryFrameType, payload, payloadLen,
+                       parentId, telemetryAckRequired, TxContext::TELEMETRY, extraOptions)) {
+        LOG_I("Sending %zu encrypted bytes (%zu plaintext)", txArena.payloadSize(), payloadLen);
+    }
+}
+
+// ============================================================================
+// Metrics Frame — live metrics region, as is or as a delta (MetricsReport)
+// ============================================================================
+void sendMetricsFrame(void)
 {
-    uint8_t sensorId[4];
-    getDeviceSensorId(sensorId);
+    uint8_t report[ResonantFRAMStorage::PAYLOAD_SIZE];
+    buildMetricsReport(report);
+
+    uint8_t payload[ResonantFRAMStorage::PAYLOAD_SIZE];
+    bool delta = false;
+    size_t payloadLen = metricsReport.build(report, payload, sizeof(payload), delta);
+
+    // Stays due (telemetrySinceMetrics is not reset) until the budget has room
+    size_t frameBytes = TxFrameArena::HEADER_SIZE + TxFrameArena::CHECKSUM_SIZE
+                      + ENCRYPTION_OVERHEAD + payloadLen;
+    if (!dutyCycle.allows(DutyCycleBudget::frameUs(resonantRadio.getConfig(), frameBytes))) {
+        LOG_W("Duty cycle: %lu of %lu ms used this hour, metrics deferred",
+              (unsigned long)dutyCycle.usedMs(), (unsigned long)dutyCycle.limitMs());
+        dutyCycle.onDeferred();
+        powerManager.requestSleep();
+        return;
+    }
 
-    uint32_t seq = framStorage.getNextTxSequenceNumber();
+    uint8_t destinationID[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t options = delta ? TelemetryFormat::OPTION_EXTENDED_PAYLOAD : 0;
+    bool ackRequired = metricsReport.enabled() || downlinkGate.enabled();
+    if (sendArenaFrame(resonantFrame.metricsFrameType, payload, payloadLen,
+                       destinationID, ackRequired, TxContext::METRICS, options)) {
+        LOG_I("Encrypted %s metrics frame sent (%zu bytes)", delta ? "delta" : "full",
+              txArena.payloadSize());
+        metricsReport.onSent(txArena.sequence());
+    }
+}
 
-    uint8_t* encPayload = nullptr;
-    size_t encLen = 0;
-    bool encrypted = encryption.isInitialized() &&
-                     encryption.encryptForWire(payload, payloadLen,
-                         resonantFrame.telemetryFrameType, sensorId, seq,
-                         &encPayload, &encLen);
+// ============================================================================
+// Journal Page — a Command Response to CMD_READ_JOURNAL carrying one page
+// ============================================================================
+void sendJournalPage(void)
+{
+    uint8_t payload[ResonantFRAMStorage::PAYLOAD_SIZE];
+    payload[0] = EventJournal::CMD_READ_JOURNAL;
+    payload[1] = ResonantFrame::CMD_RESPONSE_SUCCESS;
+    size_t pageLen = eventJournal.buildPage(journalNextPage, payload + 2, sizeof(payload) - 2);
+    journalPagesLeft--;
+
+    size_t frameBytes = TxFrameArena::HEADER_SIZE + TxFrameArena::CHECKSUM_SIZE
+                      + ENCRYPTION_OVERHEAD + 2 + pageLen;
+    if (pageLen == 0 || !dutyCycle.allows(DutyCycleBudget::frameUs(resonantRadio.getConfig(), frameBytes))) {
+        LOG_W("Journal page %u not sent (%s)", journalNextPage, pageLen == 0 ? "past the end" : "duty cycle");
+        if (pageLen != 0) dutyCycle.onDeferred();
+        journalPagesLeft = 0;
+        powerManager.requestSleep();
+        return;
+    }
 
-    uint8_t* txData = encrypted ? encPayload : const_cast<uint8_t*>(payload);
-    size_t txLen = encrypted ? encLen : payloadLen;
+    powerManager.extendWakeTimeout(framStorage.settings().telemetryMaxWake);
+    if (sendArenaFrame(resonantFrame.commandResponseFrameType, payload, 2 + pageLen,
+                       journalDestination, false, TxContext::JOURNAL_PAGE)) {
+        LOG_I("Journal page %u sent (%u records, %zu bytes)", journalNextPage,
+              payload[2 + 4], txArena.payloadSize());
+    }
+    journalNextPage++;
+}
 
-    if (encrypted) {
-        LOG_I("Sending %zu encrypted bytes (%zu plaintext)", encLen, payloadLen);
-    } else {
-        LOG_W("Encryption unavailable, sending plaintext");
+// The metrics region as it stands now, built from the library's RAM map and
+// the live sensor tail. FRAM lags both until the next flushStorage(), so this
+// costs no flush and no region read-back.
+void buildMetricsReport(uint8_t* report)
+{
+    auto be16 = [report](size_t at, uint16_t v) {
+        report[at] = (uint8_t)(v >> 8);
+        report[at + 1] = (uint8_t)v;
+    };
+    auto be32 = [be16](size_t at, uint32_t v) {
+        be16(at, (uint16_t)(v >> 16));
+        be16(at + 2, (uint16_t)v);
+    };
+    const MetricsMap& m = framStorage.metrics();
+    memset(report, 0, ResonantFRAMStorage::PAYLOAD_SIZE);
+    report[0] = m.metricsVersion;
+    report[1] = FIRMWARE_VERSION;
+    report[2] = HARDWARE_VERSION;
+    report[3] = SENSOR_TYPE;
+    be16(4, m.batteryVoltage);
+    be32(6, m.totalTxTime);
+    be32(10, m.totalRxTime);
+    be32(14, m.totalActiveTime);
+    be32(18, m.totalSleepTime);
+    be32(22, m.cycleCount);
+    be32(26, m.txCount);
+    report[30] = m.ackFailCount;
+    be16(31, m.ackFailTotal);
+    be16(33, m.telemetrySinceMetrics);
+    be16(35, m.bootCount);
+    be32(37, m.totalEnergy);
+    if (sensorStore.isInitialized()) {
+        memcpy(report + SensorMetrics::REGION_OFFSET,
+               sensorStore.data(SensorRegion::METRICS), SensorMetrics::SIZE);
     }
+}
 
-    bool telemetryAckRequired = framStorage.settings().telemetryAckRequired != 0;
-    uint8_t opts = ResonantFrame::buildOptionsV1(telemetryAckRequired);
-    FrameData frame = resonantFrame.buildTelemetryFrame(
-        txData, txLen, parentId, opts, seq);
-    currentTxContext = TxContext::TELEMETRY;
-    resonantRadio.send(frame.frame, frame.size, parentId, telemetryAckRequired);
-    delete[] frame.frame;
-    if (encrypted) {
-        delete[] encPayload;
+// The settings region needs no flush first: every applySettingsFromWire() is
+// followed by flushStorage(), so FRAM only lags in parentID (adoption and
+// connection loss set it without one) and in the sensor tail
+void buildSettingsPayload(uint8_t* payload)
+{
+    framStorage.preparePayloads();
+    memcpy(payload, framStorage.getSettingsPayload(), ResonantFRAMStorage::PAYLOAD_SIZE);
+    memcpy(payload + SETTINGS_PARENT_ID, framStorage.settings().parentID, 4);
+    if (sensorStore.isInitialized()) {
+        memcpy(payload + SensorSettings::REGION_OFFSET,
+               sensorStore.data(SensorRegion::SETTINGS), SensorSettings::SIZE);
     }
 }
 
 // ============================================================================
-// Metrics Frame — reads directly from FRAM metrics region
+// Send Settings Report Frame
 // ============================================================================
-void sendMetricsFrame(void)
+void sendSettingsFrame(void)
 {
-    framStorage.flush();
-    framStorage.preparePayloads();
-
-    const uint8_t* metricsData = framStorage.getMetricsPayload();
-    size_t metricsLen = ResonantFRAMStorage::PAYLOAD_SIZE;
+    uint8_t payload[ResonantFRAMStorage::PAYLOAD_SIZE];
+    buildSettingsPayload(payload);
 
     uint8_t destinationID[4] = {0xFF, 0xFF, 0xFF, 0xFF};
-    uint8_t* encPayload = nullptr;
-    size_t encLen = 0;
+    if (sendArenaFrame(resonantFrame.configAdvertisementFrameType, payload, sizeof(payload),
+                       destinationID, false, TxContext::SETTINGS_REPORT)) {
+        LOG_I("Encrypted settings report sent (%zu bytes)", txArena.payloadSize());
+    }
+}
 
-    uint8_t metricsOpts = ResonantFrame::buildOptionsV1(false);
-    uint8_t metricsSensorId[4];
-    getDeviceSensorId(metricsSensorId);
+// ============================================================================
+// Arena TX — header template + in-place GCM, no heap allocation
+// ============================================================================
+bool sendArenaFrame(uint8_t frameType, const uint8_t* payload, size_t payloadLen,
+                    uint8_t destinationID[4], bool ackRequired, TxContext context,
+                    uint8_t extraOptions)
+{
+    uint8_t options = ResonantFrame::buildOptionsV1(ackRequired) | extraOptions;
+    txArena.setHeader(frameType, destinationID, options);
     uint32_t seq = framStorage.getNextTxSequenceNumber();
 
-    if (encryption.isInitialized() &&
-        encryption.encryptForWire(metricsData, metricsLen,
-                       resonantFrame.metricsFrameType, metricsSensorId, seq,
-                       &encPayload, &encLen)) {
-        FrameData metricsFrame = resonantFrame.buildMetricsFrame(
-            encPayload, encLen, destinationID, metricsOpts, seq);
-        currentTxContext = TxContext::METRICS;
-        resonantRadio.send(metricsFrame.frame, metricsFrame.size);
-        delete[] metricsFrame.frame;
-        delete[] encPayload;
-        LOG_I("Encrypted metrics frame sent (%zu bytes)", encLen);
-    } else {
-        FrameData metricsFrame = resonantFrame.buildMetricsFrame(
-            const_cast<uint8_t*>(metricsData), metricsLen,
-            destinationID, metricsOpts, seq);
-        currentTxContext = TxContext::METRICS;
-        resonantRadio.send(metricsFrame.frame, metricsFrame.size);
-        delete[] metricsFrame.frame;
+    cpuGovernor.enter(CpuPhase::CRYPTO);
+    bool encrypted = txArena.buildEncrypted(payload, payloadLen, seq);
+    cpuGovernor.leave(CpuPhase::CRYPTO);
+    if (!encrypted) {
+        LOG_W("Encryption unavailable, sending plaintext");
+        if (!txArena.buildPlain(payload, payloadLen, seq)) {
+            LOG_E("Frame too large for arena: %zu bytes", payloadLen);
+            return false;
+        }
     }
+
+    currentTxContext = context;
+    phaseTracer.start(WakePhase::TX);
+    resonantRadio.send(txArena.frame(), txArena.size(), destinationID, ackRequired);
+    radioTask.kick();
+    return encrypted;
 }
 
 // ============================================================================
-// Send Settings Report Frame
+// Storage Flush — library regions first, then the sensor-specific tails
 // ============================================================================
-void sendSettingsFrame(void)
+void flushStorage()
 {
+    cpuGovernor.enter(CpuPhase::FLUSH);
     framStorage.flush();
-    framStorage.preparePayloads();
+    sensorStore.onLibraryFlush();
+    sensorStore.flush();
+    cpuGovernor.leave(CpuPhase::FLUSH);
+}
 
-    const uint8_t* settingsData = framStorage.getSettingsPayload();
-    size_t settingsLen = ResonantFRAMStorage::PAYLOAD_SIZE;
+// ============================================================================
+// Pre-Sleep Flush — timed; the trace bytes it produces go out in one more burst.
+// Only now, with the wake's last write done, do its FRAM stats replace the
+// previous wake's in RTC memory; accumulateMetricsBeforeSleep() has reported
+// those by then.
+// ============================================================================
+void flushBeforeSleep()
+{
+    phaseTracer.start(WakePhase::FINAL_FLUSH);
+    flushStorage();
+    phaseTracer.stop(WakePhase::FINAL_FLUSH);
+    sensorStore.flush();
+    lastCycleFramStats = sensorStore.stats();
+}
 
-    uint8_t destinationID[4] = {0xFF, 0xFF, 0xFF, 0xFF};
-    uint8_t* encPayload = nullptr;
-    size_t encLen = 0;
+// The conversions bootSensor() started have been running through boot;
+// wait out whatever is left of them
+void waitForSensorPipeline()
+{
+    if (!sensorPipeline.isBusy()) return;
+    phaseTracer.start(WakePhase::SENSOR_READ);
+    cpuGovernor.enter(CpuPhase::SENSOR_IO);
+    sensorPipeline.loop();
+    while (sensorPipeline.isBusy()) {
+        delay(1);
+        sensorPipeline.loop();
+    }
+    cpuGovernor.leave(CpuPhase::SENSOR_IO);
+}
 
-    uint8_t opts = ResonantFrame::buildOptionsV1(false);
-    uint8_t sensorId[4];
-    getDeviceSensorId(sensorId);
-    uint32_t seq = framStorage.getNextTxSequenceNumber();
+// Every path into deep sleep puts the SX1262 to sleep here. Cold sleep: the
+// next wake that transmits runs a full ResonantLRRadio::init(). With
+// wake-on-radio the chip sniffs for commands instead.
+void sleepRadio()
+{
+    if (resonantRadio.radioInitialized && wakeOnRadio.enabled() && framStorage.isAdopted()) {
+        RadioConfig config = resonantRadio.getConfig();
+        if (config.modem == MODEM_LORA_MODE
+            && wakeOnRadio.arm(resonantRadio, config.loraSpreadingFactor, config.loraBandwidth)) {
+            return;
+        }
+        LOG_W("Wake-on-radio: sniff not armed, radio to sleep");
+    }
+    resonantRadio.deepSleep();
+}
 
-    if (encryption.isInitialized() &&
-        encryption.encryptForWire(settingsData, settingsLen,
-                       resonantFrame.configAdvertisementFrameType, sensorId, seq,
-                       &encPayload, &encLen)) {
-        FrameData frame = resonantFrame.buildConfigAdvertisementFrame(
-            encPayload, encLen, destinationID, opts, seq);
-        currentTxContext = TxContext::SETTINGS_REPORT;
-        resonantRadio.send(frame.frame, frame.size);
-        delete[] frame.frame;
-        delete[] encPayload;
-        LOG_I("Encrypted settings report sent (%zu bytes)", encLen);
-    } else {
-        FrameData frame = resonantFrame.buildConfigAdvertisementFrame(
-            const_cast<uint8_t*>(settingsData), settingsLen,
-            destinationID, opts, seq);
-        currentTxContext = TxContext::SETTINGS_REPORT;
-        resonantRadio.send(frame.frame, frame.size);
-        delete[] frame.frame;
+void setSleepDuration(uint32_t seconds)
+{
+    sleepDurationS = seconds;
+    powerManager.setSleepDuration(seconds);
+}
+
+// Deep sleep, or light sleep while the SX1262 sniffs if sleepRadio() (this
+// wake or an earlier one that left it sniffing) armed wake-on-radio. The
+// light sleep ends in a reboot, so this never returns.
+void enterSleep()
+{
+    ResonantLog::flush();
+    if (bootError == 0 && framStorage.isAdopted() && wakeOnRadio.armed()) {
+        if (bootScheduler.succeeded(BootStep::RADIO)
+            && xTaskGetCurrentTaskHandle() != backgroundTask) {
+            vTaskSuspend(backgroundTask);
+        }
+        uint8_t deviceId[4];
+        getDeviceSensorId(deviceId);
+        wakeOnRadio.sleep(resonantRadio, sleepDurationS, deviceId);
     }
+    powerManager.goToSleep();
+}
+
+// ============================================================================
+// Wake-on-Radio Command Wake — the frame that ended the sniff is handled as
+// if it had just been received
+// ============================================================================
+void dispatchSniffedFrame()
+{
+    uint8_t frame[WorSniffer::MAX_FRAME];
+    size_t len = 0;
+    int16_t rssi = 0;
+    int8_t snr = 0;
+    if (!wakeOnRadio.takeFrame(frame, &len, &rssi, &snr)) {
+        LOG_W("Wake-on-radio: no frame kept, back to sleep");
+        powerManager.requestSleep();
+        return;
+    }
+
+    // WorSniffer::addressedTo() checked the header and checksum
+    ValidateFrameResult result = {};
+    memcpy(result.sourceID, frame + 3, 4);
+    result.frameType = frame[11];
+    result.options = frame[12];
+    result.sequenceNumber = (uint32_t)frame[13] << 24 | (uint32_t)frame[14] << 16
+                          | (uint32_t)frame[15] << 8 | frame[16];
+    result.totalPackets = frame[17];
+    onDataReceived(result, frame + WorSniffer::FRAME_HEADER_SIZE,
+                   len - WorSniffer::FRAME_HEADER_SIZE - 1, rssi, snr);
+}
+
+// ============================================================================
+// Sample-Only Wake — queue a reading for the next batch (or drop a quiet
+// report-by-exception reading) and sleep, radio off
+// ============================================================================
+void runSampleOnlyWake()
+{
+    waitForSensorPipeline();
+
+    if (sensorDataReady) {
+        sensorDataReady = false;
+        if (telemetryBatch.enabled()) {
+            telemetryBatch.append(tempSensor.lastRawCount, lastContactClosed);
+            LOG_I("Queued reading %u/%u: %.2f C, contact %s (radio off)",
+                  telemetryBatch.count(), telemetryBatch.batchSize(),
+                  lastTemperatureC, lastContactClosed ? "CLOSED" : "OPEN");
+        } else if (airtimeDeferred) {
+            LOG_I("Deferred wake: %.2f C, contact %s not sent (radio off)",
+                  lastTemperatureC, lastContactClosed ? "CLOSED" : "OPEN");
+        } else {
+            reportFilter.onSuppressed();
+            LOG_I("Quiet wake: %.2f C, contact %s within deadband (radio off)",
+                  lastTemperatureC, lastContactClosed ? "CLOSED" : "OPEN");
+        }
+    }
+
+    accumulateMetricsBeforeSleep();
+    flushBeforeSleep();
+    sensorPipeline.shutdown();
+    enterSleep();
+}
+
+// ============================================================================
+// Crypto Credentials — parsed at most once per wake, on demand when warm
+// ============================================================================
+uint32_t credentialsFingerprint()
+{
+    uint32_t crc = WarmContext::fingerprint(device_key_der, device_key_der_len);
+    crc = WarmContext::fingerprint(device_cert_der, device_cert_der_len, crc);
+    return WarmContext::fingerprint(resonant_ca_cert_der, resonant_ca_cert_der_len, crc);
+}
+
+bool ensureCryptoCredentials()
+{
+    if (cryptoCredentialsLoaded) {
+        return true;
+    }
+
+    bool ok = true;
+    if (device_key_der_len > 0 && device_cert_der_len > 0
+        && encryption.loadDeviceCredentials(device_key_der, device_key_der_len,
+                                            device_cert_der, device_cert_der_len)) {
+        LOG_I("Provisioned device credentials loaded");
+    } else { ok = false; }
+
+    if (resonant_ca_cert_der_len > 0
+        && encryption.loadCACertBundle(resonant_ca_cert_der, resonant_ca_cert_der_len)) {
+        LOG_I("Root CA certificate loaded");
+    } else { ok = false; }
+
+    cryptoCredentialsLoaded = ok;
+    return ok;
 }
 
 // ============================================================================
@@ -733,6 +1472,7 @@ void updateBatteryVoltage()
 {
     uint16_t rawCV = (uint16_t)(powerManager.getBatteryVoltage() * 100);
     framStorage.setRawBatteryVoltage(rawCV);
+    cycleRecord.batteryCentivolts = rawCV;
 
     uint16_t storedCV = framStorage.metrics().batteryVoltage;
 
@@ -754,11 +1494,78 @@ void accumulateMetricsBeforeSleep()
     framStorage.addTxTime(powerManager.getTxTime());
     framStorage.addRxTime(powerManager.getRxTime());
     framStorage.addActiveTime(powerManager.getIdleTime());
-    framStorage.addEnergy((uint32_t)powerManager.getTotalEnergy_uWh());
 
+    // The library charges the whole wake at the full-clock MCU current; the
+    // governor's time below full clock comes off its total
+    reportCpuTime();
+    float energy = powerManager.getTotalEnergy_uWh();
+    float saved = (float)cpuGovernor.saved_uWh(EspCpuClock::SUPPLY_V);
+    energy = energy > saved ? energy - saved : 0.0f;
+    framStorage.addEnergy((uint32_t)energy);
+
+    if (sensorStore.isInitialized() && lastCycleFramStats.libraryFlushes > 0) {
+        const FramStats& f = lastCycleFramStats;
+        sensorStore.put16(SensorRegion::METRICS, SensorMetrics::FRAM_WRITE_BURSTS, f.writeBursts);
+        sensorStore.put16(SensorRegion::METRICS, SensorMetrics::FRAM_BYTES_WRITTEN, f.bytesWritten);
+        sensorStore.put8(SensorRegion::METRICS, SensorMetrics::FRAM_LIBRARY_FLUSHES, f.libraryFlushes);
+        uint32_t total = sensorStore.get32(SensorRegion::METRICS, SensorMetrics::FRAM_TOTAL_BYTES);
+        sensorStore.put32(SensorRegion::METRICS, SensorMetrics::FRAM_TOTAL_BYTES, total + f.bytesWritten);
+        LOG_I("FRAM last cycle: %u bursts, %u bytes, %u library flushes",
+              f.writeBursts, f.bytesWritten, f.libraryFlushes);
+        lastCycleFramStats = FramStats();
+    }
+
+    if (sensorStore.isInitialized() && appEvents.lightSleepCount() > 0) {
+        uint32_t total = sensorStore.get32(SensorRegion::METRICS, SensorMetrics::LIGHT_SLEEP_TIME);
+        sensorStore.put32(SensorRegion::METRICS, SensorMetrics::LIGHT_SLEEP_TIME,
+                          total + appEvents.lightSleepMs());
+        LOG_I("Light sleep: %lu ms in %lu slices", (unsigned long)appEvents.lightSleepMs(),
+              (unsigned long)appEvents.lightSleepCount());
+    }
+    if (radioTask.wakeups() > 0) {
+        LOG_I("Radio task: %lu passes, %lu DIO1 interrupts", (unsigned long)radioTask.wakeups(),
+              (unsigned long)radioTask.dio1Irqs());
+    }
+
+    appendJournalRecord();
+    phaseTracer.log();
     powerManager.printEnergyReport();
 }
 
+// This wake's event journal entry. Flags not set as they happened are
+// filled in here.
+void appendJournalRecord()
+{
+    if (!eventJournal.isInitialized()) return;
+    if (bootError != 0) cycleRecord.flags |= JournalFlag::BOOT_ERROR;
+    if (sampleOnlyWake) cycleRecord.flags |= JournalFlag::RADIO_OFF;
+    if (airtimeDeferred) cycleRecord.tx = JournalTx::DEFERRED;
+    uint32_t awake = millis();
+    cycleRecord.awakeMs = awake > UINT16_MAX ? UINT16_MAX : (uint16_t)awake;
+    eventJournal.append(cycleRecord);
+    LOG_I("Journal: cycle %u, wake %u, tx %u, flags 0x%02X (%u records)", cycleRecord.cycle,
+          (unsigned)cycleRecord.wake, (unsigned)cycleRecord.tx, cycleRecord.flags, eventJournal.count());
+}
+
+// CpuGovernor time at each frequency, overall and per phase
+void reportCpuTime()
+{
+    cpuGovernor.settle();
+    for (uint8_t l = 0; l < CpuGovernor::LEVEL_COUNT; l++) {
+        CpuLevel level = (CpuLevel)l;
+        uint32_t ms = (uint32_t)(cpuGovernor.levelUs(level) / 1000);
+        if (ms == 0) continue;
+        LOG_I("CPU %u MHz: %lu ms", CpuGovernor::LEVEL_MHZ[l], (unsigned long)ms);
+        for (uint8_t p = 0; p < CpuGovernor::PHASE_COUNT; p++) {
+            uint32_t phaseMs = (uint32_t)(cpuGovernor.phaseUs((CpuPhase)p, level) / 1000);
+            if (phaseMs == 0) continue;
+            LOG_D("  %s: %lu ms", CpuGovernor::phaseName((CpuPhase)p), (unsigned long)phaseMs);
+        }
+    }
+    LOG_I("CPU governor: %lu switches, %.1f uWh saved against full clock",
+          (unsigned long)cpuGovernor.transitions(), cpuGovernor.saved_uWh(EspCpuClock::SUPPLY_V));
+}
+
 // ============================================================================
 // Device Identity Helper
 // ============================================================================
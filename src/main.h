@@ -10,7 +10,27 @@
 #include "resonant_encryption.h"
 #include "resonant_log.h"
 #include "adoption_handler.h"
+#include "tx_frame_arena.h"
+#include "sensor_region_store.h"
+#include "telemetry_batch.h"
+#include "report_filter.h"
+#include "adr_engine.h"
+#include "duty_cycle_budget.h"
+#include "metrics_report.h"
+#include "settings_fields.h"
+#include "downlink_gate.h"
+#include "wake_on_radio.h"
+#include "phase_tracer.h"
+#include "warm_context.h"
+#include "boot_scheduler.h"
+#include "app_event_loop.h"
+#include "cpu_clock.h"
+#include "radio_task.h"
+#include "fram_journal.h"
+#include "SensorPipeline.h"
+#include "ContactChannel.h"
 #include "Sensor.h"
+#include "SHTC3Sensor.h"
 #include "MB85RS64V.h"
 #include "certs/resonant_ca_cert.h"
 #include "certs/device_credentials.h"
@@ -24,6 +44,9 @@ constexpr uint8_t SENSOR_TYPE = 0x01;
 
 constexpr size_t ENCRYPTION_OVERHEAD = ResonantEncryption::WIRE_OVERHEAD;
 
+// parentID in the settings region (FRAM_MEMORY_MAP.md section 1)
+constexpr size_t SETTINGS_PARENT_ID = 19;
+
 // Voltage delta threshold for battery swap detection (centivolts)
 constexpr uint16_t BATTERY_SWAP_DELTA_CV = 30;
 
@@ -36,7 +59,27 @@ inline ResonantPowerManager powerManager;
 inline ResonantFRAMStorage framStorage;
 inline ResonantEncryption encryption;
 inline DeviceAdoptionHandler adoptionHandler;
-inline TMP112Sensor tempSensor;
+inline TxFrameArena txArena;
+inline SensorRegionStore sensorStore;
+inline TelemetryBatch telemetryBatch;
+inline ReportFilter reportFilter;
+inline AdrEngine adrEngine;
+inline DutyCycleBudget dutyCycle;
+inline MetricsReport metricsReport;
+inline DownlinkGate downlinkGate;
+inline WakeOnRadio wakeOnRadio;
+inline PhaseTracer phaseTracer;
+inline WarmContext warmContext;
+inline BootScheduler bootScheduler;
+inline AppEventLoop appEvents;
+inline EspCpuClock cpuClock;
+inline CpuGovernor cpuGovernor;
+inline FramJournalStorage framJournal;
+inline EventJournal eventJournal;
+inline SensorPipeline sensorPipeline;
+inline TMP112Sensor tempSensor(0x48);
+inline ContactChannel contactInput(14);
+inline SHTC3Sensor humiditySensor;      // optional, fitted on multi-sensor SKUs
 inline SPIClass framSPI(HSPI);
 inline MB85RS64V fram;
 
@@ -46,19 +89,52 @@ inline MB85RS64V fram;
 inline volatile bool transmissionComplete = false;
 inline volatile bool sensorDataReady = false;
 inline volatile bool pendingSettingsReport = false;
+inline volatile bool pendingMetricsReport = false;
 inline volatile bool pendingRadioConfigApply = false;
+inline volatile bool batchInFlight = false;
 inline RadioConfig pendingRadioConfig;
 inline float lastTemperatureC = 0.0f;
 inline bool lastContactClosed = false;
-
+inline uint32_t commandWindowStartMs = 0;
+inline volatile bool commandWindowOpen = false;     // listening for commands after a telemetry ACK
+
+inline bool cryptoCredentialsLoaded = false;
+inline uint16_t bootError = 0;
+inline esp_reset_reason_t resetReason = ESP_RST_UNKNOWN;
+inline bool sampleOnlyWake = false;
+inline bool airtimeDeferred = false;
 inline bool firstBoot = true;
 inline bool interruptWake = false;
 inline bool contactWake = false;
+inline bool radioWake = false;          // wake-on-radio: a command frame ended the sleep
+inline uint32_t sleepDurationS = 5;     // what powerManager was last given
+inline JournalRecord cycleRecord;       // this wake's event journal entry, appended before sleep
+
+// CMD_READ_JOURNAL: pages still to send, one Command Response frame each
+inline uint8_t journalNextPage = 0;
+inline uint8_t journalPagesLeft = 0;
+inline uint8_t journalDestination[4];
+
+// ============================================================================
+// Core 1 State Machine
+// ============================================================================
+constexpr uint32_t APP_RECHECK_MS = 100;    // longest wait without an event (wake timeout check)
+constexpr uint32_t REPLY_GAP_MS = 50;       // radio idle to a queued report going out
+
+inline AppState appState = AppState::SAMPLING;
+inline uint32_t replyAtMs = 0;
+
+void setAppState(AppState next);
+uint32_t appWaitMs();
+bool telemetryDue();
+void sendTelemetryReading();
+void sendQueuedReport();
 
 // ============================================================================
 // Background Tasks
 // ============================================================================
 inline TaskHandle_t backgroundTask;
+inline RadioTask radioTask;
 void backgroundTasks(void *arg);
 
 // ============================================================================
@@ -67,21 +143,59 @@ void backgroundTasks(void *arg);
 void onDataReceived(ValidateFrameResult& result, uint8_t* data, size_t dataLength, int16_t rssi, int8_t snr);
 void onTxComplete(bool success, size_t bytesSent, uint8_t packetCount);
 void onRadioError(uint8_t errorCode, const char* message);
-void onSensorDataReady(float temperatureC, bool contactClosed);
-void sendEncryptedTelemetry(const uint8_t* payload, size_t payloadLen, uint8_t parentId[4]);
+void onSensorDataReady();
+void sendEncryptedTelemetry(const uint8_t* payload, size_t payloadLen, uint8_t parentId[4],
+                            uint8_t extraOptions = 0);
 void sendMetricsFrame(void);
 void sendSettingsFrame(void);
+void buildMetricsReport(uint8_t* report);
+void buildSettingsPayload(uint8_t* payload);
+void sendJournalPage(void);
+bool sendArenaFrame(uint8_t frameType, const uint8_t* payload, size_t payloadLen,
+                    uint8_t destinationID[4], bool ackRequired, TxContext context,
+                    uint8_t extraOptions = 0);
 
 // ============================================================================
 // Command Processing
 // ============================================================================
 void handleCommand(uint8_t commandId, uint8_t* params, size_t paramsLength, uint8_t sourceID[4]);
+bool readDownlinkHint(ValidateFrameResult& result, uint8_t* data, size_t dataLength, DownlinkHint& hint);
+void stageRadioConfig();
+void applyStagedRadioConfig();
 
 // ============================================================================
 // Device Identity Helper
 // ============================================================================
 void getDeviceSensorId(uint8_t* sensorId);
 
+// ============================================================================
+// Boot Steps
+// ============================================================================
+namespace BootStep {
+    constexpr uint8_t SENSOR  = 0;
+    constexpr uint8_t FRAM    = 1;
+    constexpr uint8_t STORAGE = 2;
+    constexpr uint8_t PLAN    = 3;
+    constexpr uint8_t RADIO   = 4;      // Core 0
+    constexpr uint8_t CRYPTO  = 5;
+}
+
+bool bootSensor();
+bool bootFram();
+bool bootStorage();
+bool bootPlan();
+bool bootRadio();
+bool bootCrypto();
+void recordBootCriticalPath();
+void applySensorConfig();
+RadioConfig plannedRadioConfig();
+
+// ============================================================================
+// Crypto Credentials
+// ============================================================================
+uint32_t credentialsFingerprint();
+bool ensureCryptoCredentials();
+
 // ============================================================================
 // Battery Voltage Filtering
 // ============================================================================
@@ -91,6 +205,20 @@ void updateBatteryVoltage();
 // Pre-Sleep Accumulation
 // ============================================================================
 void accumulateMetricsBeforeSleep();
+void reportCpuTime();
+void appendJournalRecord();
+
+// ============================================================================
+// Storage / Batched Telemetry
+// ============================================================================
+void flushStorage();
+void flushBeforeSleep();
+void sleepRadio();
+void setSleepDuration(uint32_t seconds);
+void enterSleep();
+void dispatchSniffedFrame();
+void waitForSensorPipeline();
+void runSampleOnlyWake();
 
 namespace BootError {
     constexpr uint16_t STORAGE    = (1 << 0);
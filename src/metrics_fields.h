@@ -0,0 +1,59 @@
+#ifndef METRICS_FIELDS_H
+#define METRICS_FIELDS_H
+
+#include <MetricsDelta.h>
+#include "sensor_layout.h"
+
+// ============================================================================
+// Metrics Delta Field Table
+// ============================================================================
+// Fields of the 207-byte metrics report a delta report may carry, in bitmap
+// order. Universal offsets follow MetricsMap (FRAM_MEMORY_MAP.md section 3),
+// sensor offsets are SensorMetrics + REGION_OFFSET. Append only: gateways
+// decode with the table of the firmware version in the baseline report.
+// Host-compilable, shared with the native simulation.
+namespace MetricsFields {
+    constexpr uint8_t tail(uint16_t off) { return (uint8_t)(SensorMetrics::REGION_OFFSET + off); }
+
+    inline constexpr MetricsDelta::Field TABLE[] = {
+        // Universal
+        {0, 1}, {1, 1}, {2, 1}, {3, 1},         // metricsVersion, firmware, hardware, sensorType
+        {4, 2},                                 // batteryVoltage
+        {6, 4}, {10, 4}, {14, 4}, {18, 4},      // totalTxTime, totalRxTime, totalActiveTime, totalSleepTime
+        {22, 4}, {26, 4},                       // cycleCount, txCount
+        {30, 1}, {31, 2},                       // ackFailCount, ackFailTotal
+        {33, 2}, {35, 2},                       // telemetrySinceMetrics, bootCount
+        {37, 4},                                // totalEnergy
+
+        // Sensor type 0x01
+        {tail(SensorMetrics::FRAM_WRITE_BURSTS), 2},
+        {tail(SensorMetrics::FRAM_BYTES_WRITTEN), 2},
+        {tail(SensorMetrics::FRAM_LIBRARY_FLUSHES), 1},
+        {tail(SensorMetrics::FRAM_TOTAL_BYTES), 4},
+        {tail(SensorMetrics::PHASE_LATEST + 0), 2},  {tail(SensorMetrics::PHASE_LATEST + 2), 2},
+        {tail(SensorMetrics::PHASE_LATEST + 4), 2},  {tail(SensorMetrics::PHASE_LATEST + 6), 2},
+        {tail(SensorMetrics::PHASE_LATEST + 8), 2},  {tail(SensorMetrics::PHASE_LATEST + 10), 2},
+        {tail(SensorMetrics::PHASE_LATEST + 12), 2}, {tail(SensorMetrics::PHASE_LATEST + 14), 2},
+        {tail(SensorMetrics::PHASE_WORST + 0), 2},   {tail(SensorMetrics::PHASE_WORST + 2), 2},
+        {tail(SensorMetrics::PHASE_WORST + 4), 2},   {tail(SensorMetrics::PHASE_WORST + 6), 2},
+        {tail(SensorMetrics::PHASE_WORST + 8), 2},   {tail(SensorMetrics::PHASE_WORST + 10), 2},
+        {tail(SensorMetrics::PHASE_WORST + 12), 2},  {tail(SensorMetrics::PHASE_WORST + 14), 2},
+        {tail(SensorMetrics::BOOT_READY_TIME), 2},
+        {tail(SensorMetrics::BOOT_CRITICAL_PATH), 1},
+        {tail(SensorMetrics::SUPPRESSED_REPORTS), 2},
+        {tail(SensorMetrics::ADR_STEP), 1},
+        {tail(SensorMetrics::ADR_LAST_MARGIN), 1},
+        {tail(SensorMetrics::AIRTIME_LAST_FRAME), 2},
+        {tail(SensorMetrics::AIRTIME_MAX_FRAME), 2},
+        {tail(SensorMetrics::AIRTIME_TOTAL), 4},
+        {tail(SensorMetrics::DUTY_DEFERRED), 2},
+        {tail(SensorMetrics::RX_SAVED_TIME), 4},
+        {tail(SensorMetrics::WINDOWS_SKIPPED), 2},
+        {tail(SensorMetrics::WOR_WAKES), 2},
+        {tail(SensorMetrics::WOR_FALSE_WAKES), 2},
+        {tail(SensorMetrics::LIGHT_SLEEP_TIME), 4},
+    };
+    constexpr uint8_t COUNT = sizeof(TABLE) / sizeof(TABLE[0]);
+}
+
+#endif // METRICS_FIELDS_H
@@ -0,0 +1,107 @@
+#include "metrics_report.h"
+
+void MetricsReport::init(SensorRegionStore* store, MB85RS64V* fram) {
+    _store = store;
+    _fram = fram;
+    _awaitingAck = false;
+}
+
+uint8_t MetricsReport::fullEvery() const {
+    if (_store == nullptr || !_store->isInitialized()) return 0;
+    uint8_t n = _store->get8(SensorRegion::SETTINGS, SensorSettings::METRICS_FULL_EVERY);
+    return n == 0xFF ? 0 : n;
+}
+
+bool MetricsReport::loadBaseline(uint8_t* report, uint32_t* sequence) {
+    uint8_t header[BASELINE_HEADER];
+    _fram->read(BASELINE_ADDR, header, sizeof(header));
+    _store->stats().bytesRead += sizeof(header);
+    if ((uint16_t)(header[0] << 8 | header[1]) != BASELINE_MAGIC) {
+        return false;
+    }
+    *sequence = (uint32_t)header[2] << 24 | (uint32_t)header[3] << 16
+              | (uint32_t)header[4] << 8 | header[5];
+    _fram->read(BASELINE_ADDR + BASELINE_HEADER, report, REPORT_SIZE);
+    _store->stats().bytesRead += REPORT_SIZE;
+    return true;
+}
+
+size_t MetricsReport::build(const uint8_t* report, uint8_t* out, size_t outLen, bool& delta) {
+    delta = false;
+    memcpy(_built, report, REPORT_SIZE);
+    _builtDelta = false;
+
+    uint8_t n = fullEvery();
+    if (n > 1) {
+        uint8_t sinceFull = _store->get8(SensorRegion::SCRATCHPAD, BASE);
+        uint8_t flags = _store->get8(SensorRegion::SCRATCHPAD, BASE + 1);
+        uint8_t baseline[REPORT_SIZE];
+        uint32_t baseSequence = 0;
+        if (!(flags & FLAG_FORCE_FULL) && sinceFull + 1 < n && loadBaseline(baseline, &baseSequence)) {
+            size_t len = MetricsDelta::encode(MetricsFields::TABLE, MetricsFields::COUNT,
+                                              baseline, report, REPORT_SIZE,
+                                              baseSequence, out, outLen);
+            if (len > 0 && len < REPORT_SIZE) {
+                LOG_I("Metrics delta against seq %lu: %zu bytes", (unsigned long)baseSequence, len);
+                _builtDelta = delta = true;
+                return len;
+            }
+            LOG_I("Metrics delta not possible, sending full report");
+        }
+    }
+
+    if (outLen < REPORT_SIZE) return 0;
+    memcpy(out, report, REPORT_SIZE);
+    return REPORT_SIZE;
+}
+
+void MetricsReport::onSent(uint32_t sequence) {
+    _sentSequence = sequence;
+    _awaitingAck = enabled();
+    if (!_awaitingAck) return;
+
+    uint8_t sinceFull = _store->get8(SensorRegion::SCRATCHPAD, BASE);
+    if (_builtDelta) {
+        if (sinceFull < 0xFF) {
+            _store->put8(SensorRegion::SCRATCHPAD, BASE, sinceFull + 1);
+        }
+    } else if (sinceFull != 0) {
+        _store->put8(SensorRegion::SCRATCHPAD, BASE, 0);
+    }
+}
+
+void MetricsReport::onAcknowledged() {
+    if (!_awaitingAck || _fram == nullptr) return;
+    _awaitingAck = false;
+
+    // Invalidate, write, then validate, so a brownout never leaves a
+    // baseline the gateway does not have
+    uint8_t header[BASELINE_HEADER] = {
+        0, 0,
+        (uint8_t)(_sentSequence >> 24), (uint8_t)(_sentSequence >> 16),
+        (uint8_t)(_sentSequence >> 8), (uint8_t)_sentSequence
+    };
+    _fram->write(BASELINE_ADDR, header, BASELINE_HEADER);
+    _fram->write(BASELINE_ADDR + BASELINE_HEADER, _built, REPORT_SIZE);
+    header[0] = (uint8_t)(BASELINE_MAGIC >> 8);
+    header[1] = (uint8_t)BASELINE_MAGIC;
+    _fram->write(BASELINE_ADDR, header, 2);
+
+    FramStats& s = _store->stats();
+    s.writeBursts += 3;
+    s.bytesWritten += FreeRegion::METRICS_BASELINE_SIZE + 2;
+
+    if (!_builtDelta) {
+        uint8_t flags = _store->get8(SensorRegion::SCRATCHPAD, BASE + 1);
+        if (flags & FLAG_FORCE_FULL) {
+            _store->put8(SensorRegion::SCRATCHPAD, BASE + 1, flags & ~FLAG_FORCE_FULL);
+        }
+    }
+    LOG_I("Metrics baseline now seq %lu", (unsigned long)_sentSequence);
+}
+
+void MetricsReport::requestFull() {
+    if (_store == nullptr || !_store->isInitialized()) return;
+    uint8_t flags = _store->get8(SensorRegion::SCRATCHPAD, BASE + 1);
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 1, flags | FLAG_FORCE_FULL);
+}
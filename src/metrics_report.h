@@ -0,0 +1,77 @@
+#ifndef METRICS_REPORT_H
+#define METRICS_REPORT_H
+
+#include <Arduino.h>
+#include "MB85RS64V.h"
+#include "sensor_region_store.h"
+#include "metrics_fields.h"
+
+// ============================================================================
+// Metrics Report (full or delta)
+// ============================================================================
+// Between reports only a handful of counters move, so with deltas on most
+// metrics frames carry just the fields that changed since the last report the
+// gateway acknowledged (MetricsDelta, metrics format 0x01) instead of the
+// whole 207-byte region. Metrics frames then request an ACK; an acknowledged
+// report, full or delta, becomes the baseline for the next one.
+//
+// A full report goes out instead when:
+//   - there is no baseline yet
+//   - the previous N-1 reports were deltas
+//   - the gateway asked for one (CMD_REQUEST_METRICS) and has not yet
+//     acknowledged a full report since
+//   - a byte outside the field table changed
+//
+// Settings (sensor tail):
+//   METRICS_FULL_EVERY  uint8_t  every N-th report is full, 0 / 0xFF = deltas
+//                                off (full reports without ACK, as before)
+//
+// FRAM state (scratchpad sensor tail, METRICS_STATE):
+//   0      sinceFull   uint8_t  delta reports sent since the last full one
+//   1      flags       uint8_t  bit 0 = full report requested
+//
+// Baseline (free region, METRICS_BASELINE):
+//   0-1    magic       uint16_t BASELINE_MAGIC, written last
+//   2-5    sequence    uint32_t frame sequence number of the report
+//   6-212  report      207 bytes
+class MetricsReport {
+public:
+    static constexpr size_t REPORT_SIZE = 207;
+    static constexpr uint16_t BASELINE_MAGIC = 0xD17A;
+    static constexpr uint8_t FLAG_FORCE_FULL = 0x01;
+
+    void init(SensorRegionStore* store, MB85RS64V* fram);
+
+    bool enabled() const { return fullEvery() != 0; }
+
+    // This wake's report (REPORT_SIZE bytes) -> frame payload. Returns the
+    // payload length; `delta` tells whether it is a delta (options bit 1).
+    size_t build(const uint8_t* report, uint8_t* out, size_t outLen, bool& delta);
+
+    // The built payload went out with this frame sequence number
+    void onSent(uint32_t sequence);
+    // The gateway acknowledged it: it becomes the baseline
+    void onAcknowledged();
+    // Next report is full (gateway request)
+    void requestFull();
+
+private:
+    SensorRegionStore* _store = nullptr;
+    MB85RS64V* _fram = nullptr;
+
+    uint8_t _built[REPORT_SIZE];
+    bool _builtDelta = false;
+    uint32_t _sentSequence = 0;
+    bool _awaitingAck = false;
+
+    static constexpr uint16_t BASE = SensorScratchpad::METRICS_STATE;
+    static constexpr uint16_t BASELINE_ADDR = FreeRegion::METRICS_BASELINE;
+    static constexpr size_t BASELINE_HEADER = 6;
+    static_assert(BASELINE_HEADER + REPORT_SIZE == FreeRegion::METRICS_BASELINE_SIZE,
+                  "baseline layout");
+
+    uint8_t fullEvery() const;
+    bool loadBaseline(uint8_t* report, uint32_t* sequence);
+};
+
+#endif // METRICS_REPORT_H
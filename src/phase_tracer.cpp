@@ -0,0 +1,78 @@
+#include "phase_tracer.h"
+
+static const char* const PHASE_NAMES[PhaseTracer::PHASE_COUNT] = {
+    "boot", "fram", "crypto", "radio", "sensor", "tx", "ack", "flush"
+};
+
+void PhaseTracer::begin() {
+    _totalUs[(uint8_t)WakePhase::BOOT] = micros();
+    _seen = 1 << (uint8_t)WakePhase::BOOT;
+}
+
+void PhaseTracer::attach(SensorRegionStore* store) {
+    _store = store;
+    if (_store == nullptr || !_store->isInitialized()) return;
+
+    // Fold the previous wake's trace into the metrics tail
+    uint8_t prevSeen = _store->get8(SensorRegion::SCRATCHPAD, SensorScratchpad::PHASE_TRACE);
+    if (prevSeen != 0) {
+        for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+            uint16_t off = 2 * i;
+            uint16_t latest = (prevSeen & (1 << i))
+                ? _store->get16(SensorRegion::SCRATCHPAD, SensorScratchpad::PHASE_TRACE + 1 + off) : 0;
+            uint16_t worst = _store->get16(SensorRegion::METRICS, SensorMetrics::PHASE_WORST + off);
+            _store->put16(SensorRegion::METRICS, SensorMetrics::PHASE_LATEST + off, latest);
+            if (latest > worst) {
+                _store->put16(SensorRegion::METRICS, SensorMetrics::PHASE_WORST + off, latest);
+            }
+        }
+    }
+
+    uint8_t cleared[1 + 2 * PHASE_COUNT] = {};
+    _store->write(SensorRegion::SCRATCHPAD, SensorScratchpad::PHASE_TRACE, cleared, sizeof(cleared));
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        if (_seen & (1 << i)) {
+            persist((WakePhase)i);
+        }
+    }
+}
+
+void PhaseTracer::start(WakePhase phase) {
+    uint8_t i = (uint8_t)phase;
+    _startUs[i] = micros();
+    _running |= 1 << i;
+}
+
+void PhaseTracer::stop(WakePhase phase) {
+    uint8_t i = (uint8_t)phase;
+    if (!(_running & (1 << i))) return;
+    _running &= ~(1 << i);
+    _totalUs[i] += micros() - _startUs[i];
+    _seen |= 1 << i;
+    persist(phase);
+}
+
+uint16_t PhaseTracer::duration(WakePhase phase) const {
+    uint32_t units = _totalUs[(uint8_t)phase] / UNIT_US;
+    return units > 0xFFFF ? 0xFFFF : (uint16_t)units;
+}
+
+void PhaseTracer::persist(WakePhase phase) {
+    if (_store == nullptr || !_store->isInitialized()) return;
+    uint8_t i = (uint8_t)phase;
+    _store->put8(SensorRegion::SCRATCHPAD, SensorScratchpad::PHASE_TRACE, _seen);
+    _store->put16(SensorRegion::SCRATCHPAD, SensorScratchpad::PHASE_TRACE + 1 + 2 * i, duration(phase));
+}
+
+void PhaseTracer::log() const {
+    char line[128];
+    size_t pos = 0;
+    for (uint8_t i = 0; i < PHASE_COUNT && pos < sizeof(line); i++) {
+        if (!(_seen & (1 << i))) continue;
+        uint16_t d = duration((WakePhase)i);
+        pos += snprintf(line + pos, sizeof(line) - pos, " %s=%u.%u",
+                        PHASE_NAMES[i], d / 10, d % 10);
+    }
+    line[pos < sizeof(line) ? pos : sizeof(line) - 1] = '\0';
+    LOG_I("Wake phases (ms):%s", line);
+}
@@ -0,0 +1,55 @@
+#ifndef PHASE_TRACER_H
+#define PHASE_TRACER_H
+
+#include <Arduino.h>
+#include "sensor_region_store.h"
+
+enum class WakePhase : uint8_t {
+    BOOT,               // app start to setup() entry
+    FRAM_SELF_TEST,
+    CRYPTO_INIT,        // encryption.begin + credentials + CA bundle
+    RADIO_WAIT,         // setup() blocked on radioInitialized
+    SENSOR_READ,
+    TX,                 // all transmissions of the wake
+    ACK_RX,             // telemetry ACK window
+    FINAL_FLUSH,        // pre-sleep FRAM flush
+    COUNT
+};
+
+// ============================================================================
+// Phase Tracer
+// ============================================================================
+// Times the phases of one wake in 100 us units. The running trace lives in
+// the scratchpad sensor tail, so it survives a brownout. On the next wake,
+// attach() folds it into the metrics tail as "latest" and "worst case", and
+// the metrics frame carries both to the gateway.
+//
+// Phases that run more than once in a wake (TX) are summed. Phases can be
+// timed before FRAM is up; they are held in RAM until attach().
+class PhaseTracer {
+public:
+    static constexpr uint8_t  PHASE_COUNT = (uint8_t)WakePhase::COUNT;
+    static constexpr uint32_t UNIT_US = 100;
+
+    // Call first thing in setup()
+    void begin();
+    void attach(SensorRegionStore* store);
+
+    void start(WakePhase phase);
+    void stop(WakePhase phase);
+
+    // This wake so far, in UNIT_US (saturating)
+    uint16_t duration(WakePhase phase) const;
+    void log() const;
+
+private:
+    SensorRegionStore* _store = nullptr;
+    uint32_t _startUs[PHASE_COUNT] = {};
+    uint32_t _totalUs[PHASE_COUNT] = {};
+    uint8_t _seen = 0;
+    uint8_t _running = 0;
+
+    void persist(WakePhase phase);
+};
+
+#endif // PHASE_TRACER_H
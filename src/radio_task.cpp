@@ -0,0 +1,51 @@
+#include "radio_task.h"
+#include "resonant_log.h"
+
+RadioTask* RadioTask::_instance = nullptr;
+
+void RadioTask::begin(ResonantLRRadio* radio, AppEventLoop* events) {
+    _radio = radio;
+    _events = events;
+    _task = xTaskGetCurrentTaskHandle();
+    _instance = this;
+    attachInterrupt(DIO1_PIN, onDio1, RISING);
+    _events->onDio1Missed([] { _instance->dio1Rose(); });
+    LOG_I("Radio task on core %d, DIO1 interrupt driven", xPortGetCoreID());
+}
+
+void RadioTask::run() {
+    while (true) {
+        uint32_t bits = 0;
+        TickType_t wait = _radio->isBusy() ? pdMS_TO_TICKS(BUSY_CHECK_MS) : portMAX_DELAY;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, wait);
+        _wakeups++;
+
+        _events->radioLock();           // Core 1 light-sleeps only between passes
+        if (bits & NOTIFY_DIO1) {
+            resonantRadioDio1Missed(*_radio);
+        }
+        _radio->loop();
+        _events->radioUnlock();
+    }
+}
+
+void RadioTask::kick() {
+    if (_task != nullptr) {
+        xTaskNotify(_task, NOTIFY_KICK, eSetBits);
+    }
+}
+
+void RadioTask::dio1Rose() {
+    if (_task != nullptr) {
+        xTaskNotify(_task, NOTIFY_DIO1, eSetBits);
+    }
+}
+
+void IRAM_ATTR RadioTask::onDio1() {
+    RadioTask* self = _instance;
+    if (self == nullptr || self->_task == nullptr) return;
+    self->_dio1Irqs++;
+    BaseType_t woken = pdFALSE;
+    xTaskNotifyFromISR(self->_task, NOTIFY_DIO1, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,67 @@
+#ifndef RADIO_TASK_H
+#define RADIO_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "resonant_lr_radio.h"
+#include "app_event_loop.h"
+
+// Core the radio task is pinned to. 1 puts it on the app core next to
+// loop(), so Core 0 only runs its idle task and stays clock-gated in WAITI;
+// boot steps marked for Core 0 then run there too, without the overlap.
+#ifndef RADIO_TASK_CORE
+#define RADIO_TASK_CORE 0
+#endif
+
+// ============================================================================
+// Radio Task
+// ============================================================================
+// Runs resonantRadio.loop() when there is something for it to do, instead
+// of every tick. The task blocks on a notification from:
+//   - its DIO1 ISR: the SX1262 raised TxDone, RxDone, CRC error or a timeout
+//   - kick(): Core 1 queued a frame (send()), or AppEventLoop saw a DIO1
+//     rise while the pin was a light-sleep wake source
+//   - its own timeout, only while the radio is busy: the library's TX and
+//     RX-accumulation timeouts are checked in software
+// An idle radio (listen windows included, whose timeout is the SX1262's)
+// costs Core 0 no wakeups at all.
+//
+// begin() replaces the driver's DIO1 ISR with this task's, and each rise is
+// handed back to the driver through resonantRadioDio1Missed() (sx126x_hooks.h)
+// before the pass, as AppEventLoop does after a light sleep.
+class RadioTask {
+public:
+    static constexpr uint8_t  DIO1_PIN = 47;            // LORA_SX126X_DIO1
+    static constexpr uint32_t BUSY_CHECK_MS = 20;       // resolution of the software timeouts
+
+    // On the task itself, once the radio is initialized
+    void begin(ResonantLRRadio* radio, AppEventLoop* events);
+
+    // Never returns
+    void run();
+
+    // Any task, not ISRs
+    void kick();
+    void dio1Rose();
+
+    // This wake: passes through resonantRadio.loop() and DIO1 interrupts
+    uint32_t wakeups() const { return _wakeups; }
+    uint32_t dio1Irqs() const { return _dio1Irqs; }
+
+private:
+    static constexpr uint32_t NOTIFY_DIO1 = 0x01;
+    static constexpr uint32_t NOTIFY_KICK = 0x02;
+
+    static RadioTask* _instance;
+
+    ResonantLRRadio* _radio = nullptr;
+    AppEventLoop* _events = nullptr;
+    TaskHandle_t _task = nullptr;
+    uint32_t _wakeups = 0;
+    volatile uint32_t _dio1Irqs = 0;
+
+    static void IRAM_ATTR onDio1();
+};
+
+#endif // RADIO_TASK_H
@@ -0,0 +1,74 @@
+#include "report_filter.h"
+#include <TelemetryCodec.h>
+
+void ReportFilter::init(SensorRegionStore* store) {
+    _store = store;
+}
+
+uint16_t ReportFilter::deadbandCenti() const {
+    if (_store == nullptr || !_store->isInitialized()) return 0;
+    uint16_t d = _store->get16(SensorRegion::SETTINGS, SensorSettings::DEADBAND_TEMP);
+    return d == 0xFFFF ? 0 : d;
+}
+
+uint32_t ReportFilter::heartbeatSeconds() const {
+    uint16_t m = _store->get16(SensorRegion::SETTINGS, SensorSettings::HEARTBEAT_INTERVAL);
+    if (m == 0 || m == 0xFFFF) m = DEFAULT_HEARTBEAT_MIN;
+    return (uint32_t)m * 60;
+}
+
+void ReportFilter::onWake(uint32_t sleptSeconds) {
+    if (!enabled()) return;
+    uint32_t silent = _store->get32(SensorRegion::SCRATCHPAD, BASE + 3);
+    _store->put32(SensorRegion::SCRATCHPAD, BASE + 3, silent + sleptSeconds);
+}
+
+bool ReportFilter::shouldReport(int16_t rawCount, bool contactClosed) const {
+    if (!enabled()) return true;
+
+    uint32_t silent = _store->get32(SensorRegion::SCRATCHPAD, BASE + 3);
+    if (silent >= heartbeatSeconds()) {
+        LOG_I("Report: heartbeat (%lus silent)", (unsigned long)silent);
+        return true;
+    }
+
+    int16_t lastRaw = (int16_t)_store->get16(SensorRegion::SCRATCHPAD, BASE);
+    if (rawCount == TelemetryCodec::RAW_INVALID || lastRaw == TelemetryCodec::RAW_INVALID) {
+        return true;
+    }
+    int32_t delta = TelemetryCodec::centiFromRaw(rawCount) - TelemetryCodec::centiFromRaw(lastRaw);
+    if (delta < 0) delta = -delta;
+    if (delta >= deadbandCenti()) {
+        LOG_I("Report: temperature moved %ld.%02ld C", (long)(delta / 100), (long)(delta % 100));
+        return true;
+    }
+
+    uint8_t flags = _store->get8(SensorRegion::SETTINGS, SensorSettings::DEADBAND_FLAGS);
+    bool lastContact = _store->get8(SensorRegion::SCRATCHPAD, BASE + 2) != 0;
+    if (flags != 0xFF && (flags & FLAG_CONTACT_TRIGGER) && contactClosed != lastContact) {
+        LOG_I("Report: contact changed");
+        return true;
+    }
+    return false;
+}
+
+void ReportFilter::onSending(int16_t rawCount, bool contactClosed) {
+    _sending = true;
+    _sendingRaw = rawCount;
+    _sendingContact = contactClosed;
+}
+
+void ReportFilter::onReported() {
+    if (!_sending || _store == nullptr || !_store->isInitialized()) return;
+    _sending = false;
+    _store->put16(SensorRegion::SCRATCHPAD, BASE, (uint16_t)_sendingRaw);
+    _store->put8(SensorRegion::SCRATCHPAD, BASE + 2, _sendingContact ? 0x01 : 0x00);
+    _store->put32(SensorRegion::SCRATCHPAD, BASE + 3, 0);
+}
+
+void ReportFilter::onSuppressed() {
+    uint16_t n = _store->get16(SensorRegion::METRICS, SensorMetrics::SUPPRESSED_REPORTS);
+    if (n < 0xFFFF) {
+        _store->put16(SensorRegion::METRICS, SensorMetrics::SUPPRESSED_REPORTS, n + 1);
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef REPORT_FILTER_H
+#define REPORT_FILTER_H
+
+#include <Arduino.h>
+#include "sensor_region_store.h"
+
+// ============================================================================
+// Report Filter (report-by-exception)
+// ============================================================================
+// Decides on adopted timer wakes whether this reading is worth a radio
+// session. A reading is sent when the temperature moved at least the deadband
+// since the last reported value, when the contact changed (if enabled), or
+// when nothing has been sent for the heartbeat interval. Quiet wakes go back
+// to sleep without starting the radio.
+//
+// Only used with batching off; batches already keep the radio off between
+// flushes.
+//
+// Settings (sensor tail):
+//   DEADBAND_TEMP       uint16_t  centi-degrees C, 0 / 0xFFFF = off
+//   DEADBAND_FLAGS      uint8_t   bit 0 = contact change forces a report
+//   HEARTBEAT_INTERVAL  uint16_t  minutes, 0 / 0xFFFF = DEFAULT_HEARTBEAT_MIN
+//
+// FRAM state (scratchpad sensor tail, REPORT_STATE):
+//   0-1    lastRaw        int16_t   TMP112 count of the last reported reading
+//   2      lastContact    uint8_t
+//   3-6    silentSeconds  uint32_t  since the last report
+class ReportFilter {
+public:
+    static constexpr uint16_t DEFAULT_HEARTBEAT_MIN = 60;
+    static constexpr uint8_t  FLAG_CONTACT_TRIGGER = 0x01;
+
+    void init(SensorRegionStore* store);
+
+    bool enabled() const { return deadbandCenti() != 0; }
+
+    // Advance the silent clock by the sleep that just ended
+    void onWake(uint32_t sleptSeconds);
+
+    bool shouldReport(int16_t rawCount, bool contactClosed) const;
+    // The reading going out. It becomes the deadband reference only once
+    // onReported() confirms delivery: TX done, or the ACK when one is required.
+    void onSending(int16_t rawCount, bool contactClosed);
+    void onReported();
+    // Count a wake that was kept off the air (metrics)
+    void onSuppressed();
+
+private:
+    SensorRegionStore* _store = nullptr;
+    bool _sending = false;
+    int16_t _sendingRaw = 0;
+    bool _sendingContact = false;
+
+    static constexpr uint16_t BASE = SensorScratchpad::REPORT_STATE;
+
+    uint16_t deadbandCenti() const;
+    uint32_t heartbeatSeconds() const;
+};
+
+#endif // REPORT_FILTER_H
@@ -0,0 +1,156 @@
+#include "resonant_log.h"
+
+#if RESONANT_LOG_TOKENIZED
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+namespace ResonantLog {
+
+namespace {
+
+constexpr uint32_t RING_MAGIC = 0x524C4731;     // "RLG1"
+
+// Survives deep sleep: records the drain did not get to are sent next wake.
+// Stored as a length byte and the payload; the sync byte is added on output.
+struct Ring {
+    uint32_t magic;
+    uint16_t tableHash;
+    uint16_t head;
+    uint16_t tail;
+    uint16_t used;
+    uint32_t dropped;
+    uint8_t data[RING_SIZE];
+};
+
+RTC_DATA_ATTR Ring rtcLogRing;
+
+portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+SemaphoreHandle_t drainMutex = nullptr;
+StaticSemaphore_t drainMutexBuffer;
+TaskHandle_t drainTask = nullptr;
+bool ready = false;
+
+bool ringValid(const Ring& r) {
+    return r.magic == RING_MAGIC
+        && r.tableHash == TABLE_HASH
+        && r.head < RING_SIZE
+        && r.tail < RING_SIZE
+        && r.used <= RING_SIZE
+        && (r.tail + r.used) % RING_SIZE == r.head;
+}
+
+// Ring lock held
+void dropOldest(Ring& r) {
+    uint16_t len = r.data[r.tail] + 1;
+    r.tail = (r.tail + len) % RING_SIZE;
+    r.used -= len;
+    r.dropped++;
+}
+
+// Ring lock held
+void putByte(Ring& r, uint8_t b) {
+    r.data[r.head] = b;
+    r.head = (r.head + 1) % RING_SIZE;
+    r.used++;
+}
+
+// Pops the oldest record into `out` (length byte first). Ring lock held.
+size_t popRecord(Ring& r, uint8_t* out) {
+    size_t len = (size_t)r.data[r.tail] + 1;
+    for (size_t i = 0; i < len; i++) {
+        out[i] = r.data[r.tail];
+        r.tail = (r.tail + 1) % RING_SIZE;
+    }
+    r.used -= len;
+    return len;
+}
+
+void emit(const uint8_t* lengthAndPayload, size_t len) {
+    RESONANT_LOG_SERIAL.write(RECORD_SYNC);
+    RESONANT_LOG_SERIAL.write(lengthAndPayload, len);
+}
+
+// Writes every pending record to the serial port, oldest first. Records are
+// copied out one at a time so callers only ever wait for a single copy.
+void drain() {
+    xSemaphoreTake(drainMutex, portMAX_DELAY);
+    uint8_t record[MAX_RECORD + 1];
+    while (true) {
+        uint32_t dropped = 0;
+        size_t len = 0;
+        taskENTER_CRITICAL(&ringMux);
+        if (rtcLogRing.used > 0) {
+            dropped = rtcLogRing.dropped;
+            rtcLogRing.dropped = 0;
+            len = popRecord(rtcLogRing, record);
+        }
+        taskEXIT_CRITICAL(&ringMux);
+        if (len == 0) break;
+
+        if (dropped > 0) {
+            Packer p(TOKEN_DROPPED);
+            p.put(dropped);
+            uint8_t n = (uint8_t)p.size();
+            emit(&n, 1);
+            RESONANT_LOG_SERIAL.write(p.data(), p.size());
+        }
+        emit(record, len);
+    }
+    xSemaphoreGive(drainMutex);
+}
+
+// Lowest priority on Core 1: runs while loop() waits, never ahead of it
+void drainLoop(void*) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        drain();
+    }
+}
+
+} // namespace
+
+void begin() {
+    if (ready) return;
+    if (!ringValid(rtcLogRing)) {
+        memset(&rtcLogRing, 0, sizeof(rtcLogRing));
+        rtcLogRing.magic = RING_MAGIC;
+        rtcLogRing.tableHash = TABLE_HASH;
+    }
+    drainMutex = xSemaphoreCreateMutexStatic(&drainMutexBuffer);
+    ready = true;
+    write(TOKEN_BOOT, TABLE_HASH);
+#if RESONANT_LOG_DRAIN
+    xTaskCreatePinnedToCore(drainLoop, "LogDrain", 3072, nullptr, tskIDLE_PRIORITY, &drainTask, 1);
+#endif
+}
+
+void commit(const uint8_t* record, size_t len) {
+    if (!ready) return;
+    taskENTER_CRITICAL(&ringMux);
+    Ring& r = rtcLogRing;
+    while (r.used + len + 1 > RING_SIZE) {
+        dropOldest(r);
+    }
+    putByte(r, (uint8_t)len);
+    for (size_t i = 0; i < len; i++) {
+        putByte(r, record[i]);
+    }
+    taskEXIT_CRITICAL(&ringMux);
+    if (drainTask != nullptr) {
+        xTaskNotifyGive(drainTask);
+    }
+}
+
+void flush() {
+#if RESONANT_LOG_DRAIN
+    if (!ready) return;
+    drain();
+    RESONANT_LOG_SERIAL.flush();
+#endif
+}
+
+} // namespace ResonantLog
+
+#endif // RESONANT_LOG_TOKENIZED
@@ -14,6 +14,194 @@
 #define RESONANT_LOG_SERIAL Serial1
 #endif
 
+// 1 = tokenized binary records in an RTC ring (below), 0 = printf as text
+#ifndef RESONANT_LOG_TOKENIZED
+#define RESONANT_LOG_TOKENIZED 1
+#endif
+
+// Tokenized only. 1 = a low-priority task drains the ring to
+// RESONANT_LOG_SERIAL; 0 = never drained (battery builds), the ring keeps
+// the latest records across deep sleep.
+#ifndef RESONANT_LOG_DRAIN
+#define RESONANT_LOG_DRAIN 1
+#endif
+
+#if RESONANT_LOG_TOKENIZED
+
+#include <type_traits>
+#include "log_tokens.h"
+
+// ============================================================================
+// Tokenized Log
+// ============================================================================
+// Each LOG_x format string is replaced at compile time by its index in
+// log_tokens.h (generated by tools/log_tokens.py before every build), so
+// the strings are not in flash. A call packs its arguments into a record
+// and copies it into a ring in RTC memory; nothing waits on the UART.
+//
+// Record, as drained: 0xA5, length, then `length` bytes:
+//   token      uint16_t LE
+//   ms         varint, millis() at the call
+//   arguments  in call order: integers (bools, enums, pointers) as zigzag
+//              varints, floats and doubles as float32 LE, strings as a
+//              length byte and up to MAX_STRING bytes
+// Token 0xFFFF marks a boot (argument: TABLE_HASH); 0xFFFE reports records
+// overwritten before they were drained (argument: count).
+//
+// tools/detokenize.py turns a capture back into the text printf would
+// have printed.
+namespace ResonantLog {
+
+constexpr uint16_t NO_TOKEN      = 0xFFFF;
+constexpr uint16_t TOKEN_BOOT    = 0xFFFF;
+constexpr uint16_t TOKEN_DROPPED = 0xFFFE;
+constexpr uint8_t  RECORD_SYNC   = 0xA5;
+constexpr size_t   MAX_RECORD    = 160;     // payload, fits the length byte
+constexpr size_t   MAX_STRING    = 128;     // prebuilt lines (phase trace, critical path)
+constexpr size_t   RING_SIZE     = 2048;    // RTC slow memory
+
+constexpr uint32_t fnv1a(const char* s) {
+    uint32_t h = 0x811C9DC5u;
+    while (*s != '\0') {
+        h = (h ^ (uint8_t)*s++) * 0x01000193u;
+    }
+    return h;
+}
+
+constexpr bool sameString(const char* a, const char* b) {
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+constexpr uint16_t tokenOf(char level, const char* fmt) {
+    uint32_t hash = fnv1a(fmt);
+    for (uint16_t i = 0; i < TOKEN_COUNT; i++) {
+        if (TOKENS[i].hash == hash && TOKENS[i].level == level && sameString(TOKENS[i].fmt, fmt)) {
+            return i;
+        }
+    }
+    return NO_TOKEN;
+}
+
+template <uint16_t ID>
+struct Token {
+    static_assert(ID != NO_TOKEN, "LOG format string missing from log_tokens.h: run tools/log_tokens.py");
+    static constexpr uint16_t value = ID;
+};
+
+// Builds one record on the caller's stack; arguments past MAX_RECORD are cut
+class Packer {
+public:
+    explicit Packer(uint16_t token) {
+        _buf[0] = (uint8_t)token;
+        _buf[1] = (uint8_t)(token >> 8);
+        _len = 2;
+        putVarint(millis());
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    put(T value) {
+        int64_t v = (int64_t)value;
+        putVarint(((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+    }
+
+    void put(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        if (_len + 4 > MAX_RECORD) return;
+        for (uint8_t i = 0; i < 4; i++) {
+            _buf[_len++] = (uint8_t)(bits >> (8 * i));
+        }
+    }
+    void put(double value) { put((float)value); }
+
+    void put(const char* s) {
+        if (_len + 1 > MAX_RECORD) return;
+        size_t n = s != nullptr ? strnlen(s, MAX_STRING) : 0;
+        if (_len + 1 + n > MAX_RECORD) n = MAX_RECORD - _len - 1;
+        _buf[_len++] = (uint8_t)n;
+        memcpy(_buf + _len, s, n);
+        _len += n;
+    }
+    void put(char* s) { put((const char*)s); }
+
+    template <typename T>
+    void put(const T* p) { put((uintptr_t)p); }
+
+    const uint8_t* data() const { return _buf; }
+    size_t size() const { return _len; }
+
+private:
+    uint8_t _buf[MAX_RECORD];
+    size_t _len;
+
+    void putVarint(uint64_t v) {
+        while (_len < MAX_RECORD) {
+            uint8_t b = v & 0x7F;
+            v >>= 7;
+            _buf[_len++] = v ? (b | 0x80) : b;
+            if (!v) break;
+        }
+    }
+};
+
+// Call first thing in setup(), after the serial port is up
+void begin();
+
+// Copies a record into the ring, overwriting the oldest ones if it is full
+void commit(const uint8_t* record, size_t len);
+
+// Writes everything pending to RESONANT_LOG_SERIAL and waits for the UART
+void flush();
+
+template <typename... Args>
+inline void write(uint16_t token, const Args&... args) {
+    Packer p(token);
+    (p.put(args), ...);
+    commit(p.data(), p.size());
+}
+
+} // namespace ResonantLog
+
+#define RESONANT_LOG_TOKEN(level, fmt) ResonantLog::Token<ResonantLog::tokenOf(level, fmt)>::value
+#define RESONANT_LOG_WRITE(level, fmt, ...) \
+    ResonantLog::write(RESONANT_LOG_TOKEN(level, fmt), ##__VA_ARGS__)
+
+#if RESONANT_LOG_LEVEL >= 1
+#define LOG_E(fmt, ...) RESONANT_LOG_WRITE('E', fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(fmt, ...) ((void)0)
+#endif
+
+#if RESONANT_LOG_LEVEL >= 2
+#define LOG_W(fmt, ...) RESONANT_LOG_WRITE('W', fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(fmt, ...) ((void)0)
+#endif
+
+#if RESONANT_LOG_LEVEL >= 3
+#define LOG_I(fmt, ...) RESONANT_LOG_WRITE('I', fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(fmt, ...) ((void)0)
+#endif
+
+#if RESONANT_LOG_LEVEL >= 4
+#define LOG_D(fmt, ...) RESONANT_LOG_WRITE('D', fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(fmt, ...) ((void)0)
+#endif
+
+#else // !RESONANT_LOG_TOKENIZED
+
+namespace ResonantLog {
+inline void begin() {}
+inline void flush() { RESONANT_LOG_SERIAL.flush(); }
+}
+
 #if RESONANT_LOG_LEVEL >= 1
 #define LOG_E(fmt, ...) RESONANT_LOG_SERIAL.printf("[E] " fmt "\n", ##__VA_ARGS__)
 #else
@@ -38,4 +226,6 @@
 #define LOG_D(fmt, ...) ((void)0)
 #endif
 
+#endif // RESONANT_LOG_TOKENIZED
+
 #endif // RESONANT_LOG_H
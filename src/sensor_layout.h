@@ -0,0 +1,132 @@
+#ifndef SENSOR_LAYOUT_H
+#define SENSOR_LAYOUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Sensor-Specific FRAM Sub-Layouts (sensor type 0x01: TMP112 + contact)
+// ============================================================================
+// Offsets are relative to the start of each sensor-specific tail, see
+// FRAM_MEMORY_MAP.md. Multi-byte fields are big-endian like the rest of FRAM.
+
+namespace SensorSettings {
+    constexpr uint16_t REGION_OFFSET = 36;      // settings bytes 36-206
+    constexpr size_t   SIZE          = 171;
+
+    constexpr uint16_t TELEMETRY_BATCH_SIZE = 0;    // uint8_t: readings per uplink (0/1 = every wake)
+    constexpr uint16_t TELEMETRY_FORMAT     = 1;    // uint8_t: 0x02 = compact batches, 0x03 = typed records
+    constexpr uint16_t TMP112_CONFIG        = 2;    // uint8_t: TMP112Config bits, 0xFF = defaults
+
+    // Report-by-exception, see report_filter.h
+    constexpr uint16_t DEADBAND_TEMP        = 3;    // uint16_t: centi-degrees C, 0 = off
+    constexpr uint16_t DEADBAND_FLAGS       = 5;    // uint8_t: bit 0 = contact change triggers
+    constexpr uint16_t HEARTBEAT_INTERVAL   = 6;    // uint16_t: minutes, 0 = 60
+
+    // Adaptive data rate / TX power, see adr_engine.h
+    constexpr uint16_t ADR_FLAGS            = 8;    // uint8_t: bit 0 = on, bit 1 = SF/BW steps allowed
+    constexpr uint16_t ADR_MARGIN_TARGET    = 9;    // uint8_t: dB, 0 = 10
+
+    // Airtime budget, see duty_cycle_budget.h
+    constexpr uint16_t DUTY_CYCLE           = 10;   // uint8_t: permille per hour, 0 = no limit
+
+    // Delta metrics reports, see metrics_report.h
+    constexpr uint16_t METRICS_FULL_EVERY   = 11;   // uint8_t: every N-th report is full, 0 = deltas off
+
+    // Command window gating, see downlink_gate.h
+    constexpr uint16_t DOWNLINK_GATE        = 12;   // uint8_t: bit 0 = ACKs signal pending downlinks
+
+    // Wake-on-radio, see wake_on_radio.h
+    constexpr uint16_t WOR_FLAGS            = 13;   // uint8_t: bit 0 = sniff for commands while asleep
+    constexpr uint16_t WOR_SNIFF_PERIOD     = 14;   // uint16_t: ms between sniffs, 0 = 1000
+    constexpr uint16_t WOR_PREAMBLE         = 16;   // uint16_t: preamble symbols, 0 = cover the sniff period
+}
+
+// SensorSettings::TMP112_CONFIG bits. 0x00 = one-shot, 12-bit, 4 Hz.
+namespace TMP112Config {
+    constexpr uint8_t EXTENDED   = 0x01;    // 13-bit, up to +150 C
+    constexpr uint8_t RATE_MASK  = 0x06;    // bits 2-1: conversion rate (continuous only)
+    constexpr uint8_t RATE_SHIFT = 1;       //   0 = 4 Hz, 1 = 8 Hz, 2 = 0.25 Hz, 3 = 1 Hz
+    constexpr uint8_t CONTINUOUS = 0x08;    // convert continuously while awake
+
+    // Field value -> TMP112 CR1:CR0 (0 = 0.25 Hz ... 3 = 8 Hz). The field is
+    // the CR bits XOR 2, so 0 is the part's 4 Hz power-on default.
+    constexpr uint8_t rate(uint8_t cfg) { return (uint8_t)(((cfg & RATE_MASK) >> RATE_SHIFT) ^ 2); }
+}
+
+namespace SensorMetrics {
+    constexpr uint16_t REGION_OFFSET = 51;      // metrics bytes 51-206
+    constexpr size_t   SIZE          = 156;
+
+    // FRAM write-back traffic of the previous wake (SensorRegionStore)
+    constexpr uint16_t FRAM_WRITE_BURSTS    = 0;    // uint16_t: SPI WRITE transactions
+    constexpr uint16_t FRAM_BYTES_WRITTEN   = 2;    // uint16_t
+    constexpr uint16_t FRAM_LIBRARY_FLUSHES = 4;    // uint8_t: framStorage.flush() calls
+    constexpr uint16_t FRAM_TOTAL_BYTES     = 5;    // uint32_t: cumulative bytes written
+
+    // Wake phase durations, 8 x uint16_t in 100 us units (PhaseTracer)
+    constexpr uint16_t PHASE_LATEST = 9;            // previous wake
+    constexpr uint16_t PHASE_WORST  = 25;           // maximum since metrics reset
+
+    // Boot scheduler: time until the first-TX dependencies were done
+    constexpr uint16_t BOOT_READY_TIME    = 41;     // uint16_t, 100 us units
+    constexpr uint16_t BOOT_CRITICAL_PATH = 43;     // uint8_t: BootStep bit mask
+
+    // ReportFilter: timer wakes kept off the air since metrics reset
+    constexpr uint16_t SUPPRESSED_REPORTS = 44;     // uint16_t
+
+    // AdrEngine: current ladder step and the margin of the last ACK
+    constexpr uint16_t ADR_STEP        = 46;        // int8_t
+    constexpr uint16_t ADR_LAST_MARGIN = 47;        // int8_t, dB
+
+    // DutyCycleBudget: time on air per frame (Airtime model)
+    constexpr uint16_t AIRTIME_LAST_FRAME = 48;     // uint16_t, ms
+    constexpr uint16_t AIRTIME_MAX_FRAME  = 50;     // uint16_t, ms, since metrics reset
+    constexpr uint16_t AIRTIME_TOTAL      = 52;     // uint32_t, ms
+    constexpr uint16_t DUTY_DEFERRED      = 56;     // uint16_t: frames held back by the budget
+
+    // DownlinkGate: command windows the gateway's ACK closed or shortened
+    constexpr uint16_t RX_SAVED_TIME      = 58;     // uint32_t, ms of command window not listened
+    constexpr uint16_t WINDOWS_SKIPPED    = 62;     // uint16_t: windows closed at the ACK
+
+    // WakeOnRadio: packets that ended a sniff while the MCU slept
+    constexpr uint16_t WOR_WAKES          = 64;     // uint16_t: commands for this device
+    constexpr uint16_t WOR_FALSE_WAKES    = 66;     // uint16_t: other packets, back to sleep
+
+    // AppEventLoop: Core 1 light sleep while waiting on the radio or sensor
+    constexpr uint16_t LIGHT_SLEEP_TIME   = 68;     // uint32_t, ms, cumulative
+}
+
+namespace SensorScratchpad {
+    constexpr uint16_t REGION_OFFSET = 32;      // scratchpad bytes 32-399 (sensorReadingBuffer)
+    constexpr size_t   SIZE          = 368;
+
+    constexpr uint16_t READING_BUFFER      = 0;     // TelemetryBatch, see telemetry_batch.h
+    constexpr size_t   READING_BUFFER_SIZE = 285;
+    constexpr uint16_t PHASE_TRACE         = 285;   // PhaseTracer: seen mask + 8 x uint16_t
+    constexpr size_t   PHASE_TRACE_SIZE    = 17;
+    constexpr uint16_t REPORT_STATE        = 302;   // ReportFilter: last reported reading + silent time
+    constexpr size_t   REPORT_STATE_SIZE   = 7;
+    constexpr uint16_t ADR_STATE           = 309;   // AdrEngine: step, missed ACKs, margin window
+    constexpr size_t   ADR_STATE_SIZE      = 12;
+    constexpr uint16_t DUTY_STATE          = 321;   // DutyCycleBudget: hourly airtime buckets
+    constexpr size_t   DUTY_STATE_SIZE     = 27;
+    constexpr uint16_t METRICS_STATE       = 348;   // MetricsReport: deltas since full, flags
+    constexpr size_t   METRICS_STATE_SIZE  = 2;
+}
+
+// Free FRAM after the scratchpad region, absolute addresses. Not touched by
+// the library's factory reset.
+namespace FreeRegion {
+    constexpr uint16_t START = 0x03FC;
+    constexpr uint16_t END   = 0x1FFF;
+
+    constexpr uint16_t METRICS_BASELINE      = 0x03FC;  // MetricsReport: last acknowledged report
+    constexpr size_t   METRICS_BASELINE_SIZE = 213;
+
+    constexpr uint16_t EVENT_JOURNAL          = 0x04D1; // EventJournal: header + one record per wake
+    constexpr uint16_t EVENT_JOURNAL_CAPACITY = 512;    // records
+    constexpr size_t   EVENT_JOURNAL_SIZE     = 6151;   // 7 + 512 x 12, up to 0x1CD7
+}
+
+#endif // SENSOR_LAYOUT_H
@@ -0,0 +1,127 @@
+#include "sensor_region_store.h"
+
+bool SensorRegionStore::begin(MB85RS64V& fram) {
+    _fram = &fram;
+    _fram->read(SETTINGS_ADDR, _settings, sizeof(_settings));
+    _fram->read(METRICS_ADDR, _metrics, sizeof(_metrics));
+    _fram->read(SCRATCHPAD_ADDR, _scratchpad, sizeof(_scratchpad));
+    _stats.bytesRead += sizeof(_settings) + sizeof(_metrics) + sizeof(_scratchpad);
+    for (uint8_t i = 0; i < 3; i++) {
+        _dirty[i].clear();
+        _changed[i].clear();
+    }
+    return true;
+}
+
+void SensorRegionStore::reloadSettings() {
+    if (_fram == nullptr) return;
+    _fram->read(SETTINGS_ADDR, _settings, sizeof(_settings));
+    _stats.bytesRead += sizeof(_settings);
+    _dirty[(uint8_t)SensorRegion::SETTINGS].clear();
+    _changed[(uint8_t)SensorRegion::SETTINGS].clear();
+}
+
+void SensorRegionStore::onLibraryFlush() {
+    _stats.libraryFlushes++;
+    for (uint8_t i = 0; i < 3; i++) {
+        _dirty[i].add(_changed[i]);
+    }
+}
+
+void SensorRegionStore::flush() {
+    if (_fram == nullptr) return;
+    for (uint8_t i = 0; i < 3; i++) {
+        SensorRegion r = (SensorRegion)i;
+        const DirtyRanges& d = _dirty[i];
+        for (uint8_t k = 0; k < d.count(); k++) {
+            uint16_t len = d[k].end - d[k].start;
+            _fram->write(address(r) + d[k].start, mirror(r) + d[k].start, len);
+            _stats.writeBursts++;
+            _stats.bytesWritten += len;
+        }
+        _dirty[i].clear();
+    }
+}
+
+uint8_t* SensorRegionStore::mirror(SensorRegion r) {
+    switch (r) {
+        case SensorRegion::SETTINGS: return _settings;
+        case SensorRegion::METRICS:  return _metrics;
+        default:                     return _scratchpad;
+    }
+}
+
+const uint8_t* SensorRegionStore::data(SensorRegion r) const {
+    return const_cast<SensorRegionStore*>(this)->mirror(r);
+}
+
+uint16_t SensorRegionStore::address(SensorRegion r) {
+    switch (r) {
+        case SensorRegion::SETTINGS: return SETTINGS_ADDR;
+        case SensorRegion::METRICS:  return METRICS_ADDR;
+        default:                     return SCRATCHPAD_ADDR;
+    }
+}
+
+size_t SensorRegionStore::size(SensorRegion r) {
+    switch (r) {
+        case SensorRegion::SETTINGS: return SensorSettings::SIZE;
+        case SensorRegion::METRICS:  return SensorMetrics::SIZE;
+        default:                     return SensorScratchpad::SIZE;
+    }
+}
+
+void SensorRegionStore::touch(SensorRegion r, uint16_t off, size_t len) {
+    _dirty[(uint8_t)r].add(off, len);
+    _changed[(uint8_t)r].add(off, len);
+}
+
+uint8_t SensorRegionStore::get8(SensorRegion r, uint16_t off) const {
+    return data(r)[off];
+}
+
+uint16_t SensorRegionStore::get16(SensorRegion r, uint16_t off) const {
+    const uint8_t* p = data(r) + off;
+    return ((uint16_t)p[0] << 8) | p[1];
+}
+
+uint32_t SensorRegionStore::get32(SensorRegion r, uint16_t off) const {
+    const uint8_t* p = data(r) + off;
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+void SensorRegionStore::put8(SensorRegion r, uint16_t off, uint8_t v) {
+    write(r, off, &v, 1);
+}
+
+void SensorRegionStore::put16(SensorRegion r, uint16_t off, uint16_t v) {
+    uint8_t b[2] = {(uint8_t)(v >> 8), (uint8_t)(v & 0xFF)};
+    write(r, off, b, sizeof(b));
+}
+
+void SensorRegionStore::put32(SensorRegion r, uint16_t off, uint32_t v) {
+    uint8_t b[4] = {(uint8_t)(v >> 24), (uint8_t)((v >> 16) & 0xFF),
+                    (uint8_t)((v >> 8) & 0xFF), (uint8_t)(v & 0xFF)};
+    write(r, off, b, sizeof(b));
+}
+
+void SensorRegionStore::read(SensorRegion r, uint16_t off, uint8_t* buf, size_t len) const {
+    if (off + len > size(r)) {
+        LOG_E("Sensor region read out of range: %u+%zu", off, len);
+        return;
+    }
+    memcpy(buf, data(r) + off, len);
+}
+
+void SensorRegionStore::write(SensorRegion r, uint16_t off, const uint8_t* data, size_t len) {
+    if (off + len > size(r)) {
+        LOG_E("Sensor region write out of range: %u+%zu", off, len);
+        return;
+    }
+    uint8_t* dst = mirror(r) + off;
+    if (memcmp(dst, data, len) == 0) {
+        return;
+    }
+    memcpy(dst, data, len);
+    touch(r, off, len);
+}
@@ -0,0 +1,80 @@
+#ifndef SENSOR_REGION_STORE_H
+#define SENSOR_REGION_STORE_H
+
+#include <Arduino.h>
+#include "MB85RS64V.h"
+#include "dirty_ranges.h"
+#include "sensor_layout.h"
+#include "resonant_log.h"
+
+enum class SensorRegion : uint8_t {
+    SETTINGS,
+    METRICS,
+    SCRATCHPAD
+};
+
+// FRAM SPI traffic issued by the firmware over one wake cycle
+struct FramStats {
+    uint16_t writeBursts = 0;       // WRITE transactions
+    uint16_t bytesWritten = 0;
+    uint16_t bytesRead = 0;
+    uint8_t libraryFlushes = 0;     // framStorage.flush() calls (region writes not visible here)
+};
+
+// ============================================================================
+// Sensor Region Store
+// ============================================================================
+// RAM mirror of the three sensor-specific FRAM tails (settings 36-206,
+// metrics 51-206, scratchpad 32-399). ResonantFRAMStorage owns the universal
+// fields; the firmware owns these sub-layouts.
+//
+// Write-back: setters only touch the mirror and record the changed byte
+// range; flush() writes each coalesced range as one SPI burst. The library
+// rewrites its regions, tails included, from its own begin()-time copy, so
+// bytes changed this wake are re-sent after every framStorage.flush()
+// (onLibraryFlush()). Always flush after framStorage.flush().
+class SensorRegionStore {
+public:
+    static constexpr uint16_t SETTINGS_ADDR   = 0x0000 + SensorSettings::REGION_OFFSET;
+    static constexpr uint16_t METRICS_ADDR    = 0x019E + SensorMetrics::REGION_OFFSET;
+    static constexpr uint16_t SCRATCHPAD_ADDR = 0x026C + SensorScratchpad::REGION_OFFSET;
+
+    bool begin(MB85RS64V& fram);
+    bool isInitialized() const { return _fram != nullptr; }
+
+    // Re-read the settings tail after the gateway rewrites settings
+    void reloadSettings();
+    void onLibraryFlush();
+    void flush();
+
+    const FramStats& stats() const { return _stats; }
+    FramStats& stats() { return _stats; }
+
+    uint8_t  get8(SensorRegion r, uint16_t off) const;
+    uint16_t get16(SensorRegion r, uint16_t off) const;
+    uint32_t get32(SensorRegion r, uint16_t off) const;
+    void put8(SensorRegion r, uint16_t off, uint8_t v);
+    void put16(SensorRegion r, uint16_t off, uint16_t v);
+    void put32(SensorRegion r, uint16_t off, uint32_t v);
+
+    void read(SensorRegion r, uint16_t off, uint8_t* buf, size_t len) const;
+    void write(SensorRegion r, uint16_t off, const uint8_t* data, size_t len);
+
+    const uint8_t* data(SensorRegion r) const;
+    static size_t size(SensorRegion r);
+
+private:
+    MB85RS64V* _fram = nullptr;
+    uint8_t _settings[SensorSettings::SIZE];
+    uint8_t _metrics[SensorMetrics::SIZE];
+    uint8_t _scratchpad[SensorScratchpad::SIZE];
+    DirtyRanges _dirty[3];          // pending writes
+    DirtyRanges _changed[3];        // written this wake, stale in the library's copy
+    FramStats _stats;
+
+    uint8_t* mirror(SensorRegion r);
+    static uint16_t address(SensorRegion r);
+    void touch(SensorRegion r, uint16_t off, size_t len);
+};
+
+#endif // SENSOR_REGION_STORE_H
@@ -0,0 +1,52 @@
+#ifndef SETTINGS_FIELDS_H
+#define SETTINGS_FIELDS_H
+
+#include <SettingsPatch.h>
+#include "sensor_layout.h"
+
+// ============================================================================
+// Settings Patch Field Table
+// ============================================================================
+// Fields of the 207-byte settings region a patch may write, FRAM_MEMORY_MAP.md
+// sections 1 and 5. Gaps are reserved; touch 0 marks the fields adoption
+// owns. Sensor offsets are SensorSettings + REGION_OFFSET.
+namespace SettingsFields {
+    constexpr uint8_t tail(uint16_t off) { return (uint8_t)(SensorSettings::REGION_OFFSET + off); }
+
+    inline constexpr SettingsPatch::Field TABLE[] = {
+        {0,  1, SettingsPatch::TOUCH_OTHER},        // settingsVersion
+        {1,  2, SettingsPatch::TOUCH_TIMING},       // telemetryInterval
+        {3,  2, SettingsPatch::TOUCH_TIMING},       // telemetryMaxWake
+        {5,  1, SettingsPatch::TOUCH_RADIO},        // txPower
+        {6,  1, SettingsPatch::TOUCH_RADIO},        // spreadingFactor
+        {7,  1, SettingsPatch::TOUCH_RADIO},        // bandwidth
+        {8,  4, SettingsPatch::TOUCH_RADIO},        // frequency
+        {12, 1, SettingsPatch::TOUCH_RADIO},        // codingRate
+        {13, 2, SettingsPatch::TOUCH_OTHER},        // waitAfterTx
+        {15, 1, SettingsPatch::TOUCH_OTHER},        // ackFailThreshold
+        {16, 1, SettingsPatch::TOUCH_OTHER},        // telemetryAckRequired
+        {17, 2, SettingsPatch::TOUCH_OTHER},        // metricsReportInterval
+        {19, 4, 0},                                 // parentID
+        {33, 1, 0},                                 // sensorType
+        {34, 1, 0},                                 // firmwareVersion
+        {35, 1, 0},                                 // hardwareVersion
+
+        {tail(SensorSettings::TELEMETRY_BATCH_SIZE), 1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::TELEMETRY_FORMAT),     1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::TMP112_CONFIG),        1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::DEADBAND_TEMP),        2, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::DEADBAND_FLAGS),       1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::HEARTBEAT_INTERVAL),   2, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::ADR_FLAGS),            1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::ADR_MARGIN_TARGET),    1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::DUTY_CYCLE),           1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::METRICS_FULL_EVERY),   1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::DOWNLINK_GATE),        1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::WOR_FLAGS),            1, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::WOR_SNIFF_PERIOD),     2, SettingsPatch::TOUCH_SENSOR},
+        {tail(SensorSettings::WOR_PREAMBLE),         2, SettingsPatch::TOUCH_SENSOR},
+    };
+    constexpr uint8_t COUNT = sizeof(TABLE) / sizeof(TABLE[0]);
+}
+
+#endif // SETTINGS_FIELDS_H
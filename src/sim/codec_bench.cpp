@@ -0,0 +1,254 @@
+#include "codec_bench.h"
+#include <TelemetryCodec.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "sim_clock.h"
+#include "sim_hal.h"
+
+namespace {
+
+constexpr size_t FRAME_OVERHEAD = 20;       // header + checksum
+constexpr size_t GCM_OVERHEAD   = 28;       // iv + tag
+constexpr size_t LEGACY_SIZE    = 3;        // tempCenti + contact
+constexpr size_t MAX_SAMPLES    = 40;       // TelemetryBatch::MAX_RECORDS
+constexpr uint8_t BATCH_SIZES[] = {1, 6, 12, 24, 40};
+
+struct Reading {
+    int16_t raw;
+    bool contact;
+};
+
+struct Trace {
+    std::string name;
+    std::vector<Reading> readings;
+};
+
+// ----------------------------------------------------------------------------
+// Traces
+// ----------------------------------------------------------------------------
+// Cold room: defrost cycles every 6 h, door openings spike the air
+// temperature and close the contact for a few minutes
+Trace coldRoomTrace(SimRandom& rng, uint32_t intervalS, size_t n) {
+    Trace t{"cold-room", {}};
+    float doorHeat = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        float s = (float)(i * intervalS);
+        bool doorOpen = rng.chance(0.03f);
+        if (doorOpen) doorHeat += 2.5f + rng.uniform() * 3.0f;
+        doorHeat *= expf(-(float)intervalS / 900.0f);
+        float c = 3.5f + 1.2f * sinf(2.0f * (float)M_PI * s / (6 * 3600.0f))
+                + doorHeat + rng.gaussian(0.04f);
+        t.readings.push_back({TelemetryCodec::rawFromCelsius(c), doorOpen});
+    }
+    return t;
+}
+
+// Unheated warehouse: diurnal swing with weather fronts
+Trace ambientTrace(SimRandom& rng, uint32_t intervalS, size_t n) {
+    Trace t{"ambient", {}};
+    float front = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        float s = (float)(i * intervalS);
+        front += rng.gaussian(0.05f);
+        float c = 14.0f + 6.0f * sinf(2.0f * (float)M_PI * (s / 86400.0f - 0.3f))
+                + front + rng.gaussian(0.03f);
+        t.readings.push_back({TelemetryCodec::rawFromCelsius(c), false});
+    }
+    return t;
+}
+
+// Freezer with compressor on/off sawtooth and a defrost heater once a day
+Trace freezerTrace(SimRandom& rng, uint32_t intervalS, size_t n) {
+    Trace t{"freezer", {}};
+    for (size_t i = 0; i < n; i++) {
+        uint32_t s = (uint32_t)(i * intervalS);
+        float saw = (float)(s % 2700) / 2700.0f;
+        float c = -20.0f + 2.0f * saw + rng.gaussian(0.06f);
+        if (s % 86400 < 1800) c += 12.0f;
+        t.readings.push_back({TelemetryCodec::rawFromCelsius(c), false});
+    }
+    return t;
+}
+
+bool loadTrace(const char* path, Trace& t) {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot open trace %s\n", path);
+        return false;
+    }
+    t.name = path;
+    char line[128];
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        char* end = nullptr;
+        float c = strtof(line, &end);
+        if (end == line) continue;      // header or blank line
+        bool contact = false;
+        if (*end == ',') contact = strtol(end + 1, nullptr, 10) != 0;
+        t.readings.push_back({TelemetryCodec::rawFromCelsius(c), contact});
+    }
+    fclose(f);
+    return !t.readings.empty();
+}
+
+// ----------------------------------------------------------------------------
+// Measurement
+// ----------------------------------------------------------------------------
+struct FormatStats {
+    uint64_t samples = 0;
+    uint64_t payloadBytes = 0;
+    uint64_t frames = 0;
+    uint64_t airtimeSf7 = 0;
+    uint64_t airtimeSf12 = 0;
+
+    void add(size_t samplesInFrame, size_t plaintext, SimRadio& sf7, SimRadio& sf12) {
+        size_t frame = FRAME_OVERHEAD + GCM_OVERHEAD + plaintext;
+        samples += samplesInFrame;
+        payloadBytes += plaintext;
+        frames++;
+        airtimeSf7 += sf7.packetAirtimeMs(frame);
+        airtimeSf12 += sf12.packetAirtimeMs(frame);
+    }
+};
+
+void printRow(const char* label, const FormatStats& s) {
+    printf("  %-10s %10.2f %12.1f %14.1f %14.1f\n", label,
+           (double)s.payloadBytes / s.samples,
+           (double)s.payloadBytes / s.frames,
+           (double)s.airtimeSf7 / s.samples,
+           (double)s.airtimeSf12 / s.samples);
+}
+
+bool benchTrace(const Trace& t, uint32_t intervalS, SimRadio& sf7, SimRadio& sf12) {
+    printf("\nTrace: %s (%zu samples)\n", t.name.c_str(), t.readings.size());
+    printf("  %-10s %10s %12s %14s %14s\n",
+           "Batch", "B/sample", "B/frame", "SF7 ms/sample", "SF12 ms/sample");
+
+    for (uint8_t batch : BATCH_SIZES) {
+        FormatStats legacy, batched, compact;
+        TelemetrySample samples[MAX_SAMPLES];
+        TelemetrySample decoded[MAX_SAMPLES];
+        uint8_t out[TelemetryCodec::maxEncodedSize(MAX_SAMPLES)];
+
+        for (size_t start = 0; start + batch <= t.readings.size(); start += batch) {
+            for (uint8_t i = 0; i < batch; i++) {
+                const Reading& r = t.readings[start + i];
+                samples[i].ageS = (uint32_t)(batch - 1 - i) * intervalS;
+                samples[i].raw = r.raw;
+                samples[i].contact = r.contact;
+                legacy.add(1, LEGACY_SIZE, sf7, sf12);
+            }
+            batched.add(batch, 2 + 5 * (size_t)batch, sf7, sf12);
+
+            size_t len = TelemetryCodec::encode(samples, batch, out, sizeof(out));
+            uint8_t n = TelemetryCodec::decode(out, len, decoded, MAX_SAMPLES);
+            if (len == 0 || n != batch) {
+                fprintf(stderr, "Round trip failed at sample %zu\n", start);
+                return false;
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                if (decoded[i].raw != samples[i].raw || decoded[i].contact != samples[i].contact
+                    || decoded[i].ageS != samples[i].ageS) {
+                    fprintf(stderr, "Round trip mismatch at sample %zu\n", start + i);
+                    return false;
+                }
+            }
+            compact.add(batch, len, sf7, sf12);
+        }
+        if (compact.frames == 0) continue;
+
+        printf(" batch %u\n", batch);
+        printRow("legacy", legacy);
+        printRow("0x01", batched);
+        printRow("0x02", compact);
+    }
+    return true;
+}
+
+void benchThroughput(const Trace& t) {
+    const uint8_t batch = 24;
+    TelemetrySample samples[batch];
+    TelemetrySample decoded[batch];
+    uint8_t out[TelemetryCodec::maxEncodedSize(batch)];
+    size_t frames = t.readings.size() / batch;
+    if (frames == 0) return;
+
+    uint64_t bytes = 0;
+    const int reps = 200;
+    auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < reps; rep++) {
+        for (size_t f = 0; f < frames; f++) {
+            for (uint8_t i = 0; i < batch; i++) {
+                const Reading& r = t.readings[f * batch + i];
+                samples[i] = {(uint32_t)(batch - 1 - i) * 600, r.raw, r.contact};
+            }
+            size_t len = TelemetryCodec::encode(samples, batch, out, sizeof(out));
+            bytes += TelemetryCodec::decode(out, len, decoded, batch) + len;
+        }
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double samplesPerSec = sec > 0 ? reps * frames * batch / sec : 0.0;
+    printf("\nHost: encode+decode %.1f M samples/s (checksum %llu)\n",
+           samplesPerSec / 1e6, (unsigned long long)bytes);
+}
+
+} // namespace
+
+int runCodecBenchmark(int argc, char** argv) {
+    uint32_t intervalS = 600;
+    uint32_t seed = 1;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--codec") == 0) {
+            continue;
+        } else if (val == nullptr) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return 2;
+        } else if (strcmp(arg, "--trace") == 0) {
+            files.push_back(val); i++;
+        } else if (strcmp(arg, "--interval") == 0) {
+            intervalS = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--seed") == 0) {
+            seed = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return 2;
+        }
+    }
+
+    std::vector<Trace> traces;
+    if (files.empty()) {
+        SimRandom rng(seed);
+        size_t n = intervalS > 0 ? 14 * 86400 / intervalS : 0;
+        traces.push_back(coldRoomTrace(rng, intervalS, n));
+        traces.push_back(ambientTrace(rng, intervalS, n));
+        traces.push_back(freezerTrace(rng, intervalS, n));
+    } else {
+        for (const char* path : files) {
+            Trace t;
+            if (!loadTrace(path, t)) return 1;
+            traces.push_back(t);
+        }
+    }
+
+    SimClock clock;
+    SimRadio sf7(clock);
+    SimRadio sf12(clock);
+    sf12.config.spreadingFactor = 12;
+
+    printf("\n=== Telemetry Codec Benchmark ===\n");
+    printf("Interval: %us  frame overhead: %zu + %zu GCM bytes\n",
+           intervalS, FRAME_OVERHEAD, GCM_OVERHEAD);
+    for (const Trace& t : traces) {
+        if (!benchTrace(t, intervalS, sf7, sf12)) return 1;
+    }
+    benchThroughput(traces[0]);
+    return 0;
+}
@@ -0,0 +1,20 @@
+#ifndef CODEC_BENCH_H
+#define CODEC_BENCH_H
+
+// ============================================================================
+// Telemetry Codec Benchmark
+// ============================================================================
+// Bytes-per-sample and time-on-air of the legacy, BATCH (0x01) and COMPACT
+// (0x02) telemetry payloads over temperature traces. Every compact payload
+// is decoded again and checked against the input.
+//
+//   --codec               run this benchmark instead of the wake-cycle model
+//   --trace FILE          one reading per line: "<celsius>[,<contact 0|1>]"
+//                         (repeatable; built-in synthetic traces otherwise)
+//   --interval S          sample spacing in seconds (default 600)
+//   --seed N              RNG seed for the synthetic traces (default 1)
+//
+// Returns the process exit code.
+int runCodecBenchmark(int argc, char** argv);
+
+#endif // CODEC_BENCH_H
@@ -0,0 +1,607 @@
+#include "decode_bench.h"
+#include <FrameBatch.h>
+#include <FrameDecoder.h>
+#include <MetricsDelta.h>
+#include <TelemetryCodec.h>
+#include <ctype.h>
+#include <openssl/evp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "sim_hal.h"
+#include "../metrics_fields.h"
+
+using namespace ResonantWire;
+
+namespace {
+
+using Key = std::array<uint8_t, KEY_SIZE>;
+using KeyMap = std::unordered_map<uint32_t, Key>;
+
+constexpr uint32_t GATEWAY_ID = 0x47570001;
+constexpr uint8_t OPTIONS_V1 = 0x20;
+constexpr size_t STATUSES = 8;          // FrameStatus values
+constexpr size_t KINDS = 6;             // PayloadKind values
+
+struct Capture {
+    std::string name;
+    std::vector<uint8_t> bytes;
+    std::vector<size_t> offsets;
+    std::vector<size_t> lengths;
+    std::vector<FrameRef> refs;         // built once all frames are in
+    KeyMap keys;
+
+    // Synthetic only: what each frame should decode to
+    std::vector<std::vector<uint8_t>> plaintext;
+    std::vector<bool> valid;
+
+    void add(const uint8_t* frame, size_t len) {
+        offsets.push_back(bytes.size());
+        lengths.push_back(len);
+        bytes.insert(bytes.end(), frame, frame + len);
+    }
+
+    void finish() {
+        refs.clear();
+        for (size_t i = 0; i < offsets.size(); i++) {
+            refs.push_back(FrameRef{bytes.data() + offsets[i], lengths[i]});
+        }
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Capture files
+// ----------------------------------------------------------------------------
+int hexValue(int c) {
+    return isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+}
+
+// Hex digits of one line, "0x" prefixes and separators skipped
+size_t parseHexLine(const char* line, uint8_t* out, size_t outLen) {
+    size_t n = 0;
+    int high = -1;
+    for (const char* p = line; *p && *p != '#'; p++) {
+        if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+            p++;
+            continue;
+        }
+        if (!isxdigit((unsigned char)*p)) continue;
+        if (high < 0) {
+            high = hexValue(*p);
+        } else {
+            if (n == outLen) return outLen + 1;
+            out[n++] = (uint8_t)(high << 4 | hexValue(*p));
+            high = -1;
+        }
+    }
+    return n;
+}
+
+bool loadCapture(const char* path, Capture& c) {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot open capture %s\n", path);
+        return false;
+    }
+    char line[1024];
+    uint8_t frame[MAX_FRAME];
+    size_t lineNo = 0;
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        lineNo++;
+        size_t n = parseHexLine(line, frame, sizeof(frame));
+        if (n == 0) continue;
+        if (n > sizeof(frame)) {
+            fprintf(stderr, "%s:%zu: frame longer than %zu bytes, skipped\n", path, lineNo, MAX_FRAME);
+            continue;
+        }
+        c.add(frame, n);
+    }
+    fclose(f);
+    return true;
+}
+
+bool loadKeys(const char* path, KeyMap& keys) {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot open keys %s\n", path);
+        return false;
+    }
+    char line[256];
+    uint8_t raw[4 + KEY_SIZE];
+    size_t lineNo = 0;
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        lineNo++;
+        size_t n = parseHexLine(line, raw, sizeof(raw));
+        if (n == 0) continue;
+        if (n != sizeof(raw)) {
+            fprintf(stderr, "%s:%zu: expected <sourceId> <key>, 20 bytes of hex\n", path, lineNo);
+            fclose(f);
+            return false;
+        }
+        uint32_t id = (uint32_t)raw[0] << 24 | (uint32_t)raw[1] << 16 | (uint32_t)raw[2] << 8 | raw[3];
+        Key k;
+        memcpy(k.data(), raw + 4, KEY_SIZE);
+        keys[id] = k;
+    }
+    fclose(f);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Synthetic fleet traffic
+// ----------------------------------------------------------------------------
+// Each device reports like the firmware's defaults: telemetry every wake,
+// metrics every 6th (three deltas to one full report), the odd settings
+// report and command response. A few devices are not adopted and send the
+// plaintext fallback; a few frames arrive corrupted.
+struct Device {
+    uint32_t id;
+    bool adopted;
+    Key key;
+    uint8_t telemetryFormat;            // 0 = legacy
+    uint32_t sequence;
+    uint32_t cycle;
+    float celsius;
+    uint8_t metrics[REGION_SIZE];
+    uint32_t baseSequence;
+};
+
+void putBe16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+void putBe32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+uint32_t getBe32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+void addToField(uint8_t* region, uint8_t offset, uint32_t n) {
+    putBe32(region + offset, getBe32(region + offset) + n);
+}
+
+bool gcmEncrypt(const Key& key, const uint8_t* iv, const uint8_t* aad,
+                const uint8_t* in, size_t len, uint8_t* out, uint8_t* tag) {
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    int n = 0;
+    bool ok = ctx != nullptr
+        && EVP_EncryptInit_ex(ctx, EVP_aes_128_gcm(), nullptr, key.data(), iv) == 1
+        && EVP_EncryptUpdate(ctx, nullptr, &n, aad, AAD_SIZE) == 1
+        && EVP_EncryptUpdate(ctx, out, &n, in, (int)len) == 1
+        && EVP_EncryptFinal_ex(ctx, out + n, &n) == 1
+        && EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, GCM_TAG_SIZE, tag) == 1;
+    EVP_CIPHER_CTX_free(ctx);
+    return ok;
+}
+
+void addFrame(Capture& c, Device& d, uint8_t type, uint8_t options,
+              const uint8_t* pt, size_t ptLen, SimRandom& rng) {
+    uint8_t frame[MAX_FRAME];
+    FrameHeader h{d.id, GATEWAY_ID, d.sequence++, type, options, 1, 0};
+    size_t payloadLen = d.adopted ? ptLen + GCM_OVERHEAD : ptLen;
+    size_t len = payloadLen + FRAME_OVERHEAD;
+    frame[0] = HEADER_BYTE;
+    putBe16(frame + 1, (uint16_t)(len - 3));
+    putBe32(frame + 3, h.sourceId);
+    putBe32(frame + 7, h.destinationId);
+    frame[11] = type;
+    frame[12] = options;
+    putBe32(frame + 13, h.sequence);
+    frame[17] = 1;
+    frame[18] = 0;
+
+    uint8_t* payload = frame + HEADER_SIZE;
+    if (d.adopted) {
+        uint8_t aad[AAD_SIZE];
+        FrameDecoder::aad(h, aad);
+        for (size_t i = 0; i < GCM_IV_SIZE; i++) {
+            payload[i] = (uint8_t)rng.next();
+        }
+        gcmEncrypt(d.key, payload, aad, pt, ptLen, payload + GCM_IV_SIZE,
+                   payload + GCM_IV_SIZE + ptLen);
+    } else {
+        memcpy(payload, pt, ptLen);
+    }
+    uint8_t sum = 0;
+    for (size_t i = 3; i < len - 1; i++) {
+        sum += frame[i];
+    }
+    frame[len - 1] = sum;
+
+    bool corrupt = rng.chance(0.001f);
+    if (corrupt) {
+        frame[3 + rng.next() % (len - 4)] ^= (uint8_t)(1 + rng.next() % 255);
+    }
+    c.add(frame, len);
+    c.plaintext.emplace_back(pt, pt + ptLen);
+    c.valid.push_back(!corrupt);
+}
+
+size_t telemetryPayload(Device& d, SimRandom& rng, uint8_t* out, uint8_t* options) {
+    d.celsius += rng.gaussian(0.1f);
+    bool contact = rng.chance(0.05f);
+    int16_t raw = TelemetryCodec::rawFromCelsius(d.celsius);
+    if (d.telemetryFormat == 0) {
+        putBe16(out, (uint16_t)(int16_t)(d.celsius * 100));
+        out[2] = contact ? 1 : 0;
+        return 3;
+    }
+    *options |= OPTION_EXTENDED;
+    if (d.telemetryFormat == TELEMETRY_TYPED) {
+        const uint8_t typed[] = {TELEMETRY_TYPED, 2, 0x01, (uint8_t)(raw >> 8), (uint8_t)raw,
+                                 0x02, (uint8_t)(contact ? 1 : 0)};
+        memcpy(out, typed, sizeof(typed));
+        return sizeof(typed);
+    }
+    TelemetrySample samples[6];
+    for (uint8_t i = 0; i < 6; i++) {
+        samples[i] = TelemetrySample{(uint32_t)(5 - i) * 600,
+                                     (int16_t)(raw + (int16_t)rng.gaussian(2.0f)), contact};
+    }
+    return TelemetryCodec::encode(samples, 6, out, MAX_PAYLOAD);
+}
+
+size_t metricsPayload(Device& d, SimRandom& rng, uint8_t* out, uint8_t* options) {
+    uint8_t current[REGION_SIZE];
+    memcpy(current, d.metrics, REGION_SIZE);
+    addToField(current, 6, 6 * 60 + rng.next() % 40);        // totalTxTime
+    addToField(current, 10, 8000);                           // totalRxTime
+    addToField(current, 14, 6 * 180 + rng.next() % 100);     // totalActiveTime
+    addToField(current, 18, 3600);                           // totalSleepTime
+    addToField(current, 22, 6);                              // cycleCount
+    addToField(current, 26, 7);                              // txCount
+    addToField(current, 37, 40 + rng.next() % 10);           // totalEnergy
+
+    size_t len = 0;
+    if (d.cycle % 28 != 6) {
+        len = MetricsDelta::encode(MetricsFields::TABLE, MetricsFields::COUNT, d.metrics, current,
+                                   REGION_SIZE, d.baseSequence, out, REGION_SIZE);
+    }
+    if (len > 0) {
+        *options |= OPTION_EXTENDED | OPTION_ACK;
+    } else {
+        memcpy(out, current, REGION_SIZE);
+        len = REGION_SIZE;
+    }
+    memcpy(d.metrics, current, REGION_SIZE);
+    d.baseSequence = d.sequence;            // acknowledged; the next delta builds on it
+    return len;
+}
+
+size_t settingsPayload(uint8_t* out) {
+    memset(out, 0, REGION_SIZE);
+    out[0] = 0x01;
+    putBe16(out + 1, 600);
+    putBe16(out + 3, 10000);
+    out[5] = 22;
+    out[6] = 7;
+    putBe32(out + 8, 915000000);
+    out[12] = 1;
+    putBe16(out + 13, 8000);
+    out[15] = 5;
+    putBe16(out + 17, 6);
+    putBe32(out + 19, GATEWAY_ID);
+    out[33] = 0x01;
+    out[34] = 0x01;
+    out[35] = 0x01;
+    return REGION_SIZE;
+}
+
+Capture syntheticCapture(uint32_t devices, uint32_t frames, uint32_t seed) {
+    SimRandom rng(seed);
+    Capture c;
+    c.name = "synthetic";
+    std::vector<Device> fleet(devices);
+    for (uint32_t n = 0; n < devices; n++) {
+        Device& d = fleet[n];
+        d.id = 0x3C610000 + n * 0x2F;
+        d.adopted = !rng.chance(0.03f);
+        for (uint8_t& b : d.key) {
+            b = (uint8_t)rng.next();
+        }
+        float f = rng.uniform();
+        d.telemetryFormat = f < 0.7f ? 0 : f < 0.9f ? TELEMETRY_COMPACT : TELEMETRY_TYPED;
+        d.sequence = rng.next() % 100000;
+        d.cycle = rng.next() % 7;
+        d.celsius = 2.0f + rng.uniform() * 20.0f;
+        memset(d.metrics, 0, REGION_SIZE);
+        d.metrics[0] = d.metrics[1] = d.metrics[2] = d.metrics[3] = 0x01;
+        putBe16(d.metrics + 4, 330 + rng.next() % 90);
+        d.baseSequence = d.sequence;
+        if (d.adopted) c.keys[d.id] = d.key;
+    }
+
+    uint8_t pt[MAX_PAYLOAD];
+    for (uint32_t i = 0; i < frames; i++) {
+        Device& d = fleet[rng.next() % devices];
+        uint8_t options = OPTIONS_V1;
+        if (rng.chance(0.002f)) {
+            addFrame(c, d, TYPE_SETTINGS, options, pt, settingsPayload(pt), rng);
+        } else if (rng.chance(0.002f)) {
+            const uint8_t response[] = {0x09, 0x00};
+            addFrame(c, d, TYPE_COMMAND_RESPONSE, options, response, sizeof(response), rng);
+        } else if (++d.cycle % 7 == 6) {
+            size_t len = metricsPayload(d, rng, pt, &options);
+            addFrame(c, d, TYPE_METRICS, options, pt, len, rng);
+        } else {
+            size_t len = telemetryPayload(d, rng, pt, &options);
+            addFrame(c, d, TYPE_TELEMETRY, options, pt, len, rng);
+        }
+    }
+    return c;
+}
+
+// ----------------------------------------------------------------------------
+// Decoders under test
+// ----------------------------------------------------------------------------
+// What a gateway script does: one context and key setup per frame
+bool decodeOneShot(const KeyMap& keys, const FrameRef& f, uint8_t* out) {
+    FrameHeader h;
+    const uint8_t* payload;
+    size_t len;
+    if (FrameDecoder::parse(f.data, f.len, &h, &payload, &len) != FrameStatus::OK) return false;
+    auto it = keys.find(h.sourceId);
+    if (it == keys.end() || h.frameType > TYPE_SETTINGS) {
+        memcpy(out, payload, len);
+        return true;
+    }
+    if (len <= GCM_OVERHEAD) return false;
+    uint8_t aad[AAD_SIZE];
+    uint8_t tag[GCM_TAG_SIZE];
+    FrameDecoder::aad(h, aad);
+    size_t ctLen = len - GCM_OVERHEAD;
+    memcpy(tag, payload + GCM_IV_SIZE + ctLen, GCM_TAG_SIZE);
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    int n = 0;
+    bool ok = EVP_DecryptInit_ex(ctx, EVP_aes_128_gcm(), nullptr, it->second.data(), payload) == 1
+        && EVP_DecryptUpdate(ctx, nullptr, &n, aad, AAD_SIZE) == 1
+        && EVP_DecryptUpdate(ctx, out, &n, payload + GCM_IV_SIZE, (int)ctLen) == 1
+        && EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, GCM_TAG_SIZE, tag) == 1
+        && EVP_DecryptFinal_ex(ctx, out + n, &n) == 1;
+    EVP_CIPHER_CTX_free(ctx);
+    return ok;
+}
+
+uint8_t scalarChecksum(const uint8_t* frame, size_t len) {
+    uint8_t sum = 0;
+    for (size_t i = 3; i + 1 < len; i++) {
+        sum += frame[i];
+    }
+    return sum;
+}
+
+SessionKeyCache::Loader keyLoader(const KeyMap& keys) {
+    return [&keys](uint32_t id, uint8_t* key) {
+        auto it = keys.find(id);
+        if (it == keys.end()) return false;
+        memcpy(key, it->second.data(), KEY_SIZE);
+        return true;
+    };
+}
+
+// Batched decode of frames [begin, end), `repeat` times. Returns frames OK
+// in the last pass.
+size_t runBatched(const Capture& c, size_t begin, size_t end, size_t batch, uint32_t repeat) {
+    SessionKeyCache keys(SessionKeyCache::DEFAULT_CAPACITY, keyLoader(c.keys));
+    FrameBatchDecoder decoder(keys);
+    std::vector<DecodedFrame> out(batch);
+    size_t ok = 0;
+    for (uint32_t r = 0; r < repeat; r++) {
+        ok = 0;
+        for (size_t i = begin; i < end; i += batch) {
+            size_t n = end - i < batch ? end - i : batch;
+            ok += decoder.decode(&c.refs[i], n, out.data());
+        }
+    }
+    return ok;
+}
+
+template <typename F>
+double timed(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printRate(const char* label, double frames, double bytes, double sec) {
+    printf("  %-34s %12.0f %10.1f\n", label, frames / sec, bytes / sec / 1e6);
+}
+
+// ----------------------------------------------------------------------------
+// Report
+// ----------------------------------------------------------------------------
+bool verify(const Capture& c, size_t batch) {
+    SessionKeyCache keys(SessionKeyCache::DEFAULT_CAPACITY, keyLoader(c.keys));
+    FrameBatchDecoder decoder(keys);
+    std::vector<DecodedFrame> out(c.refs.size());
+    for (size_t i = 0; i < c.refs.size(); i += batch) {
+        size_t n = c.refs.size() - i < batch ? c.refs.size() - i : batch;
+        decoder.decode(&c.refs[i], n, &out[i]);
+    }
+
+    static const char* KIND_NAMES[KINDS] = {
+        "unknown", "telemetry", "metrics", "metrics delta", "settings", "command response"};
+    size_t byStatus[STATUSES] = {};
+    size_t byKind[KINDS] = {};
+    size_t encrypted = 0;
+    size_t readings = 0;
+    size_t mismatches = 0;
+    for (size_t i = 0; i < out.size(); i++) {
+        const DecodedFrame& d = out[i];
+        byStatus[(size_t)d.status]++;
+        if (d.status == FrameStatus::OK) {
+            byKind[(size_t)d.kind]++;
+            if (d.encrypted) encrypted++;
+            TelemetryReading r[FrameDecoder::MAX_READINGS];
+            readings += FrameDecoder::telemetry(d.header, d.payload, d.payloadLen,
+                                                r, FrameDecoder::MAX_READINGS);
+        }
+        if (c.plaintext.empty()) continue;
+        bool ok = d.status == FrameStatus::OK;
+        if (ok != c.valid[i]
+            || (ok && (d.payloadLen != c.plaintext[i].size()
+                       || memcmp(d.payload, c.plaintext[i].data(), d.payloadLen) != 0))) {
+            if (mismatches++ < 5) {
+                fprintf(stderr, "Frame %zu: %s, expected %s\n", i, frameStatusName(d.status),
+                        c.valid[i] ? "ok" : "a failure");
+            }
+        }
+    }
+
+    printf("Frames: ");
+    for (size_t s = 0; s < STATUSES; s++) {
+        if (byStatus[s] > 0) printf("%s %zu  ", frameStatusName((FrameStatus)s), byStatus[s]);
+    }
+    printf("\n        ");
+    for (size_t k = 0; k < KINDS; k++) {
+        if (byKind[k] > 0) printf("%s %zu  ", KIND_NAMES[k], byKind[k]);
+    }
+    printf("\n        %zu encrypted, %zu telemetry readings, %llu key lookups (%llu misses)\n",
+           encrypted, readings, (unsigned long long)(keys.hits() + keys.misses()),
+           (unsigned long long)keys.misses());
+    if (!c.plaintext.empty()) {
+        printf("Verify: %s (%zu mismatches)\n", mismatches == 0 ? "ok" : "FAILED", mismatches);
+    }
+    return mismatches == 0;
+}
+
+} // namespace
+
+int runDecodeBenchmark(int argc, char** argv) {
+    std::vector<const char*> capturePaths;
+    const char* keysPath = nullptr;
+    uint32_t devices = 2000;
+    uint32_t frames = 200000;
+    uint32_t batch = 256;
+    uint32_t threads = 1;
+    uint32_t repeat = 5;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--decode") == 0) {
+            continue;
+        } else if (val == nullptr) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return 2;
+        } else if (strcmp(arg, "--capture") == 0) {
+            capturePaths.push_back(val); i++;
+        } else if (strcmp(arg, "--keys") == 0) {
+            keysPath = val; i++;
+        } else if (strcmp(arg, "--devices") == 0) {
+            devices = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--frames") == 0) {
+            frames = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--batch") == 0) {
+            batch = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--threads") == 0) {
+            threads = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--repeat") == 0) {
+            repeat = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--seed") == 0) {
+            seed = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return 2;
+        }
+    }
+    if (devices == 0 || frames == 0 || batch == 0 || threads == 0 || repeat == 0) {
+        fprintf(stderr, "Need devices, frames, batch, threads and repeat > 0\n");
+        return 2;
+    }
+
+    Capture c;
+    if (capturePaths.empty()) {
+        c = syntheticCapture(devices, frames, seed);
+    } else {
+        for (const char* path : capturePaths) {
+            if (!loadCapture(path, c)) return 1;
+            c.name += (c.name.empty() ? "" : ", ") + std::string(path);
+        }
+        if (keysPath != nullptr && !loadKeys(keysPath, c.keys)) return 1;
+    }
+    c.finish();
+    if (c.refs.empty()) {
+        fprintf(stderr, "No frames in the capture\n");
+        return 1;
+    }
+    const double n = (double)c.refs.size() * repeat;
+    const double bytes = (double)c.bytes.size() * repeat;
+
+    printf("\n=== Frame Decoder ===\n");
+    printf("Capture: %s, %zu frames, %.1f bytes average, %zu session keys\n",
+           c.name.c_str(), c.refs.size(), (double)c.bytes.size() / c.refs.size(), c.keys.size());
+    bool verified = verify(c, batch);
+
+    uint64_t check = 0;
+    printf("\n  %-34s %12s %10s\n", "Single core", "frames/s", "MB/s");
+    double sec = timed([&] {
+        for (uint32_t r = 0; r < repeat; r++) {
+            for (const FrameRef& f : c.refs) {
+                check += scalarChecksum(f.data, f.len) == f.data[f.len - 1];
+            }
+        }
+    });
+    printRate("checksum, byte loop", n, bytes, sec);
+    sec = timed([&] {
+        for (uint32_t r = 0; r < repeat; r++) {
+            for (const FrameRef& f : c.refs) {
+                check += FrameDecoder::checksum(f.data, f.len) == f.data[f.len - 1];
+            }
+        }
+    });
+    printRate("checksum, SWAR", n, bytes, sec);
+    sec = timed([&] {
+        uint8_t out[MAX_PAYLOAD];
+        for (uint32_t r = 0; r < repeat; r++) {
+            for (const FrameRef& f : c.refs) {
+                check += decodeOneShot(c.keys, f, out);
+            }
+        }
+    });
+    printRate("decode, context per frame", n, bytes, sec);
+    sec = timed([&] { check += runBatched(c, 0, c.refs.size(), batch, repeat); });
+    char label[64];
+    snprintf(label, sizeof(label), "decode, batch %u + key cache", batch);
+    printRate(label, n, bytes, sec);
+
+    if (threads > 1) {
+        std::vector<std::thread> pool;
+        std::vector<size_t> ok(threads);
+        size_t shard = (c.refs.size() + threads - 1) / threads;
+        sec = timed([&] {
+            for (uint32_t t = 0; t < threads; t++) {
+                size_t begin = std::min(c.refs.size(), t * shard);
+                size_t end = std::min(c.refs.size(), begin + shard);
+                pool.emplace_back([&, t, begin, end] { ok[t] = runBatched(c, begin, end, batch, repeat); });
+            }
+            for (std::thread& th : pool) {
+                th.join();
+            }
+        });
+        for (size_t v : ok) {
+            check += v;
+        }
+        // More threads than cores only time-slice
+        uint32_t hw = std::thread::hardware_concurrency();
+        uint32_t cores = hw > 0 && hw < threads ? hw : threads;
+        printf("\n  %u threads on %u cores: %.0f frames/s, %.0f frames/s per core\n",
+               threads, cores, n / sec, n / sec / cores);
+    }
+    printf("\n(check %llu)\n", (unsigned long long)check);
+    return verified ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+#ifndef DECODE_BENCH_H
+#define DECODE_BENCH_H
+
+// ============================================================================
+// Gateway Frame Decode Benchmark
+// ============================================================================
+// Frames per second per core of lib/FrameDecoder on a capture: checksum
+// only (scalar and SWAR), a frame at a time with a fresh GCM context per
+// frame, and batched with the session key cache. Every synthetic frame is
+// checked against the plaintext it was built from.
+//
+//   --decode              run this benchmark instead of the wake-cycle model
+//   --capture FILE        recorded frames, one per line in hex; '#' starts a
+//                         comment (repeatable; synthetic fleet traffic otherwise)
+//   --keys FILE           session keys for the capture, "<sourceId> <key>" in
+//                         hex per line
+//   --devices N           synthetic fleet size (default 2000)
+//   --frames N            synthetic frames (default 200000)
+//   --batch N             frames per decode call (default 256)
+//   --threads N           decoding threads, one cache each (default 1)
+//   --repeat N            passes over the capture per measurement (default 5)
+//   --seed N              RNG seed for the synthetic traffic (default 1)
+//
+// Returns the process exit code.
+int runDecodeBenchmark(int argc, char** argv);
+
+#endif // DECODE_BENCH_H
@@ -0,0 +1,137 @@
+#include "governor_bench.h"
+#include <Airtime.h>
+#include <CpuGovernor.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_clock.h"
+#include "sim_hal.h"
+#include "wake_cycle_model.h"
+
+namespace {
+
+// The simulated clock; the levels themselves are checked in test/test_governor
+class SimClockBackend : public CpuClockBackend {
+public:
+    explicit SimClockBackend(SimClock& clock) : _clock(clock) {}
+
+    uint64_t nowUs() override { return _clock.nowUs(); }
+    void acquire(CpuLevel) override {}
+    void release(CpuLevel) override {}
+
+private:
+    SimClock& _clock;
+};
+
+enum class Op : uint8_t { ENTER, LEAVE };
+
+// One governor call and how long the wake stays there before the next step
+struct Step {
+    Op op;
+    CpuPhase phase;
+    uint32_t thenUs;
+    const char* what;
+};
+
+constexpr uint32_t MS = 1000;
+
+double uWh(float mA, uint64_t us) {
+    return SimEnergy::uWh(mA, us / 1000.0);
+}
+
+} // namespace
+
+int runGovernorBenchmark(int argc, char** argv) {
+    uint32_t waitAfterTx = 8000;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--wait-after-tx") == 0 && i + 1 < argc) {
+            waitAfterTx = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        } else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    using W = WakeCycleModel;
+    const uint32_t telemetryTxUs = Airtime::loraPacketUs(7, 0, 1, 8, W::TELEMETRY_FRAME);
+    const uint32_t metricsTxUs = Airtime::loraPacketUs(7, 0, 1, 8, W::METRICS_FRAME);
+    const uint32_t ackUs = W::GATEWAY_TURNAROUND_MS * MS + Airtime::loraPacketUs(7, 0, 1, 8, W::ACK_FRAME);
+    const uint32_t radioInitUs = SimRadio::INIT_MS * MS;
+    const uint32_t cryptoUs = W::CRYPTO_INIT_MS * MS;
+
+    const Step steps[] = {
+        {Op::ENTER, CpuPhase::BOOT,        2 * MS,              "setup(): FRAM, storage, plan"},
+        {Op::ENTER, CpuPhase::CRYPTO,      cryptoUs,            "bootCrypto()"},
+        {Op::LEAVE, CpuPhase::CRYPTO,      radioInitUs > cryptoUs ? radioInitUs - cryptoUs : 0,
+                                                                "radio init on Core 0"},
+        {Op::LEAVE, CpuPhase::BOOT,        0,                   "first loop() pass"},
+        {Op::ENTER, CpuPhase::SENSOR_IO,   5 * MS,              "TMP112 conversion"},
+        {Op::ENTER, CpuPhase::CRYPTO,      1 * MS,              "Core 0 decrypt overlapping"},
+        {Op::LEAVE, CpuPhase::CRYPTO,      5 * MS,              "sensor read"},
+        {Op::LEAVE, CpuPhase::SENSOR_IO,   0,                   ""},
+        {Op::ENTER, CpuPhase::FLUSH,       2 * MS,              "flushStorage() before TX"},
+        {Op::LEAVE, CpuPhase::FLUSH,       0,                   ""},
+        {Op::ENTER, CpuPhase::CRYPTO,      1 * MS,              "telemetry AES-GCM"},
+        {Op::LEAVE, CpuPhase::CRYPTO,      0,                   ""},
+        {Op::ENTER, CpuPhase::RADIO_WAIT,  telemetryTxUs + ackUs, "TX + ACK"},
+        {Op::ENTER, CpuPhase::CRYPTO,      1 * MS,              "ACK hint decrypt (Core 0)"},
+        {Op::LEAVE, CpuPhase::CRYPTO,      0,                   ""},
+        {Op::LEAVE, CpuPhase::RADIO_WAIT,  0,                   ""},
+        {Op::ENTER, CpuPhase::CRYPTO,      2 * MS,              "metrics AES-GCM"},
+        {Op::LEAVE, CpuPhase::CRYPTO,      0,                   ""},
+        {Op::ENTER, CpuPhase::RADIO_WAIT,  metricsTxUs + waitAfterTx * MS, "TX + command window"},
+        {Op::LEAVE, CpuPhase::RADIO_WAIT,  0,                   ""},
+        {Op::ENTER, CpuPhase::FLUSH,       2 * MS,              "flushBeforeSleep()"},
+        {Op::LEAVE, CpuPhase::FLUSH,       0,                   ""},
+    };
+
+    SimClock clock;
+    SimClockBackend backend(clock);
+    CpuGovernor governor;
+    governor.begin(&backend);
+
+    printf("\n=== CPU Governor: metrics wake ===\n");
+    for (const Step& s : steps) {
+        if (s.op == Op::ENTER) {
+            governor.enter(s.phase);
+        } else {
+            governor.leave(s.phase);
+        }
+        if (s.what[0] != '\0') {
+            printf("  %-5s %-10s -> %3u MHz  %9.1f ms  %s\n", s.op == Op::ENTER ? "enter" : "leave",
+                   CpuGovernor::phaseName(s.phase), governor.currentMhz(), s.thenUs / 1000.0, s.what);
+        }
+        clock.advanceUs(s.thenUs);
+    }
+    governor.settle();
+
+    uint64_t totalUs = 0;
+    for (uint8_t l = 0; l < CpuGovernor::LEVEL_COUNT; l++) {
+        totalUs += governor.levelUs((CpuLevel)l);
+    }
+    double full_uWh = uWh(CpuGovernor::LEVEL_MA[(uint8_t)CpuLevel::FULL], totalUs);
+    double modeled = governor.modeled_uWh(SimEnergy::SUPPLY_V);
+    double saved = governor.saved_uWh(SimEnergy::SUPPLY_V);
+
+    printf("\n%-12s", "Phase");
+    for (uint8_t l = 0; l < CpuGovernor::LEVEL_COUNT; l++) {
+        printf(" %7u MHz", CpuGovernor::LEVEL_MHZ[l]);
+    }
+    printf("\n");
+    for (uint8_t p = 0; p < CpuGovernor::PHASE_COUNT; p++) {
+        printf("%-12s", CpuGovernor::phaseName((CpuPhase)p));
+        for (uint8_t l = 0; l < CpuGovernor::LEVEL_COUNT; l++) {
+            printf(" %8.1f ms", governor.phaseUs((CpuPhase)p, (CpuLevel)l) / 1000.0);
+        }
+        printf("\n");
+    }
+    printf("%-12s", "(all)");
+    for (uint8_t l = 0; l < CpuGovernor::LEVEL_COUNT; l++) {
+        printf(" %8.1f ms", governor.levelUs((CpuLevel)l) / 1000.0);
+    }
+    printf("\n\nMCU energy: %.2f uWh governed, %.2f uWh at %u MHz throughout (%.0f%% saved), %u switches\n",
+           modeled, full_uWh, CpuGovernor::LEVEL_MHZ[(uint8_t)CpuLevel::FULL],
+           full_uWh > 0 ? 100.0 * saved / full_uWh : 0.0, governor.transitions());
+
+    return 0;
+}
@@ -0,0 +1,19 @@
+#ifndef GOVERNOR_BENCH_H
+#define GOVERNOR_BENCH_H
+
+// ============================================================================
+// CPU Governor Report
+// ============================================================================
+// Replays the CpuGovernor phases of a metrics wake (boot, telemetry with an
+// ACK window, metrics with a command window, final flush) on the simulated
+// clock. Phase durations come from the wake cycle model's bench figures.
+// The transition and energy checks are unit tests (test/test_governor).
+//
+//   --governor            run this report instead of the wake-cycle model
+//   --wait-after-tx MS    command window after the metrics frame (default 8000)
+//
+// Prints per-phase time at each frequency and the modeled MCU energy.
+// Returns the process exit code.
+int runGovernorBenchmark(int argc, char** argv);
+
+#endif // GOVERNOR_BENCH_H
@@ -0,0 +1,293 @@
+#include "journal_bench.h"
+#include <Airtime.h>
+#include <EventJournal.h>
+#include <FrameDecoder.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "sim_clock.h"
+#include "sim_hal.h"
+#include "../sensor_layout.h"
+
+namespace {
+
+// The simulated FRAM, with a power cut after a given number of writes
+class SimJournalStorage : public JournalStorage {
+public:
+    explicit SimJournalStorage(SimFram& fram) : _fram(fram) {}
+
+    void read(uint16_t addr, uint8_t* buf, size_t len) override { _fram.read(addr, buf, len); }
+
+    void write(uint16_t addr, const uint8_t* data, size_t len) override {
+        if (_writesLeft == 0) return;
+        if (_writesLeft > 0 && --_writesLeft == 0 && len > _tornLength) {
+            len = _tornLength;
+        }
+        _fram.write(addr, data, len);
+    }
+
+    // Only the next `writes` writes reach the FRAM, the last of them cut
+    // after `tornLength` bytes
+    void cutAfter(int writes, size_t tornLength = SIZE_MAX) {
+        _writesLeft = writes;
+        _tornLength = tornLength;
+    }
+    void restore() { _writesLeft = -1; }
+
+private:
+    SimFram& _fram;
+    int _writesLeft = -1;
+    size_t _tornLength = SIZE_MAX;
+};
+
+class Checker {
+public:
+    void fail(const char* what, long a = 0, long b = 0) {
+        printf("  FAIL: %s (%ld, %ld)\n", what, a, b);
+        _failures++;
+    }
+    uint32_t failures() const { return _failures; }
+
+private:
+    uint32_t _failures = 0;
+};
+
+bool same(const JournalRecord& a, const JournalRecord& b) {
+    return a.cycle == b.cycle && a.wake == b.wake && a.tx == b.tx && a.flags == b.flags
+        && a.ackRssi == b.ackRssi && a.ackSnr == b.ackSnr
+        && a.batteryCentivolts == b.batteryCentivolts && a.awakeMs == b.awakeMs;
+}
+
+// One wake's record, roughly as the firmware would see it
+JournalRecord randomWake(SimRandom& rng, uint16_t cycle, float ackLoss, uint16_t& battery) {
+    JournalRecord r;
+    r.cycle = cycle;
+    r.wake = rng.chance(0.02f) ? JournalWake::BUTTON
+           : rng.chance(0.05f) ? JournalWake::CONTACT : JournalWake::TIMER;
+    if (rng.chance(0.001f)) {
+        r.flags |= JournalFlag::BROWNOUT;
+    }
+    if (rng.chance(0.1f)) {
+        r.flags |= JournalFlag::RADIO_OFF;
+    } else if (rng.chance(ackLoss)) {
+        r.tx = JournalTx::NO_ACK;
+    } else {
+        r.tx = JournalTx::ACKED;
+        r.ackRssi = (int8_t)(-70 - (int)(rng.uniform() * 50));
+        r.ackSnr = (int8_t)(9 - (int)(rng.uniform() * 20));
+    }
+    if (cycle % 6 == 0 && r.tx != JournalTx::NONE) {
+        r.flags |= JournalFlag::METRICS_SENT;
+    }
+    if (rng.chance(0.01f) && battery > 300) battery--;
+    r.batteryCentivolts = battery;
+    r.awakeMs = (uint16_t)(120 + rng.uniform() * (r.flags & JournalFlag::METRICS_SENT ? 8200 : 400));
+    return r;
+}
+
+// Reads every page; returns the records, newest first
+std::vector<JournalRecord> fetchAll(const EventJournal& journal, Checker& check,
+                                    uint32_t* pages, uint32_t* bytes, uint32_t* damaged) {
+    std::vector<JournalRecord> all;
+    uint8_t page = 0;
+    uint8_t pageCount = 1;
+    *pages = *bytes = *damaged = 0;
+    do {
+        uint8_t buf[EventJournal::PAGE_SIZE];
+        size_t len = journal.buildPage(page, buf, sizeof(buf));
+        if (len == 0) {
+            check.fail("page not built", page, pageCount);
+            break;
+        }
+        EventJournal::PageInfo info;
+        JournalRecord records[EventJournal::PAGE_RECORDS];
+        int n = EventJournal::parsePage(buf, len, &info, records, EventJournal::PAGE_RECORDS);
+        if (n < 0 || info.page != page) {
+            check.fail("page did not parse", page, n);
+            break;
+        }
+        all.insert(all.end(), records, records + n);
+        pageCount = info.pageCount;
+        *pages += 1;
+        *bytes += 2 + len;          // command id and response code ahead of the page
+        *damaged += info.damaged;
+        page++;
+    } while (page < pageCount);
+    if (journal.buildPage(page, nullptr, 0) != 0 && journal.count() > 0) {
+        check.fail("page past the end was built", page, 0);
+    }
+    return all;
+}
+
+void compare(const std::vector<JournalRecord>& got, const std::vector<JournalRecord>& appended,
+             size_t skipNewest, Checker& check) {
+    for (size_t i = 0; i < got.size(); i++) {
+        size_t at = appended.size() - 1 - skipNewest - i;
+        if (at >= appended.size() || !same(got[i], appended[at])) {
+            check.fail("record differs from the one appended", (long)i, got[i].cycle);
+            return;
+        }
+    }
+}
+
+} // namespace
+
+int runJournalBenchmark(int argc, char** argv) {
+    uint32_t wakes = 2000;
+    float ackLoss = 0.05f;
+    uint32_t seed = 1;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--wakes") == 0 && i + 1 < argc) {
+            wakes = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        } else if (strcmp(argv[i], "--ack-loss") == 0 && i + 1 < argc) {
+            ackLoss = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        } else {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    constexpr uint16_t BASE = FreeRegion::EVENT_JOURNAL;
+    constexpr uint16_t CAPACITY = FreeRegion::EVENT_JOURNAL_CAPACITY;
+    static_assert(EventJournal::regionSize(CAPACITY) == FreeRegion::EVENT_JOURNAL_SIZE, "journal layout");
+
+    SimClock clock;
+    SimFram fram(clock);
+    SimJournalStorage storage(fram);
+    SimRandom rng(seed);
+    Checker check;
+    std::vector<JournalRecord> appended;
+
+    printf("\n=== Event Journal: %u wakes, %u-record ring at 0x%04X ===\n", wakes, CAPACITY, BASE);
+
+    EventJournal journal;
+    if (journal.begin(&storage, BASE, CAPACITY)) {
+        check.fail("erased FRAM taken for a journal");
+    }
+
+    // Steady state: one append per wake, each wake a fresh boot
+    uint16_t battery = 360;
+    uint64_t appendUs = 0;
+    uint32_t appendBytes = 0;
+    uint32_t appendBursts = 0;
+    for (uint32_t w = 1; w <= wakes; w++) {
+        EventJournal boot;
+        if (!boot.begin(&storage, BASE, CAPACITY)) {
+            check.fail("journal lost across a reboot", (long)w);
+        }
+        JournalRecord r = randomWake(rng, (uint16_t)w, ackLoss, battery);
+        fram.resetCounters();
+        uint64_t start = clock.nowUs();
+        boot.append(r);
+        appendUs += clock.nowUs() - start;
+        appendBytes += fram.bytesWritten;
+        appendBursts += fram.transactions / 2;      // WREN + WRITE per burst
+        appended.push_back(r);
+        journal = boot;
+    }
+    if (journal.count() != (wakes < CAPACITY ? wakes : CAPACITY)) {
+        check.fail("record count", journal.count(), wakes < CAPACITY ? wakes : CAPACITY);
+    }
+
+    uint32_t pages = 0;
+    uint32_t bytes = 0;
+    uint32_t damaged = 0;
+    std::vector<JournalRecord> all = fetchAll(journal, check, &pages, &bytes, &damaged);
+    if (all.size() != journal.count() || damaged != 0) {
+        check.fail("records read back", (long)all.size(), damaged);
+    }
+    compare(all, appended, 0, check);
+    printf("  steady state: %u records held, %u pages, newest cycle %u\n",
+           journal.count(), pages, all.empty() ? 0 : all[0].cycle);
+
+    // Power cut between the record and the header: that record is lost (and
+    // the oldest, once the ring is full)
+    if (wakes > 0) {
+        bool full = journal.count() == CAPACITY;
+        JournalRecord r = randomWake(rng, (uint16_t)(wakes + 1), ackLoss, battery);
+        storage.cutAfter(full ? 2 : 1);
+        journal.append(r);
+        storage.restore();
+        EventJournal reboot;
+        uint16_t expect = full ? CAPACITY - 1 : (uint16_t)wakes;
+        if (!reboot.begin(&storage, BASE, CAPACITY) || reboot.count() != expect) {
+            check.fail("power cut before the header write", reboot.count(), expect);
+        }
+        std::vector<JournalRecord> after = fetchAll(reboot, check, &pages, &bytes, &damaged);
+        if (after.size() != expect || damaged != 0) {
+            check.fail("records after the power cut", (long)after.size(), damaged);
+        }
+        compare(after, appended, 0, check);
+        journal = reboot;
+        printf("  power cut before the header write: %u records intact, the new one lost\n", reboot.count());
+    }
+
+    // A corrupted slot: its CRC fails, the others still decode
+    if (journal.count() > 2) {
+        uint16_t head;
+        uint8_t header[EventJournal::HEADER_SIZE];
+        fram.read(BASE, header, sizeof(header));
+        head = (uint16_t)(header[2] << 8 | header[3]);
+        uint16_t slot = (uint16_t)((head + CAPACITY - 2) % CAPACITY);      // second newest
+        uint16_t addr = BASE + EventJournal::HEADER_SIZE + slot * EventJournal::RECORD_SIZE + 7;
+        uint8_t byte;
+        fram.read(addr, &byte, 1);
+        byte ^= 0x10;
+        fram.write(addr, &byte, 1);
+        std::vector<JournalRecord> after = fetchAll(journal, check, &pages, &bytes, &damaged);
+        if (damaged != 1 || after.size() != journal.count() - 1u) {
+            check.fail("damaged slot not reported", damaged, (long)after.size());
+        } else if (!same(after[0], appended.back()) || !same(after[1], appended[appended.size() - 3])) {
+            check.fail("records around the damaged slot", after[0].cycle, after[1].cycle);
+        }
+        byte ^= 0x10;
+        fram.write(addr, &byte, 1);
+        printf("  flipped bit in one slot: reported damaged, %zu others intact\n", after.size());
+    }
+
+    // A torn header write restarts the journal empty
+    {
+        bool full = journal.count() == CAPACITY;
+        JournalRecord r = randomWake(rng, (uint16_t)(wakes + 2), ackLoss, battery);
+        storage.cutAfter(full ? 3 : 2, 4);      // new head, stale count and CRC
+        journal.append(r);
+        storage.restore();
+        EventJournal reboot;
+        if (reboot.begin(&storage, BASE, CAPACITY) || reboot.count() != 0) {
+            check.fail("torn header accepted", reboot.count(), 0);
+        }
+        uint8_t buf[EventJournal::PAGE_SIZE];
+        if (reboot.buildPage(0, buf, sizeof(buf)) != EventJournal::PAGE_HEADER_SIZE) {
+            check.fail("empty journal page 0");
+        }
+        printf("  torn header write: journal restarted empty\n");
+    }
+
+    // Cost
+    double perWakeUs = wakes > 0 ? (double)appendUs / wakes : 0.0;
+    printf("\nPer wake: %.1f FRAM bytes in %.1f bursts, %.1f us SPI, %.4f uWh at %.0f mA\n",
+           wakes > 0 ? (double)appendBytes / wakes : 0.0, wakes > 0 ? (double)appendBursts / wakes : 0.0,
+           perWakeUs, SimEnergy::uWh(SimEnergy::MCU_ACTIVE_MA, perWakeUs / 1000.0), SimEnergy::MCU_ACTIVE_MA);
+
+    uint32_t fullPages = (CAPACITY + EventJournal::PAGE_RECORDS - 1) / EventJournal::PAGE_RECORDS;
+    size_t pageFrame = ResonantWire::FRAME_OVERHEAD + ResonantWire::GCM_OVERHEAD + 2 + EventJournal::PAGE_SIZE;
+    printf("Full journal: %u pages of %u records, %zu-byte frames (%zu-byte payload)\n",
+           fullPages, EventJournal::PAGE_RECORDS, pageFrame, 2 + EventJournal::PAGE_SIZE);
+    const uint8_t sfs[] = {7, 10, 12};
+    for (uint8_t sf : sfs) {
+        uint32_t us = Airtime::loraPacketUs(sf, 0, 1, 8, pageFrame);
+        printf("  SF%-2u BW125: %7.1f ms per page, %6.1f s for all, %u commands\n", sf, us / 1000.0,
+               us * (double)fullPages / 1e6,
+               (fullPages + EventJournal::MAX_PAGES_PER_COMMAND - 1) / EventJournal::MAX_PAGES_PER_COMMAND);
+    }
+
+    if (check.failures() > 0) {
+        printf("%u check(s) FAILED\n", check.failures());
+        return 1;
+    }
+    printf("All journal checks passed\n");
+    return 0;
+}
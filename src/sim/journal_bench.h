@@ -0,0 +1,28 @@
+#ifndef JOURNAL_BENCH_H
+#define JOURNAL_BENCH_H
+
+// ============================================================================
+// Event Journal Check
+// ============================================================================
+// Appends one lib/EventJournal record per simulated wake to the simulated
+// FRAM at the firmware's address and capacity, then reads the whole
+// journal back page by page as the gateway would (CMD_READ_JOURNAL) and
+// compares it against the records appended.
+//
+// Also checked:
+//   - a power cut between a record and its header write loses only that
+//     record; a reboot finds the journal as it was
+//   - a torn header write restarts the journal empty
+//   - a damaged slot is reported by its CRC and the rest of the page
+//     still decodes
+//
+//   --journal             run this check instead of the wake-cycle model
+//   --wakes N             wakes to record (default 2000, wraps the ring)
+//   --ack-loss P          probability a telemetry ACK is lost (default 0.05)
+//   --seed N              RNG seed (default 1)
+//
+// Prints the FRAM cost per wake and the airtime to fetch the journal.
+// Returns the process exit code (1 on any mismatch).
+int runJournalBenchmark(int argc, char** argv);
+
+#endif // JOURNAL_BENCH_H
@@ -0,0 +1,246 @@
+#include "lifetime_sim.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "wake_cycle_model.h"
+
+namespace {
+
+constexpr size_t CONTEXTS = CycleResult::CONTEXTS;
+
+struct DeviceResult {
+    double days = 0.0;
+    double consumed_mAh = 0.0;
+    double lifetimeDays = 0.0;
+    uint64_t txMs = 0;
+    uint64_t txMsBy[CONTEXTS] = {};
+    uint64_t rxMsBy[CONTEXTS] = {};
+    uint64_t framesBy[CONTEXTS] = {};
+    uint64_t lostBy[CONTEXTS] = {};
+    double awake_uWh = 0.0;
+    double sleep_uWh = 0.0;
+};
+
+// Binary (exactly 207 bytes) or hex text, whitespace and separators ignored
+bool loadSettingsFile(const char* path, uint8_t* out) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> raw;
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        raw.push_back((uint8_t)c);
+    }
+    fclose(f);
+
+    if (raw.size() == SimStorage::PAYLOAD_SIZE) {
+        memcpy(out, raw.data(), SimStorage::PAYLOAD_SIZE);
+        return true;
+    }
+    size_t n = 0;
+    int high = -1;
+    for (size_t i = 0; i < raw.size(); i++) {
+        if (raw[i] == '0' && i + 1 < raw.size() && (raw[i + 1] == 'x' || raw[i + 1] == 'X')) {
+            i++;
+            continue;
+        }
+        if (!isxdigit(raw[i])) continue;
+        int v = isdigit(raw[i]) ? raw[i] - '0' : tolower(raw[i]) - 'a' + 10;
+        if (high < 0) {
+            high = v;
+        } else if (n < SimStorage::PAYLOAD_SIZE) {
+            out[n++] = (uint8_t)(high << 4 | v);
+            high = -1;
+        } else {
+            n++;
+            break;
+        }
+    }
+    if (n != SimStorage::PAYLOAD_SIZE) {
+        fprintf(stderr, "%s: expected %zu settings bytes\n", path, SimStorage::PAYLOAD_SIZE);
+        return false;
+    }
+    return true;
+}
+
+DeviceResult runDevice(const SimScenario& scenario, float capacity_mAh, uint32_t days) {
+    WakeCycleModel model(scenario);
+    model.battery.capacity_mAh = capacity_mAh;
+
+    DeviceResult d;
+    uint64_t simMs = 0;
+    const uint64_t endMs = (uint64_t)days * 86400000ULL;
+    while (simMs < endMs) {
+        CycleResult r = model.runCycle();
+        simMs += r.awakeMs + (uint64_t)r.sleepS * 1000;
+        d.txMs += r.txMs;
+        d.awake_uWh += r.awake_uWh;
+        d.sleep_uWh += r.sleep_uWh;
+        for (size_t i = 0; i < CONTEXTS; i++) {
+            d.txMsBy[i] += r.txMsBy[i];
+            d.rxMsBy[i] += r.rxMsBy[i];
+            d.framesBy[i] += r.framesBy[i];
+            d.lostBy[i] += r.lostBy[i];
+        }
+    }
+    d.days = simMs / 86400000.0;
+    d.consumed_mAh = model.battery.consumed_mAh;
+    double perDay = d.days > 0 ? d.consumed_mAh / d.days : 0.0;
+    d.lifetimeDays = perDay > 0 ? capacity_mAh / perDay : 0.0;
+    return d;
+}
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[i];
+}
+
+void printProfile(const SimScenario& s, float capacity_mAh, uint32_t devices, float snrSpread, uint32_t days) {
+    static const uint16_t BW_KHZ[] = {125, 250, 500};
+    printf("\n=== Battery Lifetime ===\n");
+    printf("%s\n", WakeCycleModel::DISCLAIMER);
+    printf("Settings: interval %us, metrics every %u, waitAfterTx %u ms, ACK %s, SF%u/BW%u/CR4-%u, %+d dBm\n",
+           s.telemetryInterval, s.metricsInterval, s.waitAfterTx, s.telemetryAckRequired ? "yes" : "no",
+           s.spreadingFactor, BW_KHZ[s.bandwidth < 3 ? s.bandwidth : 2], s.codingRate + 4, s.txPower);
+    printf("          batch %u, deadband %u centi-C, heartbeat %us, TMP112 %s, full metrics every %u, downlink gate %s\n",
+           s.batchSize, s.deadbandCenti, s.heartbeatS, s.sensorOneShot ? "one-shot" : "continuous",
+           s.metricsFullEvery, s.downlinkGate ? "on" : "off");
+    if (s.worSniffMs > 0) {
+        printf("          wake-on-radio sniff every %u ms (+%.0f uA asleep, command latency <= %u ms)\n",
+               s.worSniffMs, SimEnergy::MCU_LIGHT_SLEEP_EXTRA_UA + WakeCycleModel::worSniffUa(s), s.worSniffMs);
+    }
+    printf("Battery: %.0f mAh  link: %.1f dB SNR, %.1f dB fading", capacity_mAh, s.linkSnrDb, s.linkFadeDb);
+    if (devices > 1) {
+        printf(", %.1f dB spread", snrSpread);
+    }
+    printf("  devices: %u  days: %u\n", devices, days);
+}
+
+} // namespace
+
+int runLifetimeSimulation(int argc, char** argv) {
+    SimScenario scenario;
+    scenario.linkModel = true;
+    float capacity_mAh = 2600.0f;
+    float snrSpread = 0.0f;
+    uint32_t devices = 1;
+    uint32_t days = 30;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--lifetime") == 0) {
+            continue;
+        } else if (val == nullptr) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return 2;
+        } else if (strcmp(arg, "--settings") == 0) {
+            uint8_t blob[SimStorage::PAYLOAD_SIZE];
+            if (!loadSettingsFile(val, blob)) return 1;
+            if (!scenario.loadSettings(blob, sizeof(blob))) {
+                fprintf(stderr, "%s: not a settings payload\n", val);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--battery-mah") == 0) {
+            capacity_mAh = strtof(val, nullptr); i++;
+        } else if (strcmp(arg, "--snr") == 0) {
+            scenario.linkSnrDb = strtof(val, nullptr); i++;
+        } else if (strcmp(arg, "--fade") == 0) {
+            scenario.linkFadeDb = strtof(val, nullptr); i++;
+        } else if (strcmp(arg, "--devices") == 0) {
+            devices = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--snr-spread") == 0) {
+            snrSpread = strtof(val, nullptr); i++;
+        } else if (strcmp(arg, "--days") == 0) {
+            days = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--seed") == 0) {
+            scenario.seed = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return 2;
+        }
+    }
+    if (devices == 0 || days == 0 || scenario.telemetryInterval == 0 || capacity_mAh <= 0) {
+        fprintf(stderr, "Need devices, days, telemetryInterval and capacity > 0\n");
+        return 2;
+    }
+
+    // Each device gets its own RNG stream and its own link
+    SimRandom fleetRng(scenario.seed);
+    std::vector<DeviceResult> results;
+    results.reserve(devices);
+    auto hostStart = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < devices; n++) {
+        SimScenario device = scenario;
+        device.seed = scenario.seed + n * 7919;
+        device.linkSnrDb = scenario.linkSnrDb + (snrSpread > 0 ? fleetRng.gaussian(snrSpread) : 0.0f);
+        results.push_back(runDevice(device, capacity_mAh, days));
+    }
+    double hostSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+
+    printProfile(scenario, capacity_mAh, devices, snrSpread, days);
+
+    // Per frame type, averaged over the fleet, per simulated day
+    double fleetDays = 0.0;
+    DeviceResult sum;
+    for (const DeviceResult& d : results) {
+        fleetDays += d.days;
+        sum.txMs += d.txMs;
+        sum.awake_uWh += d.awake_uWh;
+        sum.sleep_uWh += d.sleep_uWh;
+        for (size_t i = 0; i < CONTEXTS; i++) {
+            sum.txMsBy[i] += d.txMsBy[i];
+            sum.rxMsBy[i] += d.rxMsBy[i];
+            sum.framesBy[i] += d.framesBy[i];
+            sum.lostBy[i] += d.lostBy[i];
+        }
+    }
+
+    // Radio + MCU while the frame is on air and while its listen window is open
+    const float txMa = SimEnergy::radioTxMa(scenario.txPower) + SimEnergy::MCU_ACTIVE_MA;
+    const float rxMa = SimEnergy::RADIO_RX_MA + SimEnergy::MCU_ACTIVE_MA;
+    printf("\n%-20s %10s %7s %11s %11s %11s %9s\n",
+           "Frame type", "Frames/day", "Lost %", "Airtime ms", "TX ms/day", "RX ms/day", "mWh/day");
+    for (size_t i = 1; i < CONTEXTS; i++) {
+        if (sum.framesBy[i] == 0) continue;
+        double frames = sum.framesBy[i] / fleetDays;
+        double tx = sum.txMsBy[i] / fleetDays;
+        double rx = sum.rxMsBy[i] / fleetDays;
+        double mWh = (SimEnergy::uWh(txMa, tx) + SimEnergy::uWh(rxMa, rx)) / 1000.0;
+        printf("%-20s %10.2f %7.2f %11.1f %11.1f %11.1f %9.3f\n",
+               txContextName((SimTxContext)i), frames, 100.0 * sum.lostBy[i] / sum.framesBy[i],
+               (double)sum.txMsBy[i] / sum.framesBy[i], tx, rx, mWh);
+    }
+
+    double awakeDay = sum.awake_uWh / fleetDays / 1000.0;
+    double sleepDay = sum.sleep_uWh / fleetDays / 1000.0;
+    printf("\nEnergy: %.2f mWh/day (awake %.2f + asleep %.2f), airtime %.1f s/day\n",
+           awakeDay + sleepDay, awakeDay, sleepDay, sum.txMs / fleetDays / 1000.0);
+
+    std::vector<double> lifetimes;
+    std::vector<double> airtimes;
+    for (const DeviceResult& d : results) {
+        lifetimes.push_back(d.lifetimeDays);
+        airtimes.push_back(d.txMs / d.days / 1000.0);
+    }
+    if (devices == 1) {
+        printf("Lifetime: %.0f days (%.2f years)\n", lifetimes[0], lifetimes[0] / 365.25);
+    } else {
+        printf("Lifetime days: min %.0f  p5 %.0f  median %.0f  p95 %.0f  max %.0f\n",
+               percentile(lifetimes, 0.0), percentile(lifetimes, 0.05), percentile(lifetimes, 0.5),
+               percentile(lifetimes, 0.95), percentile(lifetimes, 1.0));
+        printf("Airtime s/day:  median %.1f  p95 %.1f  max %.1f\n",
+               percentile(airtimes, 0.5), percentile(airtimes, 0.95), percentile(airtimes, 1.0));
+    }
+    printf("Host: %.3f s\n", hostSec);
+    return 0;
+}
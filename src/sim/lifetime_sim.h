@@ -0,0 +1,28 @@
+#ifndef LIFETIME_SIM_H
+#define LIFETIME_SIM_H
+
+// ============================================================================
+// Battery Lifetime What-If
+// ============================================================================
+// Runs the wake-cycle model for a settings profile over a fleet of devices.
+// It reports, per frame type:
+//   - frames, time on air and energy per day
+//   - frames lost on the link
+// It also reports battery lifetime across the fleet. Like the wake-cycle
+// benchmark these are model estimates (WakeCycleModel), not the firmware.
+//
+//   --lifetime            run this instead of the wake-cycle benchmark
+//   --settings FILE       207-byte settings payload in the wire layout, as
+//                         binary or hex text (factory defaults, 600 s otherwise)
+//   --battery-mah N       usable battery capacity (default 2600)
+//   --snr DB              link SNR at SF7/BW125/+22 dBm (default 10)
+//   --fade DB             per-frame fading, standard deviation (default 3)
+//   --devices N           fleet size (default 1)
+//   --snr-spread DB       per-device SNR standard deviation (default 0)
+//   --days N              simulated days per device (default 30)
+//   --seed N              RNG seed (default 1)
+//
+// Returns the process exit code.
+int runLifetimeSimulation(int argc, char** argv);
+
+#endif // LIFETIME_SIM_H
@@ -0,0 +1,23 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Virtual Clock
+// ============================================================================
+// Simulated time base shared by every host stand-in. Nothing sleeps for real;
+// peripherals advance the clock by the duration the hardware would take.
+class SimClock {
+public:
+    uint64_t nowUs() const { return _nowUs; }
+    uint32_t millis() const { return (uint32_t)(_nowUs / 1000); }
+
+    void advanceUs(uint64_t us) { _nowUs += us; }
+    void advanceMs(uint32_t ms) { _nowUs += (uint64_t)ms * 1000; }
+
+private:
+    uint64_t _nowUs = 0;
+};
+
+#endif // SIM_CLOCK_H
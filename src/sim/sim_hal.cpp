@@ -0,0 +1,318 @@
+#include "sim_hal.h"
+#include <Airtime.h>
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+// SimEnergy
+// ============================================================================
+float SimEnergy::radioTxMa(int8_t dBm) {
+    static const struct { int8_t dBm; float mA; } POINTS[] = {
+        {14, 45.0f}, {17, 90.0f}, {20, 102.0f}, {22, RADIO_TX_MA}
+    };
+    if (dBm <= POINTS[0].dBm) return POINTS[0].mA;
+    for (size_t i = 1; i < sizeof(POINTS) / sizeof(POINTS[0]); i++) {
+        if (dBm <= POINTS[i].dBm) {
+            float t = (float)(dBm - POINTS[i - 1].dBm) / (POINTS[i].dBm - POINTS[i - 1].dBm);
+            return POINTS[i - 1].mA + t * (POINTS[i].mA - POINTS[i - 1].mA);
+        }
+    }
+    return RADIO_TX_MA;
+}
+
+float SimEnergy::demodFloorDb(uint8_t sf) {
+    static const float FLOOR[] = {-7.5f, -10.0f, -12.5f, -15.0f, -17.5f, -20.0f};
+    if (sf < 7) sf = 7;
+    if (sf > 12) sf = 12;
+    return FLOOR[sf - 7];
+}
+
+// ============================================================================
+// SimRandom
+// ============================================================================
+uint32_t SimRandom::next() {
+    _state ^= _state << 13;
+    _state ^= _state >> 17;
+    _state ^= _state << 5;
+    return _state;
+}
+
+float SimRandom::uniform() {
+    return (next() >> 8) * (1.0f / 16777216.0f);
+}
+
+bool SimRandom::chance(float probability) {
+    return uniform() < probability;
+}
+
+float SimRandom::gaussian(float stddev) {
+    // Irwin-Hall approximation, good enough for sensor noise
+    float sum = 0.0f;
+    for (int i = 0; i < 12; i++) {
+        sum += uniform();
+    }
+    return (sum - 6.0f) * stddev;
+}
+
+// ============================================================================
+// SimFram
+// ============================================================================
+SimFram::SimFram(SimClock& clock) : _clock(clock) {
+    memset(_mem, 0xFF, sizeof(_mem));
+}
+
+void SimFram::chargeTransaction(size_t bytesOnBus) {
+    transactions++;
+    // 8 bits per byte at SPI_HZ, plus ~2 us CS setup/teardown
+    _clock.advanceUs(2 + (uint64_t)bytesOnBus * 8 * 1000000 / SPI_HZ);
+}
+
+bool SimFram::begin() {
+    // RDID: opcode + 4 ID bytes
+    chargeTransaction(5);
+    return true;
+}
+
+bool SimFram::selfTest() {
+    // Write/readback of a test pattern at the last address, then restore
+    uint8_t saved;
+    read(SIZE - 1, &saved, 1);
+    uint8_t pattern = 0xA5;
+    write(SIZE - 1, &pattern, 1);
+    uint8_t check;
+    read(SIZE - 1, &check, 1);
+    write(SIZE - 1, &saved, 1);
+    return check == pattern;
+}
+
+void SimFram::read(uint16_t addr, uint8_t* buf, size_t len) {
+    memcpy(buf, _mem + addr, len);
+    bytesRead += len;
+    chargeTransaction(3 + len);            // READ opcode + 16-bit address
+}
+
+void SimFram::write(uint16_t addr, const uint8_t* data, size_t len) {
+    memcpy(_mem + addr, data, len);
+    bytesWritten += len;
+    chargeTransaction(1);                  // WREN
+    chargeTransaction(3 + len);            // WRITE opcode + 16-bit address
+}
+
+// ============================================================================
+// SimStorage
+// ============================================================================
+uint16_t SimStorage::regionAddr(SimRegion r) {
+    switch (r) {
+        case SimRegion::SETTINGS: return SETTINGS_ADDR;
+        case SimRegion::METRICS:  return METRICS_ADDR;
+        default:                  return SCRATCHPAD_ADDR;
+    }
+}
+
+size_t SimStorage::regionSize(SimRegion r) {
+    return r == SimRegion::SCRATCHPAD ? SCRATCHPAD_SIZE : PAYLOAD_SIZE;
+}
+
+uint8_t* SimStorage::region(SimRegion r) {
+    switch (r) {
+        case SimRegion::SETTINGS: return _settings;
+        case SimRegion::METRICS:  return _metrics;
+        default:                  return _scratchpad;
+    }
+}
+
+const uint8_t* SimStorage::region(SimRegion r) const {
+    return const_cast<SimStorage*>(this)->region(r);
+}
+
+bool SimStorage::begin() {
+    _fram.read(SETTINGS_ADDR, _settings, PAYLOAD_SIZE);
+    _fram.read(METRICS_ADDR, _metrics, PAYLOAD_SIZE);
+    _fram.read(SCRATCHPAD_ADDR, _scratchpad, SCRATCHPAD_SIZE);
+
+    if (_settings[0] == 0xFF) {
+        factoryDefaults();
+        _fram.write(FACTORY_ADDR, _settings, PAYLOAD_SIZE);
+        flush();
+    }
+    return true;
+}
+
+void SimStorage::factoryDefaults() {
+    memset(_settings, 0, sizeof(_settings));
+    memset(_metrics, 0, sizeof(_metrics));
+    memset(_scratchpad, 0, sizeof(_scratchpad));
+
+    _settings[0] = 0x01;
+    put16(SimRegion::SETTINGS, S_TELEMETRY_INTERVAL, 5);
+    put16(SimRegion::SETTINGS, S_TELEMETRY_MAX_WAKE, 5000);
+    put8(SimRegion::SETTINGS, S_TX_POWER, 22);
+    put8(SimRegion::SETTINGS, S_SPREADING_FACTOR, 7);
+    put8(SimRegion::SETTINGS, S_BANDWIDTH, 0);
+    put32(SimRegion::SETTINGS, S_FREQUENCY, 915000000);
+    put8(SimRegion::SETTINGS, S_CODING_RATE, 1);
+    put16(SimRegion::SETTINGS, S_WAIT_AFTER_TX, 8000);
+    put8(SimRegion::SETTINGS, S_ACK_FAIL_THRESHOLD, 5);
+    put8(SimRegion::SETTINGS, S_TELEMETRY_ACK, 0);
+    put16(SimRegion::SETTINGS, S_METRICS_INTERVAL, 6);
+    put32(SimRegion::SETTINGS, S_PARENT_ID, 0xFFFFFFFF);
+    _settings[33] = 0x01;
+    _settings[34] = 0x01;
+    _settings[35] = 0x01;
+
+    _metrics[0] = 0x01;
+    _metrics[1] = 0x01;
+    _metrics[2] = 0x01;
+    _metrics[3] = 0x01;
+    put32(SimRegion::SCRATCHPAD, P_TX_SEQUENCE, 1);
+
+    _dirty[0] = _dirty[1] = _dirty[2] = true;
+}
+
+void SimStorage::flush() {
+    for (uint8_t i = 0; i < 3; i++) {
+        if (!_dirty[i]) continue;
+        SimRegion r = (SimRegion)i;
+        _fram.write(regionAddr(r), region(r), regionSize(r));
+        _dirty[i] = false;
+    }
+}
+
+uint8_t SimStorage::get8(SimRegion r, uint16_t off) const {
+    return region(r)[off];
+}
+
+uint16_t SimStorage::get16(SimRegion r, uint16_t off) const {
+    const uint8_t* p = region(r) + off;
+    return ((uint16_t)p[0] << 8) | p[1];
+}
+
+uint32_t SimStorage::get32(SimRegion r, uint16_t off) const {
+    const uint8_t* p = region(r) + off;
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+void SimStorage::put8(SimRegion r, uint16_t off, uint8_t v) {
+    region(r)[off] = v;
+    _dirty[(uint8_t)r] = true;
+}
+
+void SimStorage::put16(SimRegion r, uint16_t off, uint16_t v) {
+    uint8_t* p = region(r) + off;
+    p[0] = v >> 8;
+    p[1] = v & 0xFF;
+    _dirty[(uint8_t)r] = true;
+}
+
+void SimStorage::put32(SimRegion r, uint16_t off, uint32_t v) {
+    uint8_t* p = region(r) + off;
+    p[0] = v >> 24;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+    _dirty[(uint8_t)r] = true;
+}
+
+bool SimStorage::isAdopted() const {
+    return get32(SimRegion::SETTINGS, S_PARENT_ID) != 0xFFFFFFFF;
+}
+
+bool SimStorage::isMetricsDue() const {
+    uint16_t interval = get16(SimRegion::SETTINGS, S_METRICS_INTERVAL);
+    return interval > 0 && get16(SimRegion::METRICS, M_TELEMETRY_SINCE) >= interval;
+}
+
+void SimStorage::setParentID(const uint8_t id[4]) {
+    memcpy(_settings + S_PARENT_ID, id, 4);
+    _dirty[(uint8_t)SimRegion::SETTINGS] = true;
+}
+
+void SimStorage::clearParentID() {
+    put32(SimRegion::SETTINGS, S_PARENT_ID, 0xFFFFFFFF);
+}
+
+uint32_t SimStorage::getNextTxSequenceNumber() {
+    uint32_t seq = get32(SimRegion::SCRATCHPAD, P_TX_SEQUENCE);
+    put32(SimRegion::SCRATCHPAD, P_TX_SEQUENCE, seq + 1);
+    return seq;
+}
+
+// ============================================================================
+// SimRadio
+// ============================================================================
+uint32_t SimRadio::init() {
+    _clock.advanceMs(INIT_MS);
+    return INIT_MS;
+}
+
+uint32_t SimRadio::packetAirtimeMs(size_t packetLen) const {
+    // Same time-on-air model as the firmware's duty-cycle budget
+    uint32_t us = Airtime::loraPacketUs(config.spreadingFactor, config.bandwidth, config.codingRate,
+                                        config.preambleLength, packetLen, config.crcOn);
+    return (us + 999) / 1000;
+}
+
+uint32_t SimRadio::send(size_t frameLen, uint8_t* packetCount) {
+    // ResonantLRRadio fragments frames larger than one LoRa packet
+    size_t dataLen = frameLen - FRAME_OVERHEAD;
+    const size_t perPacket = MAX_PACKET - FRAME_OVERHEAD;
+    uint8_t packets = frameLen <= MAX_PACKET ? 1 : (uint8_t)((dataLen + perPacket - 1) / perPacket);
+
+    uint32_t ms = 0;
+    size_t remaining = dataLen;
+    for (uint8_t i = 0; i < packets; i++) {
+        size_t chunk = packets == 1 ? dataLen : (remaining > perPacket ? perPacket : remaining);
+        remaining -= chunk;
+        ms += packetAirtimeMs(chunk + FRAME_OVERHEAD);
+    }
+    if (packetCount != nullptr) {
+        *packetCount = packets;
+    }
+    _clock.advanceMs(ms);
+    return ms;
+}
+
+// ============================================================================
+// SimTmp112
+// ============================================================================
+void SimTmp112::startConversion() {
+    _clock.advanceUs(I2C_READ_US);
+    _converting = true;
+    _conversionDoneUs = _clock.nowUs() + CONVERSION_US;
+}
+
+float SimTmp112::readTemperature() {
+    if (_converting) {
+        if (_clock.nowUs() < _conversionDoneUs) {
+            _clock.advanceUs(_conversionDoneUs - _clock.nowUs());
+        }
+        _converting = false;
+    }
+    _clock.advanceUs(I2C_READ_US);
+    float t = _clock.nowUs() / 1e6f;
+    float c = baseC + swingC * sinf(2.0f * (float)M_PI * t / periodS) + _rng.gaussian(noiseC);
+    // Quantize to the TMP112's 0.0625 C LSB
+    return roundf(c / 0.0625f) * 0.0625f;
+}
+
+bool SimTmp112::readContact() {
+    if (_rng.chance(contactFlipChance)) {
+        _contact = !_contact;
+    }
+    return _contact;
+}
+
+// ============================================================================
+// SimBattery
+// ============================================================================
+float SimBattery::readVoltage() {
+    _clock.advanceMs(ADC_READ_MS);
+    float soc = 1.0f - consumed_mAh / capacity_mAh;
+    if (soc < 0.0f) soc = 0.0f;
+    // Li-SOCl2-ish flat discharge with a knee near empty
+    return 3.0f + 0.6f * soc - (soc < 0.1f ? (0.1f - soc) * 3.0f : 0.0f);
+}
+
+void SimBattery::drain_uWh(double uWh) {
+    consumed_mAh += (float)(uWh / 1000.0 / SimEnergy::SUPPLY_V);
+}
@@ -0,0 +1,246 @@
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sim_clock.h"
+
+// ============================================================================
+// Energy Model
+// ============================================================================
+// Datasheet typicals for the RAK3112 (ESP32-S3 + SX1262) at the regulator
+// output. Radio currents are on top of the MCU active current.
+namespace SimEnergy {
+    constexpr float SUPPLY_V          = 3.3f;
+    constexpr float MCU_ACTIVE_MA     = 40.0f;    // ESP32-S3 @ 240 MHz, WiFi/BT off
+    constexpr float RADIO_TX_MA       = 118.0f;   // SX1262 @ +22 dBm
+    constexpr float RADIO_RX_MA       = 5.3f;     // SX1262 RX, DC-DC, boosted gain
+    constexpr float RADIO_STANDBY_MA  = 0.6f;     // STDBY_RC between operations
+    constexpr float SLEEP_UA          = 12.0f;    // MCU deep sleep + SX1262 cold sleep + FRAM standby
+    constexpr float TMP112_ACTIVE_UA  = 10.0f;    // TMP112 continuous conversion at 4 Hz
+    constexpr float TMP112_SHUTDOWN_UA = 0.5f;    // TMP112 shutdown mode
+    constexpr float RADIO_WARM_SLEEP_EXTRA_UA = 1.0f;   // SX1262 warm sleep (1.2 uA) over cold (0.16 uA)
+    constexpr float MCU_LIGHT_SLEEP_EXTRA_UA  = 230.0f; // ESP32-S3 light sleep (~240 uA) over deep sleep
+    constexpr float CORE_ACTIVE_EXTRA_MA = 12.0f;     // radio task's core running instead of gated in WAITI
+    constexpr uint32_t RADIO_PASS_US     = 30;        // one radio task wakeup: switch in, resonantRadio.loop(), out
+
+    // SX1262 TX current at the PA setting for `dBm` (datasheet 22/20/17/14 dBm
+    // points, linear in between; lower powers are not characterized and keep
+    // the 14 dBm figure)
+    float radioTxMa(int8_t dBm);
+
+    // SX1262 demodulation floor, SNR in dB at the given spreading factor
+    float demodFloorDb(uint8_t sf);
+
+    // mA * ms * V = uJ; / 3600 = uWh
+    inline double uWh(float mA, double ms) { return mA * ms * SUPPLY_V / 3600.0; }
+}
+
+// ============================================================================
+// Deterministic RNG (xorshift32) so runs are reproducible per seed
+// ============================================================================
+class SimRandom {
+public:
+    explicit SimRandom(uint32_t seed = 1) : _state(seed ? seed : 1) {}
+    uint32_t next();
+    float uniform();                  // [0, 1)
+    bool chance(float probability);   // true with the given probability
+    float gaussian(float stddev);
+
+private:
+    uint32_t _state;
+};
+
+// ============================================================================
+// MB85RS64V FRAM (8192 bytes, SPI @ 8 MHz)
+// ============================================================================
+class SimFram {
+public:
+    static constexpr size_t SIZE = 8192;
+    static constexpr uint32_t SPI_HZ = 8000000;
+
+    explicit SimFram(SimClock& clock);
+
+    bool begin();
+    bool selfTest();
+    void read(uint16_t addr, uint8_t* buf, size_t len);
+    void write(uint16_t addr, const uint8_t* data, size_t len);
+
+    uint32_t transactions = 0;
+    uint32_t bytesRead = 0;
+    uint32_t bytesWritten = 0;
+
+    void resetCounters() { transactions = 0; bytesRead = 0; bytesWritten = 0; }
+
+private:
+    SimClock& _clock;
+    uint8_t _mem[SIZE];
+
+    void chargeTransaction(size_t bytesOnBus);
+};
+
+// ============================================================================
+// FRAM Storage (mirrors ResonantFRAMStorage regions and big-endian layout)
+// ============================================================================
+enum class SimRegion : uint8_t { SETTINGS, METRICS, SCRATCHPAD };
+
+class SimStorage {
+public:
+    static constexpr uint16_t SETTINGS_ADDR   = 0x0000;
+    static constexpr uint16_t FACTORY_ADDR    = 0x00CF;
+    static constexpr uint16_t METRICS_ADDR    = 0x019E;
+    static constexpr uint16_t SCRATCHPAD_ADDR = 0x026C;
+    static constexpr size_t PAYLOAD_SIZE      = 207;
+    static constexpr size_t SCRATCHPAD_SIZE   = 400;
+
+    // Settings offsets
+    static constexpr uint16_t S_TELEMETRY_INTERVAL = 1;
+    static constexpr uint16_t S_TELEMETRY_MAX_WAKE = 3;
+    static constexpr uint16_t S_TX_POWER           = 5;
+    static constexpr uint16_t S_SPREADING_FACTOR   = 6;
+    static constexpr uint16_t S_BANDWIDTH          = 7;
+    static constexpr uint16_t S_FREQUENCY          = 8;
+    static constexpr uint16_t S_CODING_RATE        = 12;
+    static constexpr uint16_t S_WAIT_AFTER_TX      = 13;
+    static constexpr uint16_t S_ACK_FAIL_THRESHOLD = 15;
+    static constexpr uint16_t S_TELEMETRY_ACK      = 16;
+    static constexpr uint16_t S_METRICS_INTERVAL   = 17;
+    static constexpr uint16_t S_PARENT_ID          = 19;
+
+    // Metrics offsets
+    static constexpr uint16_t M_BATTERY_VOLTAGE    = 4;
+    static constexpr uint16_t M_TOTAL_TX_TIME      = 6;
+    static constexpr uint16_t M_TOTAL_RX_TIME      = 10;
+    static constexpr uint16_t M_TOTAL_ACTIVE_TIME  = 14;
+    static constexpr uint16_t M_TOTAL_SLEEP_TIME   = 18;
+    static constexpr uint16_t M_CYCLE_COUNT        = 22;
+    static constexpr uint16_t M_TX_COUNT           = 26;
+    static constexpr uint16_t M_ACK_FAIL_COUNT     = 30;
+    static constexpr uint16_t M_ACK_FAIL_TOTAL     = 31;
+    static constexpr uint16_t M_TELEMETRY_SINCE    = 33;
+    static constexpr uint16_t M_BOOT_COUNT         = 35;
+    static constexpr uint16_t M_TOTAL_ENERGY       = 37;
+
+    // Scratchpad offsets
+    static constexpr uint16_t P_LAST_TX_STATUS     = 0;
+    static constexpr uint16_t P_PRE_TX_BATTERY     = 1;
+    static constexpr uint16_t P_BROWNOUT_COUNT     = 3;
+    static constexpr uint16_t P_LAST_WAKE_REASON   = 4;
+    static constexpr uint16_t P_CYCLE_FLAGS        = 5;
+    static constexpr uint16_t P_RAW_BATTERY        = 6;
+    static constexpr uint16_t P_TX_SEQUENCE        = 8;
+
+    explicit SimStorage(SimFram& fram) : _fram(fram) {}
+
+    bool begin();
+    void flush();
+    void factoryDefaults();
+
+    uint8_t  get8(SimRegion r, uint16_t off) const;
+    uint16_t get16(SimRegion r, uint16_t off) const;
+    uint32_t get32(SimRegion r, uint16_t off) const;
+    void put8(SimRegion r, uint16_t off, uint8_t v);
+    void put16(SimRegion r, uint16_t off, uint16_t v);
+    void put32(SimRegion r, uint16_t off, uint32_t v);
+
+    uint8_t* region(SimRegion r);
+    const uint8_t* region(SimRegion r) const;
+
+    bool isAdopted() const;
+    bool isMetricsDue() const;
+    void setParentID(const uint8_t id[4]);
+    void clearParentID();
+    uint32_t getNextTxSequenceNumber();
+
+private:
+    SimFram& _fram;
+    uint8_t _settings[PAYLOAD_SIZE];
+    uint8_t _metrics[PAYLOAD_SIZE];
+    uint8_t _scratchpad[SCRATCHPAD_SIZE];
+    bool _dirty[3] = {false, false, false};
+
+    static uint16_t regionAddr(SimRegion r);
+    static size_t regionSize(SimRegion r);
+};
+
+// ============================================================================
+// SX1262 behind ResonantLRRadio
+// ============================================================================
+struct SimRadioConfig {
+    uint8_t spreadingFactor = 7;
+    uint8_t bandwidth = 0;          // 0=125 kHz, 1=250 kHz, 2=500 kHz
+    uint8_t codingRate = 1;         // 4/5
+    uint16_t preambleLength = 8;
+    int8_t txPower = 22;
+    bool crcOn = true;
+};
+
+class SimRadio {
+public:
+    static constexpr size_t MAX_PACKET = 255;
+    static constexpr size_t FRAME_OVERHEAD = 20;
+    static constexpr uint32_t INIT_MS = 30;      // reset + calibration + parameter programming
+    static constexpr uint32_t RESUME_MS = 3;     // warm start: driver rebind, config retained
+
+    explicit SimRadio(SimClock& clock) : _clock(clock) {}
+
+    SimRadioConfig config;
+
+    uint32_t init();                             // returns ms spent
+    uint32_t packetAirtimeMs(size_t packetLen) const;
+    uint32_t send(size_t frameLen, uint8_t* packetCount = nullptr);   // returns ms on air
+    void deepSleep() {}
+
+private:
+    SimClock& _clock;
+};
+
+// ============================================================================
+// TMP112 + contact input
+// ============================================================================
+class SimTmp112 {
+public:
+    static constexpr uint32_t I2C_READ_US = 300;
+    static constexpr uint32_t CONVERSION_US = 26000;
+
+    SimTmp112(SimClock& clock, SimRandom& rng) : _clock(clock), _rng(rng) {}
+
+    // One-shot mode: start a conversion; readTemperature() waits out the rest
+    void startConversion();
+    float readTemperature();
+    bool readContact();
+
+    float baseC = 4.0f;         // cold-storage setpoint
+    float swingC = 1.5f;        // defrost-cycle amplitude
+    float periodS = 6 * 3600;   // defrost-cycle period
+    float noiseC = 0.05f;
+    float contactFlipChance = 0.02f;
+
+private:
+    SimClock& _clock;
+    SimRandom& _rng;
+    bool _contact = false;
+    bool _converting = false;
+    uint64_t _conversionDoneUs = 0;
+};
+
+// ============================================================================
+// Battery + ADC path
+// ============================================================================
+class SimBattery {
+public:
+    static constexpr uint32_t ADC_READ_MS = 2;
+
+    explicit SimBattery(SimClock& clock) : _clock(clock) {}
+
+    float capacity_mAh = 2600.0f;
+    float consumed_mAh = 0.0f;
+
+    float readVoltage();
+    void drain_uWh(double uWh);
+
+private:
+    SimClock& _clock;
+};
+
+#endif // SIM_HAL_H
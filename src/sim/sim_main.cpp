@@ -0,0 +1,208 @@
+// ============================================================================
+// Native wake-cycle benchmark
+// ============================================================================
+// pio run -e native && .pio/build/native/program [options]
+//
+//   --cycles N            wake cycles to simulate (default 10000)
+//   --seed N              RNG seed (default 1)
+//   --interval S          telemetryInterval in seconds (default 600)
+//   --metrics-interval N  metricsReportInterval (default 6)
+//   --wait-after-tx MS    waitAfterTx in ms (default 8000)
+//   --ack                 telemetryAckRequired = 1
+//   --ack-loss P          probability a telemetry ACK is lost (default 0.05)
+//   --batch N             telemetryBatchSize: readings per uplink (default 0 = every wake)
+//   --whole-region-flush  rewrite whole dirty sensor tails instead of dirty ranges
+//   --cold-crypto         parse credentials and CA on every wake (no warm context)
+//   --sensor-continuous   TMP112 left converting at 4 Hz through sleep (no one-shot)
+//   --deadband C          report-by-exception threshold in centi-degrees (batch off)
+//   --heartbeat S         longest silence under the deadband (default 3600)
+//   --radio-warm          what-if: SX1262 warm sleep + resume (not in the firmware)
+//   --metrics-full-every N  delta metrics reports, every N-th one full (default 0 = off)
+//   --downlink-gate       metrics ACK closes the command window when nothing is queued
+//   --wor MS              wake-on-radio: SX1262 sniffs every MS while the MCU light-sleeps
+//   --no-light-sleep      Core 1 blocks awake through ACK and command windows (no AppEventLoop light sleep)
+//   --radio-poll          radio task polls every tick (before RadioTask blocked on DIO1)
+//   --codec ...           telemetry codec benchmark instead, see codec_bench.h
+//   --lifetime ...        battery lifetime of a settings profile instead, see lifetime_sim.h
+//   --decode ...          gateway frame decoder benchmark instead, see decode_bench.h
+//   --governor ...        CPU governor per-phase time and energy report instead, see governor_bench.h
+//   --journal ...         event journal ring, paging and power-cut check instead, see journal_bench.h
+//
+// Reports, per TxContext path, awake time, TX/RX time and modeled energy so
+// any change to the cycle can be compared run-over-run. The cycle is
+// WakeCycleModel, a hand-maintained copy of main.cpp's decisions: its
+// figures are model estimates, not measurements of the firmware.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include "codec_bench.h"
+#include "decode_bench.h"
+#include "governor_bench.h"
+#include "journal_bench.h"
+#include "lifetime_sim.h"
+#include "wake_cycle_model.h"
+
+namespace {
+
+struct PathStats {
+    uint32_t cycles = 0;
+    uint64_t awakeMs = 0;
+    uint64_t txMs = 0;
+    uint64_t rxMs = 0;
+    double awake_uWh = 0.0;
+    uint64_t framTransactions = 0;
+    uint64_t framBytes = 0;
+    uint64_t radioWakeups = 0;
+    double radioTask_uWh = 0.0;
+};
+
+bool parseArgs(int argc, char** argv, SimScenario& scenario) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--ack") == 0) {
+            scenario.telemetryAckRequired = true;
+        } else if (strcmp(arg, "--whole-region-flush") == 0) {
+            scenario.dirtyRangeWriteBack = false;
+        } else if (strcmp(arg, "--cold-crypto") == 0) {
+            scenario.warmCrypto = false;
+        } else if (strcmp(arg, "--radio-warm") == 0) {
+            scenario.radioWarm = true;
+        } else if (strcmp(arg, "--downlink-gate") == 0) {
+            scenario.downlinkGate = true;
+        } else if (strcmp(arg, "--no-light-sleep") == 0) {
+            scenario.lightSleepWaits = false;
+        } else if (strcmp(arg, "--radio-poll") == 0) {
+            scenario.radioIrq = false;
+        } else if (strcmp(arg, "--sensor-continuous") == 0) {
+            scenario.sensorOneShot = false;
+        } else if (val == nullptr) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        } else if (strcmp(arg, "--cycles") == 0) {
+            scenario.cycles = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--seed") == 0) {
+            scenario.seed = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--interval") == 0) {
+            scenario.telemetryInterval = (uint16_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--metrics-interval") == 0) {
+            scenario.metricsInterval = (uint16_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--wait-after-tx") == 0) {
+            scenario.waitAfterTx = (uint16_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--ack-loss") == 0) {
+            scenario.ackLoss = strtof(val, nullptr); i++;
+        } else if (strcmp(arg, "--deadband") == 0) {
+            scenario.deadbandCenti = (uint16_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--heartbeat") == 0) {
+            scenario.heartbeatS = (uint32_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--batch") == 0) {
+            scenario.batchSize = (uint8_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--metrics-full-every") == 0) {
+            scenario.metricsFullEvery = (uint8_t)strtoul(val, nullptr, 0); i++;
+        } else if (strcmp(arg, "--wor") == 0) {
+            scenario.worSniffMs = (uint16_t)strtoul(val, nullptr, 0); i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--codec") == 0) {
+        return runCodecBenchmark(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "--lifetime") == 0) {
+        return runLifetimeSimulation(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "--decode") == 0) {
+        return runDecodeBenchmark(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "--governor") == 0) {
+        return runGovernorBenchmark(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "--journal") == 0) {
+        return runJournalBenchmark(argc, argv);
+    }
+
+    SimScenario scenario;
+    if (!parseArgs(argc, argv, scenario)) {
+        return 2;
+    }
+
+    WakeCycleModel model(scenario);
+    std::map<std::string, PathStats> byPath;
+    PathStats total;
+    double sleep_uWh = 0.0;
+    uint64_t sleepS = 0;
+
+    auto hostStart = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < scenario.cycles; i++) {
+        CycleResult r = model.runCycle();
+
+        char path[160];
+        r.describePath(path, sizeof(path));
+        PathStats* targets[2] = {&byPath[path], &total};
+        for (PathStats* s : targets) {
+            s->cycles++;
+            s->awakeMs += r.awakeMs;
+            s->txMs += r.txMs;
+            s->rxMs += r.rxMs;
+            s->awake_uWh += r.awake_uWh;
+            s->framTransactions += r.framTransactions;
+            s->framBytes += r.framBytes;
+            s->radioWakeups += r.radioWakeups;
+            s->radioTask_uWh += r.radioTask_uWh;
+        }
+        sleep_uWh += r.sleep_uWh;
+        sleepS += r.sleepS;
+    }
+    double hostSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+
+    printf("\n=== Wake Cycle Benchmark ===\n");
+    printf("%s\n", WakeCycleModel::DISCLAIMER);
+    printf("Cycles: %u  interval: %us  metrics every %u  ACK: %s  batch: %u  seed: %u\n",
+           scenario.cycles, scenario.telemetryInterval, scenario.metricsInterval,
+           scenario.telemetryAckRequired ? "yes" : "no", scenario.batchSize, scenario.seed);
+    if (scenario.lightSleepWaits) {
+        printf("Light sleep in listen windows: MCU at %.0f uA instead of %.0f mA\n",
+               SimEnergy::SLEEP_UA + SimEnergy::MCU_LIGHT_SLEEP_EXTRA_UA, SimEnergy::MCU_ACTIVE_MA);
+    }
+    if (scenario.worSniffMs > 0) {
+        printf("Wake-on-radio: sniff every %u ms, %.1f uA sniffing + %.0f uA light sleep, "
+               "command latency <= %u ms, gateway preamble %u symbols\n",
+               scenario.worSniffMs, WakeCycleModel::worSniffUa(scenario), SimEnergy::MCU_LIGHT_SLEEP_EXTRA_UA,
+               scenario.worSniffMs, WakeCycleModel::worPreambleSymbols(scenario));
+    }
+    printf("\n%-60s %8s %10s %8s %8s %10s %8s %8s\n",
+           "Path", "Cycles", "Awake ms", "TX ms", "RX ms", "uWh", "SPI tx", "SPI B");
+    for (const auto& entry : byPath) {
+        const PathStats& s = entry.second;
+        printf("%-60s %8u %10.1f %8.1f %8.1f %10.2f %8.1f %8.1f\n",
+               entry.first.c_str(), s.cycles,
+               (double)s.awakeMs / s.cycles, (double)s.txMs / s.cycles,
+               (double)s.rxMs / s.cycles, s.awake_uWh / s.cycles,
+               (double)s.framTransactions / s.cycles, (double)s.framBytes / s.cycles);
+    }
+
+    if (total.cycles > 0) {
+        double simDays = (sleepS + total.awakeMs / 1000.0) / 86400.0;
+        printf("\nAverage per cycle: awake %.1f ms, TX %.1f ms, RX %.1f ms, %.2f uWh awake\n",
+               (double)total.awakeMs / total.cycles, (double)total.txMs / total.cycles,
+               (double)total.rxMs / total.cycles, total.awake_uWh / total.cycles);
+        printf("Radio task (%s): %.1f wakeups, %.3f uWh per cycle\n",
+               scenario.radioIrq ? "DIO1 interrupt" : "1 ms polling",
+               (double)total.radioWakeups / total.cycles, total.radioTask_uWh / total.cycles);
+        printf("Simulated %.1f days: %.1f mWh awake + %.1f mWh asleep, %.1f mAh from battery\n",
+               simDays, total.awake_uWh / 1000.0, sleep_uWh / 1000.0, model.battery.consumed_mAh);
+    }
+    printf("Host: %.3f s, %.0f cycles/s\n", hostSec, hostSec > 0 ? total.cycles / hostSec : 0.0);
+    return 0;
+}
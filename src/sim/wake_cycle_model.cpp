@@ -0,0 +1,565 @@
+#include "wake_cycle_model.h"
+#include <stdio.h>
+#include <string.h>
+#include <Airtime.h>
+#include <WorSniffer.h>
+
+const char* txContextName(SimTxContext ctx) {
+    switch (ctx) {
+        case SimTxContext::TELEMETRY:          return "TELEMETRY";
+        case SimTxContext::METRICS:            return "METRICS";
+        case SimTxContext::SETTINGS_REPORT:    return "SETTINGS_REPORT";
+        case SimTxContext::COMMAND_RESPONSE:   return "COMMAND_RESPONSE";
+        case SimTxContext::JOURNAL_PAGE:       return "JOURNAL_PAGE";
+        case SimTxContext::ACK:                return "ACK";
+        case SimTxContext::ADOPTION_ADVERTISE: return "ADOPTION_ADVERTISE";
+        case SimTxContext::ADOPTION_ACCEPT:    return "ADOPTION_ACCEPT";
+        default:                               return "NONE";
+    }
+}
+
+void CycleResult::describePath(char* out, size_t outLen) const {
+    size_t used = 0;
+    out[0] = '\0';
+    if (pathLength == 0) {
+        snprintf(out, outLen, "NONE (radio off)");
+        return;
+    }
+    for (uint8_t i = 0; i < pathLength && used < outLen; i++) {
+        used += snprintf(out + used, outLen - used, "%s%s",
+                         i > 0 ? ">" : "", txContextName(path[i]));
+    }
+}
+
+bool SimScenario::loadSettings(const uint8_t* blob, size_t len) {
+    if (len != SimStorage::PAYLOAD_SIZE || blob[0] == 0xFF) {
+        return false;
+    }
+    auto be16 = [blob](size_t off) { return (uint16_t)(blob[off] << 8 | blob[off + 1]); };
+    constexpr size_t TAIL = 36;     // SensorSettings::REGION_OFFSET
+
+    telemetryInterval    = be16(SimStorage::S_TELEMETRY_INTERVAL);
+    txPower              = (int8_t)blob[SimStorage::S_TX_POWER];
+    spreadingFactor      = blob[SimStorage::S_SPREADING_FACTOR];
+    bandwidth            = blob[SimStorage::S_BANDWIDTH];
+    codingRate           = blob[SimStorage::S_CODING_RATE];
+    waitAfterTx          = be16(SimStorage::S_WAIT_AFTER_TX);
+    ackFailThreshold     = blob[SimStorage::S_ACK_FAIL_THRESHOLD];
+    telemetryAckRequired = blob[SimStorage::S_TELEMETRY_ACK] != 0;
+    metricsInterval      = be16(SimStorage::S_METRICS_INTERVAL);
+
+    batchSize = blob[TAIL + 0];
+    uint16_t deadband = be16(TAIL + 3);
+    deadbandCenti = deadband == 0xFFFF ? 0 : deadband;
+    uint16_t heartbeatMin = be16(TAIL + 6);
+    heartbeatS = (heartbeatMin == 0 || heartbeatMin == 0xFFFF ? 60 : heartbeatMin) * 60UL;
+    uint8_t tmp112 = blob[TAIL + 2];
+    sensorOneShot = tmp112 == 0xFF || !(tmp112 & 0x08);
+    uint8_t fullEvery = blob[TAIL + 11];
+    metricsFullEvery = fullEvery == 0xFF ? 0 : fullEvery;
+    downlinkGate = blob[TAIL + 12] != 0xFF && (blob[TAIL + 12] & 0x01);
+    uint16_t sniffMs = be16(TAIL + 14);
+    bool wor = blob[TAIL + 13] != 0xFF && (blob[TAIL + 13] & 0x01);
+    worSniffMs = !wor ? 0 : (sniffMs == 0 || sniffMs == 0xFFFF ? 1000 : sniffMs);
+    return true;
+}
+
+WakeCycleModel::WakeCycleModel(const SimScenario& scenario)
+    : rng(scenario.seed),
+      fram(clock),
+      storage(fram),
+      radio(clock),
+      sensor(clock, rng),
+      battery(clock),
+      _scenario(scenario) {
+}
+
+// ============================================================================
+// One wake: boot -> frames -> sleep
+// ============================================================================
+CycleResult WakeCycleModel::runCycle() {
+    CycleResult result;
+    _result = &result;
+    _wakeStartUs = clock.nowUs();
+    _radioOn = false;
+    _radioIrqWakeups = 0;
+    _sampled = false;
+    _tailChanged.clear();
+    fram.resetCounters();
+
+    boot();
+
+    if (storage.isAdopted() && !_powerOn && batchEnabled()
+        && _queued + 1 < _scenario.batchSize) {
+        // runSampleOnlyWake(): queue the reading, radio and crypto never start
+        sensor.readTemperature();
+        sensor.readContact();
+        queueReading();
+    } else if (storage.isAdopted() && !_powerOn && deadbandEnabled()
+               && !reportDue(sensor.readTemperature())) {
+        // Quiet wake: reading within the deadband, radio never powered
+        sensor.readContact();
+        touchTail(REPORT_STATE + 3, 4);
+    } else {
+        bootRadio();
+        if (!storage.isAdopted()) {
+            sendAdvertise();
+        } else {
+            sendTelemetry();
+        }
+    }
+
+    finishCycle();
+    _result = nullptr;
+    _powerOn = false;
+    return result;
+}
+
+void WakeCycleModel::boot() {
+    clock.advanceMs(_powerOn ? POWER_ON_BOOT_MS : DEEP_SLEEP_BOOT_MS);
+
+    // --- FRAM Init / Storage Init ---
+    fram.begin();
+    fram.selfTest();
+    storage.begin();
+
+    if (_powerOn) {
+        // Scenario knobs override the factory defaults on first boot
+        storage.put16(SimRegion::SETTINGS, SimStorage::S_TELEMETRY_INTERVAL, _scenario.telemetryInterval);
+        storage.put16(SimRegion::SETTINGS, SimStorage::S_METRICS_INTERVAL, _scenario.metricsInterval);
+        storage.put16(SimRegion::SETTINGS, SimStorage::S_WAIT_AFTER_TX, _scenario.waitAfterTx);
+        storage.put8(SimRegion::SETTINGS, SimStorage::S_TELEMETRY_ACK, _scenario.telemetryAckRequired ? 1 : 0);
+        storage.put8(SimRegion::SETTINGS, SimStorage::S_TX_POWER, (uint8_t)_scenario.txPower);
+        storage.put8(SimRegion::SETTINGS, SimStorage::S_SPREADING_FACTOR, _scenario.spreadingFactor);
+        storage.put8(SimRegion::SETTINGS, SimStorage::S_BANDWIDTH, _scenario.bandwidth);
+        storage.put8(SimRegion::SETTINGS, SimStorage::S_CODING_RATE, _scenario.codingRate);
+        storage.put8(SimRegion::SETTINGS, SimStorage::S_ACK_FAIL_THRESHOLD, _scenario.ackFailThreshold);
+    }
+
+    radio.config.spreadingFactor = storage.get8(SimRegion::SETTINGS, SimStorage::S_SPREADING_FACTOR);
+    radio.config.bandwidth = storage.get8(SimRegion::SETTINGS, SimStorage::S_BANDWIDTH);
+    radio.config.codingRate = storage.get8(SimRegion::SETTINGS, SimStorage::S_CODING_RATE);
+    radio.config.txPower = (int8_t)storage.get8(SimRegion::SETTINGS, SimStorage::S_TX_POWER);
+
+    // --- Determine wake reason ---
+    if (_powerOn) {
+        storage.put8(SimRegion::SCRATCHPAD, SimStorage::P_LAST_WAKE_REASON, 3);
+        storage.put16(SimRegion::METRICS, SimStorage::M_BOOT_COUNT,
+                      storage.get16(SimRegion::METRICS, SimStorage::M_BOOT_COUNT) + 1);
+    } else {
+        storage.put8(SimRegion::SCRATCHPAD, SimStorage::P_LAST_WAKE_REASON, 0);
+    }
+    storage.put8(SimRegion::SCRATCHPAD, SimStorage::P_CYCLE_FLAGS, 0);
+    storage.put32(SimRegion::METRICS, SimStorage::M_CYCLE_COUNT,
+                  storage.get32(SimRegion::METRICS, SimStorage::M_CYCLE_COUNT) + 1);
+
+    // --- Brownout Detection ---
+    if (storage.get8(SimRegion::SCRATCHPAD, SimStorage::P_LAST_TX_STATUS) == 1) {
+        storage.put8(SimRegion::SCRATCHPAD, SimStorage::P_BROWNOUT_COUNT,
+                     storage.get8(SimRegion::SCRATCHPAD, SimStorage::P_BROWNOUT_COUNT) + 1);
+    }
+    storage.put8(SimRegion::SCRATCHPAD, SimStorage::P_LAST_TX_STATUS, 0);
+
+    // --- Battery Voltage Filtering ---
+    uint16_t rawCV = (uint16_t)(battery.readVoltage() * 100);
+    storage.put16(SimRegion::SCRATCHPAD, SimStorage::P_RAW_BATTERY, rawCV);
+    uint16_t storedCV = storage.get16(SimRegion::METRICS, SimStorage::M_BATTERY_VOLTAGE);
+    if (storedCV == 0 || rawCV < storedCV) {
+        storage.put16(SimRegion::METRICS, SimStorage::M_BATTERY_VOLTAGE, rawCV);
+    }
+
+    if (!_powerOn) {
+        storage.put32(SimRegion::METRICS, SimStorage::M_TOTAL_SLEEP_TIME,
+                      storage.get32(SimRegion::METRICS, SimStorage::M_TOTAL_SLEEP_TIME)
+                      + storage.get16(SimRegion::SETTINGS, SimStorage::S_TELEMETRY_INTERVAL));
+    }
+
+    // --- Sensor Init --- (one-shot: the conversion runs through the rest of boot)
+    clock.advanceUs(I2C_PROBE_US);
+    if (_scenario.sensorOneShot) {
+        sensor.startConversion();
+    }
+
+    // Adoption is cleared on every non-deep-sleep reset (test behaviour in setup())
+    if (_powerOn && storage.isAdopted()) {
+        storage.clearParentID();
+        _cryptoWarm = false;
+        _queued = 0;
+    }
+}
+
+float WakeCycleModel::worSniffUa(const SimScenario& s) {
+    if (s.worSniffMs == 0) return 0.0f;
+    uint32_t rxUs = WorSniffer::rxWindowUs(s.spreadingFactor, s.bandwidth);
+    uint32_t periodUs = WorSniffer::periodUs(s.worSniffMs, s.spreadingFactor, s.bandwidth);
+    return SimEnergy::RADIO_RX_MA * 1000.0f * rxUs / periodUs + SimEnergy::RADIO_WARM_SLEEP_EXTRA_UA;
+}
+
+uint32_t WakeCycleModel::worPreambleSymbols(const SimScenario& s) {
+    uint32_t periodUs = WorSniffer::periodUs(s.worSniffMs, s.spreadingFactor, s.bandwidth);
+    return WorSniffer::preambleSymbols(periodUs / 1000, s.spreadingFactor, s.bandwidth);
+}
+
+void WakeCycleModel::bootRadio() {
+    // Radio init runs on Core 0 while Core 1 sets up crypto; setup() blocks
+    // until both are done. A valid warm context skips credential/CA parsing.
+    bool warm = _scenario.warmCrypto && _cryptoWarm && !_powerOn && storage.isAdopted();
+    uint32_t cryptoMs = warm ? CRYPTO_WARM_MS : CRYPTO_INIT_MS;
+    uint32_t radioMs = (_radioWarm && !_powerOn) ? SimRadio::RESUME_MS : SimRadio::INIT_MS;
+    uint32_t parallelMs = cryptoMs > radioMs ? cryptoMs : radioMs;
+    clock.advanceMs(parallelMs);
+    _cryptoWarm = storage.isAdopted();
+    _radioWarm = _scenario.radioWarm && _scenario.telemetryInterval <= RADIO_WARM_MAX_SLEEP_S;
+    _radioOn = true;
+    _radioUpUs = clock.nowUs();
+}
+
+bool WakeCycleModel::reportDue(float tempC) {
+    // Called after the sleep that just ended has been added to the silent clock
+    _sampled = true;
+    _sampleC = tempC;
+    _silentS += storage.get16(SimRegion::SETTINGS, SimStorage::S_TELEMETRY_INTERVAL);
+    float delta = tempC > _lastReportedC ? tempC - _lastReportedC : _lastReportedC - tempC;
+    return _silentS >= _scenario.heartbeatS || delta * 100.0f >= _scenario.deadbandCenti;
+}
+
+void WakeCycleModel::queueReading() {
+    if (_queued < 40) {
+        _queued++;
+    }
+    uint16_t off = 5 + (_queued - 1) * BATCH_RECORD_SIZE;
+    memset(_sensorTail + off, _queued, BATCH_RECORD_SIZE);
+    touchTail(off, BATCH_RECORD_SIZE);
+    _sensorTail[0] = _queued;
+    touchTail(0, 1);
+    if (_queued == 1) {
+        touchTail(1, 4);    // batch clock reset
+    }
+}
+
+void WakeCycleModel::clearBatch() {
+    _queued = 0;
+    _sensorTail[0] = 0;
+    touchTail(0, 5);
+}
+
+void WakeCycleModel::touchTail(uint16_t off, size_t len) {
+    _tailDirty.add(off, len);
+    _tailChanged.add(off, len);
+}
+
+void WakeCycleModel::flushStorage() {
+    storage.flush();
+    if (!_scenario.dirtyRangeWriteBack) {
+        if (!_tailDirty.empty()) {
+            fram.write(SENSOR_TAIL_ADDR, _sensorTail, SENSOR_TAIL_SIZE);
+        }
+        _tailDirty.clear();
+        return;
+    }
+    // SensorRegionStore::onLibraryFlush() + flush()
+    _tailDirty.add(_tailChanged);
+    for (uint8_t i = 0; i < _tailDirty.count(); i++) {
+        fram.write(SENSOR_TAIL_ADDR + _tailDirty[i].start, _sensorTail + _tailDirty[i].start,
+                   _tailDirty[i].end - _tailDirty[i].start);
+    }
+    _tailDirty.clear();
+}
+
+// ============================================================================
+// Frame Paths
+// ============================================================================
+void WakeCycleModel::transmit(SimTxContext ctx, size_t frameLen) {
+    if (_result->pathLength < CycleResult::MAX_PATH) {
+        _result->path[_result->pathLength++] = ctx;
+    }
+    uint8_t packets = 1;
+    uint32_t ms = radio.send(frameLen, &packets);
+    radioTaskPasses(1 + packets, ms);      // kick from send(), TxDone per packet
+    _result->txMs += ms;
+    size_t i = (size_t)ctx;
+    _result->txMsBy[i] += ms;
+    _result->framesBy[i]++;
+    _lastTx = ctx;
+    _lastTxLost = _scenario.linkModel && !linkDelivers(true);
+    if (_lastTxLost) {
+        _result->lostBy[i]++;
+    }
+
+    // onTxComplete(success=true)
+    storage.put8(SimRegion::SCRATCHPAD, SimStorage::P_LAST_TX_STATUS, 2);
+    storage.put32(SimRegion::METRICS, SimStorage::M_TX_COUNT,
+                  storage.get32(SimRegion::METRICS, SimStorage::M_TX_COUNT) + 1);
+}
+
+// SNR of one frame against the demodulation floor. Wider bandwidth lets in
+// 3 dB more noise per step; the gateway answers at +22 dBm.
+bool WakeCycleModel::linkDelivers(bool uplink) {
+    float snr = _scenario.linkSnrDb - 3.0f * radio.config.bandwidth + rng.gaussian(_scenario.linkFadeDb);
+    if (uplink) {
+        snr += radio.config.txPower - 22;
+    }
+    return snr >= SimEnergy::demodFloorDb(radio.config.spreadingFactor);
+}
+
+// RadioTask: DIO1 interrupts and kicks, plus a timeout check every
+// RADIO_BUSY_CHECK_MS while a TX or a multi-packet RX is in progress
+void WakeCycleModel::radioTaskPasses(uint8_t irqs, uint32_t busyMs) {
+    _radioIrqWakeups += irqs + busyMs / RADIO_BUSY_CHECK_MS;
+}
+
+// The SX1262's own RX timeout ends the window: one RxDone or RxTimeout
+void WakeCycleModel::listen(uint32_t ms) {
+    radioTaskPasses(1, 0);
+    clock.advanceMs(ms);
+    _result->rxMs += ms;
+    _result->rxMsBy[(size_t)_lastTx] += ms;
+}
+
+bool WakeCycleModel::metricsDue() const {
+    return storage.isMetricsDue() || _powerOn;
+}
+
+void WakeCycleModel::sendAdvertise() {
+    storage.getNextTxSequenceNumber();
+    transmit(SimTxContext::ADOPTION_ADVERTISE, ADVERTISE_FRAME);
+
+    uint16_t waitAfterTx = storage.get16(SimRegion::SETTINGS, SimStorage::S_WAIT_AFTER_TX);
+    if (_lastTxLost || !rng.chance(_scenario.adoptionResponse)) {
+        listen(waitAfterTx);
+        return;
+    }
+
+    // Adoption request arrives inside the listen window
+    uint8_t requestPackets = 1;
+    uint32_t requestMs = GATEWAY_TURNAROUND_MS + radio.send(ADOPTION_REQ_FRAME, &requestPackets);
+    radioTaskPasses(requestPackets, requestMs);
+    _result->rxMs += requestMs;
+    _result->rxMsBy[(size_t)SimTxContext::ADOPTION_ADVERTISE] += requestMs;
+    clock.advanceMs(ADOPTION_CRYPTO_MS + HANDLER_DELAY_MS);
+
+    static const uint8_t gatewayId[4] = {0x47, 0x57, 0x00, 0x01};
+    storage.setParentID(gatewayId);
+    storage.put8(SimRegion::METRICS, SimStorage::M_ACK_FAIL_COUNT, 0);
+    storage.put32(SimRegion::SCRATCHPAD, SimStorage::P_TX_SEQUENCE, 2);
+    transmit(SimTxContext::ADOPTION_ACCEPT, ACCEPT_FRAME);
+
+    // ADOPTION_ACCEPT -> initial metrics; once its command window closes,
+    // AppState::RADIO sends the reading taken at boot
+    sendMetrics();
+    sendTelemetry();
+}
+
+void WakeCycleModel::sendTelemetry() {
+    float tempC = _sampled ? _sampleC : sensor.readTemperature();
+    sensor.readContact();
+    _sendingC = tempC;
+
+    // Brownout marker must reach FRAM before the PA turns on
+    storage.put16(SimRegion::SCRATCHPAD, SimStorage::P_PRE_TX_BATTERY,
+                  storage.get16(SimRegion::SCRATCHPAD, SimStorage::P_RAW_BATTERY));
+    storage.put8(SimRegion::SCRATCHPAD, SimStorage::P_LAST_TX_STATUS, 1);
+
+    size_t frameLen = TELEMETRY_FRAME;
+    if (batchEnabled()) {
+        queueReading();
+        frameLen = TELEMETRY_FRAME - 3 + 2 + _queued * BATCH_WIRE_RECORD;
+    }
+    flushStorage();
+
+    storage.getNextTxSequenceNumber();
+    transmit(SimTxContext::TELEMETRY, frameLen);
+    storage.put16(SimRegion::METRICS, SimStorage::M_TELEMETRY_SINCE,
+                  storage.get16(SimRegion::METRICS, SimStorage::M_TELEMETRY_SINCE) + 1);
+
+    if (storage.get8(SimRegion::SETTINGS, SimStorage::S_TELEMETRY_ACK) != 0) {
+        bool ackLost = _scenario.linkModel ? _lastTxLost || !linkDelivers(false)
+                                           : rng.chance(_scenario.ackLoss);
+        if (ackLost) {
+            listen(ACK_WINDOW_MS);
+            onAckTimeout();
+        } else {
+            listen(GATEWAY_TURNAROUND_MS + radio.packetAirtimeMs(ACK_FRAME));
+            onAckReceived();
+        }
+        return;
+    }
+
+    // TX success without ACK clears the batch
+    if (batchEnabled()) {
+        clearBatch();
+    }
+    onReported();
+
+    if (metricsDue()) {
+        sendMetrics();
+    }
+}
+
+void WakeCycleModel::onAckReceived() {
+    if (batchEnabled()) {
+        clearBatch();
+    }
+    onReported();
+    storage.put8(SimRegion::METRICS, SimStorage::M_ACK_FAIL_COUNT, 0);
+    if (metricsDue()) {
+        sendMetrics();
+    }
+}
+
+// ReportFilter::onReported(): the deadband reference moves only once the
+// reading is delivered
+void WakeCycleModel::onReported() {
+    _lastReportedC = _sendingC;
+    _silentS = 0;
+    if (deadbandEnabled()) {
+        touchTail(REPORT_STATE, 7);
+    }
+}
+
+void WakeCycleModel::onAckTimeout() {
+    uint8_t fails = storage.get8(SimRegion::METRICS, SimStorage::M_ACK_FAIL_COUNT) + 1;
+    storage.put8(SimRegion::METRICS, SimStorage::M_ACK_FAIL_COUNT, fails);
+    storage.put16(SimRegion::METRICS, SimStorage::M_ACK_FAIL_TOTAL,
+                  storage.get16(SimRegion::METRICS, SimStorage::M_ACK_FAIL_TOTAL) + 1);
+    if (fails >= storage.get8(SimRegion::SETTINGS, SimStorage::S_ACK_FAIL_THRESHOLD)) {
+        storage.clearParentID();
+        _cryptoWarm = false;
+    }
+}
+
+void WakeCycleModel::sendMetrics() {
+    // buildMetricsReport(): from the live region, no flush
+    uint32_t seq = storage.getNextTxSequenceNumber();
+    uint8_t report[SimStorage::PAYLOAD_SIZE];
+    memcpy(report, storage.region(SimRegion::METRICS), sizeof(report));
+
+    uint32_t baseSequence = 0;
+    size_t payloadLen = buildMetrics(report, &baseSequence);
+    transmit(SimTxContext::METRICS, METRICS_FRAME - SimStorage::PAYLOAD_SIZE + payloadLen);
+    storage.put16(SimRegion::METRICS, SimStorage::M_TELEMETRY_SINCE, 0);
+
+    // Deltas or gate on: the gateway ACKs inside the command window, and the
+    // report becomes the baseline
+    bool acked = false;
+    if (_scenario.metricsFullEvery > 0 || _scenario.downlinkGate) {
+        acked = _scenario.linkModel ? !_lastTxLost && linkDelivers(false)
+                                    : !rng.chance(_scenario.ackLoss);
+        if (acked && _scenario.metricsFullEvery > 0) {
+            storeMetricsBaseline(report, seq);
+        }
+    }
+
+    // Command window; the simulated gateway has nothing queued, so with the
+    // gate on its ACK closes the window
+    if (acked && _scenario.downlinkGate) {
+        listen(GATEWAY_TURNAROUND_MS + radio.packetAirtimeMs(ACK_HINT_FRAME));
+    } else {
+        listen(storage.get16(SimRegion::SETTINGS, SimStorage::S_WAIT_AFTER_TX));
+    }
+}
+
+// MetricsReport::build() + onSent(): payload length of this report
+size_t WakeCycleModel::buildMetrics(const uint8_t* report, uint32_t* baseSequence) {
+    uint8_t n = _scenario.metricsFullEvery;
+    if (n == 0) return SimStorage::PAYLOAD_SIZE;
+
+    size_t len = 0;
+    if (n > 1 && _sinceFull + 1 < n) {
+        uint8_t baseline[BASELINE_SIZE];
+        fram.read(BASELINE_ADDR, baseline, 6);
+        if ((uint16_t)(baseline[0] << 8 | baseline[1]) == BASELINE_MAGIC) {
+            fram.read(BASELINE_ADDR + 6, baseline + 6, SimStorage::PAYLOAD_SIZE);
+            *baseSequence = (uint32_t)baseline[2] << 24 | (uint32_t)baseline[3] << 16
+                          | (uint32_t)baseline[4] << 8 | baseline[5];
+            uint8_t payload[SimStorage::PAYLOAD_SIZE];
+            len = MetricsDelta::encode(MetricsFields::TABLE, MetricsFields::COUNT, baseline + 6,
+                                       report, SimStorage::PAYLOAD_SIZE, *baseSequence,
+                                       payload, sizeof(payload));
+        }
+    }
+    bool delta = len > 0 && len < SimStorage::PAYLOAD_SIZE;
+    _sinceFull = delta ? (_sinceFull < 0xFF ? _sinceFull + 1 : 0xFF) : 0;
+    touchTail(METRICS_STATE, 1);
+    return delta ? len : SimStorage::PAYLOAD_SIZE;
+}
+
+// MetricsReport::onAcknowledged(): invalidate, write, validate
+void WakeCycleModel::storeMetricsBaseline(const uint8_t* report, uint32_t sequence) {
+    uint8_t header[6] = {0, 0, (uint8_t)(sequence >> 24), (uint8_t)(sequence >> 16),
+                         (uint8_t)(sequence >> 8), (uint8_t)sequence};
+    fram.write(BASELINE_ADDR, header, sizeof(header));
+    fram.write(BASELINE_ADDR + 6, report, SimStorage::PAYLOAD_SIZE);
+    header[0] = (uint8_t)(BASELINE_MAGIC >> 8);
+    header[1] = (uint8_t)BASELINE_MAGIC;
+    fram.write(BASELINE_ADDR, header, 2);
+}
+
+// ============================================================================
+// Pre-sleep accounting + deep sleep
+// ============================================================================
+void WakeCycleModel::finishCycle() {
+    uint32_t awakeMs = (uint32_t)((clock.nowUs() - _wakeStartUs) / 1000);
+    uint32_t radioBusyMs = _result->txMs + _result->rxMs;
+    uint32_t idleMs = awakeMs > radioBusyMs ? awakeMs - radioBusyMs : 0;
+    const float standbyMa = _radioOn ? SimEnergy::RADIO_STANDBY_MA : 0.0f;
+
+    // AppEventLoop: in listen windows the MCU light-sleeps instead of
+    // spinning in loop(); the SX1262 RX current is unchanged
+    uint32_t mcuActiveMs = awakeMs;
+    double mcuSleep_uWh = 0.0;
+    if (_scenario.lightSleepWaits) {
+        mcuActiveMs = awakeMs > _result->rxMs ? awakeMs - _result->rxMs : 0;
+        mcuSleep_uWh = SimEnergy::uWh((SimEnergy::SLEEP_UA + SimEnergy::MCU_LIGHT_SLEEP_EXTRA_UA) / 1000.0f,
+                                      awakeMs - mcuActiveMs);
+    }
+
+    // Radio task: every pass takes its core out of WAITI
+    uint32_t radioWakeups = 0;
+    if (_radioOn) {
+        radioWakeups = _scenario.radioIrq ? _radioIrqWakeups
+                                          : (uint32_t)((clock.nowUs() - _radioUpUs) / RADIO_TICK_US);
+    }
+    double radioTask_uWh = SimEnergy::uWh(SimEnergy::CORE_ACTIVE_EXTRA_MA,
+                                          radioWakeups * (double)SimEnergy::RADIO_PASS_US / 1000.0);
+    _result->radioWakeups = radioWakeups;
+    _result->radioTask_uWh = radioTask_uWh;
+
+    double uWh = SimEnergy::uWh(SimEnergy::MCU_ACTIVE_MA, mcuActiveMs) + mcuSleep_uWh + radioTask_uWh
+               + SimEnergy::uWh(SimEnergy::radioTxMa(radio.config.txPower), _result->txMs)
+               + SimEnergy::uWh(SimEnergy::RADIO_RX_MA, _result->rxMs)
+               + SimEnergy::uWh(standbyMa, idleMs);
+
+    // accumulateMetricsBeforeSleep()
+    storage.put32(SimRegion::METRICS, SimStorage::M_TOTAL_TX_TIME,
+                  storage.get32(SimRegion::METRICS, SimStorage::M_TOTAL_TX_TIME) + _result->txMs);
+    storage.put32(SimRegion::METRICS, SimStorage::M_TOTAL_RX_TIME,
+                  storage.get32(SimRegion::METRICS, SimStorage::M_TOTAL_RX_TIME) + _result->rxMs);
+    storage.put32(SimRegion::METRICS, SimStorage::M_TOTAL_ACTIVE_TIME,
+                  storage.get32(SimRegion::METRICS, SimStorage::M_TOTAL_ACTIVE_TIME) + idleMs);
+    storage.put32(SimRegion::METRICS, SimStorage::M_TOTAL_ENERGY,
+                  storage.get32(SimRegion::METRICS, SimStorage::M_TOTAL_ENERGY) + (uint32_t)uWh);
+    flushStorage();
+    if (_radioOn) {
+        radio.deepSleep();
+    }
+
+    // Report the full wake including the final flush
+    _result->awakeMs = (uint32_t)((clock.nowUs() - _wakeStartUs) / 1000);
+    _result->awake_uWh = uWh + SimEnergy::uWh(SimEnergy::MCU_ACTIVE_MA + standbyMa,
+                                              _result->awakeMs - awakeMs);
+    _result->framTransactions = fram.transactions;
+    _result->framBytes = fram.bytesRead + fram.bytesWritten;
+
+    uint16_t sleepS = storage.get16(SimRegion::SETTINGS, SimStorage::S_TELEMETRY_INTERVAL);
+    _result->sleepS = sleepS;
+    float tmp112Ua = _scenario.sensorOneShot ? SimEnergy::TMP112_SHUTDOWN_UA : SimEnergy::TMP112_ACTIVE_UA;
+    float radioUa = _radioWarm ? SimEnergy::RADIO_WARM_SLEEP_EXTRA_UA : 0.0f;
+    if (_scenario.worSniffMs > 0) {
+        radioUa = SimEnergy::MCU_LIGHT_SLEEP_EXTRA_UA + worSniffUa(_scenario);
+    }
+    _result->sleep_uWh = SimEnergy::uWh((SimEnergy::SLEEP_UA + tmp112Ua + radioUa) / 1000.0f,
+                                        (double)sleepS * 1000.0);
+    battery.drain_uWh(_result->awake_uWh + _result->sleep_uWh);
+    clock.advanceMs((uint32_t)sleepS * 1000);
+}
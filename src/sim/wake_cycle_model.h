@@ -0,0 +1,217 @@
+#ifndef WAKE_CYCLE_MODEL_H
+#define WAKE_CYCLE_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sim_clock.h"
+#include "sim_hal.h"
+#include "../dirty_ranges.h"
+#include "../metrics_fields.h"
+
+// Mirrors TxContext in adoption_handler.h
+enum class SimTxContext : uint8_t {
+    NONE,
+    TELEMETRY,
+    METRICS,
+    SETTINGS_REPORT,
+    COMMAND_RESPONSE,
+    JOURNAL_PAGE,
+    ACK,
+    ADOPTION_ADVERTISE,
+    ADOPTION_ACCEPT
+};
+
+const char* txContextName(SimTxContext ctx);
+
+struct SimScenario {
+    uint32_t cycles = 10000;
+    uint32_t seed = 1;
+    uint16_t telemetryInterval = 600;     // seconds
+    uint16_t metricsInterval = 6;         // telemetry cycles per metrics report
+    uint16_t waitAfterTx = 8000;          // ms
+    bool telemetryAckRequired = false;
+    float ackLoss = 0.05f;                // probability an ACK never arrives
+    float adoptionResponse = 1.0f;        // probability the gateway answers an advertise
+    uint8_t batchSize = 0;                // telemetryBatchSize (<= 1 = send every wake)
+    bool dirtyRangeWriteBack = true;      // false = rewrite whole dirty sensor tails
+    bool warmCrypto = true;               // RTC warm context on adopted deep-sleep wakes
+    bool sensorOneShot = true;            // TMP112 one-shot + shutdown between wakes
+    uint16_t deadbandCenti = 0;           // report-by-exception threshold (0 = off, batch off only)
+    uint32_t heartbeatS = 3600;           // longest silence under the deadband
+    bool radioWarm = false;               // what-if: SX1262 warm sleep + resume, not in the firmware
+    int8_t txPower = 22;                  // dBm
+    uint8_t spreadingFactor = 7;
+    uint8_t bandwidth = 0;                // 0=125 kHz, 1=250 kHz, 2=500 kHz
+    uint8_t codingRate = 1;               // 4/5
+    uint8_t ackFailThreshold = 5;
+    uint8_t metricsFullEvery = 0;         // delta metrics: every N-th report full (0 = off)
+    bool downlinkGate = false;            // metrics ACK says whether a command is queued
+    uint16_t worSniffMs = 0;              // wake-on-radio sniff period (0 = off, MCU deep-sleeps)
+    bool lightSleepWaits = true;          // AppEventLoop light-sleeps Core 1 in listen windows
+    bool radioIrq = true;                 // RadioTask blocks on DIO1 instead of polling every tick
+
+    // Link model: per-frame SNR decides uplink and ACK loss instead of ackLoss
+    bool linkModel = false;
+    float linkSnrDb = 10.0f;              // SNR at SF7/BW125/+22 dBm, same both ways
+    float linkFadeDb = 3.0f;              // per-frame fading, standard deviation
+
+    // Take the knobs above from a 207-byte settings payload (wire layout,
+    // sensor type 0x01 tail included). False if it is not one.
+    bool loadSettings(const uint8_t* blob, size_t len);
+};
+
+struct CycleResult {
+    static constexpr size_t MAX_PATH = 8;
+    static constexpr size_t CONTEXTS = 9;     // SimTxContext values
+
+    SimTxContext path[MAX_PATH];
+    uint8_t pathLength = 0;
+    uint32_t awakeMs = 0;
+    uint32_t txMs = 0;
+    uint32_t rxMs = 0;
+    uint32_t sleepS = 0;
+    double awake_uWh = 0.0;
+    double sleep_uWh = 0.0;
+    uint32_t framTransactions = 0;
+    uint32_t framBytes = 0;
+    uint32_t radioWakeups = 0;                // radio task passes (tick polling or DIO1/kick/timeout)
+    double radioTask_uWh = 0.0;               // their share of awake_uWh
+
+    // Per frame type, indexed by SimTxContext. RX is the listen window the
+    // frame opened (ACK or command window).
+    uint32_t txMsBy[CONTEXTS] = {};
+    uint32_t rxMsBy[CONTEXTS] = {};
+    uint8_t framesBy[CONTEXTS] = {};
+    uint8_t lostBy[CONTEXTS] = {};            // never reached the gateway (link model)
+
+    // "TELEMETRY>METRICS" etc.
+    void describePath(char* out, size_t outLen) const;
+};
+
+// ============================================================================
+// Wake Cycle Model
+// ============================================================================
+// Hand-written replay of setup()/loop()/onTxComplete()/onDataReceived() from
+// main.cpp against the simulated HAL. It does not compile or run the firmware:
+// every decision here is a copy, kept in step with main.cpp by hand. Its
+// numbers compare one version of the model with another. They are estimates,
+// not measurements, and not evidence that the firmware takes a given path.
+// A knob models a feature as designed, whether or not the code it stands for
+// runs on the device; the firmware and its host tests (test/) say that, and
+// figures to rely on come from the hardware bench.
+class WakeCycleModel {
+public:
+    // First line of every report built on this model
+    static constexpr const char* DISCLAIMER =
+        "Model estimate: hand-written copy of main.cpp's decisions, not the firmware "
+        "(see wake_cycle_model.h)";
+
+    // Fixed costs measured on the bench (ms)
+    static constexpr uint32_t DEEP_SLEEP_BOOT_MS    = 110;   // ROM + 2nd stage + app init after deep sleep
+    static constexpr uint32_t POWER_ON_BOOT_MS      = 320;   // cold boot incl. PSRAM test
+    static constexpr uint32_t CRYPTO_INIT_MS        = 55;    // encryption.begin + credentials + CA parse
+    static constexpr uint32_t CRYPTO_WARM_MS        = 3;     // encryption.begin + fingerprint + RTC session key
+    static constexpr uint32_t ADOPTION_CRYPTO_MS    = 450;   // chain verify + ECDSA + ECDH + HKDF + sign
+    static constexpr uint32_t HANDLER_DELAY_MS      = 150;   // delay(150) before replies
+    static constexpr uint32_t ACK_WINDOW_MS         = 3000;
+    static constexpr uint32_t GATEWAY_TURNAROUND_MS = 60;
+    static constexpr uint32_t I2C_PROBE_US          = 100;
+    static constexpr uint32_t RADIO_WARM_MAX_SLEEP_S = 180;  // where warm sleep stops paying
+    static constexpr uint32_t RADIO_TICK_US         = 1000;  // vTaskDelay(1) at CONFIG_FREERTOS_HZ 1000
+    static constexpr uint32_t RADIO_BUSY_CHECK_MS   = 20;    // RadioTask::BUSY_CHECK_MS
+
+    // Frame sizes on the wire (bytes, including 20-byte frame overhead)
+    static constexpr size_t TELEMETRY_FRAME    = 51;
+    static constexpr size_t METRICS_FRAME      = 255;
+    static constexpr size_t ACK_FRAME          = 20;
+    static constexpr size_t ACK_HINT_FRAME     = ACK_FRAME + 2;     // DownlinkGate hint, plaintext
+    static constexpr size_t DEVICE_CERT_LEN    = 695;
+    static constexpr size_t GATEWAY_CERT_LEN   = 620;
+    static constexpr size_t ADVERTISE_FRAME    = 20 + 8 + DEVICE_CERT_LEN;
+    static constexpr size_t ADOPTION_REQ_FRAME = 20 + 153 + GATEWAY_CERT_LEN;
+    static constexpr size_t ACCEPT_FRAME       = 20 + 174 + DEVICE_CERT_LEN;
+
+    explicit WakeCycleModel(const SimScenario& scenario);
+
+    // Wake-on-radio: average SX1262 current of the sniff (RX window each
+    // period, warm sleep in between) and the gateway preamble it needs
+    static float worSniffUa(const SimScenario& s);
+    static uint32_t worPreambleSymbols(const SimScenario& s);
+
+    CycleResult runCycle();
+
+    SimClock clock;
+    SimRandom rng;
+    SimFram fram;
+    SimStorage storage;
+    SimRadio radio;
+    SimTmp112 sensor;
+    SimBattery battery;
+
+private:
+    static constexpr uint16_t SENSOR_TAIL_ADDR = SimStorage::SCRATCHPAD_ADDR + 32;
+    static constexpr size_t SENSOR_TAIL_SIZE = 368;
+    static constexpr size_t BATCH_RECORD_SIZE = 7;
+    static constexpr size_t BATCH_WIRE_RECORD = 5;
+    static constexpr uint16_t REPORT_STATE = 302;
+    static constexpr uint16_t METRICS_STATE = SensorScratchpad::METRICS_STATE;
+    static constexpr uint16_t BASELINE_ADDR = FreeRegion::METRICS_BASELINE;
+    static constexpr size_t BASELINE_SIZE = FreeRegion::METRICS_BASELINE_SIZE;
+    static constexpr uint16_t BASELINE_MAGIC = 0xD17A;     // MetricsReport::BASELINE_MAGIC
+
+    SimScenario _scenario;
+    bool _powerOn = true;
+    bool _radioOn = false;
+    bool _cryptoWarm = false;             // WarmContext saved in RTC
+    bool _radioWarm = false;              // SX1262 left in warm sleep (what-if)
+    CycleResult* _result = nullptr;
+    uint64_t _wakeStartUs = 0;
+    uint64_t _radioUpUs = 0;              // radio task entered its loop
+    uint32_t _radioIrqWakeups = 0;        // interrupt-driven passes so far this wake
+
+    // SensorRegionStore scratchpad tail (TelemetryBatch reading buffer)
+    uint8_t _sensorTail[SENSOR_TAIL_SIZE] = {};
+    DirtyRanges _tailDirty;
+    DirtyRanges _tailChanged;
+    uint8_t _queued = 0;
+
+    // ReportFilter state
+    float _lastReportedC = -1000.0f;
+    uint32_t _silentS = 0;
+    bool _sampled = false;                // this wake's reading already taken
+    float _sampleC = 0.0f;
+    float _sendingC = 0.0f;               // reading in the telemetry frame, not yet delivered
+
+    // MetricsReport: delta reports since the last full one (baseline in SimFram)
+    uint8_t _sinceFull = 0;
+
+    // Last frame sent, for RX attribution and the link model
+    SimTxContext _lastTx = SimTxContext::NONE;
+    bool _lastTxLost = false;
+
+    void boot();
+    void bootRadio();
+    bool batchEnabled() const { return _scenario.batchSize > 1; }
+    bool deadbandEnabled() const { return _scenario.deadbandCenti > 0 && !batchEnabled(); }
+    bool reportDue(float tempC);
+    void queueReading();
+    void clearBatch();
+    void touchTail(uint16_t off, size_t len);
+    void flushStorage();
+    void sendAdvertise();
+    void sendTelemetry();
+    void sendMetrics();
+    size_t buildMetrics(const uint8_t* report, uint32_t* baseSequence);
+    void storeMetricsBaseline(const uint8_t* report, uint32_t sequence);
+    void listen(uint32_t ms);
+    void radioTaskPasses(uint8_t irqs, uint32_t busyMs);
+    void transmit(SimTxContext ctx, size_t frameLen);
+    bool linkDelivers(bool uplink);
+    void onAckReceived();
+    void onReported();
+    void onAckTimeout();
+    void finishCycle();
+    bool metricsDue() const;
+};
+
+#endif // WAKE_CYCLE_MODEL_H
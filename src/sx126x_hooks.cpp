@@ -0,0 +1,89 @@
+#include "sx126x_hooks.h"
+#include <SX126x-Arduino.h>
+
+namespace {
+
+constexpr uint16_t SNIFF_IRQS = IRQ_RX_DONE | IRQ_CRC_ERROR | IRQ_HEADER_ERROR;
+
+bool driverReady = false;
+
+// On a wake where ResonantLRRadio::init() did not run, the chip is still
+// sniffing with the configuration an earlier wake left. Bring up SPI and
+// the pins without resetting it.
+bool ensureDriver(ResonantLRRadio& radio) {
+    if (radio.radioInitialized || driverReady) return true;
+    hw_config hwConfig;
+    hwConfig.CHIP_TYPE = SX1262_CHIP;
+    hwConfig.PIN_LORA_RESET = LORA_SX126X_RESET;
+    hwConfig.PIN_LORA_NSS = LORA_SX126X_CS;
+    hwConfig.PIN_LORA_SCLK = LORA_SX126X_SCK;
+    hwConfig.PIN_LORA_MISO = LORA_SX126X_MISO;
+    hwConfig.PIN_LORA_DIO_1 = LORA_SX126X_DIO1;
+    hwConfig.PIN_LORA_BUSY = LORA_SX126X_BUSY;
+    hwConfig.PIN_LORA_MOSI = LORA_SX126X_MOSI;
+    hwConfig.RADIO_TXEN = -1;
+    hwConfig.RADIO_RXEN = -1;
+    hwConfig.USE_DIO2_ANT_SWITCH = true;
+    hwConfig.USE_DIO3_TCXO = true;
+    hwConfig.USE_DIO3_ANT_SWITCH = false;
+    hwConfig.USE_LDO = false;
+    hwConfig.USE_RXEN_ANT_PWR = false;
+    if (lora_hardware_re_init(hwConfig) != 0) return false;
+    // WakeOnRadio::sleep() reads DIO1 itself
+    detachInterrupt(LORA_SX126X_DIO1);
+    driverReady = true;
+    return true;
+}
+
+// SX1262 timer steps of 15.625 us
+uint32_t timerSteps(uint32_t us) {
+    return (uint32_t)(((uint64_t)us * 64 + 999) / 1000);
+}
+
+} // namespace
+
+bool resonantRadioSniff(ResonantLRRadio& radio, uint32_t rxUs, uint32_t sleepUs,
+                        uint16_t preambleLength) {
+    if (!ensureDriver(radio)) return false;
+    Radio.Standby();
+    // After init() the chip holds the library's packet parameters; a chip
+    // re-armed after a sniff still holds the long preamble
+    if (radio.radioInitialized) {
+        RadioConfig config = radio.getConfig();
+        if (config.modem != MODEM_LORA_MODE) return false;
+        Radio.SetRxConfig(MODEM_LORA, config.loraBandwidth, config.loraSpreadingFactor,
+                          config.loraCodingRate, 0, preambleLength, 0, false, 0,
+                          config.crcOn, false, 0, false, true);
+    }
+    SX126xClearIrqStatus(IRQ_RADIO_ALL);
+    SX126xSetDioIrqParams(SNIFF_IRQS, SNIFF_IRQS, IRQ_RADIO_NONE, IRQ_RADIO_NONE);
+    Radio.SetRxDutyCycle(timerSteps(rxUs), timerSteps(sleepUs));
+    return true;
+}
+
+void resonantRadioDio1Missed(ResonantLRRadio& radio) {
+    if (!radio.radioInitialized) return;
+    // Sets the driver's IrqFired and processes the IRQ status right away
+    Radio.IrqProcessAfterDeepSleep();
+}
+
+bool resonantRadioSniffRead(ResonantLRRadio& radio, uint8_t* buf, size_t* len,
+                            int16_t* rssi, int8_t* snr) {
+    if (!ensureDriver(radio)) return false;
+    uint16_t irq = SX126xGetIrqStatus();
+    SX126xClearIrqStatus(IRQ_RADIO_ALL);
+    if (!(irq & IRQ_RX_DONE) || (irq & (IRQ_CRC_ERROR | IRQ_HEADER_ERROR))) return false;
+
+    uint8_t size = 0;
+    uint8_t offset = 0;
+    SX126xGetRxBufferStatus(&size, &offset);
+    if (size > *len) return false;
+    SX126xReadBuffer(offset, buf, size);
+    *len = size;
+
+    PacketStatus_t status;
+    SX126xGetPacketStatus(&status);
+    *rssi = status.Params.LoRa.RssiPkt;
+    *snr = status.Params.LoRa.SnrPkt;
+    return true;
+}
@@ -0,0 +1,30 @@
+#ifndef SX126X_HOOKS_H
+#define SX126X_HOOKS_H
+
+#include <Arduino.h>
+#include "resonant_lr_radio.h"
+
+// ============================================================================
+// ResonantLRRadio Hooks
+// ============================================================================
+// Chip-side steps ResonantLRRadio has no API for. The library keeps the
+// SX126x-Arduino event table private, so these go to the chip through the
+// driver's Radio and SX126x* calls directly. Both also work on a wake where
+// init() did not run: SPI and the pins come up with lora_hardware_re_init(),
+// without NRESET.
+
+// Wake-on-radio (WakeOnRadio): program `preambleLength`, map RxDone to DIO1,
+// Radio.SetRxDutyCycle()
+bool resonantRadioSniff(ResonantLRRadio& radio, uint32_t rxUs, uint32_t sleepUs,
+                        uint16_t preambleLength);
+// The packet that ended a sniff; clears the IRQ
+bool resonantRadioSniffRead(ResonantLRRadio& radio, uint8_t* buf, size_t* len,
+                            int16_t* rssi, int8_t* snr);
+
+// Light sleep (AppEventLoop, RadioTask): a DIO1 rise the driver's edge
+// interrupt missed while the pin was a wake source. The driver handles it
+// as if its own ISR had run, callbacks included, so call it with radioLock()
+// held.
+void resonantRadioDio1Missed(ResonantLRRadio& radio);
+
+#endif // SX126X_HOOKS_H
@@ -0,0 +1,112 @@
+#include "telemetry_batch.h"
+
+void TelemetryBatch::init(SensorRegionStore* store) {
+    _store = store;
+    if (count() > MAX_RECORDS) {
+        LOG_W("Reading buffer corrupt (count=%u), clearing", count());
+        clear();
+    }
+}
+
+uint8_t TelemetryBatch::batchSize() const {
+    if (_store == nullptr || !_store->isInitialized()) return 0;
+    uint8_t n = _store->get8(SensorRegion::SETTINGS, SensorSettings::TELEMETRY_BATCH_SIZE);
+    return n > MAX_RECORDS ? MAX_RECORDS : n;
+}
+
+uint8_t TelemetryBatch::format() const {
+    if (_store == nullptr || !_store->isInitialized()) return TelemetryFormat::BATCH;
+    uint8_t f = _store->get8(SensorRegion::SETTINGS, SensorSettings::TELEMETRY_FORMAT);
+    return f == TelemetryFormat::COMPACT ? TelemetryFormat::COMPACT : TelemetryFormat::BATCH;
+}
+
+bool TelemetryBatch::typedRecords() const {
+    if (_store == nullptr || !_store->isInitialized()) return false;
+    return _store->get8(SensorRegion::SETTINGS, SensorSettings::TELEMETRY_FORMAT) == TelemetryFormat::TYPED;
+}
+
+uint8_t TelemetryBatch::count() const {
+    if (_store == nullptr || !_store->isInitialized()) return 0;
+    return _store->get8(SensorRegion::SCRATCHPAD, BASE);
+}
+
+void TelemetryBatch::onWake(uint32_t sleptSeconds) {
+    if (count() == 0) return;
+    uint32_t elapsed = _store->get32(SensorRegion::SCRATCHPAD, BASE + 1);
+    _store->put32(SensorRegion::SCRATCHPAD, BASE + 1, elapsed + sleptSeconds);
+}
+
+void TelemetryBatch::append(int16_t rawCount, bool contactClosed) {
+    if (_store == nullptr || !_store->isInitialized()) return;
+
+    uint8_t n = count();
+    if (n == 0) {
+        _store->put32(SensorRegion::SCRATCHPAD, BASE + 1, 0);
+    }
+    if (n >= MAX_RECORDS) {
+        uint8_t shifted[(MAX_RECORDS - 1) * RECORD_SIZE];
+        _store->read(SensorRegion::SCRATCHPAD, recordOffset(1), shifted, sizeof(shifted));
+        _store->write(SensorRegion::SCRATCHPAD, recordOffset(0), shifted, sizeof(shifted));
+        n = MAX_RECORDS - 1;
+        LOG_W("Reading buffer full, oldest reading dropped");
+    }
+
+    uint32_t elapsed = _store->get32(SensorRegion::SCRATCHPAD, BASE + 1);
+    uint16_t off = recordOffset(n);
+    _store->put32(SensorRegion::SCRATCHPAD, off, elapsed);
+    _store->put16(SensorRegion::SCRATCHPAD, off + 4, (uint16_t)rawCount);
+    _store->put8(SensorRegion::SCRATCHPAD, off + 6, contactClosed ? 0x01 : 0x00);
+    _store->put8(SensorRegion::SCRATCHPAD, BASE, n + 1);
+}
+
+size_t TelemetryBatch::encode(uint8_t* out, size_t outLen) const {
+    if (format() == TelemetryFormat::COMPACT) {
+        return encodeCompact(out, outLen);
+    }
+    return encodeBatch(out, outLen);
+}
+
+size_t TelemetryBatch::encodeBatch(uint8_t* out, size_t outLen) const {
+    uint8_t n = count();
+    size_t len = WIRE_HEADER_SIZE + n * WIRE_RECORD_SIZE;
+    if (n == 0 || len > outLen) return 0;
+
+    uint32_t elapsed = _store->get32(SensorRegion::SCRATCHPAD, BASE + 1);
+    out[0] = TelemetryFormat::BATCH;
+    out[1] = n;
+    uint8_t* p = out + WIRE_HEADER_SIZE;
+    for (uint8_t i = 0; i < n; i++) {
+        uint16_t off = recordOffset(i);
+        uint32_t age = elapsed - _store->get32(SensorRegion::SCRATCHPAD, off);
+        if (age > 0xFFFF) age = 0xFFFF;
+        int16_t centi = TelemetryCodec::centiFromRaw((int16_t)_store->get16(SensorRegion::SCRATCHPAD, off + 4));
+        p[0] = (age >> 8) & 0xFF;
+        p[1] = age & 0xFF;
+        p[2] = ((uint16_t)centi >> 8) & 0xFF;
+        p[3] = (uint16_t)centi & 0xFF;
+        p[4] = _store->get8(SensorRegion::SCRATCHPAD, off + 6);
+        p += WIRE_RECORD_SIZE;
+    }
+    return len;
+}
+
+size_t TelemetryBatch::encodeCompact(uint8_t* out, size_t outLen) const {
+    uint8_t n = count();
+    if (n == 0) return 0;
+
+    TelemetrySample samples[MAX_RECORDS];
+    uint32_t elapsed = _store->get32(SensorRegion::SCRATCHPAD, BASE + 1);
+    for (uint8_t i = 0; i < n; i++) {
+        uint16_t off = recordOffset(i);
+        samples[i].ageS = elapsed - _store->get32(SensorRegion::SCRATCHPAD, off);
+        samples[i].raw = (int16_t)_store->get16(SensorRegion::SCRATCHPAD, off + 4);
+        samples[i].contact = _store->get8(SensorRegion::SCRATCHPAD, off + 6) != 0;
+    }
+    return TelemetryCodec::encode(samples, n, out, outLen);
+}
+
+void TelemetryBatch::clear() {
+    if (_store == nullptr || !_store->isInitialized()) return;
+    _store->put8(SensorRegion::SCRATCHPAD, BASE, 0);
+    _store->put32(SensorRegion::SCRATCHPAD, BASE + 1, 0);
+}
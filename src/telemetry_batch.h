@@ -0,0 +1,91 @@
+#ifndef TELEMETRY_BATCH_H
+#define TELEMETRY_BATCH_H
+
+#include <Arduino.h>
+#include <TelemetryCodec.h>
+#include <SensorPipeline.h>
+#include "sensor_region_store.h"
+
+// ============================================================================
+// Telemetry Payload Formats
+// ============================================================================
+// Options bit 1 set = telemetry payload starts with a format byte. Clear =
+// legacy 3-byte single reading (V1_SENSOR_WIRE_FORMAT.md section 4).
+namespace TelemetryFormat {
+    constexpr uint8_t OPTION_EXTENDED_PAYLOAD = 0x02;
+
+    constexpr uint8_t BATCH   = 0x01;   // count + N x (age, tempCenti, contact)
+    constexpr uint8_t COMPACT = TelemetryCodec::FORMAT_COMPACT;  // raw count + varint deltas
+    constexpr uint8_t TYPED   = SensorPipeline::FORMAT_TYPED;    // one typed record per channel
+}
+
+// ============================================================================
+// Telemetry Batch
+// ============================================================================
+// Queues one reading per wake in the FRAM sensorReadingBuffer and flushes
+// them as a single multi-record telemetry frame every N wakes
+// (SensorSettings::TELEMETRY_BATCH_SIZE), encoded as BATCH or COMPACT
+// (SensorSettings::TELEMETRY_FORMAT).
+//
+// FRAM layout (scratchpad sensor tail, READING_BUFFER):
+//   0      count          uint8_t
+//   1-4    elapsed        uint32_t  seconds since the first queued reading
+//   5..    records        N x { offset uint32_t, raw int16_t (TMP112 count), contact uint8_t }
+//
+// Wire payload (format BATCH):
+//   0      format         0x01
+//   1      count          uint8_t
+//   2..    records        N x { age uint16_t (s before TX, saturating),
+//                               tempCenti int16_t, contact uint8_t }
+class TelemetryBatch {
+public:
+    static constexpr uint8_t MAX_RECORDS = 40;
+    static constexpr size_t  HEADER_SIZE = 5;
+    static constexpr size_t  RECORD_SIZE = 7;
+    static constexpr size_t  WIRE_HEADER_SIZE = 2;
+    static constexpr size_t  WIRE_RECORD_SIZE = 5;
+    static constexpr size_t  MAX_BATCH_WIRE_SIZE = WIRE_HEADER_SIZE + MAX_RECORDS * WIRE_RECORD_SIZE;
+    static constexpr size_t  MAX_WIRE_SIZE =
+        MAX_BATCH_WIRE_SIZE > TelemetryCodec::maxEncodedSize(MAX_RECORDS)
+            ? MAX_BATCH_WIRE_SIZE : TelemetryCodec::maxEncodedSize(MAX_RECORDS);
+
+    static_assert(HEADER_SIZE + MAX_RECORDS * RECORD_SIZE <= SensorScratchpad::READING_BUFFER_SIZE,
+                  "reading buffer overflows its scratchpad slot");
+
+    void init(SensorRegionStore* store);
+
+    // Readings per uplink from settings, clamped to MAX_RECORDS. <= 1 = disabled.
+    uint8_t batchSize() const;
+    bool enabled() const { return batchSize() > 1; }
+    // Payload format from settings; anything unknown falls back to BATCH
+    uint8_t format() const;
+    // telemetryFormat 0x03: single-reading wakes send the SensorPipeline's
+    // typed record. Batches still use BATCH.
+    bool typedRecords() const;
+    uint8_t count() const;
+
+    // Advance the batch clock by the sleep that just ended
+    void onWake(uint32_t sleptSeconds);
+
+    // Queue a reading (TMP112 raw count); the oldest record is dropped when full
+    void append(int16_t rawCount, bool contactClosed);
+
+    // True once this wake's reading fills the batch
+    bool isFlushDue() const { return count() >= batchSize(); }
+    bool isFlushDueAfterNext() const { return count() + 1 >= batchSize(); }
+
+    // Encode the queued readings in format(). Returns bytes written, 0 if empty.
+    size_t encode(uint8_t* out, size_t outLen) const;
+    void clear();
+
+private:
+    SensorRegionStore* _store = nullptr;
+
+    static constexpr uint16_t BASE = SensorScratchpad::READING_BUFFER;
+    static uint16_t recordOffset(uint8_t index) { return BASE + HEADER_SIZE + index * RECORD_SIZE; }
+
+    size_t encodeBatch(uint8_t* out, size_t outLen) const;
+    size_t encodeCompact(uint8_t* out, size_t outLen) const;
+};
+
+#endif // TELEMETRY_BATCH_H
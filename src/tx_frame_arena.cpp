@@ -0,0 +1,89 @@
+#include "tx_frame_arena.h"
+
+void TxFrameArena::init(ResonantEncryption* enc, const uint8_t sourceID[4]) {
+    _enc = enc;
+    memset(_frame, 0, sizeof(_frame));
+    _frame[0] = HEADER_BYTE;
+    memcpy(_frame + 3, sourceID, 4);
+    _frame[17] = 0x01;  // total packets
+    _frame[18] = 0x00;  // packet index
+    _templateValid = false;
+}
+
+void TxFrameArena::setHeader(uint8_t frameType, const uint8_t destinationID[4], uint8_t options) {
+    if (_templateValid &&
+        _frame[11] == frameType &&
+        _frame[12] == options &&
+        memcmp(_frame + 7, destinationID, 4) == 0) {
+        return;
+    }
+
+    memcpy(_frame + 7, destinationID, 4);
+    _frame[11] = frameType;
+    _frame[12] = options;
+
+    uint8_t sum = 0;
+    for (size_t i = 3; i <= 12; i++) {
+        sum += _frame[i];
+    }
+    _templateSum = sum;
+    _templateValid = true;
+}
+
+bool TxFrameArena::buildEncrypted(const uint8_t* plaintext, size_t len, uint32_t seq) {
+    if (_enc == nullptr || !_enc->isInitialized() || !_templateValid || len > MAX_PLAINTEXT) {
+        return false;
+    }
+
+    // AAD: frameType(1) + sourceID(4) + sequenceNumber(4, big-endian)
+    uint8_t aad[AAD_SIZE];
+    aad[0] = _frame[11];
+    memcpy(aad + 1, _frame + 3, 4);
+    aad[5] = (seq >> 24) & 0xFF;
+    aad[6] = (seq >> 16) & 0xFF;
+    aad[7] = (seq >> 8) & 0xFF;
+    aad[8] = seq & 0xFF;
+
+    uint8_t* iv = _frame + HEADER_SIZE;
+    uint8_t* ciphertext = iv + ResonantEncryption::GCM_IV_SIZE;
+    uint8_t* tag = ciphertext + len;
+
+    if (!_enc->encryptGCM(plaintext, len, aad, sizeof(aad), ciphertext, iv, tag)) {
+        LOG_W("Arena GCM encrypt failed");
+        return false;
+    }
+
+    seal(seq, len + ResonantEncryption::WIRE_OVERHEAD);
+    return true;
+}
+
+bool TxFrameArena::buildPlain(const uint8_t* data, size_t len, uint32_t seq) {
+    if (!_templateValid || len > MAX_PAYLOAD) {
+        return false;
+    }
+    memcpy(_frame + HEADER_SIZE, data, len);
+    seal(seq, len);
+    return true;
+}
+
+void TxFrameArena::seal(uint32_t seq, size_t payloadLen) {
+    _size = HEADER_SIZE + payloadLen + CHECKSUM_SIZE;
+
+    uint16_t packetLength = (uint16_t)(_size - 3);
+    _frame[1] = (packetLength >> 8) & 0xFF;
+    _frame[2] = packetLength & 0xFF;
+
+    _frame[13] = (seq >> 24) & 0xFF;
+    _frame[14] = (seq >> 16) & 0xFF;
+    _frame[15] = (seq >> 8) & 0xFF;
+    _frame[16] = seq & 0xFF;
+
+    // Checksum: sum of bytes [3..N] & 0xFF
+    uint8_t sum = _templateSum + _frame[13] + _frame[14] + _frame[15] + _frame[16]
+                + _frame[17] + _frame[18];
+    const uint8_t* payload = _frame + HEADER_SIZE;
+    for (size_t i = 0; i < payloadLen; i++) {
+        sum += payload[i];
+    }
+    _frame[_size - 1] = sum;
+}
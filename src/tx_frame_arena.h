@@ -0,0 +1,60 @@
+#ifndef TX_FRAME_ARENA_H
+#define TX_FRAME_ARENA_H
+
+#include <Arduino.h>
+#include "resonant_encryption.h"
+#include "resonant_log.h"
+
+// ============================================================================
+// TX Frame Arena
+// ============================================================================
+// Fixed 255-byte buffer that every single-packet uplink is built in. The
+// 19-byte Wire Protocol v1 header is written once per (frame type,
+// destination, options) and kept as a template; each frame then only patches
+// sequence number, length and checksum. Encrypted payloads are produced by
+// AES-GCM directly at offset 19 as iv(12) + ciphertext(N) + tag(16), so the
+// TX path performs no heap allocation and no intermediate copy.
+//
+// resonantRadio.send() copies the frame, so the arena may be reused as soon
+// as send() returns.
+class TxFrameArena {
+public:
+    static constexpr size_t MAX_FRAME_SIZE = 255;
+    static constexpr size_t HEADER_SIZE    = 19;
+    static constexpr size_t CHECKSUM_SIZE  = 1;
+    static constexpr size_t MAX_PAYLOAD    = MAX_FRAME_SIZE - HEADER_SIZE - CHECKSUM_SIZE;
+    static constexpr size_t MAX_PLAINTEXT  = MAX_PAYLOAD - ResonantEncryption::WIRE_OVERHEAD;
+    static constexpr uint8_t HEADER_BYTE   = 0x85;
+    static constexpr size_t AAD_SIZE       = 9;
+
+    void init(ResonantEncryption* enc, const uint8_t sourceID[4]);
+
+    void setHeader(uint8_t frameType, const uint8_t destinationID[4], uint8_t options);
+
+    // Encrypts plaintext into the payload field and seals the frame.
+    // Returns false (frame left unsealed) if encryption is unavailable or fails.
+    bool buildEncrypted(const uint8_t* plaintext, size_t len, uint32_t seq);
+
+    // Copies data into the payload field unencrypted and seals the frame.
+    bool buildPlain(const uint8_t* data, size_t len, uint32_t seq);
+
+    uint8_t* frame() { return _frame; }
+    size_t size() const { return _size; }
+    size_t payloadSize() const { return _size > HEADER_SIZE ? _size - HEADER_SIZE - CHECKSUM_SIZE : 0; }
+    const uint8_t* sourceID() const { return _frame + 3; }
+    // Sequence number of the last sealed frame
+    uint32_t sequence() const {
+        return (uint32_t)_frame[13] << 24 | (uint32_t)_frame[14] << 16 | (uint32_t)_frame[15] << 8 | _frame[16];
+    }
+
+private:
+    ResonantEncryption* _enc = nullptr;
+    uint8_t _frame[MAX_FRAME_SIZE];
+    size_t _size = 0;
+    uint8_t _templateSum = 0;      // checksum contribution of bytes 3..12
+    bool _templateValid = false;
+
+    void seal(uint32_t seq, size_t payloadLen);
+};
+
+#endif // TX_FRAME_ARENA_H
@@ -0,0 +1,214 @@
+#include "wake_on_radio.h"
+#include "resonant_log.h"
+#include <esp_rom_crc.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+
+namespace {
+
+constexpr uint32_t WOR_MAGIC = 0x574F5231;      // "WOR1"
+constexpr uint64_t REBOOT_US = 1000;            // deep sleep that hands a wake to setup()
+
+struct WorState {
+    uint32_t magic;
+    uint8_t sniffing;
+    uint8_t sf;
+    uint8_t bandwidth;
+    uint8_t wake;               // WorWake
+    uint32_t sleptMs;
+    uint32_t remainingMs;
+    uint16_t frameWakes;        // not yet counted in FRAM metrics
+    uint16_t falseWakes;
+    int16_t rssi;
+    int8_t snr;
+    uint8_t frameLen;
+    uint8_t frame[WorSniffer::MAX_FRAME];
+    uint32_t crc;
+};
+
+RTC_DATA_ATTR WorState rtcWorState;
+
+uint32_t stateCrc(const WorState& s) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&s, offsetof(WorState, crc));
+}
+
+bool valid(const WorState& s) {
+    return s.magic == WOR_MAGIC && s.crc == stateCrc(s);
+}
+
+void seal(WorState& s) {
+    s.crc = stateCrc(s);
+}
+
+// Light sleep with GPIO wakes, radio through the sniff hooks
+class EspSniffBackend : public SniffBackend {
+public:
+    EspSniffBackend(ResonantLRRadio& radio, int contactLevel)
+        : _radio(radio), _contactLevel(contactLevel) {}
+
+    uint64_t nowUs() override { return (uint64_t)esp_timer_get_time(); }
+
+    SniffEvent lightSleep(uint64_t us) override {
+        esp_sleep_enable_timer_wakeup(us);
+        esp_light_sleep_start();
+        if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_GPIO) return SniffEvent::NONE;
+        if (digitalRead(WakeOnRadio::BUTTON_PIN) == HIGH) return SniffEvent::BUTTON;
+        if (digitalRead(WakeOnRadio::CONTACT_PIN) != _contactLevel) return SniffEvent::CONTACT;
+        if (digitalRead(WakeOnRadio::DIO1_PIN) == HIGH) return SniffEvent::DIO1;
+        return SniffEvent::NONE;
+    }
+
+    bool sniff(uint32_t rxUs, uint32_t sleepUs, uint16_t preambleLength) override {
+        return resonantRadioSniff(_radio, rxUs, sleepUs, preambleLength);
+    }
+
+    bool read(uint8_t* buf, size_t* len, int16_t* rssi, int8_t* snr) override {
+        return resonantRadioSniffRead(_radio, buf, len, rssi, snr);
+    }
+
+private:
+    ResonantLRRadio& _radio;
+    int _contactLevel;
+};
+
+void reset(WorState& s) {
+    memset(&s, 0, sizeof(s));
+    s.magic = WOR_MAGIC;
+    seal(s);
+}
+
+} // namespace
+
+void WakeOnRadio::init(SensorRegionStore* store, bool deepSleepWake) {
+    _store = store;
+    WorState& s = rtcWorState;
+    if (!valid(s) || !deepSleepWake) {
+        reset(s);
+        return;
+    }
+    _wake = (WorWake)s.wake;
+    _sleptMs = s.sleptMs;
+    _remainingMs = s.remainingMs;
+    count(SensorMetrics::WOR_WAKES, s.frameWakes);
+    count(SensorMetrics::WOR_FALSE_WAKES, s.falseWakes);
+    s.wake = (uint8_t)WorWake::NONE;
+    s.frameWakes = 0;
+    s.falseWakes = 0;
+    if (_wake != WorWake::FRAME) {
+        s.frameLen = 0;
+    }
+    seal(s);
+}
+
+bool WakeOnRadio::enabled() const {
+    if (_store == nullptr || !_store->isInitialized()) return false;
+    uint8_t flags = _store->get8(SensorRegion::SETTINGS, SensorSettings::WOR_FLAGS);
+    return flags != 0xFF && (flags & FLAG_ENABLED);
+}
+
+uint16_t WakeOnRadio::sniffPeriodMs() const {
+    uint16_t ms = _store->get16(SensorRegion::SETTINGS, SensorSettings::WOR_SNIFF_PERIOD);
+    if (ms == 0 || ms == 0xFFFF) return DEFAULT_SNIFF_MS;
+    return ms < MIN_SNIFF_MS ? MIN_SNIFF_MS : ms;
+}
+
+uint16_t WakeOnRadio::preambleLength(uint8_t sf, uint8_t bandwidth) const {
+    uint16_t symbols = _store->get16(SensorRegion::SETTINGS, SensorSettings::WOR_PREAMBLE);
+    if (symbols == 0 || symbols == 0xFFFF) {
+        return WorSniffer::preambleSymbols(WorSniffer::periodUs(sniffPeriodMs(), sf, bandwidth) / 1000,
+                                           sf, bandwidth);
+    }
+    return symbols;
+}
+
+bool WakeOnRadio::takeFrame(uint8_t* frame, size_t* len, int16_t* rssi, int8_t* snr) {
+    WorState& s = rtcWorState;
+    if (_wake != WorWake::FRAME || !valid(s) || s.frameLen == 0) return false;
+    memcpy(frame, s.frame, s.frameLen);
+    *len = s.frameLen;
+    *rssi = s.rssi;
+    *snr = s.snr;
+    s.frameLen = 0;
+    seal(s);
+    return true;
+}
+
+bool WakeOnRadio::arm(ResonantLRRadio& radio, uint8_t sf, uint8_t bandwidth) {
+    WorState& s = rtcWorState;
+    if (!enabled() || !valid(s)) return false;
+    s.sf = sf;
+    s.bandwidth = bandwidth;
+    EspSniffBackend backend(radio, digitalRead(CONTACT_PIN));
+    WorSniffer sniffer;
+    configure(sniffer, &backend);
+    s.sniffing = sniffer.arm() ? 1 : 0;
+    seal(s);
+    return s.sniffing;
+}
+
+void WakeOnRadio::configure(WorSniffer& sniffer, SniffBackend* backend) const {
+    const WorState& s = rtcWorState;
+    sniffer.begin(backend, sniffPeriodMs(), s.sf, s.bandwidth, preambleLength(s.sf, s.bandwidth));
+}
+
+void WakeOnRadio::onRadioStarted() {
+    WorState& s = rtcWorState;
+    if (!valid(s) || !s.sniffing) return;
+    s.sniffing = 0;
+    seal(s);
+}
+
+bool WakeOnRadio::armed() const {
+    const WorState& s = rtcWorState;
+    return enabled() && valid(s) && s.sniffing;
+}
+
+void WakeOnRadio::sleep(ResonantLRRadio& radio, uint32_t seconds, const uint8_t deviceId[4]) {
+    if (!armed()) return;
+    WorState& s = rtcWorState;
+
+    // The driver's DIO1 ISR would race the read below
+    detachInterrupt(DIO1_PIN);
+    int contactLevel = digitalRead(CONTACT_PIN);
+    gpio_wakeup_enable((gpio_num_t)DIO1_PIN, GPIO_INTR_HIGH_LEVEL);
+    gpio_wakeup_enable((gpio_num_t)BUTTON_PIN, GPIO_INTR_HIGH_LEVEL);
+    gpio_wakeup_enable((gpio_num_t)CONTACT_PIN, contactLevel ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    LOG_I("Wake-on-radio: sniffing every %u ms for %lu s", sniffPeriodMs(), (unsigned long)seconds);
+    ResonantLog::flush();
+
+    EspSniffBackend backend(radio, contactLevel);
+    WorSniffer sniffer;
+    configure(sniffer, &backend);
+    size_t frameLen = 0;
+    WorWake wake = sniffer.sleep((uint64_t)seconds * 1000000, deviceId,
+                                 s.frame, &frameLen, &s.rssi, &s.snr);
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+    if (sniffer.rearmFailed()) {
+        LOG_W("Wake-on-radio: re-arm failed");
+    }
+
+    uint32_t falseWakes = (uint32_t)s.falseWakes + sniffer.falseWakes();
+    s.falseWakes = falseWakes > 0xFFFF ? 0xFFFF : (uint16_t)falseWakes;
+    if (wake == WorWake::FRAME) {
+        s.frameLen = (uint8_t)frameLen;
+        if (s.frameWakes < 0xFFFF) s.frameWakes++;
+    }
+    s.wake = (uint8_t)wake;
+    s.sleptMs = (uint32_t)(sniffer.sleptUs() / 1000);
+    s.remainingMs = (uint32_t)(sniffer.remainingUs() / 1000);
+    if (wake != WorWake::TIMER || sniffer.rearmFailed()) {
+        s.sniffing = 0;     // RxDone left the chip in standby; other wakes restart the radio
+    }
+    seal(s);
+
+    esp_sleep_enable_timer_wakeup(REBOOT_US);
+    esp_deep_sleep_start();
+}
+
+void WakeOnRadio::count(uint16_t offset, uint16_t n) {
+    if (n == 0 || _store == nullptr || !_store->isInitialized()) return;
+    uint32_t total = (uint32_t)_store->get16(SensorRegion::METRICS, offset) + n;
+    _store->put16(SensorRegion::METRICS, offset, total > 0xFFFF ? 0xFFFF : (uint16_t)total);
+}
@@ -0,0 +1,92 @@
+#ifndef WAKE_ON_RADIO_H
+#define WAKE_ON_RADIO_H
+
+#include <Arduino.h>
+#include "resonant_lr_radio.h"
+#include "sensor_region_store.h"
+#include <WorSniffer.h>
+#include "sx126x_hooks.h"
+
+// ============================================================================
+// Wake-on-Radio
+// ============================================================================
+// Without it a command can only reach the device in the command window after
+// a metrics frame. With it, the SX1262 runs its RX duty cycle while the MCU
+// sleeps: it listens for WorSniffer::RX_WINDOW_SYMBOLS every sniff period and
+// goes back to warm sleep unless it detects a preamble. The gateway sends commands with
+// a preamble longer than the sniff period, so one sniff always lands in it.
+// A received packet raises DIO1 (RxDone).
+//
+// DIO1 is GPIO47, which is not an RTC GPIO, so it cannot wake the ESP32-S3
+// from deep sleep. While sniffing, the MCU light-sleeps instead (~240 uA vs
+// ~10 uA deep) with GPIO wakes on DIO1, the button and the contact and a
+// timer for the telemetry interval. The SX1262 has no LoRa address filter,
+// so every packet wakes the MCU. The MCU then checks it in software:
+//   - header byte, length and checksum
+//   - destination = this device, frame type = command, single packet
+// A frame that fails the check is dropped and the radio re-armed without
+// leaving light sleep (WorSniffer runs that loop). Any other wake is handed to a normal boot through
+// a 1 ms deep sleep, with the cause in RTC memory:
+//   - FRAME: the frame is dispatched after boot and no telemetry is sent.
+//     The rest of the interval is slept after the command.
+//   - BUTTON / CONTACT: booted as that wake source
+//   - TIMER: a normal timer wake
+//
+// Command latency is at most one sniff period plus the preamble. The
+// trade-off, per sniff period:
+//   sniff current ~ 5 mA * RX_WINDOW_SYMBOLS * Tsym / period
+//   (SF7/BW125, 1 s: ~22 uA) on top of the light-sleep floor
+//
+// Settings (sensor tail):
+//   WOR_FLAGS        uint8_t   bit 0 = on, 0xFF = off
+//   WOR_SNIFF_PERIOD uint16_t  ms between sniffs, 0 = DEFAULT_SNIFF_MS
+//   WOR_PREAMBLE     uint16_t  symbols, 0 = preambleSymbols() of the period
+//
+// Metrics (sensor tail):
+//   WOR_WAKES        uint16_t  command frames that woke the device
+//   WOR_FALSE_WAKES  uint16_t  other packets (saturating)
+class WakeOnRadio {
+public:
+    static constexpr uint8_t  FLAG_ENABLED = 0x01;
+    static constexpr uint16_t DEFAULT_SNIFF_MS = 1000;
+    static constexpr uint16_t MIN_SNIFF_MS = 100;
+    static constexpr uint8_t  DIO1_PIN = 47;            // LORA_SX126X_DIO1
+    static constexpr uint8_t  BUTTON_PIN = 2;
+    static constexpr uint8_t  CONTACT_PIN = 14;
+
+    // Takes the RTC state the last sleep left. Call after the store is up.
+    void init(SensorRegionStore* store, bool deepSleepWake);
+
+    bool enabled() const;
+    uint16_t sniffPeriodMs() const;
+    // For the radio's current spreading factor and bandwidth
+    uint16_t preambleLength(uint8_t sf, uint8_t bandwidth) const;
+
+    WorWake lastWake() const { return _wake; }
+    uint32_t sleptSeconds() const { return _sleptMs / 1000; }
+    uint32_t remainingSeconds() const { return _remainingMs / 1000; }
+    // FRAME wakes: the command frame, once
+    bool takeFrame(uint8_t* frame, size_t* len, int16_t* rssi, int8_t* snr);
+
+    // Puts the SX1262 into RX duty cycle. The chip keeps sniffing across
+    // wakes that leave the radio off.
+    bool arm(ResonantLRRadio& radio, uint8_t sf, uint8_t bandwidth);
+    // The radio was (re)initialized, so it no longer sniffs
+    void onRadioStarted();
+    bool armed() const;
+
+    // Light-sleeps until the first wake above, then reboots into it through
+    // deep sleep. Returns only if the radio is not armed.
+    void sleep(ResonantLRRadio& radio, uint32_t seconds, const uint8_t deviceId[4]);
+
+private:
+    SensorRegionStore* _store = nullptr;
+    WorWake _wake = WorWake::NONE;
+    uint32_t _sleptMs = 0;
+    uint32_t _remainingMs = 0;
+
+    void configure(WorSniffer& sniffer, SniffBackend* backend) const;
+    void count(uint16_t offset, uint16_t n);
+};
+
+#endif // WAKE_ON_RADIO_H
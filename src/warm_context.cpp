@@ -0,0 +1,74 @@
+#include "warm_context.h"
+#include <esp_rom_crc.h>
+
+namespace {
+
+constexpr uint32_t WARM_MAGIC = 0x57434331;     // "WCC1"
+
+struct WarmState {
+    uint32_t magic;
+    uint32_t generation;
+    uint32_t fingerprint;
+    uint8_t hasSessionKey;
+    uint8_t sessionKey[WarmContext::SESSION_KEY_SIZE];
+    uint32_t crc;
+};
+
+RTC_DATA_ATTR WarmState rtcWarmState;
+
+uint32_t stateCrc(const WarmState& s) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&s, offsetof(WarmState, crc));
+}
+
+void seal(WarmState& s) {
+    s.crc = stateCrc(s);
+}
+
+} // namespace
+
+uint32_t WarmContext::fingerprint(const uint8_t* data, size_t len, uint32_t seed) {
+    return esp_rom_crc32_le(seed, data, len);
+}
+
+bool WarmContext::restore(uint32_t generation, uint32_t fingerprint) {
+    const WarmState& s = rtcWarmState;
+    _warm = s.magic == WARM_MAGIC
+         && s.crc == stateCrc(s)
+         && s.generation == generation
+         && s.fingerprint == fingerprint;
+    if (!_warm) {
+        invalidate();
+    }
+    return _warm;
+}
+
+void WarmContext::save(uint32_t generation, uint32_t fingerprint) {
+    WarmState& s = rtcWarmState;
+    if (s.crc != stateCrc(s)) {
+        memset(&s, 0, sizeof(s));
+    }
+    s.magic = WARM_MAGIC;
+    s.generation = generation;
+    s.fingerprint = fingerprint;
+    seal(s);
+}
+
+void WarmContext::invalidate() {
+    memset(&rtcWarmState, 0, sizeof(rtcWarmState));
+    _warm = false;
+}
+
+bool WarmContext::hasSessionKey() const {
+    return _warm && rtcWarmState.hasSessionKey;
+}
+
+const uint8_t* WarmContext::sessionKey() const {
+    return rtcWarmState.sessionKey;
+}
+
+void WarmContext::setSessionKey(const uint8_t* key) {
+    WarmState& s = rtcWarmState;
+    memcpy(s.sessionKey, key, SESSION_KEY_SIZE);
+    s.hasSessionKey = 1;
+    seal(s);
+}
@@ -0,0 +1,44 @@
+#ifndef WARM_CONTEXT_H
+#define WARM_CONTEXT_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// Warm Crypto Context
+// ============================================================================
+// Lets adopted deep-sleep wakes skip the DER parsing of the device key,
+// device certificate and CA bundle. A telemetry wake only needs AES-GCM
+// with the session key. The credentials are loaded on demand, and only if
+// an adoption exchange happens (ensureCryptoCredentials() in main.cpp).
+//
+// The parsed mbedTLS contexts live on the heap and cannot survive deep
+// sleep. What is kept in RTC slow memory is the decision that a full
+// load already succeeded for this firmware's credentials, plus the mock
+// session key. A state is accepted only if all of these hold:
+//   - the wake is a deep-sleep wake
+//   - the CRC matches
+//   - the boot generation (FRAM bootCount) matches
+//   - the credential fingerprint (CRC32 over the DER blobs) matches
+// Otherwise the full load runs and the state is rebuilt.
+class WarmContext {
+public:
+    static constexpr size_t SESSION_KEY_SIZE = 16;
+
+    // CRC32, chained over the device key, device cert and CA bundle
+    static uint32_t fingerprint(const uint8_t* data, size_t len, uint32_t seed = 0);
+
+    bool restore(uint32_t generation, uint32_t fingerprint);
+    void save(uint32_t generation, uint32_t fingerprint);
+    void invalidate();
+
+    bool isWarm() const { return _warm; }
+
+    bool hasSessionKey() const;
+    const uint8_t* sessionKey() const;
+    void setSessionKey(const uint8_t* key);
+
+private:
+    bool _warm = false;
+};
+
+#endif // WARM_CONTEXT_H
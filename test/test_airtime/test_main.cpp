@@ -0,0 +1,84 @@
+// Airtime against hand-computed SX1262 time on air.
+// pio test -e native -f test_airtime
+#include <unity.h>
+#include <Airtime.h>
+
+void setUp() {}
+void tearDown() {}
+
+void test_lora_symbol() {
+    TEST_ASSERT_EQUAL_UINT32(1024, Airtime::loraSymbolUs(7, 0));
+    TEST_ASSERT_EQUAL_UINT32(32768, Airtime::loraSymbolUs(12, 0));
+    TEST_ASSERT_EQUAL_UINT32(256, Airtime::loraSymbolUs(7, 2));
+    // Out of range: clamped to SF7-SF12 and 500 kHz
+    TEST_ASSERT_EQUAL_UINT32(1024, Airtime::loraSymbolUs(5, 0));
+    TEST_ASSERT_EQUAL_UINT32(32768, Airtime::loraSymbolUs(14, 0));
+    TEST_ASSERT_EQUAL_UINT32(256, Airtime::loraSymbolUs(7, 3));
+}
+
+// Reference points in Airtime.h
+void test_lora_reference_points() {
+    // 13 B, SF7/BW125/CR4-5, 8-symbol preamble: 12.25 + 33 symbols
+    TEST_ASSERT_EQUAL_UINT32(46336, Airtime::loraPacketUs(7, 0, 1, 8, 13));
+    // 51 B, SF12/BW125 (LDRO on): 12.25 + 63 symbols
+    TEST_ASSERT_EQUAL_UINT32(2465792, Airtime::loraPacketUs(12, 0, 1, 8, 51));
+}
+
+// DE is on from 16.384 ms symbols: SF11 and SF12 at 125 kHz, SF12 at 250 kHz
+void test_lora_low_data_rate_optimize() {
+    // SF11/BW125, LDRO: 36 bits per block, 12 blocks -> 68 symbols
+    TEST_ASSERT_EQUAL_UINT32(1314816, Airtime::loraPacketUs(11, 0, 1, 8, 51));
+    // SF11/BW250, no LDRO: 44 bits per block, 10 blocks -> 58 symbols
+    TEST_ASSERT_EQUAL_UINT32(575488, Airtime::loraPacketUs(11, 1, 1, 8, 51));
+    // SF12/BW250, LDRO: half of SF12/BW125
+    TEST_ASSERT_EQUAL_UINT32(2465792 / 2, Airtime::loraPacketUs(12, 1, 1, 8, 51));
+}
+
+void test_lora_bandwidth() {
+    TEST_ASSERT_EQUAL_UINT32(46336 / 2, Airtime::loraPacketUs(7, 1, 1, 8, 13));
+    TEST_ASSERT_EQUAL_UINT32(46336 / 4, Airtime::loraPacketUs(7, 2, 1, 8, 13));
+}
+
+void test_lora_coding_rate_and_preamble() {
+    // CR4/8: 5 blocks of 8 symbols
+    TEST_ASSERT_EQUAL_UINT32(12544 + 48 * 1024, Airtime::loraPacketUs(7, 0, 4, 8, 13));
+    // 16-symbol preamble: 20.25 symbols
+    TEST_ASSERT_EQUAL_UINT32(20736 + 33 * 1024, Airtime::loraPacketUs(7, 0, 1, 16, 13));
+    // No CRC: 104 bits, 4 blocks
+    TEST_ASSERT_EQUAL_UINT32(12544 + 28 * 1024, Airtime::loraPacketUs(7, 0, 1, 8, 13, false));
+}
+
+// Header and CRC alone fit below one block: 8 payload symbols
+void test_lora_empty_payload() {
+    TEST_ASSERT_EQUAL_UINT32(401408 + 8 * 32768, Airtime::loraPacketUs(12, 0, 1, 8, 0));
+}
+
+// Preamble 5 + sync 3 + length 1 + payload + CRC 2 bytes
+void test_fsk() {
+    TEST_ASSERT_EQUAL_UINT32(3840, Airtime::fskPacketUs(50000, 13));
+    TEST_ASSERT_EQUAL_UINT32(3520, Airtime::fskPacketUs(50000, 13, false));
+    // 192 bits at 7 kbps, rounded up
+    TEST_ASSERT_EQUAL_UINT32(27429, Airtime::fskPacketUs(7000, 13));
+    TEST_ASSERT_EQUAL_UINT32(0, Airtime::fskPacketUs(0, 13));
+}
+
+void test_split() {
+    auto fsk = [](size_t len) { return Airtime::fskPacketUs(50000, len); };
+    // 100 bytes over 3 packets: 34 + 33 + 33
+    TEST_ASSERT_EQUAL_UINT32(fsk(34) + 2 * fsk(33), Airtime::splitUs(100, 3, fsk));
+    TEST_ASSERT_EQUAL_UINT32(fsk(51), Airtime::splitUs(51, 1, fsk));
+    TEST_ASSERT_EQUAL_UINT32(0, Airtime::splitUs(51, 0, fsk));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_lora_symbol);
+    RUN_TEST(test_lora_reference_points);
+    RUN_TEST(test_lora_low_data_rate_optimize);
+    RUN_TEST(test_lora_bandwidth);
+    RUN_TEST(test_lora_coding_rate_and_preamble);
+    RUN_TEST(test_lora_empty_payload);
+    RUN_TEST(test_fsk);
+    RUN_TEST(test_split);
+    return UNITY_END();
+}
@@ -0,0 +1,286 @@
+// EventJournal ring, pages and recovery from damaged storage.
+// pio test -e native -f test_event_journal
+#include <unity.h>
+#include <EventJournal.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint16_t BASE = 0x0100;
+
+// RAM image of the FRAM, with a power cut after a given number of writes
+class RamStorage : public JournalStorage {
+public:
+    uint8_t bytes[0x1000];
+    int writes = 0;
+
+    void read(uint16_t addr, uint8_t* buf, size_t len) override { memcpy(buf, bytes + addr, len); }
+
+    void write(uint16_t addr, const uint8_t* data, size_t len) override {
+        if (_writesLeft == 0) return;
+        if (_writesLeft > 0 && --_writesLeft == 0 && len > _tornLength) {
+            len = _tornLength;
+        }
+        memcpy(bytes + addr, data, len);
+        writes++;
+    }
+
+    // Only the next `n` writes land, the last of them cut after `tornLength` bytes
+    void cutAfter(int n, size_t tornLength = SIZE_MAX) {
+        _writesLeft = n;
+        _tornLength = tornLength;
+    }
+
+private:
+    int _writesLeft = -1;
+    size_t _tornLength = SIZE_MAX;
+};
+
+RamStorage storage;
+
+JournalRecord record(uint16_t cycle) {
+    JournalRecord r;
+    r.cycle = cycle;
+    r.wake = cycle % 7 == 0 ? JournalWake::CONTACT : JournalWake::TIMER;
+    r.tx = cycle % 5 == 0 ? JournalTx::NO_ACK : JournalTx::ACKED;
+    r.flags = cycle % 6 == 0 ? JournalFlag::METRICS_SENT : 0;
+    r.ackRssi = (int8_t)(-80 - cycle % 40);
+    r.ackSnr = (int8_t)(8 - cycle % 20);
+    r.batteryCentivolts = (uint16_t)(360 - cycle / 100);
+    r.awakeMs = (uint16_t)(150 + cycle);
+    return r;
+}
+
+void assertRecord(const JournalRecord& expected, const JournalRecord& actual) {
+    TEST_ASSERT_EQUAL_UINT16(expected.cycle, actual.cycle);
+    TEST_ASSERT_EQUAL(expected.wake, actual.wake);
+    TEST_ASSERT_EQUAL(expected.tx, actual.tx);
+    TEST_ASSERT_EQUAL_HEX8(expected.flags, actual.flags);
+    TEST_ASSERT_EQUAL_INT8(expected.ackRssi, actual.ackRssi);
+    TEST_ASSERT_EQUAL_INT8(expected.ackSnr, actual.ackSnr);
+    TEST_ASSERT_EQUAL_UINT16(expected.batteryCentivolts, actual.batteryCentivolts);
+    TEST_ASSERT_EQUAL_UINT16(expected.awakeMs, actual.awakeMs);
+}
+
+// Page `page` holds cycles newest..newest-n+1
+void assertPage(const EventJournal& journal, uint8_t page, uint16_t newest, uint8_t n) {
+    uint8_t buf[EventJournal::PAGE_SIZE];
+    size_t len = journal.buildPage(page, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(EventJournal::PAGE_HEADER_SIZE + n * EventJournal::RECORD_SIZE, len);
+    EventJournal::PageInfo info;
+    JournalRecord records[EventJournal::PAGE_RECORDS];
+    TEST_ASSERT_EQUAL(n, EventJournal::parsePage(buf, len, &info, records, EventJournal::PAGE_RECORDS));
+    TEST_ASSERT_EQUAL_UINT8(page, info.page);
+    TEST_ASSERT_EQUAL_UINT8(journal.pageCount(), info.pageCount);
+    TEST_ASSERT_EQUAL_UINT16(journal.count(), info.count);
+    TEST_ASSERT_EQUAL_UINT8(0, info.damaged);
+    for (uint8_t i = 0; i < n; i++) {
+        assertRecord(record((uint16_t)(newest - i)), records[i]);
+    }
+}
+
+// Each wake is a fresh boot on the same storage
+EventJournal boot(uint16_t capacity) {
+    EventJournal journal;
+    journal.begin(&storage, BASE, capacity);
+    return journal;
+}
+
+} // namespace
+
+void setUp() {
+    memset(storage.bytes, 0, sizeof(storage.bytes));
+    storage.writes = 0;
+    storage.cutAfter(-1);
+}
+
+void tearDown() {}
+
+void test_record_encoding() {
+    JournalRecord r = record(1234);
+    uint8_t slot[EventJournal::RECORD_SIZE];
+    EventJournal::encode(r, slot);
+    TEST_ASSERT_EQUAL_HEX8(0x04, slot[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xD2, slot[1]);
+    JournalRecord back;
+    TEST_ASSERT_TRUE(EventJournal::decode(slot, &back));
+    assertRecord(r, back);
+
+    slot[5] ^= 0x01;
+    TEST_ASSERT_FALSE(EventJournal::decode(slot, &back));
+    // An erased slot does not pass
+    uint8_t zero[EventJournal::RECORD_SIZE] = {};
+    TEST_ASSERT_FALSE(EventJournal::decode(zero, &back));
+}
+
+void test_empty_journal() {
+    EventJournal journal;
+    // Erased FRAM is not a journal: it starts empty with one header write
+    TEST_ASSERT_FALSE(journal.begin(&storage, BASE, 8));
+    TEST_ASSERT_EQUAL(1, storage.writes);
+    TEST_ASSERT_EQUAL_UINT16(0, journal.count());
+    TEST_ASSERT_EQUAL_UINT8(0, journal.pageCount());
+    assertPage(journal, 0, 0, 0);
+    uint8_t buf[EventJournal::PAGE_SIZE];
+    TEST_ASSERT_EQUAL(0, journal.buildPage(1, buf, sizeof(buf)));
+
+    // Now it is one
+    EventJournal again;
+    TEST_ASSERT_TRUE(again.begin(&storage, BASE, 8));
+}
+
+void test_append_across_reboots() {
+    for (uint16_t c = 1; c <= 5; c++) {
+        EventJournal journal = boot(8);
+        journal.append(record(c));
+    }
+    EventJournal journal = boot(8);
+    TEST_ASSERT_EQUAL_UINT16(5, journal.count());
+    assertPage(journal, 0, 5, 5);
+}
+
+// Past capacity the oldest records go; the newest stay in order across
+// the point where the ring wraps
+void test_wrap() {
+    EventJournal journal = boot(5);
+    for (uint16_t c = 1; c <= 13; c++) {
+        journal.append(record(c));
+    }
+    TEST_ASSERT_EQUAL_UINT16(5, journal.count());
+    assertPage(journal, 0, 13, 5);
+    // Only the journal's range was written
+    TEST_ASSERT_EQUAL_HEX8(0, storage.bytes[BASE + EventJournal::regionSize(5)]);
+    TEST_ASSERT_EQUAL_HEX8(0, storage.bytes[BASE - 1]);
+}
+
+// Pages of PAGE_RECORDS, newest first, the last one short and wrapping in storage
+void test_pages() {
+    EventJournal journal = boot(40);
+    for (uint16_t c = 1; c <= 50; c++) {
+        journal.append(record(c));
+    }
+    TEST_ASSERT_EQUAL_UINT16(40, journal.count());
+    TEST_ASSERT_EQUAL_UINT8(3, journal.pageCount());
+    assertPage(journal, 0, 50, 16);
+    assertPage(journal, 1, 34, 16);
+    assertPage(journal, 2, 18, 8);
+    uint8_t buf[EventJournal::PAGE_SIZE];
+    TEST_ASSERT_EQUAL(0, journal.buildPage(3, buf, sizeof(buf)));
+    // Too small for the page
+    TEST_ASSERT_EQUAL(0, journal.buildPage(0, buf, EventJournal::PAGE_SIZE - 1));
+}
+
+// A bad magic, CRC, head or count restarts the journal empty
+void test_damaged_header() {
+    {
+        EventJournal journal = boot(8);
+        for (uint16_t c = 1; c <= 3; c++) journal.append(record(c));
+    }
+    uint8_t good[EventJournal::HEADER_SIZE];
+    memcpy(good, storage.bytes + BASE, sizeof(good));
+
+    const size_t offsets[] = {0, 3, 5, 6};
+    for (size_t offset : offsets) {
+        memcpy(storage.bytes + BASE, good, sizeof(good));
+        storage.bytes[BASE + offset] ^= 0x01;
+        EventJournal journal;
+        TEST_ASSERT_FALSE(journal.begin(&storage, BASE, 8));
+        TEST_ASSERT_EQUAL_UINT16(0, journal.count());
+    }
+
+    // Head or count past a smaller capacity than the one it was written with
+    memcpy(storage.bytes + BASE, good, sizeof(good));
+    EventJournal smaller;
+    TEST_ASSERT_FALSE(smaller.begin(&storage, BASE, 2));
+}
+
+// A flipped bit in one slot: that record is reported damaged, the rest decode
+void test_damaged_record() {
+    EventJournal journal = boot(8);
+    for (uint16_t c = 1; c <= 4; c++) journal.append(record(c));
+    // Slot 2 holds cycle 3
+    storage.bytes[BASE + EventJournal::HEADER_SIZE + 2 * EventJournal::RECORD_SIZE + 7] ^= 0x10;
+
+    uint8_t buf[EventJournal::PAGE_SIZE];
+    size_t len = journal.buildPage(0, buf, sizeof(buf));
+    EventJournal::PageInfo info;
+    JournalRecord records[EventJournal::PAGE_RECORDS];
+    TEST_ASSERT_EQUAL(3, EventJournal::parsePage(buf, len, &info, records, EventJournal::PAGE_RECORDS));
+    TEST_ASSERT_EQUAL_UINT8(4, info.records);
+    TEST_ASSERT_EQUAL_UINT8(1, info.damaged);
+    assertRecord(record(4), records[0]);
+    assertRecord(record(2), records[1]);
+    assertRecord(record(1), records[2]);
+}
+
+// Power cut between the record and the header write: only that record is lost
+void test_power_cut_before_header() {
+    EventJournal journal = boot(8);
+    for (uint16_t c = 1; c <= 3; c++) journal.append(record(c));
+    storage.cutAfter(1);
+    journal.append(record(4));
+    storage.cutAfter(-1);
+
+    EventJournal reboot;
+    TEST_ASSERT_TRUE(reboot.begin(&storage, BASE, 8));
+    TEST_ASSERT_EQUAL_UINT16(3, reboot.count());
+    assertPage(reboot, 0, 3, 3);
+}
+
+// Once full, the oldest record is dropped before its slot is reused, so a
+// cut mid-record never leaves a torn slot inside the journal
+void test_power_cut_when_full() {
+    EventJournal journal = boot(4);
+    for (uint16_t c = 1; c <= 6; c++) journal.append(record(c));
+    storage.cutAfter(2, 5);         // header drop lands, the record is torn
+    journal.append(record(7));
+    storage.cutAfter(-1);
+
+    EventJournal reboot;
+    TEST_ASSERT_TRUE(reboot.begin(&storage, BASE, 4));
+    TEST_ASSERT_EQUAL_UINT16(3, reboot.count());
+    assertPage(reboot, 0, 6, 3);
+}
+
+// A torn header write fails its CRC: the journal restarts empty
+void test_torn_header() {
+    EventJournal journal = boot(8);
+    for (uint16_t c = 1; c <= 3; c++) journal.append(record(c));
+    storage.cutAfter(2, 4);         // new head, stale count and CRC
+    journal.append(record(4));
+    storage.cutAfter(-1);
+
+    EventJournal reboot;
+    TEST_ASSERT_FALSE(reboot.begin(&storage, BASE, 8));
+    TEST_ASSERT_EQUAL_UINT16(0, reboot.count());
+    assertPage(reboot, 0, 0, 0);
+}
+
+void test_parse_rejects() {
+    EventJournal::PageInfo info;
+    JournalRecord records[EventJournal::PAGE_RECORDS];
+    uint8_t buf[EventJournal::PAGE_SIZE + 1] = {0, 1, 0, 2, 2};
+    TEST_ASSERT_EQUAL(-1, EventJournal::parsePage(nullptr, 0, &info, records, 16));
+    TEST_ASSERT_EQUAL(-1, EventJournal::parsePage(buf, EventJournal::PAGE_HEADER_SIZE - 1, &info, records, 16));
+    // Length does not match the record count
+    TEST_ASSERT_EQUAL(-1, EventJournal::parsePage(buf, EventJournal::PAGE_HEADER_SIZE + 12, &info, records, 16));
+    buf[4] = EventJournal::PAGE_RECORDS + 1;
+    TEST_ASSERT_EQUAL(-1, EventJournal::parsePage(buf, sizeof(buf), &info, records, 16));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_record_encoding);
+    RUN_TEST(test_empty_journal);
+    RUN_TEST(test_append_across_reboots);
+    RUN_TEST(test_wrap);
+    RUN_TEST(test_pages);
+    RUN_TEST(test_damaged_header);
+    RUN_TEST(test_damaged_record);
+    RUN_TEST(test_power_cut_before_header);
+    RUN_TEST(test_power_cut_when_full);
+    RUN_TEST(test_torn_header);
+    RUN_TEST(test_parse_rejects);
+    return UNITY_END();
+}
@@ -0,0 +1,315 @@
+// FrameDecoder parsing and FrameBatchDecoder key cache, decryption and rejection.
+// pio test -e native -f test_frame_decoder
+#include <unity.h>
+#include <FrameBatch.h>
+#include <FrameDecoder.h>
+#include <openssl/evp.h>
+#include <math.h>
+#include <string.h>
+
+using namespace ResonantWire;
+
+namespace {
+
+constexpr uint32_t GATEWAY_ID = 0x47570001;
+const uint8_t KEY_A[KEY_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+const uint8_t KEY_B[KEY_SIZE] = {0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7,
+                                 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF};
+
+// 21.50 C, contact closed
+const uint8_t LEGACY_READING[] = {0x08, 0x66, 0x01};
+
+struct Frame {
+    uint8_t bytes[MAX_FRAME];
+    size_t len;
+};
+
+void putBe32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+void seal(Frame& f) {
+    f.bytes[f.len - 1] = 0;
+    for (size_t i = 3; i < f.len - 1; i++) {
+        f.bytes[f.len - 1] += f.bytes[i];
+    }
+}
+
+// As the device builds it: GCM under `key`, or plaintext without one
+Frame build(uint32_t sourceId, uint32_t sequence, uint8_t type, uint8_t options,
+            const uint8_t* pt, size_t ptLen, const uint8_t* key) {
+    Frame f;
+    size_t payloadLen = key != nullptr ? ptLen + GCM_OVERHEAD : ptLen;
+    f.len = payloadLen + FRAME_OVERHEAD;
+    f.bytes[0] = HEADER_BYTE;
+    f.bytes[1] = (uint8_t)((f.len - 3) >> 8);
+    f.bytes[2] = (uint8_t)(f.len - 3);
+    putBe32(f.bytes + 3, sourceId);
+    putBe32(f.bytes + 7, GATEWAY_ID);
+    f.bytes[11] = type;
+    f.bytes[12] = options;
+    putBe32(f.bytes + 13, sequence);
+    f.bytes[17] = 1;
+    f.bytes[18] = 0;
+
+    uint8_t* payload = f.bytes + HEADER_SIZE;
+    if (key != nullptr) {
+        FrameHeader h{sourceId, GATEWAY_ID, sequence, type, options, 1, 0};
+        uint8_t aad[AAD_SIZE];
+        FrameDecoder::aad(h, aad);
+        for (size_t i = 0; i < GCM_IV_SIZE; i++) {
+            payload[i] = (uint8_t)(sequence * 31 + i);
+        }
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        int n = 0;
+        EVP_EncryptInit_ex(ctx, EVP_aes_128_gcm(), nullptr, key, payload);
+        EVP_EncryptUpdate(ctx, nullptr, &n, aad, AAD_SIZE);
+        EVP_EncryptUpdate(ctx, payload + GCM_IV_SIZE, &n, pt, (int)ptLen);
+        EVP_EncryptFinal_ex(ctx, payload + GCM_IV_SIZE + n, &n);
+        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, GCM_TAG_SIZE, payload + GCM_IV_SIZE + ptLen);
+        EVP_CIPHER_CTX_free(ctx);
+    } else {
+        memcpy(payload, pt, ptLen);
+    }
+    seal(f);
+    return f;
+}
+
+Frame telemetry(uint32_t sourceId, uint32_t sequence, const uint8_t* key) {
+    return build(sourceId, sequence, TYPE_TELEMETRY, 0, LEGACY_READING, sizeof(LEGACY_READING), key);
+}
+
+uint8_t plainSum(const uint8_t* frame, size_t len) {
+    uint8_t sum = 0;
+    for (size_t i = 3; i + 1 < len; i++) sum += frame[i];
+    return sum;
+}
+
+// Loader backed by a fixed table, counting its calls
+int loads = 0;
+bool loadKey(uint32_t sourceId, uint8_t key[KEY_SIZE]) {
+    loads++;
+    if (sourceId == 0xA) {
+        memcpy(key, KEY_A, KEY_SIZE);
+        return true;
+    }
+    if (sourceId == 0xB) {
+        memcpy(key, KEY_B, KEY_SIZE);
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void setUp() {
+    loads = 0;
+}
+
+void tearDown() {}
+
+// The SWAR sum against a byte loop, around the 8-byte and lane-flush edges
+void test_checksum() {
+    uint8_t frame[MAX_FRAME];
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)(0xFF - i * 7);
+    }
+    for (size_t len = 4; len <= MAX_FRAME; len++) {
+        TEST_ASSERT_EQUAL_HEX8(plainSum(frame, len), FrameDecoder::checksum(frame, len));
+    }
+    TEST_ASSERT_EQUAL_HEX8(0, FrameDecoder::checksum(frame, 3));
+}
+
+void test_parse() {
+    Frame f = telemetry(0x01020304, 0x11223344, nullptr);
+    FrameHeader h;
+    const uint8_t* payload = nullptr;
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(FrameStatus::OK, FrameDecoder::parse(f.bytes, f.len, &h, &payload, &len));
+    TEST_ASSERT_EQUAL_HEX32(0x01020304, h.sourceId);
+    TEST_ASSERT_EQUAL_HEX32(GATEWAY_ID, h.destinationId);
+    TEST_ASSERT_EQUAL_HEX32(0x11223344, h.sequence);
+    TEST_ASSERT_EQUAL_HEX8(TYPE_TELEMETRY, h.frameType);
+    TEST_ASSERT_TRUE(payload == f.bytes + HEADER_SIZE);
+    TEST_ASSERT_EQUAL(sizeof(LEGACY_READING), len);
+
+    TelemetryReading r;
+    TEST_ASSERT_EQUAL(1, FrameDecoder::telemetry(h, payload, len, &r, 1));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 21.50f, r.celsius);
+    TEST_ASSERT_EQUAL_INT8(1, r.contact);
+    TEST_ASSERT_TRUE(isnan(r.humidity));
+}
+
+void test_parse_rejects() {
+    Frame f = telemetry(0x01020304, 1, nullptr);
+    FrameHeader h;
+    const uint8_t* payload;
+    size_t len;
+    TEST_ASSERT_EQUAL(FrameStatus::TOO_SHORT, FrameDecoder::parse(nullptr, 0, &h, &payload, &len));
+    TEST_ASSERT_EQUAL(FrameStatus::TOO_SHORT,
+                      FrameDecoder::parse(f.bytes, FRAME_OVERHEAD - 1, &h, &payload, &len));
+    // Cut short: the length field no longer matches
+    TEST_ASSERT_EQUAL(FrameStatus::BAD_LENGTH, FrameDecoder::parse(f.bytes, f.len - 1, &h, &payload, &len));
+
+    Frame bad = f;
+    bad.bytes[0] = 0x84;
+    TEST_ASSERT_EQUAL(FrameStatus::BAD_HEADER, FrameDecoder::parse(bad.bytes, bad.len, &h, &payload, &len));
+    bad = f;
+    bad.bytes[HEADER_SIZE] ^= 0x10;
+    TEST_ASSERT_EQUAL(FrameStatus::BAD_CHECKSUM, FrameDecoder::parse(bad.bytes, bad.len, &h, &payload, &len));
+}
+
+void test_key_cache_loader() {
+    SessionKeyCache keys(4, loadKey);
+    TEST_ASSERT_NOT_NULL(keys.context(0xA));
+    TEST_ASSERT_NOT_NULL(keys.context(0xA));
+    TEST_ASSERT_EQUAL(1, loads);
+    TEST_ASSERT_EQUAL_UINT64(1, keys.hits());
+    TEST_ASSERT_EQUAL_UINT64(1, keys.misses());
+
+    // Not adopted: asked again every time, never cached
+    TEST_ASSERT_NULL(keys.context(0xC));
+    TEST_ASSERT_NULL(keys.context(0xC));
+    TEST_ASSERT_EQUAL(3, loads);
+    TEST_ASSERT_EQUAL(1, keys.size());
+
+    keys.erase(0xA);
+    TEST_ASSERT_EQUAL(0, keys.size());
+    TEST_ASSERT_NOT_NULL(keys.context(0xA));
+    TEST_ASSERT_EQUAL(4, loads);
+}
+
+// Past capacity the least recently used key goes, not the oldest inserted
+void test_key_cache_eviction() {
+    SessionKeyCache keys(2);
+    TEST_ASSERT_TRUE(keys.put(1, KEY_A));
+    TEST_ASSERT_TRUE(keys.put(2, KEY_B));
+    TEST_ASSERT_NOT_NULL(keys.context(1));
+    TEST_ASSERT_TRUE(keys.put(3, KEY_A));
+    TEST_ASSERT_EQUAL(2, keys.size());
+    TEST_ASSERT_NOT_NULL(keys.context(1));
+    TEST_ASSERT_NULL(keys.context(2));
+    TEST_ASSERT_NOT_NULL(keys.context(3));
+
+    // A re-key replaces the entry in place
+    TEST_ASSERT_TRUE(keys.put(3, KEY_B));
+    TEST_ASSERT_EQUAL(2, keys.size());
+
+    SessionKeyCache one(0);
+    TEST_ASSERT_TRUE(one.put(1, KEY_A));
+    TEST_ASSERT_TRUE(one.put(2, KEY_A));
+    TEST_ASSERT_EQUAL(1, one.size());
+    TEST_ASSERT_NULL(one.context(1));
+}
+
+// An evicted device's frames still decode: the loader brings its key back
+void test_batch_reload_after_eviction() {
+    SessionKeyCache keys(1, loadKey);
+    FrameBatchDecoder decoder(keys);
+    Frame a = telemetry(0xA, 1, KEY_A);
+    Frame b = telemetry(0xB, 2, KEY_B);
+    DecodedFrame out;
+    TEST_ASSERT_TRUE(decoder.decode(a.bytes, a.len, &out));
+    TEST_ASSERT_TRUE(decoder.decode(b.bytes, b.len, &out));
+    TEST_ASSERT_TRUE(decoder.decode(a.bytes, a.len, &out));
+    TEST_ASSERT_TRUE(out.encrypted);
+    TEST_ASSERT_EQUAL(3, loads);
+}
+
+// Mixed devices in one call: results stay in arrival order
+void test_batch_decode() {
+    SessionKeyCache keys(8, loadKey);
+    FrameBatchDecoder decoder(keys);
+    Frame frames[] = {
+        telemetry(0xB, 10, KEY_B),
+        telemetry(0xA, 20, KEY_A),
+        telemetry(0xC, 30, nullptr),            // not adopted: plaintext fallback
+        telemetry(0xB, 11, KEY_B),
+    };
+    FrameRef refs[4];
+    for (size_t i = 0; i < 4; i++) refs[i] = FrameRef{frames[i].bytes, frames[i].len};
+    DecodedFrame out[4];
+    TEST_ASSERT_EQUAL(4, decoder.decode(refs, 4, out));
+
+    const uint32_t sequences[] = {10, 20, 30, 11};
+    for (size_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(FrameStatus::OK, out[i].status);
+        TEST_ASSERT_EQUAL_UINT32(sequences[i], out[i].header.sequence);
+        TEST_ASSERT_EQUAL(PayloadKind::TELEMETRY, out[i].kind);
+        TEST_ASSERT_EQUAL(sizeof(LEGACY_READING), out[i].payloadLen);
+        TEST_ASSERT_EQUAL_MEMORY(LEGACY_READING, out[i].payload, sizeof(LEGACY_READING));
+    }
+    TEST_ASSERT_TRUE(out[0].encrypted);
+    TEST_ASSERT_FALSE(out[2].encrypted);
+    // One lookup per device group
+    TEST_ASSERT_EQUAL(3, loads);
+}
+
+void test_batch_rejects() {
+    SessionKeyCache keys(8, loadKey);
+    FrameBatchDecoder decoder(keys);
+    DecodedFrame out;
+
+    // Sealed under the wrong key, or tampered with after sealing
+    Frame wrongKey = telemetry(0xA, 1, KEY_B);
+    TEST_ASSERT_FALSE(decoder.decode(wrongKey.bytes, wrongKey.len, &out));
+    TEST_ASSERT_EQUAL(FrameStatus::AUTH_FAILED, out.status);
+    Frame tampered = telemetry(0xA, 2, KEY_A);
+    tampered.bytes[HEADER_SIZE + GCM_IV_SIZE] ^= 0x01;
+    seal(tampered);
+    TEST_ASSERT_FALSE(decoder.decode(tampered.bytes, tampered.len, &out));
+    TEST_ASSERT_EQUAL(FrameStatus::AUTH_FAILED, out.status);
+    // The sequence number is authenticated too
+    Frame replayed = telemetry(0xA, 3, KEY_A);
+    replayed.bytes[16] ^= 0x01;
+    seal(replayed);
+    TEST_ASSERT_FALSE(decoder.decode(replayed.bytes, replayed.len, &out));
+    TEST_ASSERT_EQUAL(FrameStatus::AUTH_FAILED, out.status);
+
+    // Ciphertext from a device the gateway has no key for
+    Frame unknown = telemetry(0xC, 4, KEY_A);
+    TEST_ASSERT_FALSE(decoder.decode(unknown.bytes, unknown.len, &out));
+    TEST_ASSERT_EQUAL(FrameStatus::BAD_PAYLOAD, out.status);
+    decoder.setRequireEncryption(true);
+    Frame plain = telemetry(0xC, 5, nullptr);
+    TEST_ASSERT_FALSE(decoder.decode(plain.bytes, plain.len, &out));
+    TEST_ASSERT_EQUAL(FrameStatus::NO_KEY, out.status);
+
+    // A full metrics report that is not 207 bytes
+    uint8_t shortReport[40] = {};
+    Frame metrics = build(0xA, 6, TYPE_METRICS, 0, shortReport, sizeof(shortReport), KEY_A);
+    TEST_ASSERT_FALSE(decoder.decode(metrics.bytes, metrics.len, &out));
+    TEST_ASSERT_EQUAL(FrameStatus::BAD_PAYLOAD, out.status);
+}
+
+// ACK and command frames are never encrypted and pass through as they are
+void test_batch_plaintext_types() {
+    SessionKeyCache keys(8, loadKey);
+    FrameBatchDecoder decoder(keys);
+    decoder.setRequireEncryption(true);
+    const uint8_t command[] = {0x10, 0x00};
+    Frame f = build(0xA, 7, TYPE_COMMAND, 0, command, sizeof(command), nullptr);
+    DecodedFrame out;
+    TEST_ASSERT_TRUE(decoder.decode(f.bytes, f.len, &out));
+    TEST_ASSERT_EQUAL(PayloadKind::UNKNOWN, out.kind);
+    TEST_ASSERT_FALSE(out.encrypted);
+    TEST_ASSERT_EQUAL_MEMORY(command, out.payload, sizeof(command));
+    TEST_ASSERT_EQUAL(0, loads);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_checksum);
+    RUN_TEST(test_parse);
+    RUN_TEST(test_parse_rejects);
+    RUN_TEST(test_key_cache_loader);
+    RUN_TEST(test_key_cache_eviction);
+    RUN_TEST(test_batch_reload_after_eviction);
+    RUN_TEST(test_batch_decode);
+    RUN_TEST(test_batch_rejects);
+    RUN_TEST(test_batch_plaintext_types);
+    return UNITY_END();
+}
@@ -0,0 +1,221 @@
+// CpuGovernor against a mocked clock backend: levels, transitions, time
+// accounting and modeled energy.
+// pio test -e native -f test_governor
+#include <unity.h>
+#include <CpuGovernor.h>
+
+namespace {
+
+constexpr uint32_t MS = 1000;
+constexpr float SUPPLY_V = 3.7f;
+
+// Refcounted levels on a manual clock. Counts the ordering errors the
+// firmware backend could not survive: the governor accounting at a level
+// the clock is not at yet, or still at one the clock has left.
+class MockClockBackend : public CpuClockBackend {
+public:
+    uint64_t now = 0;
+    const CpuGovernor* governor = nullptr;
+    uint32_t failures = 0;
+    uint32_t switches = 0;
+
+    uint64_t nowUs() override { return now; }
+
+    void acquire(CpuLevel level) override {
+        _held[(uint8_t)level]++;
+        if (governor != nullptr && governor->current() > clockLevel()) failures++;
+        track();
+    }
+
+    void release(CpuLevel level) override {
+        if (_held[(uint8_t)level] == 0) {
+            failures++;
+            return;
+        }
+        _held[(uint8_t)level]--;
+        if (governor != nullptr && governor->current() > clockLevel()) failures++;
+        track();
+    }
+
+    CpuLevel clockLevel() const {
+        uint8_t level = 0;
+        for (uint8_t l = 1; l < CpuGovernor::LEVEL_COUNT; l++) {
+            if (_held[l] > 0) level = l;
+        }
+        return (CpuLevel)level;
+    }
+
+private:
+    uint8_t _held[CpuGovernor::LEVEL_COUNT] = {};
+    CpuLevel _last = CpuLevel::IDLE;
+
+    void track() {
+        if (clockLevel() != _last) {
+            _last = clockLevel();
+            switches++;
+        }
+    }
+};
+
+MockClockBackend* backend;
+CpuGovernor* governor;
+
+void enter(CpuPhase phase, CpuLevel expect) {
+    governor->enter(phase);
+    TEST_ASSERT_EQUAL(expect, governor->current());
+    TEST_ASSERT_EQUAL(expect, backend->clockLevel());
+}
+
+void leave(CpuPhase phase, CpuLevel expect) {
+    governor->leave(phase);
+    TEST_ASSERT_EQUAL(expect, governor->current());
+    TEST_ASSERT_EQUAL(expect, backend->clockLevel());
+}
+
+double uWh(CpuLevel level, uint64_t us) {
+    return CpuGovernor::LEVEL_MA[(uint8_t)level] * (us / 1000.0) * SUPPLY_V / 3600.0;
+}
+
+} // namespace
+
+void setUp() {
+    backend = new MockClockBackend();
+    governor = new CpuGovernor();
+    governor->begin(backend);
+    backend->governor = governor;
+}
+
+void tearDown() {
+    delete governor;
+    delete backend;
+}
+
+void test_default_levels() {
+    TEST_ASSERT_EQUAL(CpuLevel::IDLE, governor->current());
+    TEST_ASSERT_EQUAL(CpuLevel::FULL, governor->level(CpuPhase::BOOT));
+    TEST_ASSERT_EQUAL(CpuLevel::FULL, governor->level(CpuPhase::CRYPTO));
+    TEST_ASSERT_EQUAL(CpuLevel::IO, governor->level(CpuPhase::SENSOR_IO));
+    TEST_ASSERT_EQUAL(CpuLevel::IDLE, governor->level(CpuPhase::RADIO_WAIT));
+    TEST_ASSERT_EQUAL(CpuLevel::IO, governor->level(CpuPhase::FLUSH));
+}
+
+void test_enter_raises_leave_drops() {
+    enter(CpuPhase::FLUSH, CpuLevel::IO);
+    TEST_ASSERT_TRUE(governor->active(CpuPhase::FLUSH));
+    leave(CpuPhase::FLUSH, CpuLevel::IDLE);
+    TEST_ASSERT_FALSE(governor->active(CpuPhase::FLUSH));
+    TEST_ASSERT_EQUAL_UINT32(2, governor->transitions());
+    TEST_ASSERT_EQUAL_UINT32(0, backend->failures);
+}
+
+// CRYPTO on Core 0 overlapping SENSOR_IO on Core 1
+void test_overlapping_phases_run_at_highest() {
+    enter(CpuPhase::SENSOR_IO, CpuLevel::IO);
+    enter(CpuPhase::CRYPTO, CpuLevel::FULL);
+    leave(CpuPhase::CRYPTO, CpuLevel::IO);
+    leave(CpuPhase::SENSOR_IO, CpuLevel::IDLE);
+    TEST_ASSERT_EQUAL_UINT32(4, governor->transitions());
+    TEST_ASSERT_EQUAL_UINT32(4, backend->switches);
+    TEST_ASSERT_EQUAL_UINT32(0, backend->failures);
+}
+
+void test_nested_phase_is_refcounted() {
+    enter(CpuPhase::CRYPTO, CpuLevel::FULL);
+    enter(CpuPhase::CRYPTO, CpuLevel::FULL);
+    leave(CpuPhase::CRYPTO, CpuLevel::FULL);
+    leave(CpuPhase::CRYPTO, CpuLevel::IDLE);
+    TEST_ASSERT_EQUAL_UINT32(2, governor->transitions());
+    TEST_ASSERT_EQUAL_UINT32(0, backend->failures);
+}
+
+// An unmatched leave() must not release a level it never acquired
+void test_unmatched_leave_is_ignored() {
+    leave(CpuPhase::CRYPTO, CpuLevel::IDLE);
+    enter(CpuPhase::FLUSH, CpuLevel::IO);
+    leave(CpuPhase::CRYPTO, CpuLevel::IO);
+    TEST_ASSERT_EQUAL_UINT32(0, backend->failures);
+}
+
+void test_set_level_only_while_not_held() {
+    governor->setLevel(CpuPhase::SENSOR_IO, CpuLevel::FULL);
+    enter(CpuPhase::SENSOR_IO, CpuLevel::FULL);
+    governor->setLevel(CpuPhase::SENSOR_IO, CpuLevel::IDLE);
+    TEST_ASSERT_EQUAL(CpuLevel::FULL, governor->level(CpuPhase::SENSOR_IO));
+    leave(CpuPhase::SENSOR_IO, CpuLevel::IDLE);
+    TEST_ASSERT_EQUAL_UINT32(0, backend->failures);
+}
+
+void test_without_backend_does_nothing() {
+    CpuGovernor idle;
+    idle.begin(nullptr);
+    idle.enter(CpuPhase::CRYPTO);
+    TEST_ASSERT_EQUAL(CpuLevel::IDLE, idle.current());
+    TEST_ASSERT_FALSE(idle.active(CpuPhase::CRYPTO));
+    idle.leave(CpuPhase::CRYPTO);
+    idle.settle();
+    TEST_ASSERT_EQUAL_UINT32(0, idle.transitions());
+}
+
+// Boot with crypto and the radio init overlapping, a sensor read with a
+// Core 0 decrypt inside it, a flush and a radio wait
+void test_wake_accounting_and_energy() {
+    enter(CpuPhase::BOOT, CpuLevel::FULL);
+    backend->now += 2 * MS;
+    enter(CpuPhase::CRYPTO, CpuLevel::FULL);
+    backend->now += 55 * MS;
+    leave(CpuPhase::CRYPTO, CpuLevel::FULL);
+    backend->now += 10 * MS;
+    leave(CpuPhase::BOOT, CpuLevel::IDLE);
+    enter(CpuPhase::SENSOR_IO, CpuLevel::IO);
+    backend->now += 5 * MS;
+    enter(CpuPhase::CRYPTO, CpuLevel::FULL);
+    backend->now += 1 * MS;
+    leave(CpuPhase::CRYPTO, CpuLevel::IO);
+    backend->now += 5 * MS;
+    leave(CpuPhase::SENSOR_IO, CpuLevel::IDLE);
+    enter(CpuPhase::FLUSH, CpuLevel::IO);
+    backend->now += 2 * MS;
+    leave(CpuPhase::FLUSH, CpuLevel::IDLE);
+    enter(CpuPhase::RADIO_WAIT, CpuLevel::IDLE);
+    backend->now += 3000 * MS;
+    leave(CpuPhase::RADIO_WAIT, CpuLevel::IDLE);
+    backend->now += 1 * MS;
+    governor->settle();
+
+    TEST_ASSERT_EQUAL_UINT64(68 * MS, governor->levelUs(CpuLevel::FULL));
+    TEST_ASSERT_EQUAL_UINT64(12 * MS, governor->levelUs(CpuLevel::IO));
+    TEST_ASSERT_EQUAL_UINT64(3001 * MS, governor->levelUs(CpuLevel::IDLE));
+
+    TEST_ASSERT_EQUAL_UINT64(67 * MS, governor->phaseUs(CpuPhase::BOOT, CpuLevel::FULL));
+    TEST_ASSERT_EQUAL_UINT64(56 * MS, governor->phaseUs(CpuPhase::CRYPTO, CpuLevel::FULL));
+    // The read ran at FULL while the decrypt held it there
+    TEST_ASSERT_EQUAL_UINT64(10 * MS, governor->phaseUs(CpuPhase::SENSOR_IO, CpuLevel::IO));
+    TEST_ASSERT_EQUAL_UINT64(1 * MS, governor->phaseUs(CpuPhase::SENSOR_IO, CpuLevel::FULL));
+    TEST_ASSERT_EQUAL_UINT64(2 * MS, governor->phaseUs(CpuPhase::FLUSH, CpuLevel::IO));
+    TEST_ASSERT_EQUAL_UINT64(3000 * MS, governor->phaseUs(CpuPhase::RADIO_WAIT, CpuLevel::IDLE));
+
+    double expect = uWh(CpuLevel::FULL, 68 * MS) + uWh(CpuLevel::IO, 12 * MS)
+                  + uWh(CpuLevel::IDLE, 3001 * MS);
+    double full = uWh(CpuLevel::FULL, 3081 * MS);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6 * full, expect, governor->modeled_uWh(SUPPLY_V));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6 * full, full,
+                             governor->modeled_uWh(SUPPLY_V) + governor->saved_uWh(SUPPLY_V));
+
+    // IDLE > FULL > IDLE > IO > FULL > IO > IDLE > IO > IDLE
+    TEST_ASSERT_EQUAL_UINT32(8, governor->transitions());
+    TEST_ASSERT_EQUAL_UINT32(8, backend->switches);
+    TEST_ASSERT_EQUAL_UINT32(0, backend->failures);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_default_levels);
+    RUN_TEST(test_enter_raises_leave_drops);
+    RUN_TEST(test_overlapping_phases_run_at_highest);
+    RUN_TEST(test_nested_phase_is_refcounted);
+    RUN_TEST(test_unmatched_leave_is_ignored);
+    RUN_TEST(test_set_level_only_while_not_held);
+    RUN_TEST(test_without_backend_does_nothing);
+    RUN_TEST(test_wake_accounting_and_energy);
+    return UNITY_END();
+}
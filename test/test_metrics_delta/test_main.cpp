@@ -0,0 +1,180 @@
+// MetricsDelta against matching, missing and mismatched baselines.
+// pio test -e native -f test_metrics_delta
+#include <unity.h>
+#include <MetricsDelta.h>
+#include <string.h>
+
+namespace {
+
+constexpr size_t REGION = 16;
+constexpr MetricsDelta::Field TABLE[] = {
+    {0, 1}, {1, 2}, {3, 4}, {7, 1}, {8, 1}, {9, 1}, {10, 1}, {11, 1}, {12, 2}
+};
+constexpr uint8_t COUNT = sizeof(TABLE) / sizeof(TABLE[0]);     // 9: two bitmap bytes
+// Bytes 14 and 15 are outside the table
+
+uint8_t base[REGION];
+uint8_t current[REGION];
+uint8_t out[64];
+
+void put(uint8_t* region, uint8_t offset, uint8_t size, uint32_t v) {
+    for (uint8_t i = size; i > 0; i--) {
+        region[offset + i - 1] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+size_t encode(uint32_t seq = 1234) {
+    return MetricsDelta::encode(TABLE, COUNT, base, current, REGION, seq, out, sizeof(out));
+}
+
+} // namespace
+
+void setUp() {
+    for (size_t i = 0; i < REGION; i++) base[i] = (uint8_t)(i * 17);
+    memcpy(current, base, REGION);
+}
+
+void tearDown() {}
+
+// Nothing changed: header and an empty bitmap
+void test_unchanged() {
+    size_t len = encode(0xA1B2C3D4);
+    TEST_ASSERT_EQUAL(MetricsDelta::HEADER_SIZE + 2, len);
+    TEST_ASSERT_EQUAL_HEX8(MetricsDelta::FORMAT_DELTA, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(COUNT, out[5]);
+    TEST_ASSERT_EQUAL_HEX32(0xA1B2C3D4, MetricsDelta::baseSequence(out, len));
+
+    uint8_t region[REGION];
+    memcpy(region, base, REGION);
+    uint32_t seq = 0;
+    TEST_ASSERT_TRUE(MetricsDelta::decode(TABLE, COUNT, out, len, region, REGION, &seq));
+    TEST_ASSERT_EQUAL_HEX32(0xA1B2C3D4, seq);
+    TEST_ASSERT_EQUAL_MEMORY(base, region, REGION);
+}
+
+void test_round_trip() {
+    put(current, 1, 2, 0x1234);
+    put(current, 3, 4, 0xDEADBEEF);
+    put(current, 12, 2, 7);
+    size_t len = encode();
+    TEST_ASSERT_NOT_EQUAL(0, len);
+    // Fields 1, 2 and 8 in the bitmap
+    TEST_ASSERT_EQUAL_HEX8(0x06, out[6]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, out[7]);
+
+    uint8_t region[REGION];
+    memcpy(region, base, REGION);
+    TEST_ASSERT_TRUE(MetricsDelta::decode(TABLE, COUNT, out, len, region, REGION, nullptr));
+    TEST_ASSERT_EQUAL_MEMORY(current, region, REGION);
+}
+
+// A counter that wrapped costs what its small step costs
+void test_wrapping_counter() {
+    put(base, 1, 2, 0xFFFE);
+    put(current, 1, 2, 0x0003);
+    put(base, 3, 4, 0xFFFFFFFF);
+    put(current, 3, 4, 0x00000001);
+    size_t len = encode();
+    TEST_ASSERT_EQUAL(MetricsDelta::HEADER_SIZE + 2 + 2, len);
+
+    uint8_t region[REGION];
+    memcpy(region, base, REGION);
+    TEST_ASSERT_TRUE(MetricsDelta::decode(TABLE, COUNT, out, len, region, REGION, nullptr));
+    TEST_ASSERT_EQUAL_MEMORY(current, region, REGION);
+}
+
+// A change the table cannot carry needs a full report
+void test_change_outside_table() {
+    current[15] ^= 0x01;
+    TEST_ASSERT_EQUAL(0, encode());
+}
+
+void test_encode_rejects() {
+    put(current, 3, 4, 0x12345678);
+    TEST_ASSERT_EQUAL(0, MetricsDelta::encode(TABLE, 0, base, current, REGION, 1, out, sizeof(out)));
+    // Too small for the header, or for the deltas
+    TEST_ASSERT_EQUAL(0, MetricsDelta::encode(TABLE, COUNT, base, current, REGION, 1, out, 7));
+    size_t len = encode();
+    TEST_ASSERT_EQUAL(0, MetricsDelta::encode(TABLE, COUNT, base, current, REGION, 1, out, len - 1));
+    // A field past the end of the region
+    TEST_ASSERT_EQUAL(0, MetricsDelta::encode(TABLE, COUNT, base, current, 13, 1, out, sizeof(out)));
+    const MetricsDelta::Field bad[] = {{0, 3}};
+    TEST_ASSERT_EQUAL(0, MetricsDelta::encode(bad, 1, base, current, REGION, 1, out, sizeof(out)));
+}
+
+// The gateway has no baseline yet: the payload only names the one it needs
+void test_missing_baseline() {
+    put(current, 0, 1, 9);
+    size_t len = encode(77);
+    TEST_ASSERT_EQUAL_UINT32(77, MetricsDelta::baseSequence(out, len));
+    // Not a delta payload, or too short to name one
+    TEST_ASSERT_EQUAL_UINT32(0, MetricsDelta::baseSequence(out, MetricsDelta::HEADER_SIZE - 1));
+    uint8_t full[REGION] = {0x00, 1, 2, 3, 4, 5};
+    TEST_ASSERT_EQUAL_UINT32(0, MetricsDelta::baseSequence(full, REGION));
+}
+
+// Applied to another baseline, the deltas still add up but to another result;
+// only the sequence number tells them apart
+void test_mismatched_baseline() {
+    put(current, 3, 4, 500);
+    put(base, 3, 4, 400);
+    size_t len = encode(10);
+
+    uint8_t other[REGION];
+    memcpy(other, base, REGION);
+    put(other, 3, 4, 1400);
+    uint32_t seq = 0;
+    TEST_ASSERT_TRUE(MetricsDelta::decode(TABLE, COUNT, out, len, other, REGION, &seq));
+    TEST_ASSERT_EQUAL_UINT32(10, seq);
+    TEST_ASSERT_EQUAL_HEX8(0x05, other[5]);     // 1500 = 0x05DC
+    TEST_ASSERT_EQUAL_HEX8(0xDC, other[6]);
+}
+
+// Built against another version of the table
+void test_mismatched_table() {
+    put(current, 12, 2, 1);
+    size_t len = encode();
+    uint8_t region[REGION];
+    memcpy(region, base, REGION);
+    TEST_ASSERT_FALSE(MetricsDelta::decode(TABLE, COUNT - 1, out, len, region, REGION, nullptr));
+
+    // Same bitmap size and count byte, but a bit past the decoder's table
+    memcpy(current + 12, base + 12, 2);
+    put(current, 11, 1, 1);
+    len = MetricsDelta::encode(TABLE, 8, base, current, REGION, 1, out, sizeof(out));
+    TEST_ASSERT_NOT_EQUAL(0, len);
+    out[5] = 7;
+    memcpy(region, base, REGION);
+    TEST_ASSERT_FALSE(MetricsDelta::decode(TABLE, 7, out, len, region, REGION, nullptr));
+}
+
+void test_decode_rejects() {
+    put(current, 1, 2, 0x1234);
+    size_t len = encode();
+    uint8_t region[REGION];
+    for (size_t n = 0; n < len; n++) {
+        memcpy(region, base, REGION);
+        TEST_ASSERT_FALSE(MetricsDelta::decode(TABLE, COUNT, out, n, region, REGION, nullptr));
+    }
+    // Trailing byte
+    out[len] = 0;
+    TEST_ASSERT_FALSE(MetricsDelta::decode(TABLE, COUNT, out, len + 1, region, REGION, nullptr));
+    // Wrong format
+    out[0] = 0x00;
+    TEST_ASSERT_FALSE(MetricsDelta::decode(TABLE, COUNT, out, len, region, REGION, nullptr));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_unchanged);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_wrapping_counter);
+    RUN_TEST(test_change_outside_table);
+    RUN_TEST(test_encode_rejects);
+    RUN_TEST(test_missing_baseline);
+    RUN_TEST(test_mismatched_baseline);
+    RUN_TEST(test_mismatched_table);
+    RUN_TEST(test_decode_rejects);
+    return UNITY_END();
+}
@@ -0,0 +1,144 @@
+// SettingsPatch entry validation against a settings field table.
+// pio test -e native -f test_settings_patch
+#include <unity.h>
+#include <SettingsPatch.h>
+#include <string.h>
+
+namespace {
+
+// The universal part of the firmware's SettingsFields table, plus one
+// sensor-tail field; bytes 23-32 and 38 up are reserved
+constexpr SettingsPatch::Field TABLE[] = {
+    {0,  1, SettingsPatch::TOUCH_OTHER},        // settingsVersion
+    {1,  2, SettingsPatch::TOUCH_TIMING},       // telemetryInterval
+    {3,  2, SettingsPatch::TOUCH_TIMING},       // telemetryMaxWake
+    {5,  1, SettingsPatch::TOUCH_RADIO},        // txPower
+    {6,  1, SettingsPatch::TOUCH_RADIO},        // spreadingFactor
+    {7,  1, SettingsPatch::TOUCH_RADIO},        // bandwidth
+    {8,  4, SettingsPatch::TOUCH_RADIO},        // frequency
+    {12, 1, SettingsPatch::TOUCH_RADIO},        // codingRate
+    {13, 2, SettingsPatch::TOUCH_OTHER},        // waitAfterTx
+    {15, 1, SettingsPatch::TOUCH_OTHER},        // ackFailThreshold
+    {16, 1, SettingsPatch::TOUCH_OTHER},        // telemetryAckRequired
+    {17, 2, SettingsPatch::TOUCH_OTHER},        // metricsReportInterval
+    {19, 4, 0},                                 // parentID
+    {33, 1, 0},                                 // sensorType
+    {34, 1, 0},                                 // firmwareVersion
+    {35, 1, 0},                                 // hardwareVersion
+    {36, 2, SettingsPatch::TOUCH_SENSOR},
+};
+constexpr uint8_t COUNT = sizeof(TABLE) / sizeof(TABLE[0]);
+
+uint8_t region[SettingsPatch::REGION_SIZE];
+uint8_t original[SettingsPatch::REGION_SIZE];
+
+uint8_t apply(const uint8_t* patch, size_t len) {
+    return SettingsPatch::apply(TABLE, COUNT, region, patch, len);
+}
+
+// Rejected, and the region left as it was
+void assertRejected(const uint8_t* patch, size_t len) {
+    TEST_ASSERT_EQUAL_HEX8(0, apply(patch, len));
+    TEST_ASSERT_EQUAL_MEMORY(original, region, sizeof(region));
+}
+
+} // namespace
+
+void setUp() {
+    for (size_t i = 0; i < sizeof(region); i++) region[i] = (uint8_t)(i + 1);
+    memcpy(original, region, sizeof(region));
+}
+
+void tearDown() {}
+
+void test_single_field() {
+    const uint8_t patch[] = {1, 2, 0x02, 0x58};     // telemetryInterval = 600
+    TEST_ASSERT_EQUAL_HEX8(SettingsPatch::TOUCH_TIMING, apply(patch, sizeof(patch)));
+    TEST_ASSERT_EQUAL_HEX8(0x02, region[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x58, region[2]);
+    // Nothing else moved
+    TEST_ASSERT_EQUAL_MEMORY(original + 3, region + 3, sizeof(region) - 3);
+    TEST_ASSERT_EQUAL_HEX8(original[0], region[0]);
+}
+
+// One entry across adjacent fields, and several entries in one patch
+void test_spanning_and_multiple_entries() {
+    const uint8_t patch[] = {
+        5, 3, 14, 12, 0,                // txPower, SF, BW
+        17, 2, 0x00, 0x06,              // metricsReportInterval
+        36, 2, 0x00, 0x32,              // sensor tail
+    };
+    uint8_t touched = apply(patch, sizeof(patch));
+    TEST_ASSERT_EQUAL_HEX8(SettingsPatch::TOUCH_RADIO | SettingsPatch::TOUCH_OTHER
+                           | SettingsPatch::TOUCH_SENSOR, touched);
+    TEST_ASSERT_EQUAL_HEX8(14, region[5]);
+    TEST_ASSERT_EQUAL_HEX8(12, region[6]);
+    TEST_ASSERT_EQUAL_HEX8(0, region[7]);
+    TEST_ASSERT_EQUAL_HEX8(0x06, region[18]);
+    TEST_ASSERT_EQUAL_HEX8(0x32, region[37]);
+}
+
+// An entry has to start and end on field boundaries
+void test_split_field() {
+    const uint8_t startsInside[] = {2, 1, 0x58};             // second byte of telemetryInterval
+    assertRejected(startsInside, sizeof(startsInside));
+    const uint8_t endsInside[] = {8, 2, 0x33, 0x9A};         // half of frequency
+    assertRejected(endsInside, sizeof(endsInside));
+    const uint8_t spansIntoHalf[] = {7, 3, 0, 0x33, 0x9A};   // bandwidth + half of frequency
+    assertRejected(spansIntoHalf, sizeof(spansIntoHalf));
+}
+
+// Adoption owns parentID and the identity bytes
+void test_protected_fields() {
+    const uint8_t parent[] = {19, 4, 0xDE, 0xAD, 0xBE, 0xEF};
+    assertRejected(parent, sizeof(parent));
+    const uint8_t parentByte[] = {21, 1, 0x00};
+    assertRejected(parentByte, sizeof(parentByte));
+    // Running into parentID from the field before it
+    const uint8_t intoParent[] = {17, 6, 0, 6, 0xDE, 0xAD, 0xBE, 0xEF};
+    assertRejected(intoParent, sizeof(intoParent));
+    const uint8_t identity[] = {33, 3, 1, 2, 3};
+    assertRejected(identity, sizeof(identity));
+}
+
+// A valid entry does not get through ahead of an invalid one
+void test_all_or_nothing() {
+    const uint8_t patch[] = {
+        1, 2, 0x02, 0x58,               // fine
+        19, 4, 0xDE, 0xAD, 0xBE, 0xEF,  // parentID
+    };
+    assertRejected(patch, sizeof(patch));
+}
+
+void test_reserved_bytes() {
+    const uint8_t reserved[] = {24, 1, 0};
+    assertRejected(reserved, sizeof(reserved));
+    const uint8_t pastTable[] = {100, 1, 0};
+    assertRejected(pastTable, sizeof(pastTable));
+    const uint8_t pastRegion[] = {206, 2, 0, 0};
+    assertRejected(pastRegion, sizeof(pastRegion));
+}
+
+void test_malformed() {
+    assertRejected(nullptr, 0);
+    const uint8_t noLength[] = {1};
+    assertRejected(noLength, sizeof(noLength));
+    const uint8_t zeroLength[] = {1, 0};
+    assertRejected(zeroLength, sizeof(zeroLength));
+    const uint8_t truncated[] = {1, 2, 0x02};
+    assertRejected(truncated, sizeof(truncated));
+    const uint8_t trailing[] = {0, 1, 2, 5};
+    assertRejected(trailing, sizeof(trailing));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_field);
+    RUN_TEST(test_spanning_and_multiple_entries);
+    RUN_TEST(test_split_field);
+    RUN_TEST(test_protected_fields);
+    RUN_TEST(test_all_or_nothing);
+    RUN_TEST(test_reserved_bytes);
+    RUN_TEST(test_malformed);
+    return UNITY_END();
+}
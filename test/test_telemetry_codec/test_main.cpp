@@ -0,0 +1,189 @@
+// TelemetryCodec building blocks, limits and round trips.
+// pio test -e native -f test_telemetry_codec
+#include <unity.h>
+#include <TelemetryCodec.h>
+#include <stdint.h>
+
+void setUp() {}
+void tearDown() {}
+
+static void roundTrip(const TelemetrySample* samples, uint8_t count) {
+    uint8_t out[TelemetryCodec::maxEncodedSize(40)];
+    TelemetrySample decoded[40];
+    size_t len = TelemetryCodec::encode(samples, count, out, sizeof(out));
+    TEST_ASSERT_NOT_EQUAL(0, len);
+    TEST_ASSERT_TRUE(len <= TelemetryCodec::maxEncodedSize(count));
+    TEST_ASSERT_EQUAL_UINT8(count, TelemetryCodec::decode(out, len, decoded, 40));
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_INT16(samples[i].raw, decoded[i].raw);
+        TEST_ASSERT_EQUAL(samples[i].contact, decoded[i].contact);
+        TEST_ASSERT_EQUAL_UINT32(samples[i].ageS, decoded[i].ageS);
+    }
+}
+
+void test_zigzag() {
+    TEST_ASSERT_EQUAL_UINT32(0, TelemetryCodec::zigzag(0));
+    TEST_ASSERT_EQUAL_UINT32(1, TelemetryCodec::zigzag(-1));
+    TEST_ASSERT_EQUAL_UINT32(2, TelemetryCodec::zigzag(1));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFE, TelemetryCodec::zigzag(INT32_MAX));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, TelemetryCodec::zigzag(INT32_MIN));
+
+    const int32_t values[] = {0, 1, -1, 63, -64, 8190, -8190, INT32_MAX, INT32_MIN};
+    for (int32_t v : values) {
+        TEST_ASSERT_EQUAL_INT32(v, TelemetryCodec::unzigzag(TelemetryCodec::zigzag(v)));
+    }
+}
+
+void test_varint_sizes() {
+    uint8_t buf[TelemetryCodec::MAX_VARINT_SIZE];
+    TEST_ASSERT_EQUAL(1, TelemetryCodec::putVarint(0, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_HEX8(0x00, buf[0]);
+    TEST_ASSERT_EQUAL(1, TelemetryCodec::putVarint(127, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(2, TelemetryCodec::putVarint(128, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_HEX8(0x80, buf[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, buf[1]);
+    TEST_ASSERT_EQUAL(3, TelemetryCodec::putVarint(16384, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(5, TelemetryCodec::putVarint(UINT32_MAX, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_HEX8(0x0F, buf[4]);
+}
+
+void test_varint_round_trip() {
+    const uint32_t values[] = {0, 1, 127, 128, 300, 16383, 16384, 86400, 0x0FFFFFFF, UINT32_MAX};
+    uint8_t buf[TelemetryCodec::MAX_VARINT_SIZE];
+    for (uint32_t v : values) {
+        size_t n = TelemetryCodec::putVarint(v, buf, sizeof(buf));
+        uint32_t back = 0;
+        TEST_ASSERT_EQUAL(n, TelemetryCodec::getVarint(buf, n, &back));
+        TEST_ASSERT_EQUAL_UINT32(v, back);
+    }
+}
+
+void test_varint_limits() {
+    uint8_t buf[8];
+    uint32_t v = 0;
+    // Output too small
+    TEST_ASSERT_EQUAL(0, TelemetryCodec::putVarint(128, buf, 1));
+    TEST_ASSERT_EQUAL(0, TelemetryCodec::putVarint(0, buf, 0));
+    // Truncated input
+    size_t n = TelemetryCodec::putVarint(300, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(0, TelemetryCodec::getVarint(buf, n - 1, &v));
+    // No terminator within MAX_VARINT_SIZE bytes
+    const uint8_t unterminated[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+    TEST_ASSERT_EQUAL(0, TelemetryCodec::getVarint(unterminated, sizeof(unterminated), &v));
+}
+
+void test_raw_from_celsius() {
+    TEST_ASSERT_EQUAL_INT16(0, TelemetryCodec::rawFromCelsius(0.0f));
+    TEST_ASSERT_EQUAL_INT16(400, TelemetryCodec::rawFromCelsius(25.0f));
+    TEST_ASSERT_EQUAL_INT16(-320, TelemetryCodec::rawFromCelsius(-20.0f));
+    // Rounds to the nearest count in both directions
+    TEST_ASSERT_EQUAL_INT16(1, TelemetryCodec::rawFromCelsius(0.04f));
+    TEST_ASSERT_EQUAL_INT16(-1, TelemetryCodec::rawFromCelsius(-0.04f));
+    // Clamped to the 13-bit range
+    TEST_ASSERT_EQUAL_INT16(TelemetryCodec::RAW_MAX, TelemetryCodec::rawFromCelsius(300.0f));
+    TEST_ASSERT_EQUAL_INT16(TelemetryCodec::RAW_MIN, TelemetryCodec::rawFromCelsius(-300.0f));
+    TEST_ASSERT_EQUAL_INT16(2500, TelemetryCodec::centiFromRaw(400));
+    TEST_ASSERT_EQUAL_INT16(-6, TelemetryCodec::centiFromRaw(-1));
+}
+
+// One sample: header, newest age, interval 0, 2-byte first sample
+void test_single_sample() {
+    const TelemetrySample s[] = {{0, -2048, true}};
+    uint8_t out[16];
+    size_t len = TelemetryCodec::encode(s, 1, out, sizeof(out));
+    TEST_ASSERT_EQUAL(7, len);
+    TEST_ASSERT_EQUAL_HEX8(TelemetryCodec::FORMAT_COMPACT, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(1, out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0, out[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x98, out[5]);   // contact + 0x1800
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[6]);
+    roundTrip(s, 1);
+}
+
+// Small steady deltas cost one byte each
+void test_regular_batch() {
+    TelemetrySample s[24];
+    for (uint8_t i = 0; i < 24; i++) {
+        s[i] = {(uint32_t)(23 - i) * 600, (int16_t)(56 + (i % 5) - 2), i == 10};
+    }
+    uint8_t out[TelemetryCodec::maxEncodedSize(24)];
+    size_t len = TelemetryCodec::encode(s, 24, out, sizeof(out));
+    // header + age 0 + interval 600 (2 bytes) + first + 23 one-byte deltas
+    TEST_ASSERT_EQUAL(3 + 1 + 2 + 2 + 23, len);
+    TEST_ASSERT_EQUAL_HEX8(0, out[2]);
+    roundTrip(s, 24);
+}
+
+void test_irregular_batch() {
+    const TelemetrySample s[] = {
+        {3600, 100, false}, {3000, 101, false}, {1200, 99, true}, {30, 99, false}};
+    uint8_t out[32];
+    size_t len = TelemetryCodec::encode(s, 4, out, sizeof(out));
+    TEST_ASSERT_NOT_EQUAL(0, len);
+    TEST_ASSERT_EQUAL_HEX8(TelemetryCodec::FLAG_IRREGULAR, out[2]);
+    roundTrip(s, 4);
+}
+
+// Full-scale swings in both directions, at the 13-bit limits
+void test_extreme_deltas() {
+    TelemetrySample s[40];
+    for (uint8_t i = 0; i < 40; i++) {
+        int16_t raw = (i % 2) ? TelemetryCodec::RAW_MAX : TelemetryCodec::RAW_MIN;
+        s[i] = {(uint32_t)(39 - i) * 86400, raw, (i % 3) == 0};
+    }
+    roundTrip(s, 40);
+    // A large newest age still fits
+    s[39].ageS = 0x0FFFFFFF;
+    for (uint8_t i = 0; i < 39; i++) s[i].ageS = s[39].ageS + (uint32_t)(39 - i) * 7;
+    roundTrip(s, 40);
+}
+
+void test_encode_rejects() {
+    const TelemetrySample s[] = {{600, 10, false}, {0, 12, false}};
+    uint8_t out[32];
+    TEST_ASSERT_EQUAL(0, TelemetryCodec::encode(s, 0, out, sizeof(out)));
+    size_t len = TelemetryCodec::encode(s, 2, out, sizeof(out));
+    // Every shorter buffer is refused rather than overrun
+    for (size_t n = 0; n < len; n++) {
+        TEST_ASSERT_EQUAL(0, TelemetryCodec::encode(s, 2, out, n));
+    }
+}
+
+void test_decode_rejects() {
+    const TelemetrySample s[] = {{1200, 10, false}, {600, 12, true}, {0, 9, false}};
+    uint8_t out[32];
+    TelemetrySample decoded[3];
+    size_t len = TelemetryCodec::encode(s, 3, out, sizeof(out));
+    TEST_ASSERT_EQUAL_UINT8(3, TelemetryCodec::decode(out, len, decoded, 3));
+
+    // Too many samples for the caller
+    TEST_ASSERT_EQUAL_UINT8(0, TelemetryCodec::decode(out, len, decoded, 2));
+    // Truncated anywhere, or trailing bytes
+    for (size_t n = 0; n < len; n++) {
+        TEST_ASSERT_EQUAL_UINT8(0, TelemetryCodec::decode(out, n, decoded, 3));
+    }
+    out[len] = 0;
+    TEST_ASSERT_EQUAL_UINT8(0, TelemetryCodec::decode(out, len + 1, decoded, 3));
+    // Wrong format, zero count
+    out[0] = 0x01;
+    TEST_ASSERT_EQUAL_UINT8(0, TelemetryCodec::decode(out, len, decoded, 3));
+    out[0] = TelemetryCodec::FORMAT_COMPACT;
+    out[1] = 0;
+    TEST_ASSERT_EQUAL_UINT8(0, TelemetryCodec::decode(out, len, decoded, 3));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_zigzag);
+    RUN_TEST(test_varint_sizes);
+    RUN_TEST(test_varint_round_trip);
+    RUN_TEST(test_varint_limits);
+    RUN_TEST(test_raw_from_celsius);
+    RUN_TEST(test_single_sample);
+    RUN_TEST(test_regular_batch);
+    RUN_TEST(test_irregular_batch);
+    RUN_TEST(test_extreme_deltas);
+    RUN_TEST(test_encode_rejects);
+    RUN_TEST(test_decode_rejects);
+    return UNITY_END();
+}
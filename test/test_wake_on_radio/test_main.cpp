@@ -0,0 +1,289 @@
+// WorSniffer against a fake radio: sniff timing, frame filter and the
+// false-wake re-arm loop WakeOnRadio::sleep() runs.
+// pio test -e native -f test_wake_on_radio
+#include <unity.h>
+#include <WorSniffer.h>
+#include <string.h>
+
+namespace {
+
+const uint8_t DEVICE[4] = {0x12, 0x34, 0x56, 0x78};
+const uint8_t OTHER[4]  = {0x12, 0x34, 0x56, 0x79};
+
+struct Packet {
+    uint8_t data[WorSniffer::MAX_FRAME];
+    size_t len;
+    bool ok;                // false: CRC or header error
+};
+
+// Scripted wakes at absolute times; packets are read in order
+class FakeRadio : public SniffBackend {
+public:
+    static constexpr int MAX_STEPS = 8;
+
+    uint64_t now = 0;
+    int sniffs = 0;
+    int reads = 0;
+    int failSniffAfter = -1;        // sniff() fails from this call on
+    uint32_t lastRxUs = 0;
+    uint32_t lastSleepUs = 0;
+    uint16_t lastPreamble = 0;
+
+    void at(uint64_t us, SniffEvent event) {
+        _atUs[_steps] = us;
+        _event[_steps++] = event;
+    }
+    void packet(const uint8_t* data, size_t len, bool ok = true) {
+        memcpy(_packet[_packets].data, data, len);
+        _packet[_packets].len = len;
+        _packet[_packets++].ok = ok;
+    }
+
+    uint64_t nowUs() override { return now; }
+
+    SniffEvent lightSleep(uint64_t us) override {
+        if (_next < _steps && _atUs[_next] <= now + us) {
+            now = _atUs[_next];
+            return _event[_next++];
+        }
+        now += us;
+        return SniffEvent::NONE;
+    }
+
+    bool sniff(uint32_t rxUs, uint32_t sleepUs, uint16_t preambleLength) override {
+        lastRxUs = rxUs;
+        lastSleepUs = sleepUs;
+        lastPreamble = preambleLength;
+        return failSniffAfter < 0 || sniffs++ < failSniffAfter;
+    }
+
+    bool read(uint8_t* buf, size_t* len, int16_t* rssi, int8_t* snr) override {
+        const Packet& p = _packet[reads++];
+        if (!p.ok || p.len > *len) return false;
+        memcpy(buf, p.data, p.len);
+        *len = p.len;
+        *rssi = -97;
+        *snr = 6;
+        return true;
+    }
+
+private:
+    uint64_t _atUs[MAX_STEPS];
+    SniffEvent _event[MAX_STEPS];
+    int _steps = 0;
+    int _next = 0;
+    Packet _packet[MAX_STEPS];
+    int _packets = 0;
+};
+
+// Single-packet command frame: header, length, dest at 7, type at 11,
+// packet count at 17, checksum over bytes 3..len-2
+size_t commandFrame(uint8_t* frame, const uint8_t dest[4], size_t payload = 4) {
+    size_t len = WorSniffer::FRAME_HEADER_SIZE + payload + 1;
+    memset(frame, 0, len);
+    frame[0] = WorSniffer::FRAME_HEADER;
+    frame[1] = (uint8_t)((len - 3) >> 8);
+    frame[2] = (uint8_t)(len - 3);
+    memcpy(frame + 7, dest, 4);
+    frame[11] = WorSniffer::COMMAND_FRAME_TYPE;
+    frame[17] = 1;
+    for (size_t i = 0; i < payload; i++) {
+        frame[WorSniffer::FRAME_HEADER_SIZE + i] = (uint8_t)(0xA0 + i);
+    }
+    uint8_t sum = 0;
+    for (size_t i = 3; i < len - 1; i++) {
+        sum += frame[i];
+    }
+    frame[len - 1] = sum;
+    return len;
+}
+
+FakeRadio* radio;
+WorSniffer sniffer;
+uint8_t frame[WorSniffer::MAX_FRAME];
+size_t frameLen;
+int16_t rssi;
+int8_t snr;
+
+WorWake sleepFor(uint64_t us) {
+    return sniffer.sleep(us, DEVICE, frame, &frameLen, &rssi, &snr);
+}
+
+} // namespace
+
+void setUp() {
+    radio = new FakeRadio();
+    sniffer.begin(radio, 1000, 7, 0);
+    frameLen = 0;
+}
+
+void tearDown() {
+    delete radio;
+}
+
+// SF7/BW125: 1.024 ms symbols, 4-symbol window
+void test_preamble_covers_period() {
+    TEST_ASSERT_EQUAL_UINT32(4096, WorSniffer::rxWindowUs(7, 0));
+    // ceil((1000000 + 4096) / 1024) + 4
+    TEST_ASSERT_EQUAL_UINT16(985, WorSniffer::preambleSymbols(1000, 7, 0));
+    // SF12: ceil((1000000 + 131072) / 32768) + 4
+    TEST_ASSERT_EQUAL_UINT16(39, WorSniffer::preambleSymbols(1000, 12, 0));
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, WorSniffer::preambleSymbols(100000, 7, 2));
+}
+
+void test_period_at_least_two_windows() {
+    TEST_ASSERT_EQUAL_UINT32(1000000, WorSniffer::periodUs(1000, 7, 0));
+    TEST_ASSERT_EQUAL_UINT32(2 * 131072, WorSniffer::periodUs(100, 12, 0));
+}
+
+void test_arm_programs_window_and_preamble() {
+    TEST_ASSERT_TRUE(sniffer.arm());
+    TEST_ASSERT_EQUAL_UINT32(4096, radio->lastRxUs);
+    TEST_ASSERT_EQUAL_UINT32(1000000 - 4096, radio->lastSleepUs);
+    TEST_ASSERT_EQUAL_UINT16(985, radio->lastPreamble);
+
+    sniffer.begin(radio, 1000, 7, 0, 2000);
+    TEST_ASSERT_TRUE(sniffer.arm());
+    TEST_ASSERT_EQUAL_UINT16(2000, radio->lastPreamble);
+}
+
+void test_addressed_to_accepts_command_for_device() {
+    size_t len = commandFrame(frame, DEVICE);
+    TEST_ASSERT_TRUE(WorSniffer::addressedTo(frame, len, DEVICE));
+}
+
+void test_addressed_to_rejects_other_frames() {
+    uint8_t f[WorSniffer::MAX_FRAME];
+    size_t len = commandFrame(f, OTHER);
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(f, len, DEVICE));
+
+    len = commandFrame(f, DEVICE);
+    f[len - 1] ^= 0x01;                                 // checksum
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(f, len, DEVICE));
+
+    len = commandFrame(f, DEVICE);
+    f[11] = 0x01;                                       // not a command
+    f[len - 1] += 0x01 - WorSniffer::COMMAND_FRAME_TYPE;
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(f, len, DEVICE));
+
+    len = commandFrame(f, DEVICE);
+    f[17] = 2;                                          // multi-packet
+    f[len - 1] += 1;
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(f, len, DEVICE));
+
+    len = commandFrame(f, DEVICE);
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(f, len - 1, DEVICE));   // length field
+    f[0] = 0x84;
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(f, len, DEVICE));       // header byte
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(f, WorSniffer::FRAME_HEADER_SIZE, DEVICE));
+    TEST_ASSERT_FALSE(WorSniffer::addressedTo(nullptr, len, DEVICE));
+}
+
+void test_timer_wake_sleeps_whole_interval() {
+    TEST_ASSERT_EQUAL(WorWake::TIMER, sleepFor(600000000));
+    TEST_ASSERT_EQUAL_UINT64(600000000, sniffer.sleptUs());
+    TEST_ASSERT_EQUAL_UINT64(0, sniffer.remainingUs());
+    TEST_ASSERT_EQUAL_UINT16(0, sniffer.falseWakes());
+    TEST_ASSERT_EQUAL(0, radio->reads);
+}
+
+void test_spurious_gpio_wake_keeps_sleeping() {
+    radio->at(1000, SniffEvent::NONE);
+    TEST_ASSERT_EQUAL(WorWake::TIMER, sleepFor(5000000));
+    TEST_ASSERT_EQUAL_UINT64(5000000, sniffer.sleptUs());
+    TEST_ASSERT_EQUAL(0, radio->reads);
+}
+
+void test_command_frame_ends_sleep() {
+    uint8_t f[WorSniffer::MAX_FRAME];
+    size_t len = commandFrame(f, DEVICE);
+    radio->packet(f, len);
+    radio->at(30000000, SniffEvent::DIO1);
+
+    TEST_ASSERT_EQUAL(WorWake::FRAME, sleepFor(600000000));
+    TEST_ASSERT_EQUAL_size_t(len, frameLen);
+    TEST_ASSERT_EQUAL_MEMORY(f, frame, len);
+    TEST_ASSERT_EQUAL_INT16(-97, rssi);
+    TEST_ASSERT_EQUAL_INT8(6, snr);
+    TEST_ASSERT_EQUAL_UINT64(30000000, sniffer.sleptUs());
+    TEST_ASSERT_EQUAL_UINT64(570000000, sniffer.remainingUs());
+    TEST_ASSERT_EQUAL_UINT16(0, sniffer.falseWakes());
+}
+
+// Another device's command and a CRC error each re-arm the radio and the
+// sleep goes on until the frame for this device
+void test_false_wakes_rearm_and_continue() {
+    uint8_t f[WorSniffer::MAX_FRAME];
+    size_t len = commandFrame(f, OTHER);
+    radio->packet(f, len);
+    radio->packet(f, len, false);
+    len = commandFrame(f, DEVICE);
+    radio->packet(f, len);
+    radio->at(10000000, SniffEvent::DIO1);
+    radio->at(20000000, SniffEvent::DIO1);
+    radio->at(40000000, SniffEvent::DIO1);
+
+    TEST_ASSERT_EQUAL(WorWake::FRAME, sleepFor(600000000));
+    TEST_ASSERT_EQUAL_UINT16(2, sniffer.falseWakes());
+    TEST_ASSERT_EQUAL(3, radio->reads);
+    TEST_ASSERT_EQUAL_UINT16(985, radio->lastPreamble);
+    TEST_ASSERT_EQUAL_UINT64(40000000, sniffer.sleptUs());
+    TEST_ASSERT_FALSE(sniffer.rearmFailed());
+}
+
+void test_false_wakes_only_end_on_timer() {
+    uint8_t f[WorSniffer::MAX_FRAME];
+    size_t len = commandFrame(f, OTHER);
+    radio->packet(f, len);
+    radio->packet(f, len);
+    radio->at(1000000, SniffEvent::DIO1);
+    radio->at(2000000, SniffEvent::DIO1);
+
+    TEST_ASSERT_EQUAL(WorWake::TIMER, sleepFor(10000000));
+    TEST_ASSERT_EQUAL_UINT16(2, sniffer.falseWakes());
+    TEST_ASSERT_EQUAL_size_t(0, frameLen);
+    TEST_ASSERT_EQUAL_UINT64(10000000, sniffer.sleptUs());
+}
+
+// A radio that cannot be re-armed would leave the device deaf: boot early
+void test_failed_rearm_ends_sleep_early() {
+    uint8_t f[WorSniffer::MAX_FRAME];
+    size_t len = commandFrame(f, OTHER);
+    radio->packet(f, len);
+    radio->at(5000000, SniffEvent::DIO1);
+    radio->failSniffAfter = 0;
+
+    TEST_ASSERT_EQUAL(WorWake::TIMER, sleepFor(600000000));
+    TEST_ASSERT_TRUE(sniffer.rearmFailed());
+    TEST_ASSERT_EQUAL_UINT16(1, sniffer.falseWakes());
+    TEST_ASSERT_EQUAL_UINT64(5000000, sniffer.sleptUs());
+    TEST_ASSERT_EQUAL_UINT64(595000000, sniffer.remainingUs());
+}
+
+void test_button_and_contact_end_sleep() {
+    radio->at(7000000, SniffEvent::BUTTON);
+    TEST_ASSERT_EQUAL(WorWake::BUTTON, sleepFor(600000000));
+    TEST_ASSERT_EQUAL_UINT64(7000000, sniffer.sleptUs());
+
+    radio->at(9000000, SniffEvent::CONTACT);
+    TEST_ASSERT_EQUAL(WorWake::CONTACT, sleepFor(600000000));
+    TEST_ASSERT_EQUAL_UINT64(2000000, sniffer.sleptUs());
+    TEST_ASSERT_EQUAL(0, radio->reads);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_preamble_covers_period);
+    RUN_TEST(test_period_at_least_two_windows);
+    RUN_TEST(test_arm_programs_window_and_preamble);
+    RUN_TEST(test_addressed_to_accepts_command_for_device);
+    RUN_TEST(test_addressed_to_rejects_other_frames);
+    RUN_TEST(test_timer_wake_sleeps_whole_interval);
+    RUN_TEST(test_spurious_gpio_wake_keeps_sleeping);
+    RUN_TEST(test_command_frame_ends_sleep);
+    RUN_TEST(test_false_wakes_rearm_and_continue);
+    RUN_TEST(test_false_wakes_only_end_on_timer);
+    RUN_TEST(test_failed_rearm_ends_sleep_early);
+    RUN_TEST(test_button_and_contact_end_sleep);
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+"""Turn a tokenized log capture back into text.
+
+    python3 tools/detokenize.py [capture.bin]     (stdin if omitted)
+
+Format strings come from src/log_tokens.h, which must be the one the
+firmware was built with; the boot record's table hash is checked against
+it. The record layout is described in src/resonant_log.h.
+"""
+
+import os
+import re
+import struct
+import sys
+
+RECORD_SYNC = 0xA5
+TOKEN_BOOT = 0xFFFF
+TOKEN_DROPPED = 0xFFFE
+PREFIX = {"E": "[E] ", "W": "[W] ", "I": "", "D": "[D] "}
+
+ENTRY = re.compile(r'\{0x([0-9A-Fa-f]{8})u, \'([EWID])\', "((?:[^"\\]|\\.)*)"\}')
+TABLE_HASH = re.compile(r"TABLE_HASH = 0x([0-9A-Fa-f]{4});")
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXcpfFeEgGs%])")
+
+
+def load_table(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    table_hash = int(TABLE_HASH.search(text).group(1), 16)
+    tokens = []
+    for m in ENTRY.finditer(text):
+        body = m.group(3).encode("utf-8").decode("unicode_escape").encode("latin-1").decode("utf-8")
+        tokens.append((m.group(2), body))
+    return table_hash, tokens
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = shift = 0
+        while True:
+            b = self.data[self.pos]
+            self.pos += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return value
+
+    def signed(self):
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    def float32(self):
+        (v,) = struct.unpack_from("<f", self.data, self.pos)
+        self.pos += 4
+        return v
+
+    def string(self):
+        n = self.data[self.pos]
+        s = self.data[self.pos + 1:self.pos + 1 + n]
+        self.pos += 1 + n
+        return s.decode("utf-8", "replace")
+
+
+def unsigned(value, size):
+    bits = 64 if size in ("ll", "j") else 32
+    return value & ((1 << bits) - 1)
+
+
+def render(fmt, reader):
+    """printf() the arguments in reader against fmt."""
+    out = []
+    last = 0
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, size, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        try:
+            if conv in "di":
+                out.append(("%" + flags + "d") % reader.signed())
+            elif conv in "ouxX":
+                out.append(("%" + flags + conv) % unsigned(reader.signed(), size))
+            elif conv == "c":
+                out.append(chr(reader.signed() & 0xFF))
+            elif conv == "p":
+                out.append("0x%x" % unsigned(reader.signed(), size))
+            elif conv == "s":
+                out.append(("%" + flags + "s") % reader.string())
+            else:
+                out.append(("%" + flags + conv) % reader.float32())
+        except IndexError:
+            out.append("<truncated>")
+            break
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def records(data):
+    """(payload) for each framed record; resyncs past damaged bytes."""
+    i = 0
+    while i + 1 < len(data):
+        if data[i] != RECORD_SYNC:
+            i += 1
+            continue
+        n = data[i + 1]
+        if n < 3 or i + 2 + n > len(data):
+            i += 1
+            continue
+        yield data[i + 2:i + 2 + n]
+        i += 2 + n
+
+
+def detokenize(data, table_hash, tokens, out):
+    for payload in records(data):
+        token = payload[0] | payload[1] << 8
+        reader = Reader(payload)
+        reader.pos = 2
+        try:
+            ms = reader.varint()
+        except IndexError:
+            continue
+        stamp = "[%6d.%03d] " % (ms // 1000, ms % 1000)
+        if token == TOKEN_BOOT:
+            built = reader.signed()
+            note = "" if built == table_hash else \
+                " (firmware table %04X, log_tokens.h %04X: wrong header, lines below are garbage)" % (built, table_hash)
+            out.write("%s--- boot%s ---\n" % (stamp, note))
+        elif token == TOKEN_DROPPED:
+            out.write("%s--- %d record(s) overwritten before they were drained ---\n" % (stamp, reader.signed()))
+        elif token < len(tokens):
+            level, fmt = tokens[token]
+            text = render(fmt, reader)
+            for line in (PREFIX[level] + text).split("\n"):
+                out.write(stamp + line + "\n")
+        else:
+            out.write("%s<unknown token %d>\n" % (stamp, token))
+
+
+def main(argv):
+    repo = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    table_hash, tokens = load_table(os.path.join(repo, "src", "log_tokens.h"))
+    if len(argv) > 1:
+        with open(argv[1], "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+    detokenize(data, table_hash, tokens, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,146 @@
+"""Generate src/log_tokens.h: the token table for the tokenized logger.
+
+Every LOG_E/LOG_W/LOG_I/LOG_D format string in src/ (sim excluded) gets a
+16-bit ID, its index in the table. The firmware looks the ID up at compile
+time (resonant_log.h), so the strings never reach flash. tools/detokenize.py
+reads the same header to turn the binary log back into text.
+
+Runs as a PlatformIO pre-build script (extra_scripts = pre:tools/log_tokens.py)
+and standalone:
+
+    python3 tools/log_tokens.py [--check]
+
+The header is only rewritten when the table changes. --check exits 1 if it
+is stale instead of writing it.
+"""
+
+import os
+import re
+import sys
+
+LOG_CALL = re.compile(r'\bLOG_([EWID])\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+LEVELS = "EWID"
+SOURCE_EXTS = (".h", ".cpp")
+HEADER = "log_tokens.h"
+
+
+def c_unescape(text):
+    """Bytes of a C string literal body, as the compiler sees them."""
+    out = bytearray()
+    i = 0
+    simple = {"n": 10, "t": 9, "r": 13, "a": 7, "b": 8, "f": 12, "v": 11,
+              "\\": 92, '"': 34, "'": 39, "?": 63}
+    while i < len(text):
+        c = text[i]
+        if c != "\\":
+            out += c.encode("utf-8")
+            i += 1
+            continue
+        n = text[i + 1]
+        if n == "x":
+            j = i + 2
+            while j < len(text) and text[j] in "0123456789abcdefABCDEF":
+                j += 1
+            out.append(int(text[i + 2:j], 16) & 0xFF)
+            i = j
+        elif n in "01234567":
+            j = i + 1
+            while j < len(text) and j < i + 4 and text[j] in "01234567":
+                j += 1
+            out.append(int(text[i + 1:j], 8) & 0xFF)
+            i = j
+        else:
+            out.append(simple[n])
+            i += 2
+    return bytes(out)
+
+
+def fnv1a(data):
+    h = 0x811C9DC5
+    for b in data:
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def collect(root):
+    """{(level, literal body as written)} for every LOG call in src/."""
+    found = set()
+    src = os.path.join(root, "src")
+    for dirpath, dirnames, filenames in os.walk(src):
+        dirnames[:] = sorted(d for d in dirnames if d != "sim")
+        for name in sorted(filenames):
+            if not name.endswith(SOURCE_EXTS) or name == HEADER:
+                continue
+            with open(os.path.join(dirpath, name), encoding="utf-8") as f:
+                text = f.read()
+            for m in LOG_CALL.finditer(text):
+                body = "".join(LITERAL.findall(m.group(2)))
+                found.add((m.group(1), body))
+    return sorted(found, key=lambda e: (LEVELS.index(e[0]), e[1]))
+
+
+def render(entries):
+    table_hash = fnv1a("\n".join(lvl + body for lvl, body in entries).encode("utf-8")) & 0xFFFF
+    lines = [
+        "// Generated by tools/log_tokens.py from the LOG_* calls in src/. Do not edit;",
+        "// it is regenerated before every firmware build.",
+        "#ifndef LOG_TOKENS_H",
+        "#define LOG_TOKENS_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "namespace ResonantLog {",
+        "",
+        "struct TokenEntry {",
+        "    uint32_t hash;          // FNV-1a of the format string",
+        "    char level;             // E, W, I or D",
+        "    const char* fmt;",
+        "};",
+        "",
+        "constexpr uint16_t TABLE_HASH = 0x%04X;" % table_hash,
+        "constexpr uint16_t TOKEN_COUNT = %d;" % len(entries),
+        "",
+        "inline constexpr TokenEntry TOKENS[] = {",
+    ]
+    for i, (level, body) in enumerate(entries):
+        lines.append('    {0x%08Xu, \'%s\', "%s"},    // %d' % (fnv1a(c_unescape(body)), level, body, i))
+    if not entries:
+        lines.append("    {0u, 0, \"\"},")
+    lines += [
+        "};",
+        "",
+        "} // namespace ResonantLog",
+        "",
+        "#endif // LOG_TOKENS_H",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def generate(root, check=False):
+    path = os.path.join(root, "src", HEADER)
+    content = render(collect(root))
+    try:
+        with open(path, encoding="utf-8") as f:
+            current = f.read()
+    except FileNotFoundError:
+        current = None
+    if current == content:
+        return True
+    if check:
+        print("%s is stale; run tools/log_tokens.py" % path)
+        return False
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(content)
+    print("log_tokens: wrote %s" % path)
+    return True
+
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO/SCons)
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        repo = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+        sys.exit(0 if generate(repo, check="--check" in sys.argv[1:]) else 1)